@@ -0,0 +1,43 @@
+#
+# CompressionSetup
+#
+
+# Centralized place to find the optional compression libraries that are used to read compressed data files
+# Sets the following variables:
+#
+# ZLIB_FOUND
+# ZLIB_INCLUDE_DIRS
+# ZLIB_LIBRARIES
+#
+# ZSTD_FOUND
+# ZSTD_INCLUDE_DIRS
+# ZSTD_LIBRARIES
+
+# Include guard so we don't try to find the libraries more than once
+if(CompressionSetup_included)
+    return()
+endif()
+set(CompressionSetup_included true)
+
+find_package(ZLIB QUIET)
+if(ZLIB_FOUND)
+    message(STATUS "Using zlib include path: ${ZLIB_INCLUDE_DIRS}")
+    message(STATUS "Using zlib library: ${ZLIB_LIBRARIES}")
+else()
+    message(STATUS "zlib not found, gzip-compressed data files will not be readable")
+    set(ZLIB_INCLUDE_DIRS "")
+    set(ZLIB_LIBRARIES "")
+endif()
+
+find_path(ZSTD_INCLUDE_DIRS zstd.h)
+find_library(ZSTD_LIBRARIES NAMES zstd)
+if(ZSTD_INCLUDE_DIRS AND ZSTD_LIBRARIES)
+    message(STATUS "Using zstd include path: ${ZSTD_INCLUDE_DIRS}")
+    message(STATUS "Using zstd library: ${ZSTD_LIBRARIES}")
+    set(ZSTD_FOUND "YES")
+else()
+    message(STATUS "zstd not found, zstd-compressed data files will not be readable")
+    set(ZSTD_INCLUDE_DIRS "")
+    set(ZSTD_LIBRARIES "")
+    set(ZSTD_FOUND "NO")
+endif()
@@ -369,6 +369,8 @@ public:
     ELL_Map(ELL_Model model, ELL_InputNode inputNode, ELL_PortElements output);
     std::vector<double> ComputeDouble(const std::vector<double>& inputData);
     std::vector<float> ComputeFloat(const std::vector<float>& inputData);
+    std::vector<double> ComputeDoubleBatch(const std::vector<double>& inputData);
+    std::vector<float> ComputeFloatBatch(const std::vector<float>& inputData);
     void Save(const std::string& filePath) const;
     
 private:
@@ -401,6 +403,8 @@ public:
     std::string GetCodeString();
     std::vector<double> ComputeDouble(const std::vector<double>& inputData);
     std::vector<float> ComputeFloat(const std::vector<float>& inputData);
+    std::vector<double> ComputeDoubleBatch(const std::vector<double>& inputData);
+    std::vector<float> ComputeFloatBatch(const std::vector<float>& inputData);
 
 #ifndef SWIG
     ELL_CompiledMap() = default;
@@ -6,8 +6,8 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-%ignore ell::predictors::LinearPredictor::GetWeights() const;
-%ignore ell::predictors::LinearPredictor::GetBias() const;
+%ignore ell::predictors::LinearPredictor<double>::GetWeights() const;
+%ignore ell::predictors::LinearPredictor<double>::GetBias() const;
 
 %{
 #include "NeuralLayersInterface.h"
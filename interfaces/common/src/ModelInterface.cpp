@@ -679,6 +679,20 @@ std::vector<float> ELL_Map::ComputeFloat(const std::vector<float>& inputData)
     return _map->Compute<float>(inputData);
 }
 
+std::vector<double> ELL_Map::ComputeDoubleBatch(const std::vector<double>& inputData)
+{
+    std::vector<double> outputData;
+    _map->ComputeBatch(inputData, outputData);
+    return outputData;
+}
+
+std::vector<float> ELL_Map::ComputeFloatBatch(const std::vector<float>& inputData)
+{
+    std::vector<float> outputData;
+    _map->ComputeBatch(inputData, outputData);
+    return outputData;
+}
+
 void ELL_Map::Save(const std::string& filePath) const
 {
     ell::common::SaveMap(*_map, filePath);
@@ -747,6 +761,20 @@ std::vector<float> ELL_CompiledMap::ComputeFloat(const std::vector<float>& input
     return _map->Compute<float>(inputData);
 }
 
+std::vector<double> ELL_CompiledMap::ComputeDoubleBatch(const std::vector<double>& inputData)
+{
+    std::vector<double> outputData;
+    _map->ComputeBatch(inputData, outputData);
+    return outputData;
+}
+
+std::vector<float> ELL_CompiledMap::ComputeFloatBatch(const std::vector<float>& inputData)
+{
+    std::vector<float> outputData;
+    _map->ComputeBatch(inputData, outputData);
+    return outputData;
+}
+
 std::string ELL_CompiledMap::GetCodeString()
 {
     std::stringstream s;
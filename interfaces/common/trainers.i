@@ -5,7 +5,7 @@
 //  Authors:  Chuck Jacobs, Piali Choudhury
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-%ignore ell::trainers::IIncrementalTrainer<ell::predictors::LinearPredictor>::GetPredictor() const;
+%ignore ell::trainers::IIncrementalTrainer<ell::predictors::LinearPredictor<double>>::GetPredictor() const;
 %ignore ell::trainers::IIncrementalTrainer<ell::predictors::SimpleForestPredictor>::GetPredictor() const;
 
 %{
@@ -21,7 +21,7 @@
 %include "MultiEpochIncrementalTrainer.h"
 %include "IIncrementalTrainer.h"
 
-%template () ell::trainers::IIncrementalTrainer<ell::predictors::LinearPredictor>;
+%template () ell::trainers::IIncrementalTrainer<ell::predictors::LinearPredictor<double>>;
 %template () ell::trainers::IIncrementalTrainer<ell::predictors::SimpleForestPredictor>;
 
 class SGDTrainerProxy;
@@ -71,9 +71,9 @@ class SortingForestTrainerProxy;
 	{
 		public:
 			SGDTrainerProxy() {}
-			SGDTrainerProxy(std::unique_ptr<ell::trainers::IIncrementalTrainer<ell::predictors::LinearPredictor>>& trainer)
+			SGDTrainerProxy(std::unique_ptr<ell::trainers::IIncrementalTrainer<ell::predictors::LinearPredictor<double>>>& trainer)
 			{
-				_trainer = std::shared_ptr<ell::trainers::IIncrementalTrainer<ell::predictors::LinearPredictor>>(trainer.release());
+				_trainer = std::shared_ptr<ell::trainers::IIncrementalTrainer<ell::predictors::LinearPredictor<double>>>(trainer.release());
 			}
 
 			void Update(ell::dataset::GenericRowDataset::Iterator exampleIterator) {
@@ -83,16 +83,16 @@ class SortingForestTrainerProxy;
 			#if defined(ELL_SWIGJAVASCRIPT)
 			void UpdateAsync(ell::dataset::GenericRowDataset::Iterator exampleIterator, Callback doneCb) {
 				auto doneCallback = doneCb.GetFunction();
-				Nan::AsyncQueueWorker(new TrainWorker<ell::predictors::LinearPredictor, ell::dataset::GenericRowDataset::Iterator>(doneCallback, _trainer, exampleIterator));
+				Nan::AsyncQueueWorker(new TrainWorker<ell::predictors::LinearPredictor<double>, ell::dataset::GenericRowDataset::Iterator>(doneCallback, _trainer, exampleIterator));
 			}
 			#endif
 
-			const ell::predictors::LinearPredictor& GetPredictor() const {
+			const ell::predictors::LinearPredictor<double>& GetPredictor() const {
 				return *_trainer->GetPredictor();
 			}
 
 		private:
-			std::shared_ptr<ell::trainers::IIncrementalTrainer<ell::predictors::LinearPredictor>> _trainer = nullptr;			
+			std::shared_ptr<ell::trainers::IIncrementalTrainer<ell::predictors::LinearPredictor<double>>> _trainer = nullptr;			
 	};
 
 	class SortingForestTrainerProxy
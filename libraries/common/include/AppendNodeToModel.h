@@ -8,10 +8,15 @@
 
 #pragma once
 
+#include "DataLoadArguments.h"
+
 // model
 #include "DynamicMap.h"
 #include "Model.h"
 
+// utilities
+#include "Exception.h"
+
 namespace ell
 {
 namespace common
@@ -25,6 +30,29 @@ namespace common
     /// <returns> The new model, with the predictor node appended </returns>
     template <typename PredictorNodeType, typename PredictorType>
     model::Model AppendNodeToModel(model::DynamicMap& map, const PredictorType& predictor);
+
+    /// <summary>
+    /// Appends a predictor node of the given type to the model in a map. If the data was loaded with
+    /// feature hashing, a FeatureHashingNode is also put in front of the map, so that the new model
+    /// takes the features as they were before hashing.
+    /// </summary>
+    ///
+    /// <typeparam name="PredictorNodeType"> The type of the new predictor node to add </typeparam>
+    /// <typeparam name="PredictorType"> The type of the predictor to add </typeparam>
+    /// <param name="map"> The map </param>
+    /// <param name="predictor"> The predictor to wrap in a node and add to the model </param>
+    /// <param name="dataLoadArguments"> The arguments that the training data was loaded with </param>
+    /// <returns> The new model, with the predictor node appended </returns>
+    template <typename PredictorNodeType, typename PredictorType>
+    model::Model AppendNodeToModel(model::DynamicMap& map, const PredictorType& predictor, const DataLoadArguments& dataLoadArguments);
+
+    /// <summary> Makes a copy of a map that first hashes its input with a FeatureHashingNode. </summary>
+    ///
+    /// <param name="map"> The map, whose single input must have 2^hashingBits double elements </param>
+    /// <param name="inputSize"> The number of features before hashing, which is the input size of the new map </param>
+    /// <param name="hashingBits"> The base 2 logarithm of the number of buckets </param>
+    /// <returns> The new map </returns>
+    model::DynamicMap PrependFeatureHashingNode(const model::DynamicMap& map, size_t inputSize, size_t hashingBits);
 }
 }
 
@@ -25,11 +25,28 @@ namespace common
         /// <summary> The filename for the input data file. </summary>
         std::string inputDataFilename = "";
 
+        /// <summary> The format of the input data file. </summary>
+        enum class DataFormat
+        {
+            text,
+            binary
+        };
+        DataFormat inputDataFormat = DataFormat::text;
+
         /// <summary> The number of elements in an input data vector. </summary>
         std::string dataDimension = "";
 
+        /// <summary> The base 2 logarithm of the number of feature-hashing buckets, or zero to disable feature hashing. </summary>
+        size_t hashingBits = 0;
+
+        /// <summary> The number of threads used to parse a text input data file, or zero to use one per hardware thread. </summary>
+        size_t numParsingThreads = 1;
+
         // not exposed on the command line
         size_t parsedDataDimension = 0;
+
+        // the number of features before hashing, which is parsedDataDimension when feature hashing is disabled
+        size_t parsedInputDimension = 0;
     };
 
     /// <summary> A version of DataLoadArguments that adds its members to the command line parser. </summary>
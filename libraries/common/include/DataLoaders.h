@@ -9,6 +9,7 @@
 #pragma once
 
 #include "DataLoadArguments.h"
+#include "MapApplicationArguments.h"
 
 // data
 #include "Dataset.h"
@@ -19,13 +20,24 @@
 
 
 // stl
-#include <string>
 #include <iostream>
+#include <memory>
+#include <string>
 
 namespace ell
 {
 namespace common
 {
+    /// <summary>
+    /// Opens a text data file for reading. A file that is compressed with gzip or zstd is recognized by
+    /// its contents and decompressed on a background thread while it is read.
+    /// </summary>
+    ///
+    /// <param name="filename"> The name of the data file. </param>
+    ///
+    /// <returns> The input stream. </returns>
+    std::unique_ptr<std::istream> OpenDataStream(const std::string& filename);
+
     /// <summary> Gets a data iterator from an input stream. </summary>
     ///
     /// <param name="stream"> Input stream to load data from. </param>
@@ -33,6 +45,24 @@ namespace common
     /// <returns> The data iterator. </returns>
     data::AutoSupervisedExampleIterator GetExampleIterator(std::istream& stream);
 
+    /// <summary> Gets a data iterator from an input stream, applying the options in the data load arguments (such as feature hashing). </summary>
+    ///
+    /// <param name="stream"> Input stream to load data from. </param>
+    /// <param name="dataLoadArguments"> The data load arguments. </param>
+    ///
+    /// <returns> The data iterator. </returns>
+    data::AutoSupervisedExampleIterator GetExampleIterator(std::istream& stream, const DataLoadArguments& dataLoadArguments);
+
+    /// <summary>
+    /// Gets a data iterator over the input data file named in the data load arguments, which may be
+    /// a text file or a binary dataset, depending on the input data format.
+    /// </summary>
+    ///
+    /// <param name="dataLoadArguments"> The data load arguments. </param>
+    ///
+    /// <returns> The data iterator. </returns>
+    data::AutoSupervisedExampleIterator GetExampleIterator(const DataLoadArguments& dataLoadArguments);
+
     /// <summary> Gets a dataset from data load arguments. </summary>
     ///
     /// <typeparam name="DatasetType"> Dataset type. </typeparam>
@@ -41,6 +71,53 @@ namespace common
     /// <returns> The dataset. </returns>
     data::AutoSupervisedDataset GetDataset(std::istream& stream);
 
+    /// <summary> Gets a dataset from an input stream, applying the options in the data load arguments (such as feature hashing). </summary>
+    ///
+    /// <param name="stream"> Input stream to load data from. </param>
+    /// <param name="dataLoadArguments"> The data load arguments. </param>
+    ///
+    /// <returns> The dataset. </returns>
+    data::AutoSupervisedDataset GetDataset(std::istream& stream, const DataLoadArguments& dataLoadArguments);
+
+    /// <summary>
+    /// Gets a dataset from the input data file named in the data load arguments, which may be a text
+    /// file or a binary dataset. The file is read and parsed on a background thread, while the
+    /// examples that were already parsed are added to the dataset.
+    /// </summary>
+    ///
+    /// <param name="dataLoadArguments"> The data load arguments. </param>
+    ///
+    /// <returns> The dataset. </returns>
+    data::AutoSupervisedDataset GetDataset(const DataLoadArguments& dataLoadArguments);
+
+    /// <summary>
+    /// Gets a data iterator that runs each example of another data iterator through a map, when the
+    /// example is read. Use this to stream mapped examples without storing them.
+    /// </summary>
+    ///
+    /// <typeparam name="MapType"> Map type. </typeparam>
+    /// <param name="exampleIterator"> The example iterator. </param>
+    /// <param name="map"> The map, which must outlive the returned iterator. </param>
+    ///
+    /// <returns> The mapped data iterator. </returns>
+    template <typename MapType>
+    data::AutoSupervisedExampleIterator GetMappedExampleIterator(data::AutoSupervisedExampleIterator exampleIterator, const MapType& map);
+
+    /// <summary>
+    /// Gets a data iterator that runs the examples of another data iterator through a map, as
+    /// specified by the map application arguments. The examples are read one chunk per map thread at
+    /// a time, and the chunks are mapped in parallel. The threads share one copy of the map, unless
+    /// compileMap is set, in which case each thread JIT-compiles its own copy. The order of the
+    /// examples is preserved.
+    /// </summary>
+    ///
+    /// <param name="exampleIterator"> The example iterator. </param>
+    /// <param name="map"> The map, which is copied (or compiled) when the iterator is created. </param>
+    /// <param name="mapApplicationArguments"> The map application arguments. </param>
+    ///
+    /// <returns> The mapped data iterator. </returns>
+    data::AutoSupervisedExampleIterator GetMappedExampleIterator(data::AutoSupervisedExampleIterator exampleIterator, const model::DynamicMap& map, const MapApplicationArguments& mapApplicationArguments);
+
     /// <summary>
     /// Gets a dataset by loading it from an example iterator and running it through a map.
     /// </summary>
@@ -64,6 +141,47 @@ namespace common
     /// <returns> The dataset. </returns>
     template <typename MapType>
     data::AutoSupervisedDataset GetMappedDataset(std::istream& stream, const MapType& map);
+
+    /// <summary>
+    /// Gets a dataset by loading it from an input stream, applying the options in the data load
+    /// arguments (such as feature hashing), and then running it through a map.
+    /// </summary>
+    ///
+    /// <typeparam name="MapType"> Map type. </typeparam>
+    /// <param name="stream"> Input stream to load data from. </param>
+    /// <param name="dataLoadArguments"> The data load arguments. </param>
+    /// <param name="map"> The map. </param>
+    ///
+    /// <returns> The dataset. </returns>
+    template <typename MapType>
+    data::AutoSupervisedDataset GetMappedDataset(std::istream& stream, const DataLoadArguments& dataLoadArguments, const MapType& map);
+
+    /// <summary>
+    /// Gets a dataset by loading it from the input data file named in the data load arguments, which
+    /// may be a text file or a binary dataset, and then running it through a map. The file is read
+    /// and parsed on a background thread, while the examples that were already parsed are mapped.
+    /// </summary>
+    ///
+    /// <typeparam name="MapType"> Map type. </typeparam>
+    /// <param name="dataLoadArguments"> The data load arguments. </param>
+    /// <param name="map"> The map. </param>
+    ///
+    /// <returns> The dataset. </returns>
+    template <typename MapType>
+    data::AutoSupervisedDataset GetMappedDataset(const DataLoadArguments& dataLoadArguments, const MapType& map);
+
+    /// <summary>
+    /// Gets a dataset by loading it from the input data file named in the data load arguments and
+    /// running it through a map, which is compiled and run on several threads as specified by the
+    /// map application arguments.
+    /// </summary>
+    ///
+    /// <param name="dataLoadArguments"> The data load arguments. </param>
+    /// <param name="map"> The map. </param>
+    /// <param name="mapApplicationArguments"> The map application arguments. </param>
+    ///
+    /// <returns> The dataset. </returns>
+    data::AutoSupervisedDataset GetMappedDataset(const DataLoadArguments& dataLoadArguments, const model::DynamicMap& map, const MapApplicationArguments& mapApplicationArguments);
 }
 }
 
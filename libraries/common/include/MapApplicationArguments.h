@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MapApplicationArguments.h (common)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// utilities
+#include "CommandLineParser.h"
+
+// stl
+#include <cstddef>
+
+namespace ell
+{
+namespace common
+{
+    /// <summary> A struct that holds command line parameters for running a map over a dataset. </summary>
+    struct MapApplicationArguments
+    {
+        /// <summary> Whether to compile the map with the JIT compiler instead of interpreting it node by node. </summary>
+        bool compileMap = false;
+
+        /// <summary> The number of threads that run the map, or zero to use one per hardware thread. </summary>
+        size_t numMapThreads = 1;
+
+        /// <summary> The number of consecutive examples that each thread maps at a time. </summary>
+        size_t mapChunkSize = 256;
+
+        /// <summary> Query if the arguments ask for anything other than interpreting the map on the calling thread. </summary>
+        ///
+        /// <returns> true if the map is compiled or run on several threads. </returns>
+        bool IsAccelerated() const { return compileMap || numMapThreads != 1; }
+    };
+
+    /// <summary> A version of MapApplicationArguments that adds its members to the command line parser. </summary>
+    struct ParsedMapApplicationArguments : public MapApplicationArguments, public utilities::ParsedArgSet
+    {
+        /// <summary> Adds the arguments to the command line parser. </summary>
+        ///
+        /// <param name="parser"> [in,out] The parser. </param>
+        virtual void AddArgs(utilities::CommandLineParser& parser) override;
+
+        /// <summary> Checks the parsed arguments. </summary>
+        ///
+        /// <param name="parser"> The parser. </param>
+        ///
+        /// <returns> An utilities::CommandLineParseResult. </returns>
+        virtual utilities::CommandLineParseResult PostProcess(const utilities::CommandLineParser& parser) override;
+    };
+}
+}
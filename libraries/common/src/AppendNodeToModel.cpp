@@ -0,0 +1,48 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     AppendNodeToModel.cpp (common)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "AppendNodeToModel.h"
+
+// model
+#include "InputNode.h"
+#include "ModelTransformer.h"
+
+// nodes
+#include "FeatureHashingNode.h"
+
+namespace ell
+{
+namespace common
+{
+    model::DynamicMap PrependFeatureHashingNode(const model::DynamicMap& map, size_t inputSize, size_t hashingBits)
+    {
+        auto mapInput = map.NumInputPorts() == 1 ? dynamic_cast<const model::InputNode<double>*>(map.GetInput(0)) : nullptr;
+        if (mapInput == nullptr || mapInput->output.Size() != size_t(1) << hashingBits)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "feature hashing requires a map with a single double input of size 2^hashingBits");
+        }
+
+        // the hashing node takes the place of the map's input node
+        model::InputNode<double>* newInput = nullptr;
+        model::ModelTransformer transformer;
+        auto transformFunction = [&](const model::Node& node, model::ModelTransformer& nodeTransformer) {
+            if (&node != mapInput)
+            {
+                node.Copy(nodeTransformer);
+                return;
+            }
+            newInput = nodeTransformer.AddNode<model::InputNode<double>>(inputSize);
+            auto hashingNode = nodeTransformer.AddNode<nodes::FeatureHashingNode<double>>(newInput->output, hashingBits);
+            nodeTransformer.MapNodeOutput(mapInput->output, hashingNode->output);
+        };
+        auto newModel = transformer.TransformModel(map.GetModel(), transformFunction, model::TransformContext());
+        auto output = transformer.GetCorrespondingOutputs(map.GetOutput(0));
+        return model::DynamicMap(newModel, { { "input", newInput } }, { { "output", output } });
+    }
+}
+}
@@ -9,6 +9,9 @@
 #include "DataLoadArguments.h"
 #include "DataLoaders.h"
 
+// data
+#include "BinaryDataset.h"
+
 // utilities
 #include "Files.h"
 #include "CStringParser.h"
@@ -31,12 +34,34 @@ namespace common
             "Path to the input data file",
             "");
 
+        parser.AddOption(
+            inputDataFormat,
+            "inputDataFormat",
+            "idff",
+            "Format of the input data file: text (generalized sparse format) or binary (see the dataConverter tool)",
+            { { "text", DataFormat::text }, { "binary", DataFormat::binary } },
+            "text");
+
         parser.AddOption(
             dataDimension,
             "dataDimension",
             "dd",
-            "Number of elements to read from each data vector",
+            "Number of elements to read from each data vector (with hashingBits, the number of features before hashing, which is the input size of a saved model)",
             "");
+
+        parser.AddOption(
+            hashingBits,
+            "hashingBits",
+            "hb",
+            "If positive, hash the input features into 2^hashingBits buckets (which also sets the data dimension). A saved model starts with a node that hashes a dense input of dataDimension raw features",
+            0);
+
+        parser.AddOption(
+            numParsingThreads,
+            "numParsingThreads",
+            "npt",
+            "Number of threads used to parse a text input data file (0 = one per hardware thread)",
+            1);
     }
 
     utilities::CommandLineParseResult ParsedDataLoadArguments::PostProcess(const utilities::CommandLineParser& parser)
@@ -49,7 +74,30 @@ namespace common
             isFileReadable = utilities::IsFileReadable(inputDataFilename);
         }
 
-        // dataDimension
+        // inputDataFormat
+        if (inputDataFormat == DataFormat::binary)
+        {
+            if (isFileReadable && !data::IsBinaryDatasetFile(inputDataFilename))
+            {
+                parseErrorMessages.push_back("Input data file is not a binary dataset");
+                return parseErrorMessages;
+            }
+
+            if (hashingBits > 0)
+            {
+                parseErrorMessages.push_back("Feature hashing cannot be applied to a binary dataset; train on the text data file to hash its features");
+                return parseErrorMessages;
+            }
+        }
+
+        // hashingBits
+        if (hashingBits > 32)
+        {
+            parseErrorMessages.push_back("hashingBits must be between 0 and 32");
+            return parseErrorMessages;
+        }
+
+        // dataDimension, which counts the features before hashing
         const char* ptr = dataDimension.c_str();
         if (dataDimension == "auto")
         {
@@ -59,13 +107,23 @@ namespace common
                 return parseErrorMessages;
             }
 
-            auto stream = utilities::OpenIfstream(inputDataFilename);
-            auto exampleIterator = GetExampleIterator(stream);
-            while (exampleIterator.IsValid())
+            if (inputDataFormat == DataFormat::binary)
+            {
+                // the binary header already records the largest prefix length
+                parsedDataDimension = data::BinaryDataset(inputDataFilename).NumColumns();
+            }
+            else
             {
-                auto size = exampleIterator.Get().GetDataVector().PrefixLength();
-                parsedDataDimension = std::max(parsedDataDimension, size);
-                exampleIterator.Next();
+                DataLoadArguments unhashedArguments = *this;
+                unhashedArguments.hashingBits = 0;
+                auto stream = OpenDataStream(inputDataFilename);
+                auto exampleIterator = GetExampleIterator(*stream, unhashedArguments);
+                while (exampleIterator.IsValid())
+                {
+                    auto size = exampleIterator.Get().GetDataVector().PrefixLength();
+                    parsedDataDimension = std::max(parsedDataDimension, size);
+                    exampleIterator.Next();
+                }
             }
         }
         else if (dataDimension != "")
@@ -73,6 +131,12 @@ namespace common
             utilities::Parse(ptr, parsedDataDimension);
         }
 
+        parsedInputDimension = parsedDataDimension;
+        if (hashingBits > 0)
+        {
+            parsedDataDimension = size_t(1) << hashingBits;
+        }
+
         return parseErrorMessages;
     }
 }
@@ -9,31 +9,192 @@
 #include "DataLoaders.h"
 
 // utilities
+#include "Exception.h"
 #include "Files.h"
 
 // data
+#include "BinaryDataset.h"
+#include "BufferedLineIterator.h"
 #include "Dataset.h"
-#include "SequentialLineIterator.h"
+#include "DecompressingStreamBuffer.h"
 
+#include "ParallelParsingExampleIterator.h"
+#include "PrefetchingExampleIterator.h"
 #include "SingleLineParsingExampleIterator.h"
 #include "AutoDataVector.h"
+#include "FeatureHasher.h"
 #include "WeightLabel.h"
 #include "GeneralizedSparseParsingIterator.h"
 
 // model
 #include "DynamicMap.h"
+#include "IRCompiledMap.h"
+#include "IRMapCompiler.h"
 
 // stl
+#include <algorithm>
+#include <fstream>
+#include <future>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace ell
 {
 namespace common
 {
+    namespace
+    {
+        template <typename DataVectorParserType>
+        data::AutoSupervisedExampleIterator GetTextExampleIterator(std::istream& stream, DataVectorParserType dataVectorParser, const DataLoadArguments& dataLoadArguments)
+        {
+            data::LabelParser metadataParser;
+
+            if (dataLoadArguments.numParsingThreads != 1)
+            {
+                data::ParallelParsingParameters parameters;
+                parameters.numThreads = dataLoadArguments.numParsingThreads;
+                return data::MakeParallelParsingExampleIterator(stream, std::move(metadataParser), std::move(dataVectorParser), parameters);
+            }
+
+            data::BufferedLineIterator textLineIterator(stream);
+            return data::MakeSingleLineParsingExampleIterator(std::move(textLineIterator), std::move(metadataParser), std::move(dataVectorParser));
+        }
+
+        // an example iterator that owns the file stream that it reads from
+        class FileExampleIterator : public data::IExampleIterator<data::AutoSupervisedExample>
+        {
+        public:
+            FileExampleIterator(const DataLoadArguments& dataLoadArguments)
+                : _stream(OpenDataStream(dataLoadArguments.inputDataFilename)), _exampleIterator(GetExampleIterator(*_stream, dataLoadArguments))
+            {
+            }
+
+            virtual bool IsValid() const override { return _exampleIterator.IsValid(); }
+
+            virtual void Next() override { _exampleIterator.Next(); }
+
+            virtual data::AutoSupervisedExample Get() const override { return _exampleIterator.Get(); }
+
+        private:
+            std::unique_ptr<std::istream> _stream;
+            data::AutoSupervisedExampleIterator _exampleIterator;
+        };
+
+        // an example iterator that maps chunks of examples on several threads
+        class ParallelMappedExampleIterator : public data::IExampleIterator<data::AutoSupervisedExample>
+        {
+        public:
+            ParallelMappedExampleIterator(data::AutoSupervisedExampleIterator exampleIterator, const model::DynamicMap& map, const MapApplicationArguments& mapApplicationArguments)
+                : _exampleIterator(std::move(exampleIterator)), _numThreads(mapApplicationArguments.numMapThreads), _chunkSize(std::max(mapApplicationArguments.mapChunkSize, size_t(1)))
+            {
+                if (_numThreads == 0)
+                {
+                    _numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+                }
+
+                // an interpreted map keeps the values of each call in the call's own execution context, so
+                // the threads share one copy of it; a compiled map keeps its values in the globals of its
+                // module, so each thread gets its own compiled copy
+                if (mapApplicationArguments.compileMap)
+                {
+                    for (size_t threadIndex = 0; threadIndex < _numThreads; ++threadIndex)
+                    {
+                        model::MapCompilerParameters settings;
+                        settings.moduleName = "ELL_map" + std::to_string(threadIndex);
+                        model::IRMapCompiler compiler(settings);
+                        _maps.push_back(std::make_unique<model::IRCompiledMap>(compiler.Compile(map)));
+                    }
+                }
+                else
+                {
+                    _maps.push_back(std::make_unique<model::DynamicMap>(map));
+                }
+                MapChunk();
+            }
+
+            virtual bool IsValid() const override { return _currentIndex < _chunk.size(); }
+
+            virtual void Next() override
+            {
+                ++_currentIndex;
+                if (_currentIndex >= _chunk.size())
+                {
+                    MapChunk();
+                }
+            }
+
+            virtual data::AutoSupervisedExample Get() const override { return _chunk[_currentIndex]; }
+
+        private:
+            void MapChunk()
+            {
+                _chunk.clear();
+                _currentIndex = 0;
+                while (_chunk.size() < _numThreads * _chunkSize && _exampleIterator.IsValid())
+                {
+                    _chunk.push_back(_exampleIterator.Get());
+                    _exampleIterator.Next();
+                }
+
+                // each thread maps a contiguous range of the chunk in place
+                std::vector<std::future<void>> futures;
+                for (size_t threadIndex = 0; threadIndex * _chunkSize < _chunk.size(); ++threadIndex)
+                {
+                    auto begin = threadIndex * _chunkSize;
+                    auto end = std::min(begin + _chunkSize, _chunk.size());
+                    const auto& map = *_maps[threadIndex % _maps.size()];
+                    futures.push_back(std::async(std::launch::async, [this, &map, begin, end]() {
+                        for (size_t index = begin; index < end; ++index)
+                        {
+                            const auto& example = _chunk[index];
+                            auto mappedDataVector = map.Compute<data::DoubleDataVector>(example.GetDataVector());
+                            _chunk[index] = data::AutoSupervisedExample(std::move(mappedDataVector), example.GetMetadata());
+                        }
+                    }));
+                }
+
+                // wait for all the threads before rethrowing the first failure
+                for (auto& future : futures)
+                {
+                    future.wait();
+                }
+                for (auto& future : futures)
+                {
+                    future.get();
+                }
+            }
+
+            data::AutoSupervisedExampleIterator _exampleIterator;
+            std::vector<std::unique_ptr<model::DynamicMap>> _maps;
+            size_t _numThreads;
+            size_t _chunkSize;
+            std::vector<data::AutoSupervisedExample> _chunk;
+            size_t _currentIndex = 0;
+        };
+    }
+
+    std::unique_ptr<std::istream> OpenDataStream(const std::string& filename)
+    {
+        auto format = data::GetCompressionFormat(filename);
+        if (format == data::CompressionFormat::none)
+        {
+            return std::make_unique<std::ifstream>(utilities::OpenIfstream(filename));
+        }
+
+        if (!data::IsCompressionFormatSupported(format))
+        {
+            auto formatName = format == data::CompressionFormat::gzip ? "gzip" : "zstd";
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, std::string("file ") + filename + " is compressed with " + formatName + ", which this build of ELL cannot decompress");
+        }
+        return std::make_unique<data::DecompressingIfstream>(filename);
+    }
+
     data::AutoSupervisedExampleIterator GetExampleIterator(std::istream& stream)
     {
-        data::SequentialLineIterator textLineIterator(stream); 
+        data::BufferedLineIterator textLineIterator(stream); 
 
         data::LabelParser metadataParser;
 
@@ -42,9 +203,56 @@ namespace common
         return data::MakeSingleLineParsingExampleIterator(std::move(textLineIterator), std::move(metadataParser), std::move(dataVectorParser));
     }
 
+    data::AutoSupervisedExampleIterator GetExampleIterator(std::istream& stream, const DataLoadArguments& dataLoadArguments)
+    {
+        if (dataLoadArguments.hashingBits == 0)
+        {
+            data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator> dataVectorParser;
+            return GetTextExampleIterator(stream, std::move(dataVectorParser), dataLoadArguments);
+        }
+
+        data::HashingAutoDataVectorParser<data::GeneralizedSparseParsingIterator> dataVectorParser(data::FeatureHasher(dataLoadArguments.hashingBits));
+        return GetTextExampleIterator(stream, std::move(dataVectorParser), dataLoadArguments);
+    }
+
+    data::AutoSupervisedExampleIterator GetExampleIterator(const DataLoadArguments& dataLoadArguments)
+    {
+        if (dataLoadArguments.inputDataFormat == DataLoadArguments::DataFormat::binary)
+        {
+            return data::BinaryDataset(dataLoadArguments.inputDataFilename).GetExampleIterator();
+        }
+        return data::AutoSupervisedExampleIterator(std::make_unique<FileExampleIterator>(dataLoadArguments));
+    }
+
     data::AutoSupervisedDataset GetDataset(std::istream& stream)
     {
         return data::MakeDataset(GetExampleIterator(stream));
     }
+
+    data::AutoSupervisedDataset GetDataset(std::istream& stream, const DataLoadArguments& dataLoadArguments)
+    {
+        return data::MakeDataset(GetExampleIterator(stream, dataLoadArguments));
+    }
+
+    data::AutoSupervisedDataset GetDataset(const DataLoadArguments& dataLoadArguments)
+    {
+        return data::MakeDataset(data::MakePrefetchingExampleIterator(GetExampleIterator(dataLoadArguments)));
+    }
+
+    data::AutoSupervisedExampleIterator GetMappedExampleIterator(data::AutoSupervisedExampleIterator exampleIterator, const model::DynamicMap& map, const MapApplicationArguments& mapApplicationArguments)
+    {
+        return data::AutoSupervisedExampleIterator(std::make_unique<ParallelMappedExampleIterator>(std::move(exampleIterator), map, mapApplicationArguments));
+    }
+
+    data::AutoSupervisedDataset GetMappedDataset(const DataLoadArguments& dataLoadArguments, const model::DynamicMap& map, const MapApplicationArguments& mapApplicationArguments)
+    {
+        if (!mapApplicationArguments.IsAccelerated())
+        {
+            return GetMappedDataset(dataLoadArguments, map);
+        }
+
+        auto exampleIterator = data::MakePrefetchingExampleIterator(GetExampleIterator(dataLoadArguments));
+        return data::MakeDataset(GetMappedExampleIterator(std::move(exampleIterator), map, mapApplicationArguments));
+    }
 }
 }
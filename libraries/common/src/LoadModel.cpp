@@ -20,6 +20,7 @@
 #include "DelayNode.h"
 #include "DotProductNode.h"
 #include "ExtremalValueNode.h"
+#include "FeatureHashingNode.h"
 #include "ForestPredictorNode.h"
 #include "L2NormNode.h"
 #include "LinearPredictorNode.h"
@@ -65,7 +66,7 @@ namespace common
 
         // classifier
         auto inputs = model::Concat(model::MakePortElements(mean8->output), model::MakePortElements(var8->output), model::MakePortElements(mean16->output), model::MakePortElements(var16->output));
-        predictors::LinearPredictor predictor(inputs.Size());
+        predictors::LinearPredictor<double> predictor(inputs.Size());
         // Set some values into the predictor's vector
         for (size_t index = 0; index < inputs.Size(); ++index)
         {
@@ -214,6 +215,9 @@ namespace common
         context.GetTypeFactory().AddType<model::Node, nodes::DotProductNode<float>>();
         context.GetTypeFactory().AddType<model::Node, nodes::DotProductNode<double>>();
 
+        context.GetTypeFactory().AddType<model::Node, nodes::FeatureHashingNode<float>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::FeatureHashingNode<double>>();
+
         context.GetTypeFactory().AddType<model::Node, nodes::L2NormNode<double>>();
         context.GetTypeFactory().AddType<model::Node, nodes::L2NormNode<float>>();
 
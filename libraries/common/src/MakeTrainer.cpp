@@ -29,89 +29,89 @@ namespace ell
 {
 namespace common
 {
-    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor>> MakeSGDTrainer(const LossFunctionArguments& lossFunctionArguments, const trainers::SGDTrainerParameters& trainerParameters)
+    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor<double>>> MakeSGDTrainer(const LossFunctionArguments& lossFunctionArguments, const trainers::SGDTrainerParameters& trainerParameters)
     {
         using LossFunctionEnum = common::LossFunctionArguments::LossFunction;
 
         switch (lossFunctionArguments.lossFunction)
         {
             case LossFunctionEnum::squared:
-                return trainers::MakeSGDTrainer(functions::SquaredLoss(), trainerParameters);
+                return trainers::MakeSGDTrainer<double>(functions::SquaredLoss(), trainerParameters);
 
             case LossFunctionEnum::log:
-                return trainers::MakeSGDTrainer(functions::LogLoss(), trainerParameters);
+                return trainers::MakeSGDTrainer<double>(functions::LogLoss(), trainerParameters);
 
             case LossFunctionEnum::hinge:
-                return trainers::MakeSGDTrainer(functions::HingeLoss(), trainerParameters);
+                return trainers::MakeSGDTrainer<double>(functions::HingeLoss(), trainerParameters);
 
             case LossFunctionEnum::smoothHinge:
-                return trainers::MakeSGDTrainer(functions::SmoothHingeLoss(), trainerParameters);
+                return trainers::MakeSGDTrainer<double>(functions::SmoothHingeLoss(), trainerParameters);
 
             default:
                 throw utilities::CommandLineParserErrorException("chosen loss function is not supported by this trainer");
         }
     }
 
-    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor>> MakeSparseDataSGDTrainer(const LossFunctionArguments& lossFunctionArguments, const trainers::SGDTrainerParameters& trainerParameters)
+    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor<double>>> MakeSparseDataSGDTrainer(const LossFunctionArguments& lossFunctionArguments, const trainers::SGDTrainerParameters& trainerParameters)
     {
         using LossFunctionEnum = common::LossFunctionArguments::LossFunction;
 
         switch (lossFunctionArguments.lossFunction)
         {
             case LossFunctionEnum::squared:
-                return trainers::MakeSparseDataSGDTrainer(functions::SquaredLoss(), trainerParameters);
+                return trainers::MakeSparseDataSGDTrainer<double>(functions::SquaredLoss(), trainerParameters);
 
             case LossFunctionEnum::log:
-                return trainers::MakeSparseDataSGDTrainer(functions::LogLoss(), trainerParameters);
+                return trainers::MakeSparseDataSGDTrainer<double>(functions::LogLoss(), trainerParameters);
 
             case LossFunctionEnum::hinge:
-                return trainers::MakeSparseDataSGDTrainer(functions::HingeLoss(), trainerParameters);
+                return trainers::MakeSparseDataSGDTrainer<double>(functions::HingeLoss(), trainerParameters);
 
             case LossFunctionEnum::smoothHinge:
-                return trainers::MakeSparseDataSGDTrainer(functions::SmoothHingeLoss(), trainerParameters);
+                return trainers::MakeSparseDataSGDTrainer<double>(functions::SmoothHingeLoss(), trainerParameters);
 
             default:
                 throw utilities::CommandLineParserErrorException("chosen loss function is not supported by this trainer");
         }
     }
 
-    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor>> MakeSparseDataCenteredSGDTrainer(const LossFunctionArguments& lossFunctionArguments, math::RowVector<double> center, const trainers::SGDTrainerParameters& trainerParameters)
+    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor<double>>> MakeSparseDataCenteredSGDTrainer(const LossFunctionArguments& lossFunctionArguments, math::RowVector<double> center, const trainers::SGDTrainerParameters& trainerParameters)
     {
         using LossFunctionEnum = common::LossFunctionArguments::LossFunction;
 
         switch (lossFunctionArguments.lossFunction)
         {
         case LossFunctionEnum::squared:
-            return trainers::MakeSparseDataCenteredSGDTrainer(functions::SquaredLoss(), std::move(center), trainerParameters);
+            return trainers::MakeSparseDataCenteredSGDTrainer<double>(functions::SquaredLoss(), std::move(center), trainerParameters);
 
         case LossFunctionEnum::log:
-            return trainers::MakeSparseDataCenteredSGDTrainer(functions::LogLoss(), std::move(center), trainerParameters);
+            return trainers::MakeSparseDataCenteredSGDTrainer<double>(functions::LogLoss(), std::move(center), trainerParameters);
 
         case LossFunctionEnum::hinge:
-            return trainers::MakeSparseDataCenteredSGDTrainer(functions::HingeLoss(), std::move(center), trainerParameters);
+            return trainers::MakeSparseDataCenteredSGDTrainer<double>(functions::HingeLoss(), std::move(center), trainerParameters);
 
         case LossFunctionEnum::smoothHinge:
-            return trainers::MakeSparseDataCenteredSGDTrainer(functions::SmoothHingeLoss(), std::move(center), trainerParameters);
+            return trainers::MakeSparseDataCenteredSGDTrainer<double>(functions::SmoothHingeLoss(), std::move(center), trainerParameters);
 
         default:
             throw utilities::CommandLineParserErrorException("chosen loss function is not supported by this trainer");
         }
     }
 
-    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor>> MakeSDCATrainer(const LossFunctionArguments& lossFunctionArguments, const trainers::SDCATrainerParameters& trainerParameters)
+    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor<double>>> MakeSDCATrainer(const LossFunctionArguments& lossFunctionArguments, const trainers::SDCATrainerParameters& trainerParameters)
     {
         using LossFunctionEnum = common::LossFunctionArguments::LossFunction;
 
         switch (lossFunctionArguments.lossFunction)
         {
         case LossFunctionEnum::squared:
-            return trainers::MakeSDCATrainer(functions::SquaredLoss(), functions::L2Regularizer(), trainerParameters);
+            return trainers::MakeSDCATrainer<double>(functions::SquaredLoss(), functions::L2Regularizer(), trainerParameters);
 
         case LossFunctionEnum::log:
-            return trainers::MakeSDCATrainer(functions::LogLoss(), functions::L2Regularizer(), trainerParameters);
+            return trainers::MakeSDCATrainer<double>(functions::LogLoss(), functions::L2Regularizer(), trainerParameters);
 
         case LossFunctionEnum::smoothHinge:
-            return trainers::MakeSDCATrainer(functions::SmoothHingeLoss(), functions::L2Regularizer(), trainerParameters);
+            return trainers::MakeSDCATrainer<double>(functions::SmoothHingeLoss(), functions::L2Regularizer(), trainerParameters);
 
         default:
             throw utilities::CommandLineParserErrorException("chosen loss function is not supported by this trainer");
@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MapApplicationArguments.cpp (common)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MapApplicationArguments.h"
+
+// stl
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace common
+{
+    void ParsedMapApplicationArguments::AddArgs(utilities::CommandLineParser& parser)
+    {
+        parser.AddOption(
+            compileMap,
+            "compileMap",
+            "cm",
+            "Compile the map with the JIT compiler before running the data through it",
+            false);
+
+        parser.AddOption(
+            numMapThreads,
+            "numMapThreads",
+            "nmt",
+            "Number of threads that run the data through the map (0 = one per hardware thread)",
+            1);
+
+        parser.AddOption(
+            mapChunkSize,
+            "mapChunkSize",
+            "mcs",
+            "Number of consecutive examples that each map thread processes at a time",
+            256);
+    }
+
+    utilities::CommandLineParseResult ParsedMapApplicationArguments::PostProcess(const utilities::CommandLineParser& parser)
+    {
+        std::vector<std::string> parseErrorMessages;
+        if (mapChunkSize == 0)
+        {
+            parseErrorMessages.push_back("mapChunkSize must be positive");
+        }
+        return parseErrorMessages;
+    }
+}
+}
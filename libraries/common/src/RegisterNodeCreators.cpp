@@ -19,6 +19,7 @@
 #include "DelayNode.h"
 #include "DotProductNode.h"
 #include "ExtremalValueNode.h"
+#include "FeatureHashingNode.h"
 #include "ForestPredictorNode.h"
 #include "L2NormNode.h"
 #include "LinearPredictorNode.h"
@@ -70,6 +71,8 @@ namespace common
         builder.RegisterNodeCreator<nodes::DotProductNode<int>, const model::PortElements<int>&, const model::PortElements<int>&>();
         builder.RegisterNodeCreator<nodes::DotProductNode<double>, const model::PortElements<double>&, const model::PortElements<double>&>();
 
+        builder.RegisterNodeCreator<nodes::FeatureHashingNode<double>, const model::PortElements<double>&, size_t>();
+
         builder.RegisterNodeCreator<nodes::L2NormNode<double>, const model::PortElements<double>&>();
 
         builder.RegisterNodeCreator<nodes::MovingAverageNode<double>, const model::PortElements<double>&, size_t>();
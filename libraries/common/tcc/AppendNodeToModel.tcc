@@ -18,5 +18,21 @@ namespace common
         model.AddNode<PredictorNodeType>(mapOutput, predictor);
         return model;
     }
+
+    template <typename PredictorNodeType, typename PredictorType>
+    model::Model AppendNodeToModel(model::DynamicMap& map, const PredictorType& predictor, const DataLoadArguments& dataLoadArguments)
+    {
+        if (dataLoadArguments.hashingBits == 0)
+        {
+            return AppendNodeToModel<PredictorNodeType>(map, predictor);
+        }
+
+        if (dataLoadArguments.parsedInputDimension == 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "saving a model trained on hashed features requires the data dimension, which is the input size of the model");
+        }
+        auto hashingMap = PrependFeatureHashingNode(map, dataLoadArguments.parsedInputDimension, dataLoadArguments.hashingBits);
+        return AppendNodeToModel<PredictorNodeType>(hashingMap, predictor);
+    }
 }
 }
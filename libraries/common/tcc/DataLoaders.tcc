@@ -6,10 +6,51 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// data
+#include "PrefetchingExampleIterator.h"
+
+// stl
+#include <memory>
+
 namespace ell
 {
 namespace common
 {
+    namespace DataLoadersImpl
+    {
+        // an example iterator that maps the data vector of each example when it is read
+        template <typename MapType>
+        class MappedExampleIterator : public data::IExampleIterator<data::AutoSupervisedExample>
+        {
+        public:
+            MappedExampleIterator(data::AutoSupervisedExampleIterator exampleIterator, const MapType& map)
+                : _exampleIterator(std::move(exampleIterator)), _map(map)
+            {
+            }
+
+            virtual bool IsValid() const override { return _exampleIterator.IsValid(); }
+
+            virtual void Next() override { _exampleIterator.Next(); }
+
+            virtual data::AutoSupervisedExample Get() const override
+            {
+                auto example = _exampleIterator.Get();
+                auto mappedDataVector = _map.template Compute<data::DoubleDataVector>(example.GetDataVector());
+                return data::AutoSupervisedExample(std::move(mappedDataVector), example.GetMetadata());
+            }
+
+        private:
+            data::AutoSupervisedExampleIterator _exampleIterator;
+            const MapType& _map;
+        };
+    }
+
+    template <typename MapType>
+    data::AutoSupervisedExampleIterator GetMappedExampleIterator(data::AutoSupervisedExampleIterator exampleIterator, const MapType& map)
+    {
+        return data::AutoSupervisedExampleIterator(std::make_unique<DataLoadersImpl::MappedExampleIterator<MapType>>(std::move(exampleIterator), map));
+    }
+
     template <typename MapType>
     data::AutoSupervisedDataset GetMappedDataset(data::AutoSupervisedExampleIterator exampleIterator, const MapType& map)
     {
@@ -33,5 +74,17 @@ namespace common
     {
         return GetMappedDataset(GetExampleIterator(stream), map);
     }
+
+    template <typename MapType>
+    data::AutoSupervisedDataset GetMappedDataset(std::istream& stream, const DataLoadArguments& dataLoadArguments, const MapType& map)
+    {
+        return GetMappedDataset(GetExampleIterator(stream, dataLoadArguments), map);
+    }
+
+    template <typename MapType>
+    data::AutoSupervisedDataset GetMappedDataset(const DataLoadArguments& dataLoadArguments, const MapType& map)
+    {
+        return GetMappedDataset(data::MakePrefetchingExampleIterator(GetExampleIterator(dataLoadArguments)), map);
+    }
 }
 }
@@ -9,4 +9,5 @@ namespace ell
 {
 void TestLoadDataset();
 void TestLoadMappedDataset();
+void TestLoadParallelMappedDataset();
 }
\ No newline at end of file
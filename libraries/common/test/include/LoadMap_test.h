@@ -7,4 +7,5 @@ namespace ell
 {
 void TestLoadMapWithDefaultArgs();
 void TestLoadMapWithPorts();
+void TestPrependFeatureHashingNode();
 }
\ No newline at end of file
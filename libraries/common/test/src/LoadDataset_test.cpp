@@ -9,6 +9,7 @@
 #include "DataLoadArguments.h"
 #include "DataLoaders.h"
 #include "LoadModel.h"
+#include "MapApplicationArguments.h"
 #include "MapLoadArguments.h"
 
 // testing
@@ -40,4 +41,33 @@ void TestLoadMappedDataset()
     auto stream = utilities::OpenIfstream("../../../examples/data/testData.txt");
     auto dataset = common::GetMappedDataset(stream, map);
 }
+
+void TestLoadParallelMappedDataset()
+{
+    common::MapLoadArguments args;
+    args.inputModelFilename = "../../../examples/data/model_1.model";
+    args.modelInputsString = "";
+    args.modelOutputsString = "1026.output";
+
+    auto map = common::LoadMap(args);
+    auto stream = utilities::OpenIfstream("../../../examples/data/testData.txt");
+    auto dataset = common::GetMappedDataset(stream, map);
+
+    // small chunks, so that every thread maps several chunks
+    common::MapApplicationArguments mapApplicationArguments;
+    mapApplicationArguments.numMapThreads = 3;
+    mapApplicationArguments.mapChunkSize = 5;
+    auto parallelStream = utilities::OpenIfstream("../../../examples/data/testData.txt");
+    auto exampleIterator = common::GetMappedExampleIterator(common::GetExampleIterator(parallelStream), map, mapApplicationArguments);
+    auto parallelDataset = data::MakeDataset(std::move(exampleIterator));
+
+    bool isEqual = dataset.NumExamples() == parallelDataset.NumExamples();
+    for (size_t index = 0; isEqual && index < dataset.NumExamples(); ++index)
+    {
+        const auto& example = dataset.GetExample(index);
+        const auto& parallelExample = parallelDataset.GetExample(index);
+        isEqual = example.GetDataVector().ToArray() == parallelExample.GetDataVector().ToArray() && example.GetMetadata().label == parallelExample.GetMetadata().label;
+    }
+    testing::ProcessTest("TestLoadParallelMappedDataset", isEqual);
+}
 }
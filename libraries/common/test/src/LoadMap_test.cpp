@@ -6,10 +6,15 @@
 #include "LoadMap_test.h"
 
 // common
+#include "AppendNodeToModel.h"
 #include "LoadModel.h"
 #include "MapLoadArguments.h"
 
+// data
+#include "FeatureHasher.h"
+
 // model
+#include "InputNode.h"
 #include "Model.h"
 
 // testing
@@ -51,4 +56,23 @@ void TestLoadMapWithPorts()
     testing::ProcessTest("Testing map load", map.GetInput(0)->Size() == 3);
     testing::ProcessTest("Testing map load", map.GetOutput(0).Size() == 4);
 }
+
+void TestPrependFeatureHashingNode()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(4);
+    model::DynamicMap map(model, { { "input", inputNode } }, { { "output", inputNode->output } });
+
+    // the new map hashes the raw features the same way that data loading does
+    auto hashingMap = common::PrependFeatureHashingNode(map, 6, 2);
+    std::vector<double> input = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+    std::vector<double> expected(4);
+    data::FeatureHasher hasher(2);
+    for (size_t index = 0; index < input.size(); ++index)
+    {
+        expected[hasher.GetBucket(index)] += hasher.GetSign(index) * input[index];
+    }
+    auto output = hashingMap.Compute<double>(input);
+    testing::ProcessTest("Testing PrependFeatureHashingNode", hashingMap.GetInput(0)->Size() == 6 && testing::IsEqual(output, expected));
+}
 }
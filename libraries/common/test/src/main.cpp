@@ -35,9 +35,11 @@ int main()
 
         TestLoadMapWithDefaultArgs();
         TestLoadMapWithPorts();
+        TestPrependFeatureHashingNode();
 
         TestLoadDataset();
         TestLoadMappedDataset();
+        TestLoadParallelMappedDataset();
     }
     catch (const utilities::Exception& exception)
     {
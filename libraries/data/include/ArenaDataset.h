@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ArenaDataset.h (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "DataVector.h"
+#include "Dataset.h"
+#include "Example.h"
+#include "ExampleIterator.h"
+#include "IndexValue.h"
+#include "SparseDataVector.h"
+#include "WeightLabel.h"
+
+// stl
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary>
+    /// A supervised dataset that stores the data vectors of all of its examples in a few contiguous
+    /// arrays, instead of one heap-allocated data vector per example. Each example is stored either
+    /// as a dense row (its values up to its prefix length) or as a sparse row (its nonzero values
+    /// and their indices), whichever is smaller. GetRow reads an example in place, as a data vector
+    /// that refers to the arena. Examples are materialized as data vectors of the requested type only
+    /// when they are read through an example iterator, so the dataset can be passed to every trainer
+    /// that accepts an AnyDataset. The dataset is append-only.
+    /// </summary>
+    class ArenaDataset : public DatasetBase
+    {
+    public:
+        class Row;
+
+        /// <summary> An index-value iterator over the stored nonzero entries of one example. </summary>
+        class RowIterator : public IIndexValueIterator
+        {
+        public:
+            /// <summary> Returns true if the iterator is currently pointing to a valid iterate. </summary>
+            ///
+            /// <returns> true if the iterator is valid. </returns>
+            bool IsValid() const { return _current < _size && GetIndex() < _end; }
+
+            /// <summary> Proceeds to the next nonzero entry. </summary>
+            void Next();
+
+            /// <summary> Returns the current index-value pair. </summary>
+            ///
+            /// <returns> The current index-value pair. </returns>
+            IndexValue Get() const { return IndexValue{ GetIndex(), _values[_current] }; }
+
+        private:
+            friend class ArenaDataset;
+            friend class Row;
+            RowIterator(const uint32_t* indices, const double* values, size_t size, size_t end);
+            size_t GetIndex() const { return _indices == nullptr ? _current : _indices[_current]; }
+            void SkipZeros();
+
+            const uint32_t* _indices; // null for a dense row
+            const double* _values;
+            size_t _size;
+            size_t _end;
+            size_t _current = 0;
+        };
+
+        /// <summary> An index-value iterator over every entry of a prefix of one example, including the zeros. </summary>
+        class DenseRowIterator : public IIndexValueIterator
+        {
+        public:
+            /// <summary> Returns true if the iterator is currently pointing to a valid iterate. </summary>
+            ///
+            /// <returns> true if the iterator is valid. </returns>
+            bool IsValid() const { return _index < _end; }
+
+            /// <summary> Proceeds to the next entry. </summary>
+            void Next();
+
+            /// <summary> Returns the current index-value pair. </summary>
+            ///
+            /// <returns> The current index-value pair. </returns>
+            IndexValue Get() const;
+
+        private:
+            friend class ArenaDataset;
+            friend class Row;
+            DenseRowIterator(const uint32_t* indices, const double* values, size_t size, size_t end);
+
+            const uint32_t* _indices; // null for a dense row
+            const double* _values;
+            size_t _size;
+            size_t _end;
+            size_t _index = 0;
+            size_t _current = 0; // the first stored entry whose index is not less than _index
+        };
+
+        /// <summary>
+        /// A read-only data vector that refers to the stored entries of one example, without copying
+        /// them. A row is only valid while the dataset it came from exists and no example is added to it.
+        /// </summary>
+        class Row : public DataVectorBase<Row>
+        {
+        public:
+            template <IterationPolicy policy>
+            using Iterator = std::conditional_t<policy == IterationPolicy::all, DenseRowIterator, RowIterator>;
+
+            /// <summary> Gets the data vector type. </summary>
+            ///
+            /// <returns> The data vector type. </returns>
+            virtual IDataVector::Type GetType() const override { return IDataVector::Type::ArenaDatasetRow; }
+
+            /// <summary> Rows are read-only, so this function throws. </summary>
+            ///
+            /// <param name="index"> Zero-based index of the element. </param>
+            /// <param name="value"> The value. </param>
+            virtual void AppendElement(size_t index, double value) override;
+
+            /// <summary> Returns the first index of the suffix of zeros at the end of this vector. </summary>
+            ///
+            /// <returns> The first index of the suffix of zeros at the end of this vector. </returns>
+            virtual size_t PrefixLength() const override;
+
+            /// <summary> Returns an index-value iterator over a prefix of the row. </summary>
+            ///
+            /// <typeparam name="policy"> The iteration policy. </typeparam>
+            /// <param name="size"> The prefix size. </param>
+            ///
+            /// <returns> The iterator. </returns>
+            template <IterationPolicy policy>
+            Iterator<policy> GetIterator(size_t size) const { return Iterator<policy>(_indices, _values, _size, size); }
+
+            /// <summary> Returns an index-value iterator over the row, up to PrefixLength(). </summary>
+            ///
+            /// <typeparam name="policy"> The iteration policy. </typeparam>
+            ///
+            /// <returns> The iterator. </returns>
+            template <IterationPolicy policy>
+            Iterator<policy> GetIterator() const { return GetIterator<policy>(PrefixLength()); }
+
+        private:
+            friend class ArenaDataset;
+            friend class BinaryDataset; // the rows of a binary dataset file are sparse arena rows
+            Row(const uint32_t* indices, const double* values, size_t size);
+
+            const uint32_t* _indices; // null for a dense row
+            const double* _values;
+            size_t _size;
+        };
+
+        ArenaDataset() = default;
+
+        ArenaDataset(ArenaDataset&&) = default;
+
+        ArenaDataset(const ArenaDataset&) = delete;
+
+        /// <summary> Constructs an instance of ArenaDataset by copying the examples of an example iterator. </summary>
+        ///
+        /// <typeparam name="ExampleType"> The example type. </typeparam>
+        /// <param name="exampleIterator"> The example iterator. </param>
+        template <typename ExampleType>
+        ArenaDataset(ExampleIterator<ExampleType> exampleIterator);
+
+        ArenaDataset& operator=(ArenaDataset&&) = default;
+
+        ArenaDataset& operator=(const ArenaDataset&) = delete;
+
+        /// <summary> Returns the number of examples in the dataset. </summary>
+        ///
+        /// <returns> The number of examples. </returns>
+        size_t NumExamples() const { return _metadata.size(); }
+
+        /// <summary> Returns the maximal prefix length of any example in the dataset. </summary>
+        ///
+        /// <returns> The number of features. </returns>
+        size_t NumFeatures() const { return _numFeatures; }
+
+        /// <summary> Returns the total number of values stored in the arena. </summary>
+        ///
+        /// <returns> The number of stored values. </returns>
+        size_t NumStoredValues() const { return _values.size(); }
+
+        /// <summary> Reserves memory for examples. </summary>
+        ///
+        /// <param name="numExamples"> The total number of examples. </param>
+        /// <param name="numValues"> The total number of values. </param>
+        /// <param name="numSparseValues"> The number of those values that belong to examples stored as sparse rows. </param>
+        void Reserve(size_t numExamples, size_t numValues, size_t numSparseValues = 0);
+
+        /// <summary> Copies an example into the arena. </summary>
+        ///
+        /// <typeparam name="DataVectorType"> The data vector type. </typeparam>
+        /// <param name="dataVector"> The data vector of the example. </param>
+        /// <param name="metadata"> The metadata of the example. </param>
+        template <typename DataVectorType>
+        void AddExample(const DataVectorType& dataVector, const WeightLabel& metadata);
+
+        /// <summary> Copies an example into the arena. </summary>
+        ///
+        /// <typeparam name="ExampleType"> The example type. </typeparam>
+        /// <param name="example"> The example. </param>
+        template <typename ExampleType>
+        void AddExample(const ExampleType& example) { AddExample(example.GetDataVector(), example.GetMetadata()); }
+
+        /// <summary> Returns the metadata of an example. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The metadata. </returns>
+        const WeightLabel& GetMetadata(size_t index) const { return _metadata[index]; }
+
+        /// <summary> Returns the data vector of an example, which reads the arena directly. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The row. </returns>
+        Row GetRow(size_t index) const;
+
+        /// <summary> Returns an iterator over the nonzero entries of an example, which reads the arena directly. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The iterator. </returns>
+        RowIterator GetRowIterator(size_t index) const { return GetRow(index).GetIterator<IterationPolicy::skipZeros>(); }
+
+        /// <summary> Returns an example, copied out of the arena as the requested example type. </summary>
+        ///
+        /// <typeparam name="ExampleType"> The example type. </typeparam>
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The example. </returns>
+        template <typename ExampleType = AutoSupervisedExample>
+        ExampleType GetExample(size_t index) const;
+
+        /// <summary> Returns an iterator that traverses the examples. </summary>
+        ///
+        /// <typeparam name="IteratorExampleType"> Example type returned by the iterator. </typeparam>
+        /// <param name="fromIndex"> Zero-based index of the first example to iterate over. </param>
+        /// <param name="size"> The number of examples to iterate over, or zero to iterate to the end. </param>
+        ///
+        /// <returns> The example iterator. </returns>
+        template <typename IteratorExampleType = AutoSupervisedExample>
+        ExampleIterator<IteratorExampleType> GetExampleIterator(size_t fromIndex = 0, size_t size = 0) const;
+
+        /// <summary> Returns an AnyDataset that represents an interval of examples from this dataset. </summary>
+        ///
+        /// <param name="fromIndex"> Zero-based index of the first example in the AnyDataset. </param>
+        /// <param name="size"> The number of examples to include, or zero to include all remaining examples. </param>
+        ///
+        /// <returns> An AnyDataset. </returns>
+        AnyDataset GetAnyDataset(size_t fromIndex = 0, size_t size = 0) const { return AnyDataset(this, fromIndex, size); }
+
+        /// <summary> Prints this object. </summary>
+        ///
+        /// <param name="os"> [in,out] Stream to write data to. </param>
+        void Print(std::ostream& os) const;
+
+    private:
+        template <typename IteratorExampleType>
+        class ArenaExampleIterator : public IExampleIterator<IteratorExampleType>
+        {
+        public:
+            ArenaExampleIterator(const ArenaDataset& dataset, size_t fromIndex, size_t endIndex)
+                : _dataset(dataset), _current(fromIndex), _end(endIndex) {}
+
+            virtual bool IsValid() const override { return _current < _end; }
+
+            virtual void Next() override { ++_current; }
+
+            virtual IteratorExampleType Get() const override { return _dataset.GetExample<IteratorExampleType>(_current); }
+
+        private:
+            const ArenaDataset& _dataset;
+            size_t _current;
+            size_t _end;
+        };
+
+        template <typename IndexValueIteratorType>
+        void AddRow(IndexValueIteratorType countIterator, IndexValueIteratorType copyIterator, const WeightLabel& metadata);
+
+        std::vector<double> _values;
+        std::vector<uint32_t> _indices;
+        std::vector<size_t> _valueOffsets = { 0 };
+        std::vector<size_t> _indexOffsets = { 0 };
+        std::vector<WeightLabel> _metadata;
+        size_t _numFeatures = 0;
+    };
+}
+}
+
+#include "../tcc/ArenaDataset.tcc"
+
+// the rows of a BinaryDataset are ArenaDataset rows, so BinaryDataset can only be defined after ArenaDataset
+#include "BinaryDataset.h"
@@ -102,23 +102,36 @@ namespace data
         /// <returns> A dot product. </returns>
         virtual double Dot(const math::UnorientedConstVectorReference<double> vector) const override;
 
+        /// <summary> Computes the dot product with another single precision vector. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> A dot product. </returns>
+        virtual float Dot(const math::UnorientedConstVectorReference<float> vector) const override;
+
         /// <summary> Adds this data vector to a math::RowVector </summary>
         ///
         /// <param name="vector"> [in,out] The vector that this DataVector is added to. </param>
         virtual void AddTo(math::RowVectorReference<double> vector) const override;
 
+        /// <summary> Adds this data vector to a single precision math::RowVector </summary>
+        ///
+        /// <param name="vector"> [in,out] The vector that this DataVector is added to. </param>
+        virtual void AddTo(math::RowVectorReference<float> vector) const override;
+
         /// <summary>
         /// Adds a sparsely transformed version of this data vector to a math::RowVector.
         /// </summary>
         ///
         /// <typeparam name="policy"> The iteration policy. </typeparam>
+        /// <typeparam name="ElementType"> The element type of the vector. </typeparam>
         /// <typeparam name="TransformationType"> transformation type, which is a functor that takes a
         /// double and returns a double, and can be applied only to non-zeros . </typeparam>
         /// <param name="vector"> The vector. </param>
         /// <param name="transformation"> A functor that takes an IndexValue and returns a double, which is
         /// applied to each element before it is added to the vector. </param>
-        template <IterationPolicy policy, typename TransformationType>
-        void AddTransformedTo(math::RowVectorReference<double> vector, TransformationType transformation) const;
+        template <IterationPolicy policy, typename ElementType, typename TransformationType>
+        void AddTransformedTo(math::RowVectorReference<ElementType> vector, TransformationType transformation) const;
 
         /// <summary> Copies the contents of this DataVector into a double array of size PrefixLength(). </summary>
         ///
@@ -158,6 +171,16 @@ namespace data
         /// <param name="os"> [in,out] Stream to write to. </param>
         virtual void Print(std::ostream& os) const override;
 
+        /// <summary> Calls a generic (polymorphic) lambda with a pointer to the data vector that this AutoDataVector holds. </summary>
+        ///
+        /// <typeparam name="ReturnType"> The return type of the lambda. </typeparam>
+        /// <typeparam name="GenericLambdaType"> The lambda type. </typeparam>
+        /// <param name="lambda"> The lambda. </param>
+        ///
+        /// <returns> The value returned by the lambda. </returns>
+        template <typename ReturnType, typename GenericLambdaType>
+        ReturnType InvokeWithThis(GenericLambdaType lambda) const { return _pInternal->template InvokeWithThis<ReturnType>(lambda); }
+
     private:
         // helper function used by ctors to choose the type of data vector to use
         void FindBestRepresentation(DefaultDataVectorType defaultDataVector);
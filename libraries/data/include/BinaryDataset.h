@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BinaryDataset.h (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ArenaDataset.h"
+#include "Dataset.h"
+#include "Example.h"
+#include "ExampleIterator.h"
+#include "WeightLabel.h"
+
+// math
+#include "Vector.h"
+
+// utilities
+#include "MemoryMappedFile.h"
+
+// stl
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary>
+    /// A read-only dataset stored in the binary format described in doc/BinaryDatasetFormat.md.
+    /// The file is mapped into memory, so opening it requires no parsing, only one pass that
+    /// checks the row offsets and indices, and the data vectors are built directly from the
+    /// compressed sparse row (CSR) arrays in the file. GetRow reads an example in place, as a data
+    /// vector that refers to the mapping, and the dataset can be passed to every trainer that
+    /// accepts an AnyDataset. Copies of a BinaryDataset share the same mapping.
+    /// </summary>
+    class BinaryDataset : public DatasetBase
+    {
+    public:
+        /// <summary>
+        /// A read-only data vector that refers to the stored entries of one example, without copying
+        /// them. Each row of the file is a sparse row with the layout of a sparse ArenaDataset row,
+        /// so it is read through the same view. A row is only valid while a copy of the dataset it
+        /// came from exists.
+        /// </summary>
+        using Row = ArenaDataset::Row;
+
+        /// <summary> Opens a binary dataset file, and throws a DataFormatException if its arrays are inconsistent. </summary>
+        ///
+        /// <param name="filepath"> The path of the file. </param>
+        BinaryDataset(const std::string& filepath);
+
+        /// <summary> Returns the number of examples in the dataset. </summary>
+        ///
+        /// <returns> The number of examples. </returns>
+        size_t NumExamples() const { return _numExamples; }
+
+        /// <summary> Returns the number of columns, which is the largest prefix length of a data vector in the dataset. </summary>
+        ///
+        /// <returns> The number of columns. </returns>
+        size_t NumColumns() const { return _numColumns; }
+
+        /// <summary> Returns the total number of stored (nonzero) entries in all of the data vectors. </summary>
+        ///
+        /// <returns> The number of stored entries. </returns>
+        size_t NumNonzeros() const { return _numNonzeros; }
+
+        /// <summary> Returns true if the file also stores the data in a dense column-major block. </summary>
+        ///
+        /// <returns> true if the dataset has a dense block. </returns>
+        bool HasDenseBlock() const { return _denseBlock != nullptr; }
+
+        /// <summary> Returns the metadata of an example. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The metadata. </returns>
+        WeightLabel GetMetadata(size_t index) const { return WeightLabel{ _weights[index], _labels[index] }; }
+
+        /// <summary> Returns the data vector of an example, which reads the mapped file directly. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The row. </returns>
+        Row GetRow(size_t index) const;
+
+        /// <summary> Returns an example, copied out of the mapped file as the requested example type. </summary>
+        ///
+        /// <typeparam name="ExampleType"> The example type. </typeparam>
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The example. </returns>
+        template <typename ExampleType = AutoSupervisedExample>
+        ExampleType GetExample(size_t index) const;
+
+        /// <summary> Returns a column of the dense block, which holds the values of one feature in all of the examples. </summary>
+        ///
+        /// <param name="column"> Zero-based index of the column. </param>
+        ///
+        /// <returns> A reference to the column, which remains valid as long as a copy of this dataset exists. </returns>
+        math::ColumnConstVectorReference<double> GetDenseColumn(size_t column) const;
+
+        /// <summary> Returns an iterator that traverses the examples. The iterator holds a copy of the dataset. </summary>
+        ///
+        /// <typeparam name="IteratorExampleType"> Example type returned by the iterator. </typeparam>
+        /// <param name="fromIndex"> Zero-based index of the first example to iterate over. </param>
+        /// <param name="size"> The number of examples to iterate over, or zero to iterate to the end. </param>
+        ///
+        /// <returns> The example iterator. </returns>
+        template <typename IteratorExampleType = AutoSupervisedExample>
+        ExampleIterator<IteratorExampleType> GetExampleIterator(size_t fromIndex = 0, size_t size = 0) const;
+
+        /// <summary> Returns an AnyDataset that represents an interval of examples from this dataset. </summary>
+        ///
+        /// <param name="fromIndex"> Zero-based index of the first example in the AnyDataset. </param>
+        /// <param name="size"> The number of examples to include, or zero to include all remaining examples. </param>
+        ///
+        /// <returns> An AnyDataset. </returns>
+        AnyDataset GetAnyDataset(size_t fromIndex = 0, size_t size = 0) const { return AnyDataset(this, fromIndex, size); }
+
+    private:
+        // the iterator holds a copy of the dataset, so that it can outlive the dataset it came from
+        template <typename IteratorExampleType>
+        class BinaryDatasetExampleIterator;
+
+        std::shared_ptr<const utilities::MemoryMappedFile> _file;
+
+        size_t _numExamples = 0;
+        size_t _numNonzeros = 0;
+        size_t _numColumns = 0;
+
+        const uint64_t* _rowOffsets = nullptr;
+        const double* _labels = nullptr;
+        const double* _weights = nullptr;
+        const double* _values = nullptr;
+        const uint32_t* _indices = nullptr;
+        const double* _denseBlock = nullptr;
+    };
+
+    /// <summary> Writes examples to a stream in the binary dataset format. </summary>
+    ///
+    /// <param name="stream"> The output stream, which should be opened in binary mode. </param>
+    /// <param name="exampleIterator"> An iterator over the examples to write. </param>
+    /// <param name="includeDenseBlock"> If true, the file also stores the data in a dense column-major block. </param>
+    void WriteBinaryDataset(std::ostream& stream, AutoSupervisedExampleIterator exampleIterator, bool includeDenseBlock = false);
+
+    /// <summary> Checks whether a file starts with the binary dataset header. </summary>
+    ///
+    /// <param name="filepath"> The path of the file. </param>
+    ///
+    /// <returns> true if the file is a binary dataset. </returns>
+    bool IsBinaryDatasetFile(const std::string& filepath);
+}
+}
+
+#include "../tcc/BinaryDataset.tcc"
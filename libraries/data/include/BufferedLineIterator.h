@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BufferedLineIterator.h (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TextLine.h"
+
+// stl
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <string>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary>
+    /// An iterator that reads a long text line by line, like SequentialLineIterator, but reads the
+    /// stream in large blocks and returns TextLines that view the lines inside the current block.
+    /// Reading a line therefore does not allocate or copy it. Each block is kept alive by the
+    /// TextLines that point into it.
+    /// </summary>
+    class BufferedLineIterator
+    {
+    public:
+        /// <summary> Constructs a buffered line iterator. </summary>
+        ///
+        /// <param name="stream"> The input stream. </param>
+        /// <param name="blockSize"> The number of bytes to read from the stream at a time. </param>
+        /// <param name="delim"> The delimiter. </param>
+        BufferedLineIterator(std::istream& stream, size_t blockSize = 1 << 20, char delim = '\n');
+
+        BufferedLineIterator(BufferedLineIterator&&) = default;
+
+        BufferedLineIterator(const BufferedLineIterator&) = delete;
+
+        /// <summary> Returns true if the iterator is currently pointing to a valid iterate. </summary>
+        ///
+        /// <returns> true if it succeeds, false if it fails. </returns>
+        bool IsValid() const { return _isValid; }
+
+        /// <summary> Proceeds to the next row. </summary>
+        void Next();
+
+        /// <summary> Returns a TextLine that contains the current line. </summary>
+        ///
+        /// <returns> A TextLine </returns>
+        TextLine GetTextLine() const { return _currentLine; }
+
+    private:
+        void ReadBlock();
+
+        std::istream& _stream;
+        size_t _blockSize;
+        char _delim;
+
+        std::shared_ptr<const std::string> _block;
+        size_t _position = 0;
+        std::string _partialLine;
+
+        bool _isValid = true;
+        TextLine _currentLine;
+    };
+}
+}
@@ -43,7 +43,9 @@ namespace data
             SparseShortDataVector,
             SparseByteDataVector,
             SparseBinaryDataVector,
-            AutoDataVector
+            AutoDataVector,
+            ArenaDatasetRow,
+            QuantizedDatasetRow
         };
 
         virtual ~IDataVector() = default;
@@ -80,20 +82,33 @@ namespace data
         /// <returns> A dot product. </returns>
         virtual double Dot(const math::UnorientedConstVectorReference<double> vector) const = 0;
 
+        /// <summary> Computes the dot product with another vector of single precision floats. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> A dot product. </returns>
+        virtual float Dot(const math::UnorientedConstVectorReference<float> vector) const = 0;
+
         /// <summary> Adds this data vector to a math::RowVector </summary>
         ///
         /// <param name="vector"> [in,out] The vector to which this data vector is added. </param>
         virtual void AddTo(math::RowVectorReference<double> vector) const = 0;
 
+        /// <summary> Adds this data vector to a math::RowVector of single precision floats. </summary>
+        ///
+        /// <param name="vector"> [in,out] The vector to which this data vector is added. </param>
+        virtual void AddTo(math::RowVectorReference<float> vector) const = 0;
+
         /// <summary> Adds a transformed version of this data vector to a math::RowVector. </summary>
         ///
         /// <typeparam name="policy"> The iteration policy. </typeparam>
+        /// <typeparam name="ElementType"> The element type of the vector. </typeparam>
         /// <typeparam name="TransformationType"> Non zero transformation type, which is a functor that
         /// takes an IndexValue and returns a double, and is applied to each element of the vector. </typeparam>
         /// <param name="vector"> The vector. </param>
         /// <param name="transformation"> The transformation.. </param>
-        template <IterationPolicy policy, typename TransformationType>
-        void AddTransformedTo(math::RowVectorReference<double> vector, TransformationType transformation) const;
+        template <IterationPolicy policy, typename ElementType, typename TransformationType>
+        void AddTransformedTo(math::RowVectorReference<ElementType> vector, TransformationType transformation) const;
 
         /// <summary> Copies the contents of this DataVector into a double array of size PrefixLength(). </summary>
         ///
@@ -145,9 +160,17 @@ namespace data
         /// <param name="os"> [in,out] Stream to write to. </param>
         virtual void Print(std::ostream& os) const = 0;
 
-    private:
-        // calls a generic (polymorphic) lambda of the form `[](const auto* pThis){ return ReturnType();}`, where pThis is a pointer to the concrete
-        // DataVector implementation (e.g., DenseDataVector, SparseDataVector,...)
+        /// <summary>
+        /// Calls a generic (polymorphic) lambda of the form `[](const auto* pThis){ return ReturnType();}`, where pThis is a
+        /// pointer to the concrete DataVector implementation (e.g., DenseDataVector, SparseDataVector,...). This gives access
+        /// to the index-value iterators of the concrete type, without copying the data vector.
+        /// </summary>
+        ///
+        /// <typeparam name="ReturnType"> The return type of the lambda. </typeparam>
+        /// <typeparam name="GenericLambdaType"> The lambda type. </typeparam>
+        /// <param name="lambda"> The lambda. </param>
+        ///
+        /// <returns> The value returned by the lambda. </returns>
         template <typename ReturnType, typename GenericLambdaType>
         ReturnType InvokeWithThis(GenericLambdaType lambda) const;
     };
@@ -162,6 +185,12 @@ namespace data
     /// <param name="scaledDataVector"> The DataVector being added to the vector. </param>
     void operator+=(math::RowVectorReference<double> vector, const IDataVector& dataVector);
 
+    /// <summary> Adds a DataVector to a math::RowVector of single precision floats. </summary>
+    ///
+    /// <param name="vector"> The math::RowVector being modified. </param>
+    /// <param name="scaledDataVector"> The DataVector being added to the vector. </param>
+    void operator+=(math::RowVectorReference<float> vector, const IDataVector& dataVector);
+
     /// <summary>
     /// Base class for some of the data vector classes. This class uses a curiously recurring
     /// template pattern to significantly reduce code duplication in the derived classes.
@@ -211,20 +240,33 @@ namespace data
         /// <returns> A dot product. </returns>
         virtual double Dot(const math::UnorientedConstVectorReference<double> vector) const override;
 
+        /// <summary> Computes the dot product with another vector of single precision floats. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> A dot product. </returns>
+        virtual float Dot(const math::UnorientedConstVectorReference<float> vector) const override;
+
         /// <summary> Adds this data vector to a math::RowVector </summary>
         ///
         /// <param name="vector"> [in,out] The vector to which this data vector is added. </param>
         virtual void AddTo(math::RowVectorReference<double> vector) const override;
 
+        /// <summary> Adds this data vector to a math::RowVector of single precision floats. </summary>
+        ///
+        /// <param name="vector"> [in,out] The vector to which this data vector is added. </param>
+        virtual void AddTo(math::RowVectorReference<float> vector) const override;
+
         /// <summary> Adds a transformed version of this data vector to a math::RowVector. </summary>
         ///
         /// <typeparam name="policy"> The iteration policy. </typeparam>
+        /// <typeparam name="ElementType"> The element type of the vector. </typeparam>
         /// <typeparam name="TransformationType"> Non zero transformation type, which is a functor that
         /// takes an IndexValue and returns a double, and is applied to each element of the vector. </typeparam>
         /// <param name="vector"> The vector. </param>
         /// <param name="transformation"> The transformation.. </param>
-        template <IterationPolicy policy, typename TransformationType>
-        void AddTransformedTo(math::RowVectorReference<double> vector, TransformationType transformation) const;
+        template <IterationPolicy policy, typename ElementType, typename TransformationType>
+        void AddTransformedTo(math::RowVectorReference<ElementType> vector, TransformationType transformation) const;
 
         /// <summary> Returns a (dense) iterator of the vector elements, excluding the final suffix of zeros. </summary>
         ///
@@ -280,19 +322,27 @@ namespace data
         ///
         /// <param name="os"> [in,out] Stream to write to. </param>
         virtual void Print(std::ostream& os) const override;
+
+    private:
+        template <typename ElementType>
+        double DotImplementation(const math::UnorientedConstVectorReference<ElementType> vector) const;
+
+        template <typename ElementType>
+        void AddToImplementation(math::RowVectorReference<ElementType> vector) const;
     };
 
     /// <summary> Wrapper for AddTransformedTo that hides the template specifier. </summary>
     ///
     /// <typeparam name="DataVectorType"> The data vector type to call AddTransformedTo on </typeparam>
     /// <typeparam name="policy"> The iteration policy. </typeparam>
+    /// <typeparam name="ElementType"> The element type of the vector. </typeparam>
     /// <typeparam name="TransformationType"> Non zero transformation type, which is a functor that
     /// takes an IndexValue and returns a double, and is applied to each element of the vector. </typeparam>
     /// <param name="vector"> The data vector that we're calling AddTransformedTo. </param>
     /// <param name="vector"> The vector. </param>
     /// <param name="transformation"> The transformation.. </param>
-    template <typename DataVectorType, IterationPolicy policy, typename TransformationType>
-    static void AddTransformedTo(const DataVectorType& dataVector, math::RowVectorReference<double> vector, TransformationType transformation);
+    template <typename DataVectorType, IterationPolicy policy, typename ElementType, typename TransformationType>
+    static void AddTransformedTo(const DataVectorType& dataVector, math::RowVectorReference<ElementType> vector, TransformationType transformation);
 
     /// <summary> Wrapper for GetIterator that hides the template specifier. </summary>
     ///
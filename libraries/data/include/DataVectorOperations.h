@@ -50,6 +50,22 @@ namespace data
     /// <returns> The result of the dot product. </returns>
     double operator*(const IDataVector& dataVector, math::UnorientedConstVectorReference<double> vector);
 
+    /// <summary> Multiplication operator (dot product) for single precision vector and data vector. </summary>
+    ///
+    /// <param name="vector"> The vector. </param>
+    /// <param name="dataVector"> The data vector. </param>
+    ///
+    /// <returns> The result of the dot product. </returns>
+    float operator*(math::UnorientedConstVectorReference<float> vector, const IDataVector& dataVector);
+
+    /// <summary> Multiplication operator (dot product) for single precision vector and data vector. </summary>
+    ///
+    /// <param name="dataVector"> The data vector. </param>
+    /// <param name="vector"> The vector. </param>
+    ///
+    /// <returns> The result of the dot product. </returns>
+    float operator*(const IDataVector& dataVector, math::UnorientedConstVectorReference<float> vector);
+
     /// <summary> Elementwise square operation for data vectors. </summary>
     ///
     /// <typeparam name="DataVectorType"> Data vector type. </typeparam>
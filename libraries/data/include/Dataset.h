@@ -18,6 +18,7 @@
 #include "TypeTraits.h"
 
 // stl
+#include <cstdint>
 #include <functional>
 #include <ostream>
 #include <random>
@@ -31,6 +32,14 @@ namespace data
     template <typename ExampleType>
     class Dataset;
 
+    // forward declarations of ArenaDataset, BinaryDataset and QuantizedDataset, which AnyDataset can also refer to
+    class ArenaDataset;
+
+    class BinaryDataset;
+
+    template <typename QuantizedType>
+    class QuantizedDataset;
+
     /// <summary> Polymorphic interface for datasets, enables dynamic_cast operations. </summary>
     struct DatasetBase
     {
@@ -61,6 +70,19 @@ namespace data
         /// <returns> Number of examples. </returns>
         size_t NumExamples() const { return _size; }
 
+        /// <summary> Returns the dataset that this AnyDataset refers to, if it has a given type. </summary>
+        ///
+        /// <typeparam name="DatasetType"> The dataset type. </typeparam>
+        ///
+        /// <returns> Pointer to the dataset, or nullptr if it has a different type. </returns>
+        template <typename DatasetType>
+        const DatasetType* GetDataset() const { return dynamic_cast<const DatasetType*>(_pDataset); }
+
+        /// <summary> Returns the index of the first example of the dataset that this AnyDataset refers to. </summary>
+        ///
+        /// <returns> Zero-based index of the first example. </returns>
+        size_t GetFromIndex() const { return _fromIndex; }
+
     private:
         const DatasetBase* _pDataset;
         size_t _fromIndex;
@@ -281,3 +303,8 @@ namespace data
 }
 
 #include "../tcc/Dataset.tcc"
+
+// AnyDataset::GetExampleIterator needs the complete ArenaDataset, BinaryDataset and QuantizedDataset types;
+// ArenaDataset.h includes BinaryDataset.h
+#include "ArenaDataset.h"
+#include "QuantizedDataset.h"
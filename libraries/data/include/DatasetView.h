@@ -0,0 +1,225 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     DatasetView.h (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Dataset.h"
+#include "Example.h"
+#include "WeightLabel.h"
+
+// stl
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <vector>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary>
+    /// A typed view of an AnyDataset, used by trainers and evaluators that need their own metadata
+    /// for each example. Data vectors are shared with the underlying dataset whenever the requested
+    /// data vector type matches the stored one (and converted once otherwise), while the
+    /// view-specific metadata is kept in an array that runs parallel to the data vectors.
+    /// </summary>
+    ///
+    /// <typeparam name="DataVectorT"> The data vector type. </typeparam>
+    /// <typeparam name="MetadataT"> The metadata type, which must be constructible from a WeightLabel. </typeparam>
+    template <typename DataVectorT, typename MetadataT>
+    class DatasetView
+    {
+    public:
+        using DataVectorType = DataVectorT;
+        using MetadataType = MetadataT;
+
+        /// <summary> A lightweight read-only reference to a single example in the view. </summary>
+        class ExampleReference
+        {
+        public:
+            /// <summary> Constructs an instance of ExampleReference. </summary>
+            ///
+            /// <param name="dataVector"> The data vector. </param>
+            /// <param name="metadata"> The metadata. </param>
+            ExampleReference(const DataVectorType& dataVector, const MetadataType& metadata);
+
+            /// <summary> Gets the data vector. </summary>
+            ///
+            /// <returns> The data vector. </returns>
+            const DataVectorType& GetDataVector() const { return *_dataVector; }
+
+            /// <summary> Gets the metadata. </summary>
+            ///
+            /// <returns> The metadata. </returns>
+            const MetadataType& GetMetadata() const { return *_metadata; }
+
+            /// <summary> Prints the example to an output stream. </summary>
+            ///
+            /// <param name="os"> [in,out] Stream to write data to. </param>
+            void Print(std::ostream& os) const;
+
+        private:
+            const DataVectorType* _dataVector;
+            const MetadataType* _metadata;
+        };
+
+        /// <summary> Iterator over a range of examples in the view, which returns ExampleReferences. </summary>
+        class Iterator
+        {
+        public:
+            /// <summary> Constructs an instance of Iterator. </summary>
+            ///
+            /// <param name="view"> The dataset view. </param>
+            /// <param name="fromIndex"> Zero-based index of the first example to iterate over. </param>
+            /// <param name="size"> The number of examples to iterate over. </param>
+            Iterator(const DatasetView& view, size_t fromIndex, size_t size);
+
+            /// <summary> Returns true if the iterator is currently pointing to a valid iterate. </summary>
+            ///
+            /// <returns> true if the iterator is currently pointing to a valid iterate. </returns>
+            bool IsValid() const { return _current < _end; }
+
+            /// <summary> Proceeds to the Next iterate. </summary>
+            void Next() { ++_current; }
+
+            /// <summary> Returns a reference to the current example. </summary>
+            ///
+            /// <returns> An ExampleReference. </returns>
+            ExampleReference Get() const { return _view[_current]; }
+
+        private:
+            const DatasetView& _view;
+            size_t _current;
+            size_t _end;
+        };
+
+        DatasetView() = default;
+
+        DatasetView(DatasetView&&) = default;
+
+        DatasetView(const DatasetView&) = delete;
+
+        /// <summary> Constructs a view of an AnyDataset. </summary>
+        ///
+        /// <param name="anyDataset"> The AnyDataset. </param>
+        DatasetView(const AnyDataset& anyDataset);
+
+        DatasetView& operator=(DatasetView&&) = default;
+
+        DatasetView& operator=(const DatasetView&) = delete;
+
+        /// <summary> Returns the number of examples in the view. </summary>
+        ///
+        /// <returns> The number of examples. </returns>
+        size_t NumExamples() const { return _dataVectors.size(); }
+
+        /// <summary> Returns the maximal size of any example. </summary>
+        ///
+        /// <returns> The maximal size of any example. </returns>
+        size_t NumFeatures() const { return _numFeatures; }
+
+        /// <summary> Returns the data vector of an example. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> Const reference to the data vector. </returns>
+        const DataVectorType& GetDataVector(size_t index) const { return *_dataVectors[index]; }
+
+        /// <summary> Returns the metadata of an example. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> Reference to the metadata. </returns>
+        MetadataType& GetMetadata(size_t index) { return _metadata[index]; }
+
+        /// <summary> Returns the metadata of an example. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> Const reference to the metadata. </returns>
+        const MetadataType& GetMetadata(size_t index) const { return _metadata[index]; }
+
+        /// <summary> Returns a reference to an example. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> An ExampleReference. </returns>
+        ExampleReference operator[](size_t index) const;
+
+        /// <summary> Returns an iterator that traverses the examples. </summary>
+        ///
+        /// <param name="fromIndex"> Zero-based index of the first example to iterate over. </param>
+        /// <param name="size"> The number of examples to iterate over, a value of zero means all
+        /// the way to the end. </param>
+        ///
+        /// <returns> The iterator. </returns>
+        Iterator GetExampleIterator(size_t fromIndex = 0, size_t size = 0) const;
+
+        /// <summary> Permutes the examples so that a prefix of them is uniformly distributed. </summary>
+        ///
+        /// <param name="rng"> [in,out] The random number generator. </param>
+        /// <param name="prefixSize"> Size of the prefix that should be uniformly distributed, zero to permute the entire view. </param>
+        void RandomPermute(std::default_random_engine& rng, size_t prefixSize = 0);
+
+        /// <summary> Randomly permutes a range of examples so that a prefix of them is uniformly distributed. </summary>
+        ///
+        /// <param name="rng"> [in,out] The random number generator. </param>
+        /// <param name="rangeFirstIndex"> Zero-based index of the first example in the range. </param>
+        /// <param name="rangeSize"> Size of the range. </param>
+        /// <param name="prefixSize"> Size of the prefix that should be uniformly distributed, zero to permute the entire range. </param>
+        void RandomPermute(std::default_random_engine& rng, size_t rangeFirstIndex, size_t rangeSize, size_t prefixSize = 0);
+
+        /// <summary> Choses an example uniformly from a given range and swaps it with a given example (which can either be inside or outside of the range). </summary>
+        ///
+        /// <param name="rng"> [in,out] The random number generator. </param>
+        /// <param name="targetExampleIndex"> Zero-based index of the target example. </param>
+        /// <param name="rangeFirstIndex"> Index of the first example in the range from which the example is chosen. </param>
+        /// <param name="rangeSize"> Number of examples in the range from which the example is chosen. </param>
+        void RandomSwap(std::default_random_engine& rng, size_t targetExampleIndex, size_t rangeFirstIndex, size_t rangeSize);
+
+        /// <summary> Sorts an interval of examples by a certain key. </summary>
+        ///
+        /// <typeparam name="SortKeyType"> Type of the sort key. </typeparam>
+        /// <param name="sortKey"> A function that takes an ExampleReference and returns a sort key. </param>
+        /// <param name="fromIndex"> Zero-based index of the first example to sort. </param>
+        /// <param name="size"> The number of examples to sort. </param>
+        template <typename SortKeyType>
+        void Sort(SortKeyType sortKey, size_t fromIndex = 0, size_t size = 0);
+
+        /// <summary> Partitions an iterval of examples by a certain Boolean predicate (similar to sorting
+        /// by the predicate, but in linear time). </summary>
+        ///
+        /// <typeparam name="PartitionKeyType"> Type of predicate. </typeparam>
+        /// <param name="partitionKey"> A function that takes an ExampleReference and returns a bool. </param>
+        /// <param name="fromIndex"> Zero-based index of the first example of the interval. </param>
+        /// <param name="size"> The number of examples in the interval. </param>
+        template <typename PartitionKeyType>
+        void Partition(PartitionKeyType partitionKey, size_t fromIndex = 0, size_t size = 0);
+
+        /// <summary> Prints this object. </summary>
+        ///
+        /// <param name="os"> [in,out] Stream to write data to. </param>
+        /// <param name="tabs"> The number of tabs. </param>
+        /// <param name="fromIndex"> Zero-based index of the first example to print. </param>
+        /// <param name="size"> The number of examples to print, or 0 to print until the end. </param>
+        void Print(std::ostream& os, size_t tabs = 0, size_t fromIndex = 0, size_t size = 0) const;
+
+    private:
+        size_t CorrectRangeSize(size_t fromIndex, size_t size) const;
+        void SwapExamples(size_t index1, size_t index2);
+        void ApplyPermutation(const std::vector<size_t>& permutation, size_t fromIndex);
+
+        std::vector<std::shared_ptr<const DataVectorType>> _dataVectors;
+        std::vector<MetadataType> _metadata;
+        size_t _numFeatures = 0;
+    };
+}
+}
+
+#include "../tcc/DatasetView.tcc"
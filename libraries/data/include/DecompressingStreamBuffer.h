@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     DecompressingStreamBuffer.h (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// utilities
+#include "BackgroundProducer.h"
+
+// stl
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary> The compression formats of data files. </summary>
+    enum class CompressionFormat
+    {
+        none,
+        gzip,
+        zstd
+    };
+
+    /// <summary> Detects the compression format of a file from the magic number at its beginning. </summary>
+    ///
+    /// <param name="filename"> The file name. </param>
+    ///
+    /// <returns> The compression format, or CompressionFormat::none if the file is not compressed or cannot be read. </returns>
+    CompressionFormat GetCompressionFormat(const std::string& filename);
+
+    /// <summary> Checks if this build of ELL can decompress a compression format. </summary>
+    ///
+    /// <param name="format"> The compression format. </param>
+    ///
+    /// <returns> true if files in the given format can be read. </returns>
+    bool IsCompressionFormatSupported(CompressionFormat format);
+
+    /// <summary> Parameters for the DecompressingStreamBuffer. </summary>
+    struct DecompressionParameters
+    {
+        /// <summary> The number of decompressed bytes in a block. </summary>
+        size_t blockSize = 1 << 20;
+
+        /// <summary> The maximal number of decompressed blocks that wait in the queue for the reader. </summary>
+        size_t maxQueuedBlocks = 4;
+    };
+
+    class Decompressor;
+
+    /// <summary>
+    /// A read-only stream buffer over a gzip or zstd compressed file. A background thread reads and
+    /// decompresses the file one block at a time and puts the blocks in a bounded queue, so that the
+    /// file is decompressed on one core while the stream is parsed on another. A decompression error
+    /// is rethrown by the stream buffer once the reader reaches the data that could not be
+    /// decompressed.
+    /// </summary>
+    class DecompressingStreamBuffer : public std::streambuf
+    {
+    public:
+        /// <summary> Opens a compressed file and starts decompressing it. </summary>
+        ///
+        /// <param name="filename"> The name of a gzip or zstd compressed file. </param>
+        /// <param name="parameters"> The decompression parameters. </param>
+        DecompressingStreamBuffer(const std::string& filename, const DecompressionParameters& parameters = DecompressionParameters());
+
+        DecompressingStreamBuffer(const DecompressingStreamBuffer&) = delete;
+
+        DecompressingStreamBuffer& operator=(const DecompressingStreamBuffer&) = delete;
+
+        /// <summary> Stops the background thread and closes the file. </summary>
+        virtual ~DecompressingStreamBuffer();
+
+    protected:
+        virtual int_type underflow() override;
+
+    private:
+        bool DecompressBlock(std::vector<char>& block);
+
+        std::unique_ptr<Decompressor> _decompressor;
+        size_t _blockSize;
+
+        std::vector<char> _currentBlock;
+
+        // declared last, so that the background thread stops before the file is closed
+        utilities::BackgroundProducer<std::vector<char>> _producer;
+    };
+
+    /// <summary> An input stream that reads a compressed file through a DecompressingStreamBuffer. </summary>
+    class DecompressingIfstream : public std::istream
+    {
+    public:
+        /// <summary> Opens a compressed file. A decompression error is thrown from the read operation that reaches it. </summary>
+        ///
+        /// <param name="filename"> The name of a gzip or zstd compressed file. </param>
+        /// <param name="parameters"> The decompression parameters. </param>
+        DecompressingIfstream(const std::string& filename, const DecompressionParameters& parameters = DecompressionParameters());
+
+    private:
+        DecompressingStreamBuffer _streamBuffer;
+    };
+}
+}
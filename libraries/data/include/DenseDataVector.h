@@ -114,7 +114,40 @@ namespace data
         /// <returns> The first index of the suffix of zeros at the end of this vector. </returns>
         virtual size_t PrefixLength() const override { return _data.size(); }
 
+        /// <summary> Computes the Dot product. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> A double. </returns>
+        virtual double Dot(const math::UnorientedConstVectorReference<double> vector) const override;
+
+        /// <summary> Computes the Dot product with a single precision vector. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> A float. </returns>
+        virtual float Dot(const math::UnorientedConstVectorReference<float> vector) const override;
+
+        /// <summary> Adds this data vector to a math::RowVector </summary>
+        ///
+        /// <param name="vector"> [in,out] The vector that this DataVector is added to. </param>
+        virtual void AddTo(math::RowVectorReference<double> vector) const override;
+
+        /// <summary> Adds this data vector to a single precision math::RowVector </summary>
+        ///
+        /// <param name="vector"> [in,out] The vector that this DataVector is added to. </param>
+        virtual void AddTo(math::RowVectorReference<float> vector) const override;
+
     private:
+        // these kernels run over the stored elements contiguously, so that the compiler can widen and
+        // multiply several elements per instruction; the dot product is accumulated in double, as in
+        // the other data vectors, and the AddTo kernel converts the elements to the precision of the vector
+        template <typename VectorElementType>
+        double DotImplementation(const math::UnorientedConstVectorReference<VectorElementType> vector) const;
+
+        template <typename VectorElementType>
+        void AddToImplementation(math::RowVectorReference<VectorElementType> vector) const;
+
         using DataVectorBase<DenseDataVector<ElementType>>::AppendElements;
         size_t _numNonzeros = 0;
         std::vector<ElementType> _data;
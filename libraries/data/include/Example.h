@@ -71,6 +71,11 @@ namespace data
         /// <returns> The data vector. </returns>
         const DataVectorType& GetDataVector() const { return *_dataVector.get(); }
 
+        /// <summary> Gets the shared pointer that holds the data vector, which allows other objects to share the data vector without copying it. </summary>
+        ///
+        /// <returns> The shared pointer to the data vector. </returns>
+        const std::shared_ptr<const DataVectorType>& GetSharedDataVector() const { return _dataVector; }
+
         /// <summary> Gets the metadata. </summary>
         ///
         /// <returns> The metadata. </returns>
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FeatureHasher.h (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AutoDataVector.h"
+#include "IndexValue.h"
+#include "TextLine.h"
+
+// stl
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary>
+    /// Implements the hashing trick: maps feature indices into a fixed number of buckets (a power
+    /// of two) and multiplies each value by a pseudo-random sign, so that collisions cancel out in
+    /// expectation. The mapping is a deterministic function of the feature index, so the same
+    /// hasher can be used when loading training data and when constructing a model for inference.
+    /// </summary>
+    class FeatureHasher
+    {
+    public:
+        FeatureHasher() = default;
+
+        /// <summary> Constructs an instance of FeatureHasher. </summary>
+        ///
+        /// <param name="numBits"> The base 2 logarithm of the number of buckets. </param>
+        FeatureHasher(size_t numBits);
+
+        /// <summary> Gets the base 2 logarithm of the number of buckets. </summary>
+        ///
+        /// <returns> The number of bits. </returns>
+        size_t NumBits() const { return _numBits; }
+
+        /// <summary> Gets the number of buckets. </summary>
+        ///
+        /// <returns> The number of buckets. </returns>
+        size_t NumBuckets() const { return _mask + 1; }
+
+        /// <summary> Gets the bucket that a feature index is mapped to. </summary>
+        ///
+        /// <param name="index"> The feature index. </param>
+        ///
+        /// <returns> The bucket index. </returns>
+        size_t GetBucket(size_t index) const { return static_cast<size_t>(Mix(index) & _mask); }
+
+        /// <summary> Gets the sign that multiplies the value of a feature. </summary>
+        ///
+        /// <param name="index"> The feature index. </param>
+        ///
+        /// <returns> Either 1.0 or -1.0. </returns>
+        double GetSign(size_t index) const { return (Mix(index) >> 63) ? -1.0 : 1.0; }
+
+        /// <summary> Hashes the entries of an index-value iterator. </summary>
+        ///
+        /// <typeparam name="IndexValueIteratorType"> The index-value iterator type. </typeparam>
+        /// <param name="indexValueIterator"> The index-value iterator. </param>
+        ///
+        /// <returns> The hashed entries, sorted by bucket index, with colliding entries summed. </returns>
+        template <typename IndexValueIteratorType, IsIndexValueIterator<IndexValueIteratorType> Concept = true>
+        std::vector<IndexValue> Hash(IndexValueIteratorType indexValueIterator) const;
+
+    private:
+        static uint64_t Mix(uint64_t key);
+
+        size_t _numBits = 0;
+        uint64_t _mask = 0;
+    };
+
+    /// <summary> A helper class that constructs AutoDataVectors from hashed IndexValues, using a provided IndexValue iterator. </summary>
+    ///
+    /// <typeparam name="IndexValueParsingIterator"> Parsing iterator type. </typeparam>
+    template <typename IndexValueParsingIterator>
+    class HashingAutoDataVectorParser
+    {
+    public:
+        /// <summary> Constructs an instance of HashingAutoDataVectorParser. </summary>
+        ///
+        /// <param name="hasher"> The feature hasher. </param>
+        HashingAutoDataVectorParser(FeatureHasher hasher);
+
+        /// <summary> Parses a given text line, hashes its entries, and constructs an AutoDataVector. </summary>
+        ///
+        /// <param name="textLine"> The text line. </param>
+        ///
+        /// <returns> An AutoDataVector. </returns>
+        AutoDataVector Parse(TextLine& textLine) const;
+
+    private:
+        FeatureHasher _hasher;
+    };
+}
+}
+
+#include "../tcc/FeatureHasher.tcc"
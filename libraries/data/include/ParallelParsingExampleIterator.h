@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ParallelParsingExampleIterator.h (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AutoDataVector.h"
+#include "Example.h"
+#include "ExampleIterator.h"
+
+// stl
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary> Parameters for the ParallelParsingExampleIterator. </summary>
+    struct ParallelParsingParameters
+    {
+        /// <summary> The approximate number of bytes in each chunk. Chunks are extended to the end of the line. </summary>
+        size_t chunkSize = 1 << 22;
+
+        /// <summary> The number of worker threads, or zero to use one per hardware thread. </summary>
+        size_t numThreads = 0;
+
+        /// <summary> If true, examples are emitted in the order they appear in the stream; otherwise, chunks are emitted as soon as they are parsed. </summary>
+        bool preserveOrder = true;
+    };
+
+    /// <summary>
+    /// An Example iterator that reads a stream in newline-aligned chunks and parses the chunks on
+    /// worker threads. Each line is parsed like in SingleLineParsingExampleIterator: the metadata
+    /// parser is applied first and the datavector parser is applied second. At most two chunks per
+    /// worker thread are held in memory at any time. The parsers are copied into each worker, so
+    /// their Parse functions must not modify shared state.
+    /// </summary>
+    ///
+    /// <typeparam name="MetadataParserType"> Metadata parser type. </typeparam>
+    /// <typeparam name="DataVectorParserType"> DataVector parser type. </typeparam>
+    template <typename MetadataParserType, typename DataVectorParserType>
+    class ParallelParsingExampleIterator : public IExampleIterator<AutoSupervisedExample>
+    {
+    public:
+        /// <summary> Constructs a ParallelParsingExampleIterator. </summary>
+        ///
+        /// <param name="stream"> The input stream, which must outlive the iterator. </param>
+        /// <param name="metadataParser"> The metadata parser. </param>
+        /// <param name="dataVectorParser"> The data vector parser. </param>
+        /// <param name="parameters"> The chunking and threading parameters. </param>
+        ParallelParsingExampleIterator(std::istream& stream, MetadataParserType metadataParser, DataVectorParserType dataVectorParser, const ParallelParsingParameters& parameters);
+
+        /// <summary> Returns true if the iterator is currently pointing to a valid iterate. </summary>
+        ///
+        /// <returns> true if the iterator is valid, false otherwise. </returns>
+        virtual bool IsValid() const override { return _currentIndex < _currentBlock.size(); }
+
+        /// <summary> Proceeds to the next example. </summary>
+        virtual void Next() override;
+
+        /// <summary> Gets the current example. </summary>
+        ///
+        /// <returns> A SupervisedExample. </returns>
+        virtual AutoSupervisedExample Get() const override { return _currentBlock[_currentIndex]; }
+
+    private:
+        using ExampleBlock = std::vector<AutoSupervisedExample>;
+
+        static ExampleBlock ParseChunk(std::string chunk, MetadataParserType metadataParser, DataVectorParserType dataVectorParser);
+        std::string ReadChunk();
+        void LaunchTasks();
+        void ReadBlock();
+
+        std::istream& _stream;
+        MetadataParserType _metadataParser;
+        DataVectorParserType _dataVectorParser;
+        size_t _chunkSize;
+        size_t _maxTasks;
+        bool _preserveOrder;
+
+        std::deque<std::future<ExampleBlock>> _futures;
+        ExampleBlock _currentBlock;
+        size_t _currentIndex = 0;
+    };
+
+    /// <summary>
+    /// Helper function that creates a ParallelParsingExampleIterator from a stream, a metadata
+    /// parser, and a datavector parser.
+    /// </summary>
+    ///
+    /// <typeparam name="MetadataParserType"> Metadata parser type. </typeparam>
+    /// <typeparam name="DataVectorParserType"> Data vector parser type. </typeparam>
+    /// <param name="stream"> The input stream, which must outlive the iterator. </param>
+    /// <param name="metadataParser"> The metadata parser. </param>
+    /// <param name="dataVectorParser"> The data vector parser. </param>
+    /// <param name="parameters"> The chunking and threading parameters. </param>
+    ///
+    /// <returns> The parallel parsing example iterator. </returns>
+    template <typename MetadataParserType, typename DataVectorParserType>
+    ExampleIterator<AutoSupervisedExample> MakeParallelParsingExampleIterator(std::istream& stream, MetadataParserType metadataParser, DataVectorParserType dataVectorParser, const ParallelParsingParameters& parameters = ParallelParsingParameters());
+}
+}
+
+#include "../tcc/ParallelParsingExampleIterator.tcc"
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PrefetchingExampleIterator.h (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ExampleIterator.h"
+
+// utilities
+#include "BackgroundProducer.h"
+
+// stl
+#include <cstddef>
+#include <vector>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary> Parameters for the PrefetchingExampleIterator. </summary>
+    struct PrefetchingParameters
+    {
+        /// <summary> The number of examples that the background thread reads at a time. </summary>
+        size_t batchSize = 1024;
+
+        /// <summary> The maximal number of batches that wait in the queue for the consumer. </summary>
+        size_t maxQueuedBatches = 4;
+    };
+
+    /// <summary>
+    /// An example iterator that reads ahead of its consumer. A background thread pulls batches of
+    /// examples from a source iterator, which does the reading and parsing, and puts them in a
+    /// bounded queue, while the consumer processes the current batch. The background thread stops
+    /// when the queue is full, so at most maxQueuedBatches + 2 batches are held in memory. An
+    /// exception thrown by the source iterator is rethrown to the consumer once it reaches the
+    /// example that could not be read. Destroying the iterator stops the background thread and
+    /// discards the examples that were not consumed.
+    /// </summary>
+    ///
+    /// <typeparam name="ExampleType"> Example type. </typeparam>
+    template <typename ExampleType>
+    class PrefetchingExampleIterator : public IExampleIterator<ExampleType>
+    {
+    public:
+        /// <summary> Constructs a PrefetchingExampleIterator and starts reading the first batch. </summary>
+        ///
+        /// <param name="sourceIterator"> The iterator that the examples are read from. </param>
+        /// <param name="parameters"> The prefetching parameters. </param>
+        PrefetchingExampleIterator(ExampleIterator<ExampleType> sourceIterator, const PrefetchingParameters& parameters);
+
+        PrefetchingExampleIterator(const PrefetchingExampleIterator&) = delete;
+
+        PrefetchingExampleIterator& operator=(const PrefetchingExampleIterator&) = delete;
+
+        /// <summary> Returns true if the iterator is currently pointing to a valid iterate. </summary>
+        ///
+        /// <returns> true if the iterator is valid, false otherwise. </returns>
+        virtual bool IsValid() const override { return _currentIndex < _currentBatch.size(); }
+
+        /// <summary> Proceeds to the next example. </summary>
+        virtual void Next() override;
+
+        /// <summary> Gets the current example. </summary>
+        ///
+        /// <returns> The current example. </returns>
+        virtual ExampleType Get() const override { return _currentBatch[_currentIndex]; }
+
+    private:
+        using ExampleBatch = std::vector<ExampleType>;
+
+        bool ReadBatch(ExampleBatch& batch);
+        void WaitForBatch();
+
+        ExampleIterator<ExampleType> _sourceIterator;
+        size_t _batchSize;
+
+        ExampleBatch _currentBatch;
+        size_t _currentIndex = 0;
+
+        // declared last, so that the background thread stops before the source iterator is destroyed
+        utilities::BackgroundProducer<ExampleBatch> _producer;
+    };
+
+    /// <summary> Helper function that wraps an example iterator in a PrefetchingExampleIterator. </summary>
+    ///
+    /// <typeparam name="ExampleType"> Example type. </typeparam>
+    /// <param name="sourceIterator"> The iterator that the examples are read from. </param>
+    /// <param name="parameters"> The prefetching parameters. </param>
+    ///
+    /// <returns> The prefetching example iterator. </returns>
+    template <typename ExampleType>
+    ExampleIterator<ExampleType> MakePrefetchingExampleIterator(ExampleIterator<ExampleType> sourceIterator, const PrefetchingParameters& parameters = PrefetchingParameters());
+}
+}
+
+#include "../tcc/PrefetchingExampleIterator.tcc"
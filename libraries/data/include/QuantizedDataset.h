@@ -0,0 +1,354 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedDataset.h (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "DataVector.h"
+#include "Dataset.h"
+#include "Example.h"
+#include "ExampleIterator.h"
+#include "IndexValue.h"
+#include "SparseDataVector.h"
+#include "WeightLabel.h"
+
+// math
+#include "Vector.h"
+
+// stl
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary>
+    /// A supervised dataset that compresses its data by storing every value as a small unsigned
+    /// integer code. Each feature has its own scale and zero point, which are learned from the range of
+    /// values that the feature takes, and a value v of feature j is stored as the code
+    /// round(v / scale[j]) + zeroPoint[j]. Zero is always represented exactly, and every other value in
+    /// the learned range is reconstructed to within half of the feature's scale. As in ArenaDataset, each
+    /// example is stored either as a dense row of codes or as a sparse row of codes and indices. Dot
+    /// products and additions are computed directly from the codes, and GetRow reads an example in
+    /// place, as a data vector that refers to the codes. Examples are materialized as data vectors of
+    /// the requested type only when they are read through an example iterator.
+    /// </summary>
+    ///
+    /// <typeparam name="QuantizedType"> The type of the stored codes, either uint8_t or uint16_t. </typeparam>
+    template <typename QuantizedType>
+    class QuantizedDataset : public DatasetBase
+    {
+    public:
+        class Row;
+
+        /// <summary> An index-value iterator over the nonzero entries of one example, which dequantizes the stored codes. </summary>
+        class RowIterator : public IIndexValueIterator
+        {
+        public:
+            /// <summary> Returns true if the iterator is currently pointing to a valid iterate. </summary>
+            ///
+            /// <returns> true if the iterator is valid. </returns>
+            bool IsValid() const { return _current < _size && GetIndex() < _end; }
+
+            /// <summary> Proceeds to the next nonzero entry. </summary>
+            void Next();
+
+            /// <summary> Returns the current index-value pair. </summary>
+            ///
+            /// <returns> The current index-value pair. </returns>
+            IndexValue Get() const;
+
+        private:
+            friend class QuantizedDataset<QuantizedType>;
+            friend class Row;
+            RowIterator(const QuantizedDataset<QuantizedType>& dataset, const uint32_t* indices, const QuantizedType* codes, size_t size, size_t end);
+            size_t GetIndex() const { return _indices == nullptr ? _current : _indices[_current]; }
+            void SkipZeros();
+
+            const QuantizedDataset<QuantizedType>& _dataset;
+            const uint32_t* _indices; // null for a dense row
+            const QuantizedType* _codes;
+            size_t _size;
+            size_t _end;
+            size_t _current = 0;
+        };
+
+        /// <summary> An index-value iterator over every entry of a prefix of one example, including the zeros, which dequantizes the stored codes. </summary>
+        class DenseRowIterator : public IIndexValueIterator
+        {
+        public:
+            /// <summary> Returns true if the iterator is currently pointing to a valid iterate. </summary>
+            ///
+            /// <returns> true if the iterator is valid. </returns>
+            bool IsValid() const { return _index < _end; }
+
+            /// <summary> Proceeds to the next entry. </summary>
+            void Next();
+
+            /// <summary> Returns the current index-value pair. </summary>
+            ///
+            /// <returns> The current index-value pair. </returns>
+            IndexValue Get() const;
+
+        private:
+            friend class Row;
+            DenseRowIterator(const QuantizedDataset<QuantizedType>& dataset, const uint32_t* indices, const QuantizedType* codes, size_t size, size_t end);
+
+            const QuantizedDataset<QuantizedType>& _dataset;
+            const uint32_t* _indices; // null for a dense row
+            const QuantizedType* _codes;
+            size_t _size;
+            size_t _end;
+            size_t _index = 0;
+            size_t _current = 0; // the first stored entry whose index is not less than _index
+        };
+
+        /// <summary>
+        /// A read-only data vector that refers to the codes of one example, without dequantizing them
+        /// into a copy. Dot products and additions use the dataset's Dot and AddTo. A row is only
+        /// valid while the dataset it came from exists and no example is added to it.
+        /// </summary>
+        class Row : public DataVectorBase<Row>
+        {
+        public:
+            template <IterationPolicy policy>
+            using Iterator = std::conditional_t<policy == IterationPolicy::all, DenseRowIterator, RowIterator>;
+
+            /// <summary> Gets the data vector type. </summary>
+            ///
+            /// <returns> The data vector type. </returns>
+            virtual IDataVector::Type GetType() const override { return IDataVector::Type::QuantizedDatasetRow; }
+
+            /// <summary> Rows are read-only, so this function throws. </summary>
+            ///
+            /// <param name="index"> Zero-based index of the element. </param>
+            /// <param name="value"> The value. </param>
+            virtual void AppendElement(size_t index, double value) override;
+
+            /// <summary> Returns the first index of the suffix of zeros at the end of this vector. </summary>
+            ///
+            /// <returns> The first index of the suffix of zeros at the end of this vector. </returns>
+            virtual size_t PrefixLength() const override;
+
+            /// <summary> Computes the dot product with another vector, directly from the codes. </summary>
+            ///
+            /// <param name="vector"> The other vector. </param>
+            ///
+            /// <returns> A dot product. </returns>
+            virtual double Dot(const math::UnorientedConstVectorReference<double> vector) const override { return _dataset.Dot(_index, vector); }
+
+            using DataVectorBase<Row>::Dot;
+
+            /// <summary> Adds this data vector to a math::RowVector, directly from the codes. </summary>
+            ///
+            /// <param name="vector"> [in,out] The vector to which this data vector is added. </param>
+            virtual void AddTo(math::RowVectorReference<double> vector) const override { _dataset.AddTo(_index, vector); }
+
+            using DataVectorBase<Row>::AddTo;
+
+            /// <summary> Returns an index-value iterator over a prefix of the row. </summary>
+            ///
+            /// <typeparam name="policy"> The iteration policy. </typeparam>
+            /// <param name="size"> The prefix size. </param>
+            ///
+            /// <returns> The iterator. </returns>
+            template <IterationPolicy policy>
+            Iterator<policy> GetIterator(size_t size) const;
+
+            /// <summary> Returns an index-value iterator over the row, up to PrefixLength(). </summary>
+            ///
+            /// <typeparam name="policy"> The iteration policy. </typeparam>
+            ///
+            /// <returns> The iterator. </returns>
+            template <IterationPolicy policy>
+            Iterator<policy> GetIterator() const { return GetIterator<policy>(PrefixLength()); }
+
+        private:
+            friend class QuantizedDataset<QuantizedType>;
+            Row(const QuantizedDataset<QuantizedType>& dataset, size_t index);
+
+            const QuantizedDataset<QuantizedType>& _dataset;
+            size_t _index;
+        };
+
+        /// <summary> Constructs an empty QuantizedDataset with given feature ranges. </summary>
+        ///
+        /// <param name="minValues"> The smallest value of each feature. </param>
+        /// <param name="maxValues"> The largest value of each feature. </param>
+        QuantizedDataset(const std::vector<double>& minValues, const std::vector<double>& maxValues);
+
+        /// <summary> Constructs an instance of QuantizedDataset by learning the feature ranges in one pass over a dataset and compressing its examples in a second pass. </summary>
+        ///
+        /// <param name="dataset"> The dataset to compress. </param>
+        QuantizedDataset(const AnyDataset& dataset);
+
+        QuantizedDataset(QuantizedDataset&&) = default;
+
+        QuantizedDataset(const QuantizedDataset&) = delete;
+
+        QuantizedDataset& operator=(QuantizedDataset&&) = default;
+
+        QuantizedDataset& operator=(const QuantizedDataset&) = delete;
+
+        /// <summary> Returns the number of examples in the dataset. </summary>
+        ///
+        /// <returns> The number of examples. </returns>
+        size_t NumExamples() const { return _metadata.size(); }
+
+        /// <summary> Returns the number of features that have a learned scale. </summary>
+        ///
+        /// <returns> The number of features. </returns>
+        size_t NumFeatures() const { return _scales.size(); }
+
+        /// <summary> Returns the total number of codes stored in the dataset. </summary>
+        ///
+        /// <returns> The number of stored codes. </returns>
+        size_t NumStoredValues() const { return _codes.size(); }
+
+        /// <summary> Returns the scale of a feature, which is the difference between the values of two consecutive codes. </summary>
+        ///
+        /// <param name="feature"> Zero-based index of the feature. </param>
+        ///
+        /// <returns> The scale. </returns>
+        double GetScale(size_t feature) const { return _scales[feature]; }
+
+        /// <summary> Returns the largest difference between a value in the range of a feature and its reconstruction. </summary>
+        ///
+        /// <param name="feature"> Zero-based index of the feature. </param>
+        ///
+        /// <returns> The maximal quantization error. </returns>
+        double GetMaxQuantizationError(size_t feature) const { return _scales[feature] / 2.0; }
+
+        /// <summary> Compresses an example and adds it to the dataset. Values outside the range of their feature are clamped to the range. </summary>
+        ///
+        /// <typeparam name="DataVectorType"> The data vector type. </typeparam>
+        /// <param name="dataVector"> The data vector of the example. </param>
+        /// <param name="metadata"> The metadata of the example. </param>
+        template <typename DataVectorType>
+        void AddExample(const DataVectorType& dataVector, const WeightLabel& metadata) { AddRow(dataVector.template CopyAs<SparseDoubleDataVector>(), metadata); }
+
+        /// <summary> Compresses an example and adds it to the dataset. Values outside the range of their feature are clamped to the range. </summary>
+        ///
+        /// <typeparam name="ExampleType"> The example type. </typeparam>
+        /// <param name="example"> The example. </param>
+        template <typename ExampleType>
+        void AddExample(const ExampleType& example) { AddExample(example.GetDataVector(), example.GetMetadata()); }
+
+        /// <summary> Returns the metadata of an example. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The metadata. </returns>
+        const WeightLabel& GetMetadata(size_t index) const { return _metadata[index]; }
+
+        /// <summary> Returns the data vector of an example, which reads the codes in place. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The row. </returns>
+        Row GetRow(size_t index) const;
+
+        /// <summary> Returns an iterator over the dequantized nonzero entries of an example. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The iterator. </returns>
+        RowIterator GetRowIterator(size_t index) const { return GetRow(index).template GetIterator<IterationPolicy::skipZeros>(); }
+
+        /// <summary> Computes the dot product of an example with a vector, dequantizing the codes on the fly. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        /// <param name="vector"> The vector. </param>
+        ///
+        /// <returns> The dot product. </returns>
+        double Dot(size_t index, math::UnorientedConstVectorReference<double> vector) const;
+
+        /// <summary> Adds a scaled example to a vector, dequantizing the codes on the fly. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        /// <param name="vector"> [in,out] The vector to add to. </param>
+        /// <param name="scalar"> The scalar that multiplies the example. </param>
+        void AddTo(size_t index, math::RowVectorReference<double> vector, double scalar = 1.0) const;
+
+        /// <summary> Returns an example, dequantized as the requested example type. </summary>
+        ///
+        /// <typeparam name="ExampleType"> The example type. </typeparam>
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The example. </returns>
+        template <typename ExampleType = AutoSupervisedExample>
+        ExampleType GetExample(size_t index) const;
+
+        /// <summary> Returns an iterator that traverses the examples. </summary>
+        ///
+        /// <typeparam name="IteratorExampleType"> Example type returned by the iterator. </typeparam>
+        /// <param name="fromIndex"> Zero-based index of the first example to iterate over. </param>
+        /// <param name="size"> The number of examples to iterate over, or zero to iterate to the end. </param>
+        ///
+        /// <returns> The example iterator. </returns>
+        template <typename IteratorExampleType = AutoSupervisedExample>
+        ExampleIterator<IteratorExampleType> GetExampleIterator(size_t fromIndex = 0, size_t size = 0) const;
+
+        /// <summary> Returns an AnyDataset that represents an interval of examples from this dataset. </summary>
+        ///
+        /// <param name="fromIndex"> Zero-based index of the first example in the AnyDataset. </param>
+        /// <param name="size"> The number of examples to include, or zero to include all remaining examples. </param>
+        ///
+        /// <returns> An AnyDataset. </returns>
+        AnyDataset GetAnyDataset(size_t fromIndex = 0, size_t size = 0) const { return AnyDataset(this, fromIndex, size); }
+
+        /// <summary> Prints this object. </summary>
+        ///
+        /// <param name="os"> [in,out] Stream to write data to. </param>
+        void Print(std::ostream& os) const;
+
+    private:
+        template <typename IteratorExampleType>
+        class QuantizedExampleIterator : public IExampleIterator<IteratorExampleType>
+        {
+        public:
+            QuantizedExampleIterator(const QuantizedDataset<QuantizedType>& dataset, size_t fromIndex, size_t endIndex)
+                : _dataset(dataset), _current(fromIndex), _end(endIndex) {}
+
+            virtual bool IsValid() const override { return _current < _end; }
+
+            virtual void Next() override { ++_current; }
+
+            virtual IteratorExampleType Get() const override { return _dataset.template GetExample<IteratorExampleType>(_current); }
+
+        private:
+            const QuantizedDataset<QuantizedType>& _dataset;
+            size_t _current;
+            size_t _end;
+        };
+
+        void SetFeatureRanges(const std::vector<double>& minValues, const std::vector<double>& maxValues);
+        void AddRow(const SparseDoubleDataVector& dataVector, const WeightLabel& metadata);
+        QuantizedType Quantize(size_t feature, double value) const;
+        double Dequantize(size_t feature, QuantizedType code) const { return _scales[feature] * (static_cast<double>(code) - _zeroPoints[feature]); }
+        bool IsDenseRow(size_t index) const { return _indexOffsets[index + 1] == _indexOffsets[index]; }
+        const uint32_t* GetRowIndices(size_t index) const { return IsDenseRow(index) ? nullptr : _indices.data() + _indexOffsets[index]; }
+
+        std::vector<double> _scales;
+        std::vector<double> _zeroPoints;
+        std::vector<QuantizedType> _codes;
+        std::vector<uint32_t> _indices;
+        std::vector<size_t> _codeOffsets = { 0 };
+        std::vector<size_t> _indexOffsets = { 0 };
+        std::vector<WeightLabel> _metadata;
+    };
+
+    typedef QuantizedDataset<uint8_t> ByteQuantizedDataset;
+    typedef QuantizedDataset<uint16_t> ShortQuantizedDataset;
+}
+}
+
+#include "../tcc/QuantizedDataset.tcc"
@@ -200,12 +200,30 @@ namespace data
         /// <returns> A double. </returns>
         virtual double Dot(const math::UnorientedConstVectorReference<double> vector) const override;
 
+        /// <summary> Computes the Dot product with a single precision vector. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> A float. </returns>
+        virtual float Dot(const math::UnorientedConstVectorReference<float> vector) const override;
+
         /// <summary> Adds this data vector to a math::RowVector </summary>
         ///
         /// <param name="vector"> [in,out] The vector that this DataVector is added to. </param>
         virtual void AddTo(math::RowVectorReference<double> vector) const override;
 
+        /// <summary> Adds this data vector to a single precision math::RowVector </summary>
+        ///
+        /// <param name="vector"> [in,out] The vector that this DataVector is added to. </param>
+        virtual void AddTo(math::RowVectorReference<float> vector) const override;
+
     private:
+        template <typename ElementType>
+        double DotImplementation(const math::UnorientedConstVectorReference<ElementType> vector) const;
+
+        template <typename ElementType>
+        void AddToImplementation(math::RowVectorReference<ElementType> vector) const;
+
         using DataVectorBase<SparseBinaryDataVectorBase<IndexListType>>::AppendElements;
         IndexListType _indexList;
     };
@@ -190,7 +190,38 @@ namespace data
         /// <returns> The first index of the suffix of zeros at the end of this vector. </returns>
         virtual size_t PrefixLength() const override;
 
+        /// <summary> Computes the Dot product. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> A double. </returns>
+        virtual double Dot(const math::UnorientedConstVectorReference<double> vector) const override;
+
+        /// <summary> Computes the Dot product with a single precision vector. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> A float. </returns>
+        virtual float Dot(const math::UnorientedConstVectorReference<float> vector) const override;
+
+        /// <summary> Adds this data vector to a math::RowVector </summary>
+        ///
+        /// <param name="vector"> [in,out] The vector that this DataVector is added to. </param>
+        virtual void AddTo(math::RowVectorReference<double> vector) const override;
+
+        /// <summary> Adds this data vector to a single precision math::RowVector </summary>
+        ///
+        /// <param name="vector"> [in,out] The vector that this DataVector is added to. </param>
+        virtual void AddTo(math::RowVectorReference<float> vector) const override;
+
     private:
+        // these kernels read the indices one decoded block at a time and gather from (or scatter to) the vector
+        template <typename VectorElementType>
+        double DotImplementation(const math::UnorientedConstVectorReference<VectorElementType> vector) const;
+
+        template <typename VectorElementType>
+        void AddToImplementation(math::RowVectorReference<VectorElementType> vector) const;
+
         using DataVectorBase<SparseDataVector<ElementType, IndexListType>>::AppendElements;
         IndexListType _indexList;
         std::vector<ElementType> _values;
@@ -28,15 +28,27 @@ namespace data
         /// <param name="string"> The string. </param>
         TextLine(std::string string);
 
-        /// <summary> Gets a const reference to the underlying string. </summary>
+        /// <summary>
+        /// Constructs an instance of TextLine that views a line inside a larger buffer, without
+        /// copying it. The character that follows the line in the buffer must be a null terminator.
+        /// The TextLine shares ownership of the buffer, so the buffer remains valid as long as the
+        /// TextLine exists.
+        /// </summary>
         ///
-        /// <returns> The underlying string. </returns>
-        const std::string& GetString() const { return *_string; }
+        /// <param name="buffer"> The buffer. </param>
+        /// <param name="offset"> The position of the first character of the line in the buffer. </param>
+        /// <param name="size"> The number of characters in the line. </param>
+        TextLine(std::shared_ptr<const std::string> buffer, size_t offset, size_t size);
+
+        /// <summary> Gets a copy of the line. </summary>
+        ///
+        /// <returns> The line, as a string. </returns>
+        std::string GetString() const { return std::string(_begin, _size); }
 
         /// <summary> Query if this TextLine contains a valid string. </summary>
         ///
         /// <returns> True if valid, false if not. </returns>
-        bool IsValid() { return _string != nullptr; }
+        bool IsValid() { return _buffer != nullptr; }
 
         /// <summary> Returns a character relative to the current position of the cursor. </summary>
         ///
@@ -82,10 +94,12 @@ namespace data
         /// <summary> Gets the total number of characters in the line. </summary>
         ///
         /// <returns> The text line size. </returns>
-        size_t Size() const { return _string->length(); }
+        size_t Size() const { return _size; }
 
     private:
-        std::shared_ptr<const std::string> _string = nullptr; 
+        std::shared_ptr<const std::string> _buffer = nullptr;
+        const char* _begin = nullptr;
+        size_t _size = 0;
         const char* _currentChar = nullptr;
     };
 }
@@ -57,10 +57,11 @@ namespace data
     /// <typeparam name="policy"> The iteration policy. </typeparam>
     /// <typeparam name="DataVectorType"> The data vector type. </typeparam>
     /// <typeparam name="TransformationType"> The transformation type. </typeparam>
+    /// <typeparam name="ElementType"> The element type of the math::RowVector. </typeparam>
     /// <param name="vector"> The math::RowVector being modified. </param>
     /// <param name="transformedDataVector"> The TransformedDataVector being added to vector. </param>
-    template <IterationPolicy policy, typename DataVectorType, typename TransformationType>
-    void operator+=(math::RowVectorReference<double> vector, const TransformedDataVector<policy, DataVectorType, TransformationType>& transformedDataVector);
+    template <IterationPolicy policy, typename DataVectorType, typename TransformationType, typename ElementType>
+    void operator+=(math::RowVectorReference<ElementType> vector, const TransformedDataVector<policy, DataVectorType, TransformationType>& transformedDataVector);
 }
 }
 
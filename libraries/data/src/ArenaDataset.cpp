@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ArenaDataset.cpp (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ArenaDataset.h"
+
+// utilities
+#include "Exception.h"
+
+namespace ell
+{
+namespace data
+{
+    ArenaDataset::RowIterator::RowIterator(const uint32_t* indices, const double* values, size_t size, size_t end)
+        : _indices(indices), _values(values), _size(size), _end(end)
+    {
+        SkipZeros();
+    }
+
+    void ArenaDataset::RowIterator::Next()
+    {
+        ++_current;
+        SkipZeros();
+    }
+
+    void ArenaDataset::RowIterator::SkipZeros()
+    {
+        // only dense rows store zeros
+        while (_current < _size && _values[_current] == 0.0)
+        {
+            ++_current;
+        }
+    }
+
+    ArenaDataset::DenseRowIterator::DenseRowIterator(const uint32_t* indices, const double* values, size_t size, size_t end)
+        : _indices(indices), _values(values), _size(size), _end(end)
+    {
+    }
+
+    void ArenaDataset::DenseRowIterator::Next()
+    {
+        ++_index;
+        if (_indices != nullptr && _current < _size && _indices[_current] < _index)
+        {
+            ++_current;
+        }
+    }
+
+    IndexValue ArenaDataset::DenseRowIterator::Get() const
+    {
+        if (_indices == nullptr)
+        {
+            return IndexValue{ _index, _index < _size ? _values[_index] : 0.0 };
+        }
+        return IndexValue{ _index, (_current < _size && _indices[_current] == _index) ? _values[_current] : 0.0 };
+    }
+
+    ArenaDataset::Row::Row(const uint32_t* indices, const double* values, size_t size)
+        : _indices(indices), _values(values), _size(size)
+    {
+    }
+
+    void ArenaDataset::Row::AppendElement(size_t index, double value)
+    {
+        throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "ArenaDataset rows are read-only");
+    }
+
+    size_t ArenaDataset::Row::PrefixLength() const
+    {
+        if (_indices == nullptr)
+        {
+            return _size;
+        }
+        return _size == 0 ? 0 : _indices[_size - 1] + 1;
+    }
+
+    void ArenaDataset::Reserve(size_t numExamples, size_t numValues, size_t numSparseValues)
+    {
+        _values.reserve(numValues);
+        _indices.reserve(numSparseValues);
+        _valueOffsets.reserve(numExamples + 1);
+        _indexOffsets.reserve(numExamples + 1);
+        _metadata.reserve(numExamples);
+    }
+
+    ArenaDataset::Row ArenaDataset::GetRow(size_t index) const
+    {
+        if (index >= NumExamples())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "example index exceeds dataset size");
+        }
+
+        auto numValues = _valueOffsets[index + 1] - _valueOffsets[index];
+        bool isDense = _indexOffsets[index + 1] == _indexOffsets[index];
+        const uint32_t* indices = isDense ? nullptr : _indices.data() + _indexOffsets[index];
+        return Row(indices, _values.data() + _valueOffsets[index], numValues);
+    }
+
+    void ArenaDataset::Print(std::ostream& os) const
+    {
+        for (size_t index = 0; index < NumExamples(); ++index)
+        {
+            _metadata[index].Print(os);
+            os << "\t";
+            auto iterator = GetRowIterator(index);
+            while (iterator.IsValid())
+            {
+                auto indexValue = iterator.Get();
+                os << indexValue.index << ":" << indexValue.value << '\t';
+                iterator.Next();
+            }
+            os << '\n';
+        }
+    }
+}
+}
@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BinaryDataset.cpp (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "BinaryDataset.h"
+#include "IndexValue.h"
+#include "SparseDataVector.h"
+
+// utilities
+#include "Exception.h"
+
+// stl
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+namespace ell
+{
+namespace data
+{
+    namespace
+    {
+        const char binaryDatasetMagic[8] = { 'E', 'L', 'L', 'B', 'D', 'A', 'T', 'A' };
+        const uint32_t binaryDatasetVersion = 1;
+        const uint32_t denseBlockFlag = 1;
+
+        struct BinaryDatasetHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t flags;
+            uint64_t numExamples;
+            uint64_t numNonzeros;
+            uint64_t numColumns;
+        };
+
+        // the index array is followed by padding, so that the dense block is aligned
+        size_t PaddedSize(size_t size)
+        {
+            return (size + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+        }
+
+        // adds two sizes computed from a file header, and throws if the sum overflows
+        size_t AddSizes(size_t a, size_t b, const std::string& filepath)
+        {
+            if (b > std::numeric_limits<size_t>::max() - a)
+            {
+                throw utilities::DataFormatException(utilities::DataFormatErrors::badFormat, "binary dataset file has a corrupt header: " + filepath);
+            }
+            return a + b;
+        }
+
+        // multiplies two sizes computed from a file header, and throws if the product overflows
+        size_t MultiplySizes(size_t a, size_t b, const std::string& filepath)
+        {
+            if (a != 0 && b > std::numeric_limits<size_t>::max() / a)
+            {
+                throw utilities::DataFormatException(utilities::DataFormatErrors::badFormat, "binary dataset file has a corrupt header: " + filepath);
+            }
+            return a * b;
+        }
+
+        template <typename ValueType>
+        void WriteArray(std::ostream& stream, const std::vector<ValueType>& array)
+        {
+            stream.write(reinterpret_cast<const char*>(array.data()), array.size() * sizeof(ValueType));
+        }
+    }
+
+    BinaryDataset::BinaryDataset(const std::string& filepath)
+        : _file(std::make_shared<const utilities::MemoryMappedFile>(filepath))
+    {
+        if (_file->Size() < sizeof(BinaryDatasetHeader))
+        {
+            throw utilities::DataFormatException(utilities::DataFormatErrors::abruptEnd, "file is too short to be a binary dataset: " + filepath);
+        }
+
+        BinaryDatasetHeader header;
+        std::memcpy(&header, _file->GetData(), sizeof(header));
+        if (std::memcmp(header.magic, binaryDatasetMagic, sizeof(binaryDatasetMagic)) != 0)
+        {
+            throw utilities::DataFormatException(utilities::DataFormatErrors::badFormat, "file is not a binary dataset: " + filepath);
+        }
+        if (header.version != binaryDatasetVersion)
+        {
+            throw utilities::DataFormatException(utilities::DataFormatErrors::badFormat, "unsupported binary dataset version in file " + filepath);
+        }
+
+        _numExamples = static_cast<size_t>(header.numExamples);
+        _numNonzeros = static_cast<size_t>(header.numNonzeros);
+        _numColumns = static_cast<size_t>(header.numColumns);
+        bool hasDenseBlock = (header.flags & denseBlockFlag) != 0;
+
+        size_t rowOffsetsOffset = sizeof(BinaryDatasetHeader);
+        size_t labelsOffset = AddSizes(rowOffsetsOffset, MultiplySizes(AddSizes(_numExamples, 1, filepath), sizeof(uint64_t), filepath), filepath);
+        size_t weightsOffset = AddSizes(labelsOffset, MultiplySizes(_numExamples, sizeof(double), filepath), filepath);
+        size_t valuesOffset = AddSizes(weightsOffset, MultiplySizes(_numExamples, sizeof(double), filepath), filepath);
+        size_t indicesOffset = AddSizes(valuesOffset, MultiplySizes(_numNonzeros, sizeof(double), filepath), filepath);
+        size_t denseBlockOffset = AddSizes(indicesOffset, PaddedSize(MultiplySizes(_numNonzeros, sizeof(uint32_t), filepath)), filepath);
+        size_t expectedSize = hasDenseBlock ? AddSizes(denseBlockOffset, MultiplySizes(MultiplySizes(_numColumns, _numExamples, filepath), sizeof(double), filepath), filepath) : denseBlockOffset;
+        if (_file->Size() != expectedSize)
+        {
+            throw utilities::DataFormatException(utilities::DataFormatErrors::abruptEnd, "binary dataset file has the wrong size: " + filepath);
+        }
+
+        const char* pData = _file->GetData();
+        _rowOffsets = reinterpret_cast<const uint64_t*>(pData + rowOffsetsOffset);
+        _labels = reinterpret_cast<const double*>(pData + labelsOffset);
+        _weights = reinterpret_cast<const double*>(pData + weightsOffset);
+        _values = reinterpret_cast<const double*>(pData + valuesOffset);
+        _indices = reinterpret_cast<const uint32_t*>(pData + indicesOffset);
+        if (hasDenseBlock)
+        {
+            _denseBlock = reinterpret_cast<const double*>(pData + denseBlockOffset);
+        }
+
+        // GetRow trusts the CSR arrays, so check every row once here
+        if (_rowOffsets[0] != 0 || _rowOffsets[_numExamples] != _numNonzeros)
+        {
+            throw utilities::DataFormatException(utilities::DataFormatErrors::illegalValue, "binary dataset file has inconsistent row offsets: " + filepath);
+        }
+        for (size_t row = 0; row < _numExamples; ++row)
+        {
+            auto begin = _rowOffsets[row];
+            auto end = _rowOffsets[row + 1];
+            if (begin > end || end > _numNonzeros)
+            {
+                throw utilities::DataFormatException(utilities::DataFormatErrors::illegalValue, "binary dataset file has inconsistent row offsets: " + filepath);
+            }
+            for (auto entry = begin; entry < end; ++entry)
+            {
+                if (_indices[entry] >= _numColumns || (entry > begin && _indices[entry] <= _indices[entry - 1]))
+                {
+                    throw utilities::DataFormatException(utilities::DataFormatErrors::illegalValue, "binary dataset file has an invalid feature index: " + filepath);
+                }
+            }
+        }
+    }
+
+    BinaryDataset::Row BinaryDataset::GetRow(size_t index) const
+    {
+        if (index >= _numExamples)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "example index exceeds dataset size");
+        }
+
+        auto begin = static_cast<size_t>(_rowOffsets[index]);
+        auto end = static_cast<size_t>(_rowOffsets[index + 1]);
+        return Row(_indices + begin, _values + begin, end - begin);
+    }
+
+    math::ColumnConstVectorReference<double> BinaryDataset::GetDenseColumn(size_t column) const
+    {
+        if (_denseBlock == nullptr)
+        {
+            throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "binary dataset does not have a dense block");
+        }
+        if (column >= _numColumns)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "column index exceeds number of columns");
+        }
+
+        return math::ColumnConstVectorReference<double>(const_cast<double*>(_denseBlock + column * _numExamples), _numExamples);
+    }
+
+    void WriteBinaryDataset(std::ostream& stream, AutoSupervisedExampleIterator exampleIterator, bool includeDenseBlock)
+    {
+        std::vector<uint64_t> rowOffsets(1, 0);
+        std::vector<double> labels;
+        std::vector<double> weights;
+        std::vector<double> values;
+        std::vector<uint32_t> indices;
+        size_t numColumns = 0;
+
+        while (exampleIterator.IsValid())
+        {
+            auto example = exampleIterator.Get();
+            auto dataVector = example.GetDataVector().CopyAs<SparseDoubleDataVector>();
+            numColumns = std::max(numColumns, dataVector.PrefixLength());
+
+            auto indexValueIterator = dataVector.GetIterator<IterationPolicy::skipZeros>();
+            while (indexValueIterator.IsValid())
+            {
+                auto indexValue = indexValueIterator.Get();
+                if (indexValue.index > std::numeric_limits<uint32_t>::max())
+                {
+                    throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "binary dataset format supports indices up to 2^32-1");
+                }
+                indices.push_back(static_cast<uint32_t>(indexValue.index));
+                values.push_back(indexValue.value);
+                indexValueIterator.Next();
+            }
+
+            rowOffsets.push_back(values.size());
+            labels.push_back(example.GetMetadata().label);
+            weights.push_back(example.GetMetadata().weight);
+            exampleIterator.Next();
+        }
+
+        BinaryDatasetHeader header;
+        std::memcpy(header.magic, binaryDatasetMagic, sizeof(binaryDatasetMagic));
+        header.version = binaryDatasetVersion;
+        header.flags = includeDenseBlock ? denseBlockFlag : 0;
+        header.numExamples = labels.size();
+        header.numNonzeros = values.size();
+        header.numColumns = numColumns;
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        WriteArray(stream, rowOffsets);
+        WriteArray(stream, labels);
+        WriteArray(stream, weights);
+        WriteArray(stream, values);
+        WriteArray(stream, indices);
+
+        auto indicesSize = indices.size() * sizeof(uint32_t);
+        std::vector<char> padding(PaddedSize(indicesSize) - indicesSize, 0);
+        WriteArray(stream, padding);
+
+        if (includeDenseBlock)
+        {
+            // write the block one column at a time, so that only one column is held in memory
+            auto numExamples = labels.size();
+            std::vector<double> column(numExamples);
+            for (size_t j = 0; j < numColumns; ++j)
+            {
+                std::fill(column.begin(), column.end(), 0.0);
+                for (size_t i = 0; i < numExamples; ++i)
+                {
+                    // the indices in each row are sorted, so binary search finds the entry for column j
+                    auto rowBegin = indices.begin() + rowOffsets[i];
+                    auto rowEnd = indices.begin() + rowOffsets[i + 1];
+                    auto position = std::lower_bound(rowBegin, rowEnd, static_cast<uint32_t>(j));
+                    if (position != rowEnd && *position == j)
+                    {
+                        column[i] = values[position - indices.begin()];
+                    }
+                }
+                WriteArray(stream, column);
+            }
+        }
+
+        if (!stream)
+        {
+            throw utilities::SystemException(utilities::SystemExceptionErrors::fileNotWritable, "error writing binary dataset");
+        }
+    }
+
+    bool IsBinaryDatasetFile(const std::string& filepath)
+    {
+        std::ifstream stream(filepath, std::ios::binary);
+        char magic[sizeof(binaryDatasetMagic)] = {};
+        stream.read(magic, sizeof(magic));
+        return stream && std::memcmp(magic, binaryDatasetMagic, sizeof(binaryDatasetMagic)) == 0;
+    }
+}
+}
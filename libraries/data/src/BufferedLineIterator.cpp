@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BufferedLineIterator.cpp (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "BufferedLineIterator.h"
+
+// stl
+#include <algorithm>
+
+namespace ell
+{
+namespace data
+{
+    BufferedLineIterator::BufferedLineIterator(std::istream& stream, size_t blockSize, char delim)
+        : _stream(stream), _blockSize(std::max(blockSize, size_t(1))), _delim(delim), _block(std::make_shared<const std::string>())
+    {
+        Next();
+    }
+
+    void BufferedLineIterator::Next()
+    {
+        if (_position >= _block->size())
+        {
+            ReadBlock();
+            if (_block->empty())
+            {
+                _isValid = false;
+                return;
+            }
+        }
+
+        // the delimiters in the block were replaced by null terminators, which end each line
+        auto lineEnd = std::min(_block->find('\0', _position), _block->size());
+        _currentLine = TextLine(_block, _position, lineEnd - _position);
+        _position = lineEnd + 1;
+    }
+
+    void BufferedLineIterator::ReadBlock()
+    {
+        // start the new block with the end of the last line of the previous block
+        auto block = std::make_shared<std::string>(std::move(_partialLine));
+        _partialLine.clear();
+        _position = 0;
+
+        while (_stream)
+        {
+            auto size = block->size();
+            block->resize(size + _blockSize);
+            _stream.read(&(*block)[size], _blockSize);
+            block->resize(size + static_cast<size_t>(_stream.gcount()));
+
+            if (!_stream)
+            {
+                break;
+            }
+
+            // move the partial last line to the next block; if the block contains no delimiter, the line is longer than the block, so keep reading
+            auto lastDelimiter = block->rfind(_delim);
+            if (lastDelimiter != std::string::npos)
+            {
+                _partialLine.assign(*block, lastDelimiter + 1, std::string::npos);
+                block->resize(lastDelimiter + 1);
+                break;
+            }
+        }
+
+        std::replace(block->begin(), block->end(), _delim, '\0');
+        _block = std::move(block);
+    }
+}
+}
@@ -16,5 +16,10 @@ namespace data
     {
         dataVector.AddTo(vector);
     }
+
+    void operator+=(math::RowVectorReference<float> vector, const IDataVector& dataVector)
+    {
+        dataVector.AddTo(vector);
+    }
 }
 }
\ No newline at end of file
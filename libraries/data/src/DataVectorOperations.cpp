@@ -21,5 +21,15 @@ namespace data
     {
         return vector * dataVector;
     }
+
+    float operator*(math::UnorientedConstVectorReference<float> vector, const IDataVector& dataVector)
+    {
+        return dataVector.Dot(vector);
+    }
+
+    float operator*(const IDataVector& dataVector, math::UnorientedConstVectorReference<float> vector)
+    {
+        return vector * dataVector;
+    }
 }
 }
\ No newline at end of file
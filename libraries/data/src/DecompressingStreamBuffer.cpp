@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     DecompressingStreamBuffer.cpp (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "DecompressingStreamBuffer.h"
+
+// utilities
+#include "Exception.h"
+
+// stl
+#include <algorithm>
+#include <fstream>
+
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace ell
+{
+namespace data
+{
+    // reads the decompressed contents of a file
+    class Decompressor
+    {
+    public:
+        virtual ~Decompressor() = default;
+
+        // fills the buffer, unless the file ends first, and returns the number of bytes read
+        virtual size_t Read(char* buffer, size_t size) = 0;
+    };
+
+    namespace
+    {
+        const unsigned char gzipMagic[] = { 0x1f, 0x8b };
+        const unsigned char zstdMagic[] = { 0x28, 0xb5, 0x2f, 0xfd };
+
+#ifdef USE_ZLIB
+        class GzipDecompressor : public Decompressor
+        {
+        public:
+            GzipDecompressor(const std::string& filename)
+            {
+                _file = gzopen(filename.c_str(), "rb");
+                if (_file == nullptr)
+                {
+                    throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "error opening file " + filename);
+                }
+                gzbuffer(_file, 1 << 17);
+            }
+
+            virtual ~GzipDecompressor() { gzclose(_file); }
+
+            virtual size_t Read(char* buffer, size_t size) override
+            {
+                // gzread takes an unsigned int length and also reads concatenated gzip members
+                size_t totalRead = 0;
+                while (totalRead < size)
+                {
+                    auto length = static_cast<unsigned int>(std::min(size - totalRead, size_t(1) << 30));
+                    auto numRead = gzread(_file, buffer + totalRead, length);
+                    if (numRead <= 0)
+                    {
+                        // a truncated file is not an error for gzread, which just stops at the end of the data
+                        int errorCode = Z_OK;
+                        auto message = gzerror(_file, &errorCode);
+                        if (numRead < 0 || errorCode != Z_OK)
+                        {
+                            throw utilities::DataFormatException(utilities::DataFormatErrors::badFormat, std::string("gzip decompression failed: ") + message);
+                        }
+                        break;
+                    }
+                    totalRead += static_cast<size_t>(numRead);
+                }
+                return totalRead;
+            }
+
+        private:
+            gzFile _file;
+        };
+#endif
+
+#ifdef USE_ZSTD
+        class ZstdDecompressor : public Decompressor
+        {
+        public:
+            ZstdDecompressor(const std::string& filename)
+                : _stream(filename, std::ios::binary), _input(ZSTD_DStreamInSize())
+            {
+                if (!_stream.is_open())
+                {
+                    throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "error opening file " + filename);
+                }
+                _decompressionStream = ZSTD_createDStream();
+                ZSTD_initDStream(_decompressionStream);
+            }
+
+            virtual ~ZstdDecompressor() { ZSTD_freeDStream(_decompressionStream); }
+
+            virtual size_t Read(char* buffer, size_t size) override
+            {
+                ZSTD_outBuffer output = { buffer, size, 0 };
+                while (output.pos < output.size)
+                {
+                    if (_inputPosition == _inputSize)
+                    {
+                        _stream.read(_input.data(), _input.size());
+                        _inputSize = static_cast<size_t>(_stream.gcount());
+                        _inputPosition = 0;
+                        if (_inputSize == 0)
+                        {
+                            if (!_isFrameComplete)
+                            {
+                                throw utilities::DataFormatException(utilities::DataFormatErrors::abruptEnd, "zstd compressed file ends in the middle of a frame");
+                            }
+                            break;
+                        }
+                    }
+
+                    ZSTD_inBuffer input = { _input.data(), _inputSize, _inputPosition };
+                    auto result = ZSTD_decompressStream(_decompressionStream, &output, &input);
+                    if (ZSTD_isError(result))
+                    {
+                        throw utilities::DataFormatException(utilities::DataFormatErrors::badFormat, std::string("zstd decompression failed: ") + ZSTD_getErrorName(result));
+                    }
+                    _inputPosition = input.pos;
+
+                    // a result of zero means that a frame was completely decoded and flushed
+                    _isFrameComplete = result == 0;
+                }
+                return output.pos;
+            }
+
+        private:
+            std::ifstream _stream;
+            std::vector<char> _input;
+            size_t _inputSize = 0;
+            size_t _inputPosition = 0;
+            bool _isFrameComplete = true;
+            ZSTD_DStream* _decompressionStream;
+        };
+#endif
+
+        template <size_t size>
+        bool HasMagic(const std::vector<unsigned char>& header, const unsigned char (&magic)[size])
+        {
+            return header.size() >= size && std::equal(magic, magic + size, header.begin());
+        }
+
+        std::unique_ptr<Decompressor> MakeDecompressor(const std::string& filename)
+        {
+            switch (GetCompressionFormat(filename))
+            {
+#ifdef USE_ZLIB
+            case CompressionFormat::gzip:
+                return std::make_unique<GzipDecompressor>(filename);
+#endif
+#ifdef USE_ZSTD
+            case CompressionFormat::zstd:
+                return std::make_unique<ZstdDecompressor>(filename);
+#endif
+            case CompressionFormat::none:
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "file " + filename + " is not a gzip or zstd compressed file");
+            default:
+                throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "this build of ELL cannot decompress file " + filename);
+            }
+        }
+    }
+
+    CompressionFormat GetCompressionFormat(const std::string& filename)
+    {
+        std::ifstream stream(filename, std::ios::binary);
+        std::vector<unsigned char> header(sizeof(zstdMagic));
+        stream.read(reinterpret_cast<char*>(header.data()), header.size());
+        header.resize(static_cast<size_t>(stream.gcount()));
+
+        if (HasMagic(header, gzipMagic))
+        {
+            return CompressionFormat::gzip;
+        }
+        if (HasMagic(header, zstdMagic))
+        {
+            return CompressionFormat::zstd;
+        }
+        return CompressionFormat::none;
+    }
+
+    bool IsCompressionFormatSupported(CompressionFormat format)
+    {
+        switch (format)
+        {
+        case CompressionFormat::none:
+            return true;
+#ifdef USE_ZLIB
+        case CompressionFormat::gzip:
+            return true;
+#endif
+#ifdef USE_ZSTD
+        case CompressionFormat::zstd:
+            return true;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    //
+    // DecompressingStreamBuffer
+    //
+
+    DecompressingStreamBuffer::DecompressingStreamBuffer(const std::string& filename, const DecompressionParameters& parameters)
+        : _decompressor(MakeDecompressor(filename)), _blockSize(std::max(parameters.blockSize, size_t(1))), _producer([this](std::vector<char>& block) { return DecompressBlock(block); }, parameters.maxQueuedBlocks)
+    {
+        setg(nullptr, nullptr, nullptr);
+    }
+
+    DecompressingStreamBuffer::~DecompressingStreamBuffer() = default;
+
+    DecompressingStreamBuffer::int_type DecompressingStreamBuffer::underflow()
+    {
+        if (gptr() < egptr())
+        {
+            return traits_type::to_int_type(*gptr());
+        }
+
+        if (!_producer.Take(_currentBlock))
+        {
+            return traits_type::eof();
+        }
+
+        setg(_currentBlock.data(), _currentBlock.data(), _currentBlock.data() + _currentBlock.size());
+        return traits_type::to_int_type(*gptr());
+    }
+
+    bool DecompressingStreamBuffer::DecompressBlock(std::vector<char>& block)
+    {
+        // runs on the background thread; a block that failed to decompress is dropped
+        block.resize(_blockSize);
+        try
+        {
+            block.resize(_decompressor->Read(block.data(), block.size()));
+        }
+        catch (...)
+        {
+            block.clear();
+            throw;
+        }
+        return block.size() == _blockSize;
+    }
+
+    //
+    // DecompressingIfstream
+    //
+
+    DecompressingIfstream::DecompressingIfstream(const std::string& filename, const DecompressionParameters& parameters)
+        : std::istream(nullptr), _streamBuffer(filename, parameters)
+    {
+        rdbuf(&_streamBuffer);
+
+        // the stream rethrows the exceptions of its stream buffer only if badbit is in its exception mask
+        exceptions(std::ios::badbit);
+    }
+}
+}
@@ -0,0 +1,39 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FeatureHasher.cpp (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FeatureHasher.h"
+
+// utilities
+#include "Exception.h"
+
+namespace ell
+{
+namespace data
+{
+    FeatureHasher::FeatureHasher(size_t numBits)
+        : _numBits(numBits)
+    {
+        if (numBits == 0 || numBits > 32)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "number of hashing bits must be between 1 and 32");
+        }
+        _mask = (uint64_t(1) << numBits) - 1;
+    }
+
+    uint64_t FeatureHasher::Mix(uint64_t key)
+    {
+        // the finalization mix of MurmurHash3, which makes every bit of the output depend on every bit of the input
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb3fe1a85ec53ULL;
+        key ^= key >> 33;
+        return key;
+    }
+}
+}
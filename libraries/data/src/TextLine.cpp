@@ -15,7 +15,11 @@ namespace ell
 {
 namespace data
 {
-    TextLine::TextLine(std::string string) : _string(std::make_shared<const std::string>(std::move(string))), _currentChar(_string->c_str())
+    TextLine::TextLine(std::string string) : _buffer(std::make_shared<const std::string>(std::move(string))), _begin(_buffer->c_str()), _size(_buffer->size()), _currentChar(_begin)
+    {
+    }
+
+    TextLine::TextLine(std::shared_ptr<const std::string> buffer, size_t offset, size_t size) : _buffer(std::move(buffer)), _begin(_buffer->c_str() + offset), _size(size), _currentChar(_begin)
     {
     }
 
@@ -38,7 +42,7 @@ namespace data
 
     size_t TextLine::GetCurrentPosition() const
     {
-        return static_cast<size_t>(_currentChar - _string->c_str());
+        return static_cast<size_t>(_currentChar - _begin);
     }
 
     void TextLine::AdvancePosition(size_t increment)
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ArenaDataset.tcc (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// utilities
+#include "Exception.h"
+
+// stl
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+namespace ell
+{
+namespace data
+{
+    template <typename ExampleType>
+    ArenaDataset::ArenaDataset(ExampleIterator<ExampleType> exampleIterator)
+    {
+        while (exampleIterator.IsValid())
+        {
+            AddExample(exampleIterator.Get());
+            exampleIterator.Next();
+        }
+    }
+
+    template <typename DataVectorType>
+    void ArenaDataset::AddExample(const DataVectorType& dataVector, const WeightLabel& metadata)
+    {
+        // the entries are read straight from the concrete data vector, without an intermediate copy
+        dataVector.template InvokeWithThis<void>([this, &metadata](const auto* pThis) {
+            AddRow(pThis->template GetIterator<IterationPolicy::skipZeros>(), pThis->template GetIterator<IterationPolicy::skipZeros>(), metadata);
+        });
+    }
+
+    template <typename IndexValueIteratorType>
+    void ArenaDataset::AddRow(IndexValueIteratorType countIterator, IndexValueIteratorType copyIterator, const WeightLabel& metadata)
+    {
+        // count the nonzeros to choose the smaller of the dense and sparse layouts
+        size_t numNonzeros = 0;
+        size_t prefixLength = 0;
+        while (countIterator.IsValid())
+        {
+            ++numNonzeros;
+            prefixLength = countIterator.Get().index + 1;
+            countIterator.Next();
+        }
+
+        if (prefixLength > static_cast<size_t>(std::numeric_limits<uint32_t>::max()) + 1)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "ArenaDataset supports indices up to 2^32-1");
+        }
+        bool isDense = prefixLength * sizeof(double) <= numNonzeros * (sizeof(double) + sizeof(uint32_t));
+
+        auto firstValue = _values.size();
+        if (isDense)
+        {
+            _values.resize(firstValue + prefixLength, 0.0);
+        }
+
+        while (copyIterator.IsValid())
+        {
+            auto indexValue = copyIterator.Get();
+            if (isDense)
+            {
+                _values[firstValue + indexValue.index] = indexValue.value;
+            }
+            else
+            {
+                _values.push_back(indexValue.value);
+                _indices.push_back(static_cast<uint32_t>(indexValue.index));
+            }
+            copyIterator.Next();
+        }
+
+        _valueOffsets.push_back(_values.size());
+        _indexOffsets.push_back(_indices.size());
+        _metadata.push_back(metadata);
+        _numFeatures = std::max(_numFeatures, prefixLength);
+    }
+
+    template <typename ExampleType>
+    ExampleType ArenaDataset::GetExample(size_t index) const
+    {
+        using DataVectorType = typename ExampleType::DataVectorType;
+        using MetadataType = typename ExampleType::MetadataType;
+        return ExampleType(std::make_shared<DataVectorType>(GetRowIterator(index)), MetadataType(_metadata[index]));
+    }
+
+    template <typename IteratorExampleType>
+    ExampleIterator<IteratorExampleType> ArenaDataset::GetExampleIterator(size_t fromIndex, size_t size) const
+    {
+        size_t endIndex = (size == 0 || fromIndex + size > NumExamples()) ? NumExamples() : fromIndex + size;
+        return ExampleIterator<IteratorExampleType>(std::make_unique<ArenaExampleIterator<IteratorExampleType>>(*this, fromIndex, endIndex));
+    }
+}
+}
@@ -71,12 +71,24 @@ namespace data
         return _pInternal->Dot(vector);
     }
 
+    template <typename DefaultDataVectorType>
+    float AutoDataVectorBase<DefaultDataVectorType>::Dot(const math::UnorientedConstVectorReference<float> vector) const
+    {
+        return _pInternal->Dot(vector);
+    }
+
     template <typename DefaultDataVectorType>
     void AutoDataVectorBase<DefaultDataVectorType>::AddTo(math::RowVectorReference<double> vector) const
     {
         _pInternal->AddTo(vector);
     }
 
+    template <typename DefaultDataVectorType>
+    void AutoDataVectorBase<DefaultDataVectorType>::AddTo(math::RowVectorReference<float> vector) const
+    {
+        _pInternal->AddTo(vector);
+    }
+
     template <typename DefaultDataVectorType>
     std::vector<double> AutoDataVectorBase<DefaultDataVectorType>::ToArray(size_t size) const
     {
@@ -90,10 +102,10 @@ namespace data
     }
 
     template <typename DefaultDataVectorType>
-    template <IterationPolicy policy, typename TransformationType>
-    void AutoDataVectorBase<DefaultDataVectorType>::AddTransformedTo(math::RowVectorReference<double> vector, TransformationType transformation) const
+    template <IterationPolicy policy, typename ElementType, typename TransformationType>
+    void AutoDataVectorBase<DefaultDataVectorType>::AddTransformedTo(math::RowVectorReference<ElementType> vector, TransformationType transformation) const
     {
-        _pInternal->AddTransformedTo<policy>(vector, transformation);
+        _pInternal->template AddTransformedTo<policy>(vector, transformation);
     }
 
     template <typename DefaultDataVectorType>
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BinaryDataset.tcc (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// stl
+#include <memory>
+#include <utility>
+
+namespace ell
+{
+namespace data
+{
+    template <typename IteratorExampleType>
+    class BinaryDataset::BinaryDatasetExampleIterator : public IExampleIterator<IteratorExampleType>
+    {
+    public:
+        BinaryDatasetExampleIterator(BinaryDataset dataset, size_t fromIndex, size_t endIndex)
+            : _dataset(std::move(dataset)), _current(fromIndex), _end(endIndex) {}
+
+        virtual bool IsValid() const override { return _current < _end; }
+
+        virtual void Next() override { ++_current; }
+
+        virtual IteratorExampleType Get() const override { return _dataset.GetExample<IteratorExampleType>(_current); }
+
+    private:
+        BinaryDataset _dataset;
+        size_t _current;
+        size_t _end;
+    };
+
+    template <typename ExampleType>
+    ExampleType BinaryDataset::GetExample(size_t index) const
+    {
+        using DataVectorType = typename ExampleType::DataVectorType;
+        using MetadataType = typename ExampleType::MetadataType;
+        return ExampleType(std::make_shared<DataVectorType>(GetRow(index).GetIterator<IterationPolicy::skipZeros>()), MetadataType(GetMetadata(index)));
+    }
+
+    template <typename IteratorExampleType>
+    ExampleIterator<IteratorExampleType> BinaryDataset::GetExampleIterator(size_t fromIndex, size_t size) const
+    {
+        size_t endIndex = (size == 0 || fromIndex + size > NumExamples()) ? NumExamples() : fromIndex + size;
+        return ExampleIterator<IteratorExampleType>(std::make_unique<BinaryDatasetExampleIterator<IteratorExampleType>>(*this, fromIndex, endIndex));
+    }
+}
+}
@@ -53,8 +53,8 @@ namespace data
         }
     }
 
-    template <IterationPolicy policy, typename TransformationType>
-    void IDataVector::AddTransformedTo(math::RowVectorReference<double> vector, TransformationType transformation) const
+    template <IterationPolicy policy, typename ElementType, typename TransformationType>
+    void IDataVector::AddTransformedTo(math::RowVectorReference<ElementType> vector, TransformationType transformation) const
     {
         InvokeWithThis<void>([vector, transformation](const auto* pThis)
         {
@@ -156,6 +156,31 @@ namespace data
 
     template <class DerivedType>
     double DataVectorBase<DerivedType>::Dot(const math::UnorientedConstVectorReference<double> vector) const
+    {
+        return DotImplementation(vector);
+    }
+
+    template <class DerivedType>
+    float DataVectorBase<DerivedType>::Dot(const math::UnorientedConstVectorReference<float> vector) const
+    {
+        return static_cast<float>(DotImplementation(vector));
+    }
+
+    template <class DerivedType>
+    void DataVectorBase<DerivedType>::AddTo(math::RowVectorReference<double> vector) const
+    {
+        AddToImplementation(vector);
+    }
+
+    template <class DerivedType>
+    void DataVectorBase<DerivedType>::AddTo(math::RowVectorReference<float> vector) const
+    {
+        AddToImplementation(vector);
+    }
+
+    template <class DerivedType>
+    template <typename ElementType>
+    double DataVectorBase<DerivedType>::DotImplementation(const math::UnorientedConstVectorReference<ElementType> vector) const
     {
         auto indexValueIterator = GetIterator<DerivedType, IterationPolicy::skipZeros>(*static_cast<const DerivedType*>(this));
 
@@ -175,7 +200,8 @@ namespace data
     }
 
     template <class DerivedType>
-    void DataVectorBase<DerivedType>::AddTo(math::RowVectorReference<double> vector) const
+    template <typename ElementType>
+    void DataVectorBase<DerivedType>::AddToImplementation(math::RowVectorReference<ElementType> vector) const
     {
         auto indexValueIterator = GetIterator<DerivedType, IterationPolicy::skipZeros>(*static_cast<const DerivedType*>(this));
 
@@ -187,7 +213,7 @@ namespace data
             {
                 return;
             }
-            vector[indexValue.index] += indexValue.value;
+            vector[indexValue.index] += static_cast<ElementType>(indexValue.value);
             indexValueIterator.Next();
         }
     }
@@ -213,8 +239,8 @@ namespace data
     }
 
     template <class DerivedType>
-    template <IterationPolicy policy, typename TransformationType>
-    void DataVectorBase<DerivedType>::AddTransformedTo(math::RowVectorReference<double> vector, TransformationType transformation) const
+    template <IterationPolicy policy, typename ElementType, typename TransformationType>
+    void DataVectorBase<DerivedType>::AddTransformedTo(math::RowVectorReference<ElementType> vector, TransformationType transformation) const
     {
         auto size = vector.Size();
         auto indexValueIterator = GetIterator<DerivedType, policy>(*static_cast<const DerivedType*>(this), size);
@@ -227,7 +253,7 @@ namespace data
                 return;
             }
             double result = transformation(indexValue);
-            vector[indexValue.index] += result;
+            vector[indexValue.index] += static_cast<ElementType>(result);
             indexValueIterator.Next();
         }
     }
@@ -272,10 +298,10 @@ namespace data
         }
     }
 
-    template <typename DataVectorType, IterationPolicy policy, typename TransformationType>
-    static void AddTransformedTo(const DataVectorType& dataVector, math::RowVectorReference<double> vector, TransformationType transformation)
+    template <typename DataVectorType, IterationPolicy policy, typename ElementType, typename TransformationType>
+    static void AddTransformedTo(const DataVectorType& dataVector, math::RowVectorReference<ElementType> vector, TransformationType transformation)
     {
-        return dataVector.template AddTransformedTo<policy, TransformationType>(vector, transformation);
+        return dataVector.template AddTransformedTo<policy, ElementType, TransformationType>(vector, transformation);
     }
 
     template <typename DataVectorType, IterationPolicy policy>
@@ -29,7 +29,11 @@ namespace data
         // all Dataset types for which GetAnyDataset() is called must be listed below, in the variadic template argument.
         using Invoker = utilities::AbstractInvoker<DatasetBase,
             Dataset<data::AutoSupervisedExample>,
-            Dataset<data::DenseSupervisedExample>>;
+            Dataset<data::DenseSupervisedExample>,
+            ArenaDataset,
+            BinaryDataset,
+            QuantizedDataset<uint8_t>,
+            QuantizedDataset<uint16_t>>;
 
         return Invoker::Invoke<ExampleIterator<ExampleType>>(getExampleIterator, _pDataset);
     }
@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     DatasetView.tcc (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// utilities
+#include "Exception.h"
+
+// stl
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+namespace ell
+{
+namespace data
+{
+    //
+    // ExampleReference
+    //
+
+    template <typename DataVectorType, typename MetadataType>
+    DatasetView<DataVectorType, MetadataType>::ExampleReference::ExampleReference(const DataVectorType& dataVector, const MetadataType& metadata)
+        : _dataVector(&dataVector), _metadata(&metadata)
+    {
+    }
+
+    template <typename DataVectorType, typename MetadataType>
+    void DatasetView<DataVectorType, MetadataType>::ExampleReference::Print(std::ostream& os) const
+    {
+        _metadata->Print(os);
+        os << "\t";
+        _dataVector->Print(os);
+    }
+
+    //
+    // Iterator
+    //
+
+    template <typename DataVectorType, typename MetadataType>
+    DatasetView<DataVectorType, MetadataType>::Iterator::Iterator(const DatasetView& view, size_t fromIndex, size_t size)
+        : _view(view), _current(fromIndex), _end(fromIndex + size)
+    {
+    }
+
+    //
+    // DatasetView
+    //
+
+    template <typename DataVectorType, typename MetadataType>
+    DatasetView<DataVectorType, MetadataType>::DatasetView(const AnyDataset& anyDataset)
+    {
+        auto numExamples = anyDataset.NumExamples();
+        _dataVectors.reserve(numExamples);
+        _metadata.reserve(numExamples);
+
+        // the iterator makes a shallow copy of each data vector if its type matches DataVectorType, and a deep copy otherwise
+        auto exampleIterator = anyDataset.GetExampleIterator<Example<DataVectorType, WeightLabel>>();
+        while (exampleIterator.IsValid())
+        {
+            auto example = exampleIterator.Get();
+            auto numFeatures = example.GetDataVector().PrefixLength();
+            if (_numFeatures < numFeatures)
+            {
+                _numFeatures = numFeatures;
+            }
+
+            _dataVectors.push_back(example.GetSharedDataVector());
+            _metadata.emplace_back(example.GetMetadata());
+            exampleIterator.Next();
+        }
+    }
+
+    template <typename DataVectorType, typename MetadataType>
+    auto DatasetView<DataVectorType, MetadataType>::operator[](size_t index) const -> ExampleReference
+    {
+        return ExampleReference(*_dataVectors[index], _metadata[index]);
+    }
+
+    template <typename DataVectorType, typename MetadataType>
+    auto DatasetView<DataVectorType, MetadataType>::GetExampleIterator(size_t fromIndex, size_t size) const -> Iterator
+    {
+        size = CorrectRangeSize(fromIndex, size);
+        return Iterator(*this, fromIndex, size);
+    }
+
+    template <typename DataVectorType, typename MetadataType>
+    void DatasetView<DataVectorType, MetadataType>::RandomPermute(std::default_random_engine& rng, size_t prefixSize)
+    {
+        prefixSize = CorrectRangeSize(0, prefixSize);
+        for (size_t i = 0; i < prefixSize; ++i)
+        {
+            RandomSwap(rng, i, i, NumExamples() - i);
+        }
+    }
+
+    template <typename DataVectorType, typename MetadataType>
+    void DatasetView<DataVectorType, MetadataType>::RandomPermute(std::default_random_engine& rng, size_t rangeFirstIndex, size_t rangeSize, size_t prefixSize)
+    {
+        rangeSize = CorrectRangeSize(rangeFirstIndex, rangeSize);
+
+        if (prefixSize > rangeSize || prefixSize == 0)
+        {
+            prefixSize = rangeSize;
+        }
+
+        for (size_t s = 0; s < prefixSize; ++s)
+        {
+            size_t index = rangeFirstIndex + s;
+            RandomSwap(rng, index, index, rangeSize - s);
+        }
+    }
+
+    template <typename DataVectorType, typename MetadataType>
+    void DatasetView<DataVectorType, MetadataType>::RandomSwap(std::default_random_engine& rng, size_t targetExampleIndex, size_t rangeFirstIndex, size_t rangeSize)
+    {
+        rangeSize = CorrectRangeSize(rangeFirstIndex, rangeSize);
+        if (targetExampleIndex > NumExamples())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange);
+        }
+
+        std::uniform_int_distribution<size_t> dist(rangeFirstIndex, rangeFirstIndex + rangeSize - 1);
+        size_t j = dist(rng);
+        SwapExamples(targetExampleIndex, j);
+    }
+
+    template <typename DataVectorType, typename MetadataType>
+    template <typename SortKeyType>
+    void DatasetView<DataVectorType, MetadataType>::Sort(SortKeyType sortKey, size_t fromIndex, size_t size)
+    {
+        size = CorrectRangeSize(fromIndex, size);
+
+        std::vector<size_t> permutation(size);
+        std::iota(permutation.begin(), permutation.end(), fromIndex);
+        std::sort(permutation.begin(),
+                  permutation.end(),
+                  [&](size_t a, size_t b) -> bool {
+                      return sortKey((*this)[a]) < sortKey((*this)[b]);
+                  });
+
+        ApplyPermutation(permutation, fromIndex);
+    }
+
+    template <typename DataVectorType, typename MetadataType>
+    template <typename PartitionKeyType>
+    void DatasetView<DataVectorType, MetadataType>::Partition(PartitionKeyType partitionKey, size_t fromIndex, size_t size)
+    {
+        size = CorrectRangeSize(fromIndex, size);
+
+        std::vector<size_t> permutation(size);
+        std::iota(permutation.begin(), permutation.end(), fromIndex);
+        std::partition(permutation.begin(), permutation.end(), [&](size_t index) { return partitionKey((*this)[index]); });
+
+        ApplyPermutation(permutation, fromIndex);
+    }
+
+    template <typename DataVectorType, typename MetadataType>
+    void DatasetView<DataVectorType, MetadataType>::Print(std::ostream& os, size_t tabs, size_t fromIndex, size_t size) const
+    {
+        size = CorrectRangeSize(fromIndex, size);
+
+        for (size_t index = fromIndex; index < fromIndex + size; ++index)
+        {
+            os << std::string(tabs * 4, ' ');
+            (*this)[index].Print(os);
+            os << "\n";
+        }
+    }
+
+    template <typename DataVectorType, typename MetadataType>
+    size_t DatasetView<DataVectorType, MetadataType>::CorrectRangeSize(size_t fromIndex, size_t size) const
+    {
+        if (size == 0 || fromIndex + size > NumExamples())
+        {
+            return NumExamples() - fromIndex;
+        }
+        return size;
+    }
+
+    template <typename DataVectorType, typename MetadataType>
+    void DatasetView<DataVectorType, MetadataType>::SwapExamples(size_t index1, size_t index2)
+    {
+        using std::swap;
+        swap(_dataVectors[index1], _dataVectors[index2]);
+        swap(_metadata[index1], _metadata[index2]);
+    }
+
+    template <typename DataVectorType, typename MetadataType>
+    void DatasetView<DataVectorType, MetadataType>::ApplyPermutation(const std::vector<size_t>& permutation, size_t fromIndex)
+    {
+        // permutation[i] is the index of the example that should move to position fromIndex + i
+        std::vector<std::shared_ptr<const DataVectorType>> dataVectors;
+        std::vector<MetadataType> metadata;
+        dataVectors.reserve(permutation.size());
+        metadata.reserve(permutation.size());
+        for (auto index : permutation)
+        {
+            dataVectors.push_back(std::move(_dataVectors[index]));
+            metadata.push_back(std::move(_metadata[index]));
+        }
+
+        std::move(dataVectors.begin(), dataVectors.end(), _dataVectors.begin() + fromIndex);
+        std::move(metadata.begin(), metadata.end(), _metadata.begin() + fromIndex);
+    }
+}
+}
@@ -9,6 +9,7 @@
 #include "Exception.h"
 
 // stl
+#include <algorithm>
 #include <cassert>
 
 namespace ell
@@ -97,5 +98,97 @@ namespace data
         _data[index] = storedValue;
         ++_numNonzeros;
     }
+
+    template <typename ElementType>
+    double DenseDataVector<ElementType>::Dot(const math::UnorientedConstVectorReference<double> vector) const
+    {
+        return DotImplementation(vector);
+    }
+
+    template <typename ElementType>
+    float DenseDataVector<ElementType>::Dot(const math::UnorientedConstVectorReference<float> vector) const
+    {
+        return static_cast<float>(DotImplementation(vector));
+    }
+
+    template <typename ElementType>
+    void DenseDataVector<ElementType>::AddTo(math::RowVectorReference<double> vector) const
+    {
+        AddToImplementation(vector);
+    }
+
+    template <typename ElementType>
+    void DenseDataVector<ElementType>::AddTo(math::RowVectorReference<float> vector) const
+    {
+        AddToImplementation(vector);
+    }
+
+    template <typename ElementType>
+    template <typename VectorElementType>
+    double DenseDataVector<ElementType>::DotImplementation(const math::UnorientedConstVectorReference<VectorElementType> vector) const
+    {
+        const size_t numLanes = 8;
+
+        auto size = std::min(_data.size(), vector.Size());
+        const ElementType* data = _data.data();
+        const VectorElementType* pVector = vector.GetDataPointer();
+        auto increment = vector.GetIncrement();
+
+        if (increment != 1)
+        {
+            double result = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                result += static_cast<double>(data[i]) * static_cast<double>(pVector[i * increment]);
+            }
+            return result;
+        }
+
+        // independent partial sums break the dependency chain between consecutive additions
+        double partialSums[numLanes] = { 0 };
+        size_t i = 0;
+        for (; i + numLanes <= size; i += numLanes)
+        {
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                partialSums[lane] += static_cast<double>(data[i + lane]) * static_cast<double>(pVector[i + lane]);
+            }
+        }
+        for (; i < size; ++i)
+        {
+            partialSums[0] += static_cast<double>(data[i]) * static_cast<double>(pVector[i]);
+        }
+
+        double result = 0;
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            result += partialSums[lane];
+        }
+        return result;
+    }
+
+    template <typename ElementType>
+    template <typename VectorElementType>
+    void DenseDataVector<ElementType>::AddToImplementation(math::RowVectorReference<VectorElementType> vector) const
+    {
+        auto size = std::min(_data.size(), vector.Size());
+        const ElementType* data = _data.data();
+        VectorElementType* pVector = vector.GetDataPointer();
+        auto increment = vector.GetIncrement();
+
+        if (increment != 1)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                pVector[i * increment] += static_cast<VectorElementType>(data[i]);
+            }
+            return;
+        }
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            pVector[i] += static_cast<VectorElementType>(data[i]);
+        }
+    }
 }
 }
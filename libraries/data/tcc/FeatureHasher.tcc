@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FeatureHasher.tcc (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// stl
+#include <algorithm>
+
+namespace ell
+{
+namespace data
+{
+    template <typename IndexValueIteratorType, IsIndexValueIterator<IndexValueIteratorType> Concept>
+    std::vector<IndexValue> FeatureHasher::Hash(IndexValueIteratorType indexValueIterator) const
+    {
+        std::vector<IndexValue> hashed;
+        while (indexValueIterator.IsValid())
+        {
+            auto indexValue = indexValueIterator.Get();
+            auto hash = Mix(indexValue.index);
+            double sign = (hash >> 63) ? -1.0 : 1.0;
+            hashed.push_back({ static_cast<size_t>(hash & _mask), sign * indexValue.value });
+            indexValueIterator.Next();
+        }
+
+        std::sort(hashed.begin(), hashed.end(), [](const IndexValue& a, const IndexValue& b) { return a.index < b.index; });
+
+        // sum the values of entries that collide in the same bucket
+        size_t size = 0;
+        for (const auto& entry : hashed)
+        {
+            if (size > 0 && hashed[size - 1].index == entry.index)
+            {
+                hashed[size - 1].value += entry.value;
+            }
+            else
+            {
+                hashed[size++] = entry;
+            }
+        }
+        hashed.resize(size);
+
+        return hashed;
+    }
+
+    template <typename IndexValueParsingIterator>
+    HashingAutoDataVectorParser<IndexValueParsingIterator>::HashingAutoDataVectorParser(FeatureHasher hasher)
+        : _hasher(hasher)
+    {
+    }
+
+    template <typename IndexValueParsingIterator>
+    AutoDataVector HashingAutoDataVectorParser<IndexValueParsingIterator>::Parse(TextLine& textLine) const
+    {
+        return AutoDataVector(_hasher.Hash(IndexValueParsingIterator(textLine)));
+    }
+}
+}
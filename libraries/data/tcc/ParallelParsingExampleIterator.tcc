@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ParallelParsingExampleIterator.tcc (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TextLine.h"
+
+// stl
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace ell
+{
+namespace data
+{
+    template <typename MetadataParserType, typename DataVectorParserType>
+    ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>::ParallelParsingExampleIterator(std::istream& stream, MetadataParserType metadataParser, DataVectorParserType dataVectorParser, const ParallelParsingParameters& parameters)
+        : _stream(stream), _metadataParser(std::move(metadataParser)), _dataVectorParser(std::move(dataVectorParser)), _chunkSize(std::max(parameters.chunkSize, size_t(1))), _preserveOrder(parameters.preserveOrder)
+    {
+        size_t numThreads = parameters.numThreads == 0 ? std::thread::hardware_concurrency() : parameters.numThreads;
+        if (numThreads == 0) // if std::thread::hardware_concurrency isn't implemented
+        {
+            numThreads = 1;
+        }
+
+        // keep a second chunk per thread in flight, so that workers stay busy while examples are consumed
+        _maxTasks = 2 * numThreads;
+        ReadBlock();
+    }
+
+    template <typename MetadataParserType, typename DataVectorParserType>
+    void ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>::Next()
+    {
+        ++_currentIndex;
+        if (_currentIndex >= _currentBlock.size())
+        {
+            ReadBlock();
+        }
+    }
+
+    template <typename MetadataParserType, typename DataVectorParserType>
+    auto ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>::ParseChunk(std::string chunk, MetadataParserType metadataParser, DataVectorParserType dataVectorParser) -> ExampleBlock
+    {
+        // terminate each line, so that the TextLines can view the lines without copying them
+        std::replace(chunk.begin(), chunk.end(), '\n', '\0');
+        auto buffer = std::make_shared<const std::string>(std::move(chunk));
+
+        ExampleBlock examples;
+        size_t lineBegin = 0;
+        while (lineBegin < buffer->size())
+        {
+            auto lineEnd = std::min(buffer->find('\0', lineBegin), buffer->size());
+
+            // skip lines that contain just whitespace or just a comment
+            TextLine line(buffer, lineBegin, lineEnd - lineBegin);
+            line.TrimLeadingWhitespace();
+            if (!line.IsEndOfContent())
+            {
+                auto metaData = metadataParser.Parse(line);
+                auto dataVector = dataVectorParser.Parse(line);
+                examples.emplace_back(std::move(dataVector), std::move(metaData));
+            }
+
+            lineBegin = lineEnd + 1;
+        }
+        return examples;
+    }
+
+    template <typename MetadataParserType, typename DataVectorParserType>
+    std::string ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>::ReadChunk()
+    {
+        std::string chunk(_chunkSize, '\0');
+        _stream.read(&chunk[0], _chunkSize);
+        chunk.resize(static_cast<size_t>(_stream.gcount()));
+
+        // extend the chunk to the end of the line, so that no line is split between two chunks
+        if (_stream && chunk.back() != '\n')
+        {
+            std::string remainder;
+            std::getline(_stream, remainder);
+            chunk += remainder;
+        }
+        return chunk;
+    }
+
+    template <typename MetadataParserType, typename DataVectorParserType>
+    void ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>::LaunchTasks()
+    {
+        while (_futures.size() < _maxTasks && _stream)
+        {
+            auto chunk = ReadChunk();
+            if (chunk.empty())
+            {
+                break;
+            }
+            _futures.push_back(std::async(std::launch::async, &ParseChunk, std::move(chunk), _metadataParser, _dataVectorParser));
+        }
+    }
+
+    template <typename MetadataParserType, typename DataVectorParserType>
+    void ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>::ReadBlock()
+    {
+        _currentBlock.clear();
+        _currentIndex = 0;
+
+        // a chunk may contain only comments, so keep reading until a nonempty block is found
+        while (_currentBlock.empty())
+        {
+            LaunchTasks();
+            if (_futures.empty())
+            {
+                return;
+            }
+
+            auto position = _futures.begin();
+            if (!_preserveOrder)
+            {
+                auto isReady = [](const std::future<ExampleBlock>& future) { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; };
+                position = std::find_if(_futures.begin(), _futures.end(), isReady);
+                if (position == _futures.end())
+                {
+                    position = _futures.begin();
+                }
+            }
+
+            _currentBlock = position->get();
+            _futures.erase(position);
+        }
+    }
+
+    template <typename MetadataParserType, typename DataVectorParserType>
+    ExampleIterator<AutoSupervisedExample> MakeParallelParsingExampleIterator(std::istream& stream, MetadataParserType metadataParser, DataVectorParserType dataVectorParser, const ParallelParsingParameters& parameters)
+    {
+        using IteratorType = ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>;
+        auto iterator = std::make_unique<IteratorType>(stream, std::move(metadataParser), std::move(dataVectorParser), parameters);
+        return ExampleIterator<AutoSupervisedExample>(std::move(iterator));
+    }
+}
+}
@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PrefetchingExampleIterator.tcc (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// stl
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace ell
+{
+namespace data
+{
+    template <typename ExampleType>
+    PrefetchingExampleIterator<ExampleType>::PrefetchingExampleIterator(ExampleIterator<ExampleType> sourceIterator, const PrefetchingParameters& parameters)
+        : _sourceIterator(std::move(sourceIterator)), _batchSize(std::max(parameters.batchSize, size_t(1))), _producer([this](ExampleBatch& batch) { return ReadBatch(batch); }, parameters.maxQueuedBatches)
+    {
+        WaitForBatch();
+    }
+
+    template <typename ExampleType>
+    void PrefetchingExampleIterator<ExampleType>::Next()
+    {
+        ++_currentIndex;
+        if (_currentIndex >= _currentBatch.size())
+        {
+            WaitForBatch();
+        }
+    }
+
+    template <typename ExampleType>
+    void PrefetchingExampleIterator<ExampleType>::WaitForBatch()
+    {
+        _currentIndex = 0;
+        _currentBatch.clear();
+        _producer.Take(_currentBatch);
+    }
+
+    template <typename ExampleType>
+    bool PrefetchingExampleIterator<ExampleType>::ReadBatch(ExampleBatch& batch)
+    {
+        // runs on the background thread, which reads and parses the examples
+        batch.reserve(_batchSize);
+        while (batch.size() < _batchSize && _sourceIterator.IsValid())
+        {
+            batch.push_back(_sourceIterator.Get());
+            _sourceIterator.Next();
+        }
+        return _sourceIterator.IsValid();
+    }
+
+    template <typename ExampleType>
+    ExampleIterator<ExampleType> MakePrefetchingExampleIterator(ExampleIterator<ExampleType> sourceIterator, const PrefetchingParameters& parameters)
+    {
+        return ExampleIterator<ExampleType>(std::make_unique<PrefetchingExampleIterator<ExampleType>>(std::move(sourceIterator), parameters));
+    }
+}
+}
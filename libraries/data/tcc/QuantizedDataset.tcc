@@ -0,0 +1,343 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedDataset.tcc (data)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// utilities
+#include "Exception.h"
+
+// stl
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace ell
+{
+namespace data
+{
+    template <typename QuantizedType>
+    QuantizedDataset<QuantizedType>::RowIterator::RowIterator(const QuantizedDataset<QuantizedType>& dataset, const uint32_t* indices, const QuantizedType* codes, size_t size, size_t end)
+        : _dataset(dataset), _indices(indices), _codes(codes), _size(size), _end(end)
+    {
+        SkipZeros();
+    }
+
+    template <typename QuantizedType>
+    void QuantizedDataset<QuantizedType>::RowIterator::Next()
+    {
+        ++_current;
+        SkipZeros();
+    }
+
+    template <typename QuantizedType>
+    IndexValue QuantizedDataset<QuantizedType>::RowIterator::Get() const
+    {
+        auto index = GetIndex();
+        return IndexValue{ index, _dataset.Dequantize(index, _codes[_current]) };
+    }
+
+    template <typename QuantizedType>
+    void QuantizedDataset<QuantizedType>::RowIterator::SkipZeros()
+    {
+        // a code equal to the zero point of its feature represents zero exactly
+        while (_current < _size && _dataset.Dequantize(GetIndex(), _codes[_current]) == 0.0)
+        {
+            ++_current;
+        }
+    }
+
+    template <typename QuantizedType>
+    QuantizedDataset<QuantizedType>::DenseRowIterator::DenseRowIterator(const QuantizedDataset<QuantizedType>& dataset, const uint32_t* indices, const QuantizedType* codes, size_t size, size_t end)
+        : _dataset(dataset), _indices(indices), _codes(codes), _size(size), _end(end)
+    {
+    }
+
+    template <typename QuantizedType>
+    void QuantizedDataset<QuantizedType>::DenseRowIterator::Next()
+    {
+        ++_index;
+        if (_indices != nullptr && _current < _size && _indices[_current] < _index)
+        {
+            ++_current;
+        }
+    }
+
+    template <typename QuantizedType>
+    IndexValue QuantizedDataset<QuantizedType>::DenseRowIterator::Get() const
+    {
+        if (_indices == nullptr)
+        {
+            return IndexValue{ _index, _index < _size ? _dataset.Dequantize(_index, _codes[_index]) : 0.0 };
+        }
+        return IndexValue{ _index, (_current < _size && _indices[_current] == _index) ? _dataset.Dequantize(_index, _codes[_current]) : 0.0 };
+    }
+
+    template <typename QuantizedType>
+    QuantizedDataset<QuantizedType>::Row::Row(const QuantizedDataset<QuantizedType>& dataset, size_t index)
+        : _dataset(dataset), _index(index)
+    {
+    }
+
+    template <typename QuantizedType>
+    void QuantizedDataset<QuantizedType>::Row::AppendElement(size_t index, double value)
+    {
+        throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "QuantizedDataset rows are read-only");
+    }
+
+    template <typename QuantizedType>
+    size_t QuantizedDataset<QuantizedType>::Row::PrefixLength() const
+    {
+        auto numCodes = _dataset._codeOffsets[_index + 1] - _dataset._codeOffsets[_index];
+        if (_dataset.IsDenseRow(_index))
+        {
+            return numCodes;
+        }
+        return numCodes == 0 ? 0 : _dataset._indices[_dataset._indexOffsets[_index] + numCodes - 1] + 1;
+    }
+
+    template <typename QuantizedType>
+    template <IterationPolicy policy>
+    auto QuantizedDataset<QuantizedType>::Row::GetIterator(size_t size) const -> Iterator<policy>
+    {
+        auto numCodes = _dataset._codeOffsets[_index + 1] - _dataset._codeOffsets[_index];
+        return Iterator<policy>(_dataset, _dataset.GetRowIndices(_index), _dataset._codes.data() + _dataset._codeOffsets[_index], numCodes, size);
+    }
+
+    template <typename QuantizedType>
+    QuantizedDataset<QuantizedType>::QuantizedDataset(const std::vector<double>& minValues, const std::vector<double>& maxValues)
+    {
+        SetFeatureRanges(minValues, maxValues);
+    }
+
+    template <typename QuantizedType>
+    QuantizedDataset<QuantizedType>::QuantizedDataset(const AnyDataset& dataset)
+    {
+        std::vector<double> minValues;
+        std::vector<double> maxValues;
+        auto rangeIterator = dataset.GetExampleIterator<AutoSupervisedExample>();
+        while (rangeIterator.IsValid())
+        {
+            auto dataVector = rangeIterator.Get().GetDataVector().template CopyAs<SparseDoubleDataVector>();
+            auto indexValueIterator = dataVector.template GetIterator<IterationPolicy::skipZeros>();
+            while (indexValueIterator.IsValid())
+            {
+                auto indexValue = indexValueIterator.Get();
+                if (indexValue.index >= minValues.size())
+                {
+                    minValues.resize(indexValue.index + 1, 0.0);
+                    maxValues.resize(indexValue.index + 1, 0.0);
+                }
+                minValues[indexValue.index] = std::min(minValues[indexValue.index], indexValue.value);
+                maxValues[indexValue.index] = std::max(maxValues[indexValue.index], indexValue.value);
+                indexValueIterator.Next();
+            }
+            rangeIterator.Next();
+        }
+        SetFeatureRanges(minValues, maxValues);
+
+        auto exampleIterator = dataset.GetExampleIterator<AutoSupervisedExample>();
+        while (exampleIterator.IsValid())
+        {
+            AddExample(exampleIterator.Get());
+            exampleIterator.Next();
+        }
+    }
+
+    template <typename QuantizedType>
+    void QuantizedDataset<QuantizedType>::SetFeatureRanges(const std::vector<double>& minValues, const std::vector<double>& maxValues)
+    {
+        static_assert(std::is_unsigned<QuantizedType>::value && std::is_integral<QuantizedType>::value, "QuantizedDataset requires an unsigned integral code type");
+
+        if (minValues.size() != maxValues.size())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "feature ranges must have the same number of minimum and maximum values");
+        }
+
+        const double numLevels = static_cast<double>(std::numeric_limits<QuantizedType>::max());
+        _scales.resize(minValues.size());
+        _zeroPoints.resize(minValues.size());
+        for (size_t feature = 0; feature < minValues.size(); ++feature)
+        {
+            // the range always includes zero, so that zero has an exact code
+            auto minValue = std::min(minValues[feature], 0.0);
+            auto maxValue = std::max(maxValues[feature], 0.0);
+            _scales[feature] = (maxValue - minValue) / numLevels;
+            _zeroPoints[feature] = _scales[feature] == 0.0 ? 0.0 : std::round(-minValue / _scales[feature]);
+        }
+    }
+
+    template <typename QuantizedType>
+    QuantizedType QuantizedDataset<QuantizedType>::Quantize(size_t feature, double value) const
+    {
+        if (_scales[feature] == 0.0)
+        {
+            return static_cast<QuantizedType>(_zeroPoints[feature]);
+        }
+
+        const double numLevels = static_cast<double>(std::numeric_limits<QuantizedType>::max());
+        auto code = std::round(value / _scales[feature] + _zeroPoints[feature]);
+        return static_cast<QuantizedType>(std::min(std::max(code, 0.0), numLevels));
+    }
+
+    template <typename QuantizedType>
+    void QuantizedDataset<QuantizedType>::AddRow(const SparseDoubleDataVector& dataVector, const WeightLabel& metadata)
+    {
+        auto prefixLength = dataVector.PrefixLength();
+        if (prefixLength > NumFeatures())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "example has a feature without a learned range");
+        }
+
+        // count the nonzeros to choose the smaller of the dense and sparse layouts
+        size_t numNonzeros = 0;
+        auto countIterator = dataVector.GetIterator<IterationPolicy::skipZeros>();
+        while (countIterator.IsValid())
+        {
+            ++numNonzeros;
+            countIterator.Next();
+        }
+        bool isDense = prefixLength * sizeof(QuantizedType) <= numNonzeros * (sizeof(QuantizedType) + sizeof(uint32_t));
+
+        auto firstCode = _codes.size();
+        if (isDense)
+        {
+            _codes.resize(firstCode + prefixLength);
+            for (size_t feature = 0; feature < prefixLength; ++feature)
+            {
+                _codes[firstCode + feature] = static_cast<QuantizedType>(_zeroPoints[feature]);
+            }
+        }
+
+        auto copyIterator = dataVector.GetIterator<IterationPolicy::skipZeros>();
+        while (copyIterator.IsValid())
+        {
+            auto indexValue = copyIterator.Get();
+            auto code = Quantize(indexValue.index, indexValue.value);
+            if (isDense)
+            {
+                _codes[firstCode + indexValue.index] = code;
+            }
+            else
+            {
+                _codes.push_back(code);
+                _indices.push_back(static_cast<uint32_t>(indexValue.index));
+            }
+            copyIterator.Next();
+        }
+
+        _codeOffsets.push_back(_codes.size());
+        _indexOffsets.push_back(_indices.size());
+        _metadata.push_back(metadata);
+    }
+
+    template <typename QuantizedType>
+    auto QuantizedDataset<QuantizedType>::GetRow(size_t index) const -> Row
+    {
+        if (index >= NumExamples())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "example index exceeds dataset size");
+        }
+        return Row(*this, index);
+    }
+
+    template <typename QuantizedType>
+    double QuantizedDataset<QuantizedType>::Dot(size_t index, math::UnorientedConstVectorReference<double> vector) const
+    {
+        if (index >= NumExamples())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "example index exceeds dataset size");
+        }
+
+        const QuantizedType* codes = _codes.data() + _codeOffsets[index];
+        auto numCodes = _codeOffsets[index + 1] - _codeOffsets[index];
+        double result = 0.0;
+        if (IsDenseRow(index))
+        {
+            auto size = std::min(numCodes, vector.Size());
+            for (size_t feature = 0; feature < size; ++feature)
+            {
+                result += vector[feature] * Dequantize(feature, codes[feature]);
+            }
+        }
+        else
+        {
+            const uint32_t* indices = GetRowIndices(index);
+            auto size = vector.Size();
+            for (size_t i = 0; i < numCodes && indices[i] < size; ++i)
+            {
+                result += vector[indices[i]] * Dequantize(indices[i], codes[i]);
+            }
+        }
+        return result;
+    }
+
+    template <typename QuantizedType>
+    void QuantizedDataset<QuantizedType>::AddTo(size_t index, math::RowVectorReference<double> vector, double scalar) const
+    {
+        if (index >= NumExamples())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "example index exceeds dataset size");
+        }
+
+        const QuantizedType* codes = _codes.data() + _codeOffsets[index];
+        auto numCodes = _codeOffsets[index + 1] - _codeOffsets[index];
+        if (IsDenseRow(index))
+        {
+            auto size = std::min(numCodes, vector.Size());
+            for (size_t feature = 0; feature < size; ++feature)
+            {
+                vector[feature] += scalar * Dequantize(feature, codes[feature]);
+            }
+        }
+        else
+        {
+            const uint32_t* indices = GetRowIndices(index);
+            auto size = vector.Size();
+            for (size_t i = 0; i < numCodes && indices[i] < size; ++i)
+            {
+                vector[indices[i]] += scalar * Dequantize(indices[i], codes[i]);
+            }
+        }
+    }
+
+    template <typename QuantizedType>
+    template <typename ExampleType>
+    ExampleType QuantizedDataset<QuantizedType>::GetExample(size_t index) const
+    {
+        using DataVectorType = typename ExampleType::DataVectorType;
+        using MetadataType = typename ExampleType::MetadataType;
+        return ExampleType(std::make_shared<DataVectorType>(GetRowIterator(index)), MetadataType(_metadata[index]));
+    }
+
+    template <typename QuantizedType>
+    template <typename IteratorExampleType>
+    ExampleIterator<IteratorExampleType> QuantizedDataset<QuantizedType>::GetExampleIterator(size_t fromIndex, size_t size) const
+    {
+        size_t endIndex = (size == 0 || fromIndex + size > NumExamples()) ? NumExamples() : fromIndex + size;
+        return ExampleIterator<IteratorExampleType>(std::make_unique<QuantizedExampleIterator<IteratorExampleType>>(*this, fromIndex, endIndex));
+    }
+
+    template <typename QuantizedType>
+    void QuantizedDataset<QuantizedType>::Print(std::ostream& os) const
+    {
+        for (size_t index = 0; index < NumExamples(); ++index)
+        {
+            _metadata[index].Print(os);
+            os << "\t";
+            auto iterator = GetRowIterator(index);
+            while (iterator.IsValid())
+            {
+                auto indexValue = iterator.Get();
+                os << indexValue.index << ":" << indexValue.value << '\t';
+                iterator.Next();
+            }
+            os << '\n';
+        }
+    }
+}
+}
@@ -119,35 +119,88 @@ namespace data
 
     template <typename IndexListType>
     double SparseBinaryDataVectorBase<IndexListType>::Dot(const math::UnorientedConstVectorReference<double> vector) const
+    {
+        return DotImplementation(vector);
+    }
+
+    template <typename IndexListType>
+    float SparseBinaryDataVectorBase<IndexListType>::Dot(const math::UnorientedConstVectorReference<float> vector) const
+    {
+        return static_cast<float>(DotImplementation(vector));
+    }
+
+    template <typename IndexListType>
+    void SparseBinaryDataVectorBase<IndexListType>::AddTo(math::RowVectorReference<double> vector) const
+    {
+        AddToImplementation(vector);
+    }
+
+    template <typename IndexListType>
+    void SparseBinaryDataVectorBase<IndexListType>::AddTo(math::RowVectorReference<float> vector) const
+    {
+        AddToImplementation(vector);
+    }
+
+    template <typename IndexListType>
+    template <typename ElementType>
+    double SparseBinaryDataVectorBase<IndexListType>::DotImplementation(const math::UnorientedConstVectorReference<ElementType> vector) const
     {
         double value = 0.0;
+        auto size = vector.Size();
 
+        // gather from the vector one decoded block of indices at a time
         auto iter = _indexList.GetIterator();
         while (iter.IsValid())
         {
-            value += vector[iter.Get()];
-            iter.Next();
+            const size_t* indices = iter.GetBlock();
+            auto blockSize = iter.GetBlockSize();
+
+            // the indices are increasing, so only the last block that overlaps the vector needs to check them
+            if (indices[blockSize - 1] >= size)
+            {
+                for (size_t i = 0; i < blockSize && indices[i] < size; ++i)
+                {
+                    value += vector[indices[i]];
+                }
+                break;
+            }
+
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                value += vector[indices[i]];
+            }
+            iter.NextBlock();
         }
 
         return value;
     }
 
     template <typename IndexListType>
-    void SparseBinaryDataVectorBase<IndexListType>::AddTo(math::RowVectorReference<double> vector) const
+    template <typename ElementType>
+    void SparseBinaryDataVectorBase<IndexListType>::AddToImplementation(math::RowVectorReference<ElementType> vector) const
     {
         auto iter = _indexList.GetIterator();
         auto size = vector.Size();
 
         while (iter.IsValid())
         {
-            auto index = iter.Get();
-            if (index >= size)
+            const size_t* indices = iter.GetBlock();
+            auto blockSize = iter.GetBlockSize();
+
+            if (indices[blockSize - 1] >= size)
             {
+                for (size_t i = 0; i < blockSize && indices[i] < size; ++i)
+                {
+                    vector[indices[i]] += static_cast<ElementType>(1);
+                }
                 return;
             }
 
-            vector[index] += 1.0;
-            iter.Next();
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                vector[indices[i]] += static_cast<ElementType>(1);
+            }
+            iter.NextBlock();
         }
     }
 }
@@ -148,5 +148,94 @@ namespace data
             return _indexList.Max() + 1;
         }
     }
+
+    template <typename ElementType, typename IndexListType>
+    double SparseDataVector<ElementType, IndexListType>::Dot(const math::UnorientedConstVectorReference<double> vector) const
+    {
+        return DotImplementation(vector);
+    }
+
+    template <typename ElementType, typename IndexListType>
+    float SparseDataVector<ElementType, IndexListType>::Dot(const math::UnorientedConstVectorReference<float> vector) const
+    {
+        return static_cast<float>(DotImplementation(vector));
+    }
+
+    template <typename ElementType, typename IndexListType>
+    void SparseDataVector<ElementType, IndexListType>::AddTo(math::RowVectorReference<double> vector) const
+    {
+        AddToImplementation(vector);
+    }
+
+    template <typename ElementType, typename IndexListType>
+    void SparseDataVector<ElementType, IndexListType>::AddTo(math::RowVectorReference<float> vector) const
+    {
+        AddToImplementation(vector);
+    }
+
+    template <typename ElementType, typename IndexListType>
+    template <typename VectorElementType>
+    double SparseDataVector<ElementType, IndexListType>::DotImplementation(const math::UnorientedConstVectorReference<VectorElementType> vector) const
+    {
+        double result = 0.0;
+        auto size = vector.Size();
+        const ElementType* values = _values.data();
+
+        auto indexIterator = _indexList.GetIterator();
+        while (indexIterator.IsValid())
+        {
+            const size_t* indices = indexIterator.GetBlock();
+            auto blockSize = indexIterator.GetBlockSize();
+
+            // the indices are increasing, so only the last block that overlaps the vector needs to check them
+            if (indices[blockSize - 1] >= size)
+            {
+                for (size_t i = 0; i < blockSize && indices[i] < size; ++i)
+                {
+                    result += static_cast<double>(values[i]) * vector[indices[i]];
+                }
+                break;
+            }
+
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                result += static_cast<double>(values[i]) * vector[indices[i]];
+            }
+            values += blockSize;
+            indexIterator.NextBlock();
+        }
+        return result;
+    }
+
+    template <typename ElementType, typename IndexListType>
+    template <typename VectorElementType>
+    void SparseDataVector<ElementType, IndexListType>::AddToImplementation(math::RowVectorReference<VectorElementType> vector) const
+    {
+        auto size = vector.Size();
+        const ElementType* values = _values.data();
+
+        auto indexIterator = _indexList.GetIterator();
+        while (indexIterator.IsValid())
+        {
+            const size_t* indices = indexIterator.GetBlock();
+            auto blockSize = indexIterator.GetBlockSize();
+
+            if (indices[blockSize - 1] >= size)
+            {
+                for (size_t i = 0; i < blockSize && indices[i] < size; ++i)
+                {
+                    vector[indices[i]] += static_cast<VectorElementType>(values[i]);
+                }
+                return;
+            }
+
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                vector[indices[i]] += static_cast<VectorElementType>(values[i]);
+            }
+            values += blockSize;
+            indexIterator.NextBlock();
+        }
+    }
 }
 }
@@ -22,8 +22,8 @@ namespace data
         return TransformedDataVector<policy, DataVectorType, TransformationType>(dataVector, transformation);
     }
 
-    template <IterationPolicy policy, typename DataVectorType, typename TransformationType>
-    void operator+=(math::RowVectorReference<double> vector, const TransformedDataVector<policy, DataVectorType, TransformationType>& transformedDataVector)
+    template <IterationPolicy policy, typename DataVectorType, typename TransformationType, typename ElementType>
+    void operator+=(math::RowVectorReference<ElementType> vector, const TransformedDataVector<policy, DataVectorType, TransformationType>& transformedDataVector)
     {
         AddTransformedTo<DataVectorType, policy>(transformedDataVector.GetDataVector(), vector, transformedDataVector.GetTransformation());
     }
@@ -15,4 +15,6 @@ void DataVectorCopyAsTests();
 void AutoDataVectorTest();
 void TransformedDataVectorTest();
 void IteratorTests();
+void SparseDotTest();
+void DenseDotTest();
 }
\ No newline at end of file
@@ -11,4 +11,8 @@
 namespace ell
 {
 void DatasetCastingTests();
+void DatasetViewTests();
+void BinaryDatasetTest();
+void ArenaDatasetTest();
+void QuantizedDatasetTest();
 }
\ No newline at end of file
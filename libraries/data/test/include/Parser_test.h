@@ -11,5 +11,10 @@ namespace ell
 {
     void DataVectorParseTest();
     void AutoDataVectorParseTest();
+    void HashingAutoDataVectorParseTest();
     void SingleFileParseTest();
+    void ParallelParseTest();
+    void BufferedLineIteratorTest();
+    void PrefetchingExampleIteratorTest();
+    void DecompressingStreamTest();
 }
\ No newline at end of file
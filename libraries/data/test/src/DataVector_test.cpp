@@ -18,6 +18,7 @@
 #include "DataVectorOperations.h"
 
 // math
+#include "Matrix.h"
 #include "Vector.h"
 
 // testing
@@ -86,6 +87,23 @@ void IDataVectorBinaryTest()
     testing::ProcessTest("Testing " + std::string(typeid(DataVectorType).name()) + "::Print()", sss == "0:1\t3:1\t4:1");
 }
 
+template <typename DataVectorType>
+void IDataVectorFloatTest()
+{
+    DataVectorType u{ { 0, 2 }, { 3, -7 }, { 4, 1 } };
+
+    math::RowVector<float> w{ 1, 1, 1, 0, -1, 0 };
+    testing::ProcessTest("Testing " + std::string(typeid(DataVectorType).name()) + "::Dot() with float vector", testing::IsEqual(u.Dot(w), 1.0f));
+
+    u.AddTo(w);
+    math::RowVector<float> r0{ 3, 1, 1, -7, 0, 0 };
+    testing::ProcessTest("Testing " + std::string(typeid(DataVectorType).name()) + "::AddTo() with float vector", testing::IsEqual(w.ToArray(), r0.ToArray()));
+
+    data::AddTransformedTo<DataVectorType, data::IterationPolicy::skipZeros>(u, w, [](data::IndexValue x) { return -2 * x.value; });
+    math::RowVector<float> r1{ -1, 1, 1, 7, -2, 0 };
+    testing::ProcessTest("Testing " + std::string(typeid(DataVectorType).name()) + "::AddTransformedTo<skipZeros>() with float vector", testing::IsEqual(w.ToArray(), r1.ToArray()));
+}
+
 void IDataVectorTests()
 {
     IDataVectorTest<data::DoubleDataVector>();
@@ -108,6 +126,11 @@ void IDataVectorTests()
     IDataVectorBinaryTest<data::SparseByteDataVector>();
     IDataVectorBinaryTest<data::AutoDataVector>();
     IDataVectorBinaryTest<data::SparseBinaryDataVector>();
+
+    IDataVectorFloatTest<data::DoubleDataVector>();
+    IDataVectorFloatTest<data::FloatDataVector>();
+    IDataVectorFloatTest<data::SparseDoubleDataVector>();
+    IDataVectorFloatTest<data::AutoDataVector>();
 }
 
 template <typename DataVectorType1, typename DataVectorType2>
@@ -271,4 +294,111 @@ void IteratorTests()
     IteratorTest<data::SparseByteDataVector>();
     IteratorTest<data::SparseBinaryDataVector>();
 }
-}
\ No newline at end of file
+void SparseDotTest()
+{
+    // the deltas between indices need 1, 2, and 4 bytes, and the last index is beyond the end of the vector
+    std::vector<size_t> indices = { 0, 3, 4, 5, 6, 300, 301, 70000, 70002, 70003, 70010, 200000 };
+    std::vector<data::IndexValue> indexValues;
+    std::vector<data::IndexValue> binaryIndexValues;
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        indexValues.push_back({ indices[i], static_cast<double>(i + 1) });
+        binaryIndexValues.push_back({ indices[i], 1.0 });
+    }
+    data::SparseDoubleDataVector sparse(indexValues);
+    data::SparseBinaryDataVector binary(binaryIndexValues);
+
+    math::RowVector<double> w(100000);
+    for (size_t i = 0; i < w.Size(); ++i)
+    {
+        w[i] = std::sin(static_cast<double>(i));
+    }
+    math::RowVector<float> wFloat(100000);
+    for (size_t i = 0; i < wFloat.Size(); ++i)
+    {
+        wFloat[i] = static_cast<float>(w[i]);
+    }
+
+    double expectedDot = 0.0;
+    double expectedBinaryDot = 0.0;
+    math::RowVector<double> expectedSum(100000);
+    for (size_t i = 0; i + 1 < indices.size(); ++i)
+    {
+        expectedDot += static_cast<double>(i + 1) * w[indices[i]];
+        expectedBinaryDot += w[indices[i]];
+        expectedSum[indices[i]] = static_cast<double>(i + 1);
+    }
+
+    testing::ProcessTest("SparseDotTest Dot", testing::IsEqual(sparse.Dot(w), expectedDot) && testing::IsEqual(sparse.Dot(wFloat), static_cast<float>(expectedDot), 1.0e-4f));
+    testing::ProcessTest("SparseDotTest binary Dot", testing::IsEqual(binary.Dot(w), expectedBinaryDot) && testing::IsEqual(binary.Dot(wFloat), static_cast<float>(expectedBinaryDot), 1.0e-4f));
+
+    math::RowVector<double> sum(100000);
+    sparse.AddTo(sum);
+    testing::ProcessTest("SparseDotTest AddTo", sum == expectedSum);
+
+    math::RowVector<double> binarySum(100000);
+    binary.AddTo(binarySum);
+    testing::ProcessTest("SparseDotTest binary AddTo", binarySum[70010] == 1.0 && binarySum[70011] == 0.0 && binarySum.Norm1() == static_cast<double>(indices.size() - 1));
+}
+
+template <typename DataVectorType>
+void DenseDotTest(const std::string& typeName)
+{
+    // the length of the data vector is not a multiple of the kernel width, and the vectors are shorter than it
+    const size_t size = 203;
+    std::vector<double> values(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        values[i] = static_cast<double>((i * 7) % 101);
+    }
+    DataVectorType dataVector(values);
+
+    const size_t vectorSize = 150;
+    math::RowVector<double> w(vectorSize);
+    math::RowVector<float> wFloat(vectorSize);
+    math::RowMatrix<double> strided(vectorSize, 2);
+    for (size_t i = 0; i < vectorSize; ++i)
+    {
+        w[i] = std::sin(static_cast<double>(i));
+        wFloat[i] = static_cast<float>(w[i]);
+        strided(i, 0) = w[i];
+    }
+
+    double expectedDot = 0.0;
+    math::RowVector<double> expectedSum(vectorSize);
+    for (size_t i = 0; i < vectorSize; ++i)
+    {
+        expectedDot += values[i] * w[i];
+        expectedSum[i] = values[i];
+    }
+
+    testing::ProcessTest("DenseDotTest Dot with " + typeName, testing::IsEqual(dataVector.Dot(w), expectedDot, 1.0e-8));
+    testing::ProcessTest("DenseDotTest float Dot with " + typeName, testing::IsEqual(dataVector.Dot(wFloat), static_cast<float>(expectedDot), 1.0e-2f));
+    testing::ProcessTest("DenseDotTest strided Dot with " + typeName, testing::IsEqual(dataVector.Dot(strided.GetColumn(0)), expectedDot, 1.0e-8));
+
+    math::RowVector<double> sum(vectorSize);
+    dataVector.AddTo(sum);
+    testing::ProcessTest("DenseDotTest AddTo with " + typeName, sum == expectedSum);
+
+    math::RowVector<float> floatSum(vectorSize);
+    dataVector.AddTo(floatSum);
+    testing::ProcessTest("DenseDotTest float AddTo with " + typeName, floatSum[vectorSize - 1] == static_cast<float>(values[vectorSize - 1]) && testing::IsEqual(floatSum.Norm1(), static_cast<float>(expectedSum.Norm1())));
+
+    math::RowMatrix<double> stridedSum(vectorSize, 2);
+    dataVector.AddTo(stridedSum.GetColumn(1).Transpose());
+    testing::ProcessTest("DenseDotTest strided AddTo with " + typeName, stridedSum.GetColumn(1).Transpose() == expectedSum && stridedSum.GetColumn(0).Norm1() == 0.0);
+}
+
+void DenseDotTest()
+{
+    DenseDotTest<data::DoubleDataVector>("DoubleDataVector");
+    DenseDotTest<data::FloatDataVector>("FloatDataVector");
+    DenseDotTest<data::ShortDataVector>("ShortDataVector");
+    DenseDotTest<data::ByteDataVector>("ByteDataVector");
+
+    // a float dot product is accumulated in double, so the large terms cancel without absorbing the small one
+    data::FloatDataVector cancelling{ 1.0e8, 1.0, -1.0e8 };
+    math::RowVector<float> ones{ 1.0f, 1.0f, 1.0f };
+    testing::ProcessTest("DenseDotTest float Dot accumulates in double", cancelling.Dot(ones) == 1.0f);
+}
+}
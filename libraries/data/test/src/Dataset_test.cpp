@@ -7,12 +7,19 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Dataset_test.h"
+#include "ArenaDataset.h"
+#include "BinaryDataset.h"
 #include "Dataset.h"
+#include "DatasetView.h"
+#include "QuantizedDataset.h"
 
 // testing
 #include "testing.h"
 
 // stl
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <sstream>
 
 namespace ell
@@ -66,4 +73,227 @@ void DatasetCastingTests()
     DatasetCastingTestDispatch<data::AutoSupervisedExample>();
     DatasetCastingTestDispatch<data::DenseSupervisedExample>();
 }
-}
\ No newline at end of file
+
+struct DatasetViewTestMetadata
+{
+    DatasetViewTestMetadata(const data::WeightLabel& weightLabel) : label(weightLabel.label) {}
+    void Print(std::ostream& os) const { os << label << " " << counter; }
+
+    double label;
+    int counter = 0;
+};
+
+void DatasetViewTests()
+{
+    data::AutoSupervisedDataset dataset;
+    for (int i = 0; i < 10; ++i)
+    {
+        dataset.AddExample(data::AutoSupervisedExample(data::AutoDataVector{ static_cast<double>(i), 1.0 }, data::WeightLabel{ 1.0, static_cast<double>(i) }));
+    }
+
+    data::DatasetView<data::AutoDataVector, DatasetViewTestMetadata> view(dataset.GetAnyDataset());
+    testing::ProcessTest("DatasetView::NumExamples", view.NumExamples() == 10 && view.NumFeatures() == 2);
+    testing::ProcessTest("DatasetView shares data vectors", dataset[3].GetDataVectorReferenceCount() == 2 && &view.GetDataVector(3) == &dataset[3].GetDataVector());
+
+    // metadata must travel with its data vector when the view is rearranged
+    std::default_random_engine rng(1234);
+    view.RandomPermute(rng);
+    view.Sort([](const auto& example) { return -example.GetMetadata().label; });
+    bool isAligned = true;
+    for (size_t i = 0; i < view.NumExamples(); ++i)
+    {
+        isAligned &= (view.GetMetadata(i).label == 9.0 - i) && (view.GetDataVector(i).ToArray()[0] == view.GetMetadata(i).label);
+    }
+    testing::ProcessTest("DatasetView::Sort", isAligned);
+
+    view.Partition([](const auto& example) { return static_cast<int>(example.GetMetadata().label) % 2 == 0; }, 2, 6);
+    bool isPartitioned = true;
+    for (size_t i = 2; i < 8; ++i)
+    {
+        isPartitioned &= (static_cast<int>(view.GetMetadata(i).label) % 2 == 0) == (i < 5);
+        isPartitioned &= view.GetDataVector(i).ToArray()[0] == view.GetMetadata(i).label;
+    }
+    testing::ProcessTest("DatasetView::Partition", isPartitioned && view.GetMetadata(0).label == 9.0 && view.GetMetadata(9).label == 0.0);
+
+    // a view with a different data vector type holds converted copies
+    data::DatasetView<data::FloatDataVector, data::WeightLabel> floatView(dataset.GetAnyDataset(2, 3));
+    testing::ProcessTest("DatasetView conversion", floatView.NumExamples() == 3 && floatView.GetDataVector(1).ToArray()[0] == 3.0 && floatView.GetMetadata(1).label == 3.0);
+}
+
+void BinaryDatasetTest()
+{
+    data::AutoSupervisedDataset dataset;
+    dataset.AddExample(data::AutoSupervisedExample(data::AutoDataVector{ 1.0, 0.0, 2.5 }, data::WeightLabel{ 1.0, -1.0 }));
+    dataset.AddExample(data::AutoSupervisedExample(data::AutoDataVector{ 0.0, 0.0, 0.0, 0.0, 4.0 }, data::WeightLabel{ 2.0, 1.0 }));
+    dataset.AddExample(data::AutoSupervisedExample(data::AutoDataVector(std::vector<double>()), data::WeightLabel{ 0.5, 1.0 }));
+    dataset.AddExample(data::AutoSupervisedExample(data::AutoDataVector{ 0.0, 3.0 }, data::WeightLabel{ 1.0, -1.0 }));
+
+    std::string filename = "binaryDatasetTest.bin";
+    {
+        std::ofstream stream(filename, std::ios::binary);
+        data::WriteBinaryDataset(stream, dataset.GetExampleIterator(), true);
+    }
+
+    testing::ProcessTest("IsBinaryDatasetFile", data::IsBinaryDatasetFile(filename));
+    {
+        data::BinaryDataset binaryDataset(filename);
+        testing::ProcessTest("BinaryDataset sizes", binaryDataset.NumExamples() == 4 && binaryDataset.NumColumns() == 5 && binaryDataset.NumNonzeros() == 4 && binaryDataset.HasDenseBlock());
+
+        bool isEqual = true;
+        auto exampleIterator = binaryDataset.GetExampleIterator();
+        for (size_t i = 0; i < dataset.NumExamples(); ++i)
+        {
+            auto example = exampleIterator.Get();
+            isEqual &= example.GetDataVector().ToArray() == dataset[i].GetDataVector().ToArray();
+            isEqual &= example.GetMetadata().weight == dataset[i].GetMetadata().weight && example.GetMetadata().label == dataset[i].GetMetadata().label;
+            exampleIterator.Next();
+        }
+        testing::ProcessTest("BinaryDataset examples", isEqual && !exampleIterator.IsValid());
+
+        auto row = binaryDataset.GetRow(1);
+        testing::ProcessTest("BinaryDataset::GetRow", row.PrefixLength() == 5 && row.ToArray() == dataset[1].GetDataVector().ToArray() && binaryDataset.GetMetadata(1).weight == 2.0);
+
+        // an AnyDataset over the binary dataset reads the requested interval of examples
+        data::DenseSupervisedDataset denseDataset(binaryDataset.GetAnyDataset(1, 2));
+        testing::ProcessTest("BinaryDataset::GetAnyDataset", denseDataset.NumExamples() == 2 && denseDataset[0].GetDataVector().ToArray() == dataset[1].GetDataVector().ToArray() && denseDataset[1].GetMetadata().weight == 0.5);
+
+        auto column = binaryDataset.GetDenseColumn(4);
+        testing::ProcessTest("BinaryDataset::GetDenseColumn", column.Size() == 4 && column[0] == 0.0 && column[1] == 4.0 && column[2] == 0.0 && column[3] == 0.0);
+        testing::ProcessTest("BinaryDataset dense column 2", binaryDataset.GetDenseColumn(2)[0] == 2.5 && binaryDataset.GetDenseColumn(1)[3] == 3.0);
+    }
+
+    // corrupt one field of the file at a time: the header is 40 bytes, followed by 5 row offsets, 4 labels, 4 weights, and 4 values
+    auto isRejected = [&filename](size_t position, uint64_t value, size_t size) {
+        std::string corruptFilename = "corruptBinaryDatasetTest.bin";
+        {
+            std::ifstream source(filename, std::ios::binary);
+            std::ofstream target(corruptFilename, std::ios::binary);
+            target << source.rdbuf();
+            target.seekp(position);
+            target.write(reinterpret_cast<const char*>(&value), size);
+        }
+        bool rejected = false;
+        try
+        {
+            data::BinaryDataset corruptDataset(corruptFilename);
+        }
+        catch (const utilities::DataFormatException&)
+        {
+            rejected = true;
+        }
+        std::remove(corruptFilename.c_str());
+        return rejected;
+    };
+    testing::ProcessTest("BinaryDataset rejects an oversized header", isRejected(32, uint64_t(1) << 62, sizeof(uint64_t)));
+    testing::ProcessTest("BinaryDataset rejects a bad row offset", isRejected(48, 5, sizeof(uint64_t)));
+    testing::ProcessTest("BinaryDataset rejects a bad index", isRejected(40 + 17 * 8, 99, sizeof(uint32_t)));
+    std::remove(filename.c_str());
+}
+
+void ArenaDatasetTest()
+{
+    data::AutoSupervisedDataset dataset;
+    dataset.AddExample(data::AutoSupervisedExample(data::AutoDataVector{ 1.0, 2.0, 0.0, 4.0 }, data::WeightLabel{ 1.0, 1.0 }));
+    dataset.AddExample(data::AutoSupervisedExample(data::AutoDataVector{ data::IndexValue{ 2, 3.0 }, data::IndexValue{ 100, -1.0 } }, data::WeightLabel{ 2.0, -1.0 }));
+    dataset.AddExample(data::AutoSupervisedExample(data::AutoDataVector(std::vector<double>()), data::WeightLabel{ 1.0, 0.0 }));
+    dataset.AddExample(data::AutoSupervisedExample(data::AutoDataVector{ 0.0, 5.0, 7.0 }, data::WeightLabel{ 0.5, 1.0 }));
+
+    data::ArenaDataset arenaDataset(dataset.GetExampleIterator());
+
+    // the first and last examples are stored densely, the second sparsely
+    testing::ProcessTest("ArenaDataset sizes", arenaDataset.NumExamples() == 4 && arenaDataset.NumFeatures() == 101 && arenaDataset.NumStoredValues() == 4 + 2 + 0 + 3);
+
+    bool isEqual = true;
+    auto exampleIterator = arenaDataset.GetAnyDataset().GetExampleIterator<data::AutoSupervisedExample>();
+    for (size_t i = 0; i < dataset.NumExamples(); ++i)
+    {
+        auto example = exampleIterator.Get();
+        isEqual &= example.GetDataVector().ToArray() == dataset[i].GetDataVector().ToArray();
+        isEqual &= example.GetMetadata().weight == dataset[i].GetMetadata().weight && example.GetMetadata().label == dataset[i].GetMetadata().label;
+        exampleIterator.Next();
+    }
+    testing::ProcessTest("ArenaDataset examples", isEqual && !exampleIterator.IsValid());
+
+    data::DenseSupervisedDataset denseDataset(arenaDataset.GetAnyDataset(1, 2));
+    testing::ProcessTest("ArenaDataset AnyDataset interval", denseDataset.NumExamples() == 2 && denseDataset[0].GetDataVector().ToArray()[100] == -1.0 && denseDataset[1].GetMetadata().label == 0.0);
+
+    auto rowIterator = arenaDataset.GetRowIterator(3);
+    testing::ProcessTest("ArenaDataset::GetRowIterator", rowIterator.IsValid() && rowIterator.Get().index == 1 && rowIterator.Get().value == 5.0);
+
+    // rows read the arena in place, for both layouts
+    math::ColumnVector<double> weights(101);
+    weights[2] = 2.0;
+    weights[100] = 3.0;
+    auto sparseRow = arenaDataset.GetRow(1);
+    auto denseRow = arenaDataset.GetRow(3);
+    std::vector<double> denseValues;
+    auto denseIterator = sparseRow.GetIterator<data::IterationPolicy::all>(4);
+    while (denseIterator.IsValid())
+    {
+        denseValues.push_back(denseIterator.Get().value);
+        denseIterator.Next();
+    }
+    testing::ProcessTest("ArenaDataset::Row dense iterator", denseValues == std::vector<double>{ 0.0, 0.0, 3.0, 0.0 });
+    testing::ProcessTest("ArenaDataset::GetRow", sparseRow.PrefixLength() == 101 && sparseRow.Dot(weights) == 3.0 && denseRow.PrefixLength() == 3 && denseRow.Dot(weights) == 14.0 && sparseRow.ToArray(4) == std::vector<double>{ 0.0, 0.0, 3.0, 0.0 });
+}
+
+void QuantizedDatasetTest()
+{
+    data::AutoSupervisedDataset dataset;
+    dataset.AddExample(data::AutoSupervisedExample(data::AutoDataVector{ 1.0, -2.0, 0.0, 4.0 }, data::WeightLabel{ 1.0, 1.0 }));
+    dataset.AddExample(data::AutoSupervisedExample(data::AutoDataVector{ data::IndexValue{ 2, 3.0 }, data::IndexValue{ 40, -1.0 } }, data::WeightLabel{ 2.0, -1.0 }));
+    dataset.AddExample(data::AutoSupervisedExample(data::AutoDataVector{ 0.5, 0.0, 0.25, 3.0 }, data::WeightLabel{ 0.5, 1.0 }));
+
+    data::ByteQuantizedDataset quantizedDataset(dataset.GetAnyDataset());
+    testing::ProcessTest("QuantizedDataset sizes", quantizedDataset.NumExamples() == 3 && quantizedDataset.NumFeatures() == 41 && quantizedDataset.NumStoredValues() == 4 + 2 + 4);
+
+    // every dequantized value is within the error bound of its feature, and zeros stay zero
+    bool isWithinBound = true;
+    auto exampleIterator = quantizedDataset.GetAnyDataset().GetExampleIterator<data::AutoSupervisedExample>();
+    for (size_t i = 0; i < dataset.NumExamples(); ++i)
+    {
+        auto original = dataset[i].GetDataVector().ToArray(41);
+        auto quantized = exampleIterator.Get().GetDataVector().ToArray(41);
+        for (size_t j = 0; j < original.size(); ++j)
+        {
+            isWithinBound &= std::abs(original[j] - quantized[j]) <= quantizedDataset.GetMaxQuantizationError(j) + 1.0e-12;
+            isWithinBound &= (original[j] == 0.0) == (quantized[j] == 0.0);
+        }
+        isWithinBound &= exampleIterator.Get().GetMetadata().weight == dataset[i].GetMetadata().weight;
+        exampleIterator.Next();
+    }
+    testing::ProcessTest("QuantizedDataset reconstruction", isWithinBound && !exampleIterator.IsValid());
+
+    math::RowVector<double> weights(41);
+    for (size_t j = 0; j < weights.Size(); ++j)
+    {
+        weights[j] = 0.5 * static_cast<double>(j) - 1.0;
+    }
+    bool isDotEqual = true;
+    for (size_t i = 0; i < quantizedDataset.NumExamples(); ++i)
+    {
+        auto expected = quantizedDataset.GetExample(i).GetDataVector().Dot(weights);
+        isDotEqual &= testing::IsEqual(quantizedDataset.Dot(i, weights), expected);
+    }
+    testing::ProcessTest("QuantizedDataset::Dot", isDotEqual);
+
+    math::RowVector<double> sum(41);
+    quantizedDataset.AddTo(1, sum, 2.0);
+    testing::ProcessTest("QuantizedDataset::AddTo", testing::IsEqual(sum[2], 6.0, 0.05) && testing::IsEqual(sum[40], -2.0, 0.01) && sum[0] == 0.0);
+
+    // a row reads the codes in place, and has the same entries as the materialized example
+    bool isRowEqual = true;
+    for (size_t i = 0; i < quantizedDataset.NumExamples(); ++i)
+    {
+        auto row = quantizedDataset.GetRow(i);
+        auto example = quantizedDataset.GetExample(i);
+        isRowEqual &= row.PrefixLength() == example.GetDataVector().PrefixLength() && row.ToArray() == example.GetDataVector().ToArray() && row.Dot(weights) == quantizedDataset.Dot(i, weights);
+    }
+    testing::ProcessTest("QuantizedDataset::GetRow", isRowEqual);
+
+    data::ShortQuantizedDataset shortDataset({ -1.0, 0.0 }, { 1.0, 10.0 });
+    shortDataset.AddExample(data::AutoDataVector{ 0.3, 20.0 }, data::WeightLabel{ 1.0, 1.0 });
+    auto values = shortDataset.GetExample(0).GetDataVector().ToArray();
+    testing::ProcessTest("QuantizedDataset with given ranges", std::abs(values[0] - 0.3) <= shortDataset.GetMaxQuantizationError(0) && testing::IsEqual(values[1], 10.0));
+}
+}
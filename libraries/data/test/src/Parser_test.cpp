@@ -9,22 +9,38 @@
 #include "Parser_test.h"
 
 // data
+#include "BufferedLineIterator.h"
 #include "GeneralizedSparseParsingIterator.h"
 #include "TextLine.h"
 #include "SequentialLineIterator.h"
 #include "SingleLineParsingExampleIterator.h"
+#include "ParallelParsingExampleIterator.h"
+#include "PrefetchingExampleIterator.h"
 #include "WeightLabel.h"
 #include "AutoDataVector.h"
 #include "Dataset.h"
+#include "DecompressingStreamBuffer.h"
+#include "FeatureHasher.h"
 
 // testing
 #include "testing.h"
 
+// utilities
+#include "Exception.h"
+
 // stl
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
 #include <string>
 #include <sstream>
 #include <memory>
 
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
 namespace ell
 {
 
@@ -117,6 +133,34 @@ namespace ell
             && dataVector2.GetInternalType() == data::IDataVector::Type::SparseByteDataVector);
     }
 
+    void HashingAutoDataVectorParseTest()
+    {
+        data::FeatureHasher hasher(3);
+        auto parser = data::HashingAutoDataVectorParser<data::GeneralizedSparseParsingIterator>(hasher);
+
+        // compute the expected result directly from the hash function
+        std::vector<size_t> indices = { 0, 1, 5, 1000, 4294967295 };
+        std::vector<double> values = { 1, 2, 3, 4, 5 };
+        std::vector<double> expected(hasher.NumBuckets());
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            expected[hasher.GetBucket(indices[i])] += hasher.GetSign(indices[i]) * values[i];
+        }
+
+        data::TextLine line("0:1 1:2 5:3 1000:4 4294967295:5");
+        auto array = parser.Parse(line).ToArray();
+        array.resize(hasher.NumBuckets());
+        testing::ProcessTest("HashingAutoDataVectorParser test", testing::IsEqual(array, expected));
+
+        data::FeatureHasher otherHasher(3);
+        bool isDeterministic = true;
+        for (auto index : indices)
+        {
+            isDeterministic = isDeterministic && hasher.GetBucket(index) == otherHasher.GetBucket(index) && hasher.GetSign(index) == otherHasher.GetSign(index);
+        }
+        testing::ProcessTest("FeatureHasher deterministic test", isDeterministic);
+    }
+
     void SingleFileParseTest()
     {
         auto string = R"aw(
@@ -147,4 +191,238 @@ namespace ell
         testing::ProcessTest("SingleFileParse test2", dataset[1].GetMetadata().label == -1 && testing::IsEqual(dataset[1].GetDataVector().ToArray(), { 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 3 }));
         testing::ProcessTest("SingleFileParse test3", dataset[2].GetMetadata().label == 1 && testing::IsEqual(dataset[2].GetDataVector().ToArray(), { 2.7, 0, 0, 0, -0.3, 0, 0, 0, 0, 0, 3.14 }));
     }
-}
\ No newline at end of file
+
+    void ParallelParseTest()
+    {
+        std::stringstream text;
+        text << "// comment\n";
+        for (int i = 0; i < 100; ++i)
+        {
+            text << i << "\t" << (i % 7) << ":" << i << " " << (i % 5 + 7) << ":1\n";
+            if (i % 10 == 0)
+            {
+                text << "\n  # comment\n";
+            }
+        }
+        auto string = text.str();
+
+        std::stringstream sequentialStream(string);
+        auto sequentialDataset = data::MakeDataset(data::MakeSingleLineParsingExampleIterator(data::SequentialLineIterator(sequentialStream), data::LabelParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>()));
+
+        // use small chunks, so that every worker parses many chunks
+        data::ParallelParsingParameters parameters;
+        parameters.chunkSize = 37;
+        parameters.numThreads = 4;
+
+        std::stringstream orderedStream(string);
+        auto orderedDataset = data::MakeDataset(data::MakeParallelParsingExampleIterator(orderedStream, data::LabelParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>(), parameters));
+
+        bool isEqual = orderedDataset.NumExamples() == sequentialDataset.NumExamples();
+        for (size_t i = 0; isEqual && i < sequentialDataset.NumExamples(); ++i)
+        {
+            isEqual = orderedDataset[i].GetMetadata().label == sequentialDataset[i].GetMetadata().label && orderedDataset[i].GetDataVector().ToArray() == sequentialDataset[i].GetDataVector().ToArray();
+        }
+        testing::ProcessTest("ParallelParse ordered", isEqual && sequentialDataset.NumExamples() == 100);
+
+        parameters.preserveOrder = false;
+        std::stringstream unorderedStream(string);
+        auto unorderedDataset = data::MakeDataset(data::MakeParallelParsingExampleIterator(unorderedStream, data::LabelParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>(), parameters));
+
+        std::vector<int> labels;
+        bool isConsistent = unorderedDataset.NumExamples() == 100;
+        for (size_t i = 0; i < unorderedDataset.NumExamples(); ++i)
+        {
+            auto label = static_cast<int>(unorderedDataset[i].GetMetadata().label);
+            labels.push_back(label);
+            isConsistent &= unorderedDataset[i].GetDataVector().ToArray() == sequentialDataset[label].GetDataVector().ToArray();
+        }
+        std::sort(labels.begin(), labels.end());
+        for (int i = 0; isConsistent && i < 100; ++i)
+        {
+            isConsistent = labels[i] == i;
+        }
+        testing::ProcessTest("ParallelParse unordered", isConsistent);
+    }
+
+    void BufferedLineIteratorTest()
+    {
+        std::string string = "1 0:1\n\n-1 0:2 1:2 2:2 3:2 4:2 5:2\n  # comment\n1 2:3";
+
+        std::vector<std::string> sequentialLines;
+        std::stringstream sequentialStream(string);
+        data::SequentialLineIterator sequentialIterator(sequentialStream);
+        while (sequentialIterator.IsValid())
+        {
+            sequentialLines.push_back(sequentialIterator.GetTextLine().GetString());
+            sequentialIterator.Next();
+        }
+
+        // a block size smaller than the longest line forces lines to span several reads
+        std::vector<std::string> bufferedLines;
+        std::stringstream bufferedStream(string);
+        data::BufferedLineIterator bufferedIterator(bufferedStream, 7);
+        while (bufferedIterator.IsValid())
+        {
+            bufferedLines.push_back(bufferedIterator.GetTextLine().GetString());
+            bufferedIterator.Next();
+        }
+        testing::ProcessTest("BufferedLineIterator lines", bufferedLines == sequentialLines && bufferedLines.size() == 5);
+
+        std::stringstream parsingStream(string);
+        auto exampleIterator = data::MakeSingleLineParsingExampleIterator(data::BufferedLineIterator(parsingStream, 7), data::LabelParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>());
+        auto dataset = data::MakeDataset(std::move(exampleIterator));
+        testing::ProcessTest("BufferedLineIterator parse", dataset.NumExamples() == 3 && testing::IsEqual(dataset[1].GetDataVector().ToArray(), { 2, 2, 2, 2, 2, 2 }) && testing::IsEqual(dataset[2].GetDataVector().ToArray(), { 0, 0, 3 }));
+    }
+
+    // an example iterator that fails when it reaches a given example
+    class FailingExampleIterator : public data::IExampleIterator<data::AutoSupervisedExample>
+    {
+    public:
+        FailingExampleIterator(size_t failIndex)
+            : _failIndex(failIndex) {}
+
+        virtual bool IsValid() const override { return true; }
+
+        virtual void Next() override { ++_index; }
+
+        virtual data::AutoSupervisedExample Get() const override
+        {
+            if (_index == _failIndex)
+            {
+                throw std::runtime_error("read error");
+            }
+            return data::AutoSupervisedExample(data::AutoDataVector{ static_cast<double>(_index) }, data::WeightLabel{ 1.0, 1.0 });
+        }
+
+    private:
+        size_t _failIndex;
+        size_t _index = 0;
+    };
+
+    void PrefetchingExampleIteratorTest()
+    {
+        std::stringstream text;
+        for (int i = 0; i < 100; ++i)
+        {
+            text << i << "\t" << (i % 7) << ":" << i << "\n";
+        }
+        auto string = text.str();
+
+        std::stringstream sequentialStream(string);
+        auto sequentialDataset = data::MakeDataset(data::MakeSingleLineParsingExampleIterator(data::SequentialLineIterator(sequentialStream), data::LabelParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>()));
+
+        // use small batches and a short queue, so that the background thread waits for the consumer
+        data::PrefetchingParameters parameters;
+        parameters.batchSize = 7;
+        parameters.maxQueuedBatches = 2;
+
+        std::stringstream prefetchingStream(string);
+        auto sourceIterator = data::MakeSingleLineParsingExampleIterator(data::SequentialLineIterator(prefetchingStream), data::LabelParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>());
+        auto prefetchingDataset = data::MakeDataset(data::MakePrefetchingExampleIterator(std::move(sourceIterator), parameters));
+
+        bool isEqual = prefetchingDataset.NumExamples() == sequentialDataset.NumExamples() && sequentialDataset.NumExamples() == 100;
+        for (size_t i = 0; isEqual && i < sequentialDataset.NumExamples(); ++i)
+        {
+            isEqual = prefetchingDataset[i].GetMetadata().label == sequentialDataset[i].GetMetadata().label && prefetchingDataset[i].GetDataVector().ToArray() == sequentialDataset[i].GetDataVector().ToArray();
+        }
+        testing::ProcessTest("PrefetchingExampleIterator", isEqual);
+
+        // the examples before a failure are delivered, and then the failure is rethrown
+        auto failingIterator = data::MakePrefetchingExampleIterator(data::AutoSupervisedExampleIterator(std::make_unique<FailingExampleIterator>(10)), parameters);
+        size_t numExamples = 0;
+        bool didThrow = false;
+        try
+        {
+            while (failingIterator.IsValid())
+            {
+                ++numExamples;
+                failingIterator.Next();
+            }
+        }
+        catch (const std::runtime_error&)
+        {
+            didThrow = true;
+        }
+        testing::ProcessTest("PrefetchingExampleIterator exception", didThrow && numExamples == 10);
+
+        // destroying the iterator before the end of an endless source stops the background thread
+        {
+            auto endlessIterator = data::MakePrefetchingExampleIterator(data::AutoSupervisedExampleIterator(std::make_unique<FailingExampleIterator>(size_t(-1))), parameters);
+            endlessIterator.Next();
+        }
+        testing::ProcessTest("PrefetchingExampleIterator early destruction", true);
+    }
+    void DecompressingStreamTest()
+    {
+        std::string plainFilename = "decompressingStreamTest.txt";
+        std::string string;
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            string += std::to_string(i % 2) + "\t" + std::to_string(i) + ":" + std::to_string(i * 0.5) + "\n";
+        }
+        {
+            std::ofstream stream(plainFilename, std::ios::binary);
+            stream << string;
+        }
+        testing::ProcessTest("GetCompressionFormat of a plain file", data::GetCompressionFormat(plainFilename) == data::CompressionFormat::none);
+        std::remove(plainFilename.c_str());
+
+#ifdef USE_ZLIB
+        std::string filename = "decompressingStreamTest.gz";
+        auto file = gzopen(filename.c_str(), "wb");
+        gzwrite(file, string.data(), static_cast<unsigned int>(string.size()));
+        gzclose(file);
+        testing::ProcessTest("GetCompressionFormat of a gzip file", data::GetCompressionFormat(filename) == data::CompressionFormat::gzip && data::IsCompressionFormatSupported(data::CompressionFormat::gzip));
+
+        // small blocks, so that lines cross block boundaries and the background thread waits for the reader
+        data::DecompressionParameters parameters;
+        parameters.blockSize = 7;
+        parameters.maxQueuedBlocks = 2;
+        {
+            data::DecompressingIfstream stream(filename, parameters);
+            std::stringstream plainStream(string);
+            bool isEqual = true;
+            size_t numLines = 0;
+            std::string line;
+            std::string plainLine;
+            while (std::getline(stream, line))
+            {
+                std::getline(plainStream, plainLine);
+                isEqual = isEqual && line == plainLine;
+                ++numLines;
+            }
+            testing::ProcessTest("DecompressingIfstream", isEqual && numLines == 1000);
+        }
+
+        // corrupt the compressed data, so that decompression fails partway through the file
+        std::string compressed;
+        {
+            std::ifstream stream(filename, std::ios::binary);
+            compressed.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        }
+        for (size_t i = compressed.size() / 2; i < compressed.size() - 8; ++i)
+        {
+            compressed[i] = static_cast<char>(0xff);
+        }
+        {
+            std::ofstream stream(filename, std::ios::binary);
+            stream << compressed;
+        }
+        bool didThrow = false;
+        try
+        {
+            data::DecompressingIfstream stream(filename, parameters);
+            std::string line;
+            while (std::getline(stream, line))
+            {
+            }
+        }
+        catch (const utilities::DataFormatException&)
+        {
+            didThrow = true;
+        }
+        testing::ProcessTest("DecompressingIfstream exception", didThrow);
+        std::remove(filename.c_str());
+#endif
+    }
+}
@@ -25,11 +25,22 @@ int main()
     AutoDataVectorTest();
     TransformedDataVectorTest();
     IteratorTests();
+    SparseDotTest();
+    DenseDotTest();
     ExampleCopyAsTests();
     DatasetCastingTests();
+    DatasetViewTests();
+    BinaryDatasetTest();
+    ArenaDatasetTest();
+    QuantizedDatasetTest();
     DataVectorParseTest();
     AutoDataVectorParseTest();
+    HashingAutoDataVectorParseTest();
     SingleFileParseTest();
+    ParallelParseTest();
+    BufferedLineIteratorTest();
+    PrefetchingExampleIteratorTest();
+    DecompressingStreamTest();
 
     if (testing::DidTestFail())
     {
@@ -28,6 +28,9 @@ namespace emitters
     /// <summary> Indicates the Predict function. </summary>
     static const std::string c_predictFunctionTagName = "ell.fn.predict";
 
+    /// <summary> Indicates the function that calls Predict on a batch of inputs, with the value set to the input size. </summary>
+    static const std::string c_predictBatchFunctionTagName = "ell.fn.predictBatch";
+
     /// <summary> Indicates the Step function, with the value set to the output count. </summary>
     static const std::string c_stepFunctionTagName = "ell.fn.step";
 
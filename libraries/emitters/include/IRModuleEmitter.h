@@ -240,6 +240,27 @@ namespace emitters
         template <typename ValueType>
         llvm::GlobalVariable* GlobalArray(const std::string& name, const std::vector<ValueType>& value);
 
+        /// <summary> Emit a named global byte array with the given alignment, to hold several variables at once. </summary>
+        ///
+        /// <param name="name"> The name of the arena. </param>
+        /// <param name="size"> The size of the arena, in bytes. </param>
+        /// <param name="alignment"> The alignment of the arena, in bytes. </param>
+        ///
+        /// <returns> Pointer to the llvm::GlobalVariable that represents the arena. </returns>
+        llvm::GlobalVariable* GlobalArena(const std::string& name, size_t size, size_t alignment);
+
+        /// <summary>
+        /// Emit a global vector variable as a region of an arena, instead of as an array of its own. The variable is
+        /// represented by a constant pointer to its first element, which can be used in any function of the module.
+        /// </summary>
+        ///
+        /// <param name="var"> The global vector variable. </param>
+        /// <param name="pArena"> The arena, as returned by GlobalArena. </param>
+        /// <param name="offset"> The offset of the variable in the arena, in bytes. </param>
+        ///
+        /// <returns> Pointer to the first element of the variable. </returns>
+        llvm::Value* EmitGlobalVectorInArena(Variable& var, llvm::GlobalVariable* pArena, size_t offset);
+
         //
         // Functions
         //
@@ -349,6 +349,30 @@ namespace emitters
         return Global(name, _emitter.ArrayType(VariableType::Double, value.size()), _emitter.Literal(value), false);
     }
 
+    llvm::GlobalVariable* IRModuleEmitter::GlobalArena(const std::string& name, size_t size, size_t alignment)
+    {
+        auto pArena = GlobalArray(VariableType::Byte, name, size);
+        pArena->setAlignment(alignment);
+        return pArena;
+    }
+
+    llvm::Value* IRModuleEmitter::EmitGlobalVectorInArena(Variable& var, llvm::GlobalVariable* pArena, size_t offset)
+    {
+        assert(pArena != nullptr);
+        if (var.Scope() != VariableScope::global || !var.IsVector() || var.HasInitValue())
+        {
+            throw EmitterException(EmitterError::variableScopeNotSupported, "Only uninitialized global vectors can be placed in an arena");
+        }
+
+        AllocateVariable(var);
+        auto int32Type = llvm::Type::getInt32Ty(GetLLVMContext());
+        llvm::Constant* indices[] = { llvm::ConstantInt::get(int32Type, 0), llvm::ConstantInt::get(int32Type, offset) };
+        auto pBytes = llvm::ConstantExpr::getInBoundsGetElementPtr(pArena->getValueType(), pArena, indices);
+        llvm::Value* pVal = llvm::ConstantExpr::getBitCast(pBytes, _emitter.Type(GetPointerType(var.Type())));
+        _globals.Add(var.EmittedName(), pVal);
+        return pVal;
+    }
+
     // This is the actual implementation --- we should call it something different and/or put it in IREmitter
     llvm::GlobalVariable* IRModuleEmitter::Global(const std::string& name, llvm::Type* pType, llvm::Constant* pInitial, bool isConst)
     {
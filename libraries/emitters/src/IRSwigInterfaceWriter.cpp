@@ -100,6 +100,63 @@ namespace emitters
             llvm::Function* _function;
         };
 
+        class PredictBatchInterfaceWriter
+        {
+        public:
+            PredictBatchInterfaceWriter(IRModuleEmitter& moduleEmitter, const FunctionTagValues& predictBatchFunction)
+                : _moduleEmitter(&moduleEmitter), _function(predictBatchFunction.function)
+            {
+                InitPredictBatchFunctionInfo();
+                _inputSize = std::stoul(predictBatchFunction.values[0]);
+            }
+
+            void WriteHeaderCode(std::ostream& os)
+            {
+                // Write header for SWIG to generate a wrapper, which takes the rows of input back to back
+                std::ostringstream osHeader;
+                osHeader << "void " << _functionName << "(const std::vector<" << _inputType << ">& input, std::vector<" << _outputType << ">& output)";
+                os << osHeader.str() << ";\n\n";
+
+                {
+                    DeclareIfndefSwig ifndefSwig(os);
+
+                    // Write implementation
+                    os << osHeader.str() << "\n{\n";
+                    os << "    " << _functionName << "(static_cast<int32_t>(input.size() / " << _inputSize << "), const_cast<" << _inputType << "*>(&input[0]), &output[0]);\n";
+                    os << "}\n";
+                }
+            }
+
+        private:
+            void InitPredictBatchFunctionInfo()
+            {
+                _functionName = _function->getName();
+
+                // A count, followed by two pointer arguments
+                auto it = _function->args().begin();
+                ++it;
+                {
+                    std::ostringstream os;
+                    WriteLLVMType(os, (*it).getType()->getPointerElementType());
+                    _inputType = os.str();
+                }
+
+                {
+                    std::ostringstream os;
+                    WriteLLVMType(os, (*(++it)).getType()->getPointerElementType());
+                    _outputType = os.str();
+                }
+            }
+
+            std::string _functionName;
+            std::string _inputType;
+            std::string _outputType;
+            size_t _inputSize;
+
+            IRModuleEmitter* _moduleEmitter;
+            llvm::Function* _function;
+        };
+
         struct CallbackSignature
         {
             CallbackSignature(llvm::Function& f)
@@ -554,6 +611,7 @@ namespace emitters
         os << "#pragma once\n\n";
 
         auto predicts = GetFunctionsWithTag(moduleEmitter, c_predictFunctionTagName);
+        auto predictBatches = GetFunctionsWithTag(moduleEmitter, c_predictBatchFunctionTagName);
         auto callbacks = GetFunctionsWithTag(moduleEmitter, c_callbackFunctionTagName);
 
         // Dependencies
@@ -578,6 +636,12 @@ namespace emitters
             writer.WriteHeaderCode(os);
         }
 
+        for (const auto& p : predictBatches)
+        {
+            PredictBatchInterfaceWriter writer(moduleEmitter, p);
+            writer.WriteHeaderCode(os);
+        }
+
         // Callbacks
         if (callbacks.size() > 0)
         {
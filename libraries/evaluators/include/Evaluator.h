@@ -10,6 +10,7 @@
 
 // data
 #include "Dataset.h"
+#include "DatasetView.h"
 #include "Example.h"
 
 // stl
@@ -149,11 +150,11 @@ namespace evaluators
         template <std::size_t... Sequence>
         std::vector<std::vector<std::string>> DispatchGetValueNames(std::index_sequence<Sequence...>) const;
 
-        // the type of example used by this evaluator
-        using ExampleType = data::Example<typename PredictorType::DataVectorType, data::WeightLabel>;
+        // the type of dataset view used by this evaluator
+        using DatasetType = data::DatasetView<typename PredictorType::DataVectorType, data::WeightLabel>;
 
         // member variables
-        data::Dataset<ExampleType> _dataset;
+        DatasetType _dataset;
         EvaluatorParameters _evaluatorParameters;
         size_t _evaluateCounter = 0;
         typename std::tuple<AggregatorTypes...> _aggregatorTuple;
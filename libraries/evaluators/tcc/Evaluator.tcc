@@ -36,11 +36,11 @@ namespace evaluators
             return;
         }
 
-        auto iterator = _dataset.GetExampleReferenceIterator();
+        auto iterator = _dataset.GetExampleIterator();
 
         while (iterator.IsValid())
         {
-            const auto& example = iterator.Get();
+            auto example = iterator.Get();
 
             double weight = example.GetMetadata().weight;
             double label = example.GetMetadata().label;
@@ -113,7 +113,7 @@ namespace evaluators
 
         while (iterator.IsValid())
         {
-            const auto& example = iterator.Get();
+            auto example = iterator.Get();
 
             double weight = example.GetMetadata().weight;
             double label = example.GetMetadata().label;
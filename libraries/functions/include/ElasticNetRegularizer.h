@@ -31,7 +31,8 @@ namespace functions
         /// <param name="b"> (Optional) The bias term for which the regularizer is computed. </param>
         ///
         /// <returns> Value of the regularizer. </returns>
-        double operator()(math::ColumnConstVectorReference<double> w, double b=0) const;
+        template <typename ElementType>
+        double operator()(math::ColumnConstVectorReference<ElementType> w, double b=0) const;
 
         /// <summary> Computes the value of the convex conjugate of the regularizer. </summary>
         ///
@@ -39,13 +40,15 @@ namespace functions
         /// <param name="d"> (Optional) The bias term for which the regularizer is computed. </param>
         ///
         /// <returns> Value of the conjugate. </returns>
-        double Conjugate(math::ColumnConstVectorReference<double> v, double d=0) const;
+        template <typename ElementType>
+        double Conjugate(math::ColumnConstVectorReference<ElementType> v, double d=0) const;
 
         /// <summary> Computes the conjugate gradient function. Namely, given vector v, compute g = argmax_w {v'*w - f(w)} = argmin_w {-v'*w + f(w)} </summary>
         ///
         /// <param name="v"> The vector at which the conjugate is computed. </param>
         /// <param name="w"> The output vector. </param>
-        void ConjugateGradient(math::ColumnConstVectorReference<double> v, math::ColumnVectorReference<double> w) const;
+        template <typename ElementType>
+        void ConjugateGradient(math::ColumnConstVectorReference<ElementType> v, math::ColumnVectorReference<ElementType> w) const;
 
         /// <summary>
         /// Computes the conjugate gradient function. Namely, given vector v, compute g = argmax_w {v'*w - f(w)} = argmin_w {-v'*w + f(w)}
@@ -55,7 +58,8 @@ namespace functions
         /// <param name="d"> The bias term for which the conjugate is computed. </param>
         /// <param name="w"> The output vector. </param>
         /// <param name="b"> [in,out] The output bias term. </param>
-        void ConjugateGradient(math::ColumnConstVectorReference<double> v, double d, math::ColumnVectorReference<double> w, double& b) const;
+        template <typename ElementType>
+        void ConjugateGradient(math::ColumnConstVectorReference<ElementType> v, double d, math::ColumnVectorReference<ElementType> w, ElementType& b) const;
 
     private:
         double _ratioL1L2;
@@ -25,21 +25,24 @@ namespace functions
         /// <param name="b"> (Optional) The bias term for which the regularizer is computed. </param>
         ///
         /// <returns> Value of the regularizer. </returns>
-        double operator()(math::ColumnConstVectorReference<double> w, double b=0) const;
+        template <typename ElementType>
+        double operator()(math::ColumnConstVectorReference<ElementType> w, double b=0) const;
 
         /// <summary> Computes the value of the convex conjugate of the regularizer. </summary>
         ///
         /// <param name="v"> The point at which the conjugate is computed. </param>
         /// <param name="d"> (Optional) The bias term for which the conjugate is computed. </param>
         /// <returns> Value of the conjugate. </returns>
-        double Conjugate(math::ColumnConstVectorReference<double> v, double d=0) const;
+        template <typename ElementType>
+        double Conjugate(math::ColumnConstVectorReference<ElementType> v, double d=0) const;
 
         /// <summary> Computes the conjugate gradient function. Namely, Given vector v, 
         /// compute w = argmax_u {v'*u - f(u)} = argmin_u {-v'*u + f(u)} </summary>
         ///
         /// <param name="v"> The point at which the conjugate gradient is computed. </param>
         /// <param name="w"> The output. </param>
-        void ConjugateGradient(math::ColumnConstVectorReference<double> v, math::ColumnVectorReference<double> w) const;
+        template <typename ElementType>
+        void ConjugateGradient(math::ColumnConstVectorReference<ElementType> v, math::ColumnVectorReference<ElementType> w) const;
 
         /// <summary>
         /// Computes the conjugate gradient function. Namely, Given vector v, compute g = argmax_w {v'*w - f(w)} = argmin_w {-v'*w + f(w)}
@@ -49,7 +52,8 @@ namespace functions
         /// <param name="d"> The bias term for which the conjugate is computed. </param>
         /// <param name="w"> The output vector. </param>
         /// <param name="b"> [in,out] The output bias term. </param>
-        void ConjugateGradient(math::ColumnConstVectorReference<double> v, double d, math::ColumnVectorReference<double> w, double& b) const;
+        template <typename ElementType>
+        void ConjugateGradient(math::ColumnConstVectorReference<ElementType> v, double d, math::ColumnVectorReference<ElementType> w, ElementType& b) const;
     };
 }
 }
\ No newline at end of file
@@ -19,12 +19,14 @@ namespace functions
     {
     }
 
-    double ElasticNetRegularizer::operator()(math::ColumnConstVectorReference<double> v, double b) const
+    template <typename ElementType>
+    double ElasticNetRegularizer::operator()(math::ColumnConstVectorReference<ElementType> v, double b) const
     {
         return 0.5 * (v.Norm2Squared() + b*b) + _ratioL1L2 * (v.Norm1() + std::abs(b));
     }
 
-    double ElasticNetRegularizer::Conjugate(math::ColumnConstVectorReference<double> v, double d) const
+    template <typename ElementType>
+    double ElasticNetRegularizer::Conjugate(math::ColumnConstVectorReference<ElementType> v, double d) const
     {
         double dot = 0;
         double norm2Squared = 0;
@@ -40,7 +42,7 @@ namespace functions
         }
         else
         {
-            b = d + _ratioL1L2;
+            b = static_cast<ElementType>(d + _ratioL1L2);
             if (b < 0)
             {
                 dot += d * b;
@@ -73,39 +75,51 @@ namespace functions
         return dot - (0.5 * norm2Squared + _ratioL1L2 * norm1);
     }
 
-    void ElasticNetRegularizer::ConjugateGradient(math::ColumnConstVectorReference<double> v, math::ColumnVectorReference<double> w) const
+    template <typename ElementType>
+    void ElasticNetRegularizer::ConjugateGradient(math::ColumnConstVectorReference<ElementType> v, math::ColumnVectorReference<ElementType> w) const
     {
         for (size_t j = 0; j < v.Size(); ++j)
         {
             double z = v[j] - _ratioL1L2;
             if (z > 0)
             {
-                w[j] = z;
+                w[j] = static_cast<ElementType>(z);
                 continue;
             }
 
             z = v[j] + _ratioL1L2;
             if (z < 0)
             {
-                w[j] = z;
+                w[j] = static_cast<ElementType>(z);
             }
 
             w[j] = 0;
         }
     }
 
-    void ElasticNetRegularizer::ConjugateGradient(math::ColumnConstVectorReference<double> v, double d, math::ColumnVectorReference<double> w, double& b) const
+    template <typename ElementType>
+    void ElasticNetRegularizer::ConjugateGradient(math::ColumnConstVectorReference<ElementType> v, double d, math::ColumnVectorReference<ElementType> w, ElementType& b) const
     {
         ConjugateGradient(v, w);
-        b = d - _ratioL1L2;
+        b = static_cast<ElementType>(d - _ratioL1L2);
         if (b < 0)
         {
-            b = d + _ratioL1L2;
+            b = static_cast<ElementType>(d + _ratioL1L2);
             if (b > 0)
             {
                 b = 0;
             }
         }
     }
+
+    // explicit instantiation
+    template double ElasticNetRegularizer::operator()(math::ColumnConstVectorReference<float> w, double b) const;
+    template double ElasticNetRegularizer::operator()(math::ColumnConstVectorReference<double> w, double b) const;
+    template double ElasticNetRegularizer::Conjugate(math::ColumnConstVectorReference<float> v, double d) const;
+    template double ElasticNetRegularizer::Conjugate(math::ColumnConstVectorReference<double> v, double d) const;
+    template void ElasticNetRegularizer::ConjugateGradient(math::ColumnConstVectorReference<float> v, math::ColumnVectorReference<float> w) const;
+    template void ElasticNetRegularizer::ConjugateGradient(math::ColumnConstVectorReference<double> v, math::ColumnVectorReference<double> w) const;
+    template void ElasticNetRegularizer::ConjugateGradient(math::ColumnConstVectorReference<float> v, double d, math::ColumnVectorReference<float> w, float& b) const;
+    template void ElasticNetRegularizer::ConjugateGradient(math::ColumnConstVectorReference<double> v, double d, math::ColumnVectorReference<double> w, double& b) const;
 }
 }
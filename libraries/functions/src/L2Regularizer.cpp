@@ -12,25 +12,39 @@ namespace ell
 {
 namespace functions
 {
-    double L2Regularizer::operator()(math::ColumnConstVectorReference<double> w, double b) const
+    template <typename ElementType>
+    double L2Regularizer::operator()(math::ColumnConstVectorReference<ElementType> w, double b) const
     {
         return 0.5 * (w.Norm2Squared() + b*b);
     }
 
-    double L2Regularizer::Conjugate(math::ColumnConstVectorReference<double> v, double d) const
+    template <typename ElementType>
+    double L2Regularizer::Conjugate(math::ColumnConstVectorReference<ElementType> v, double d) const
     {
         return (*this)(v, d);
     }
 
-    void L2Regularizer::ConjugateGradient(math::ColumnConstVectorReference<double> v, math::ColumnVectorReference<double> w) const
+    template <typename ElementType>
+    void L2Regularizer::ConjugateGradient(math::ColumnConstVectorReference<ElementType> v, math::ColumnVectorReference<ElementType> w) const
     {
         w.CopyFrom(v);
     }
 
-    void L2Regularizer::ConjugateGradient(math::ColumnConstVectorReference<double> v, double d, math::ColumnVectorReference<double> w, double& b) const
+    template <typename ElementType>
+    void L2Regularizer::ConjugateGradient(math::ColumnConstVectorReference<ElementType> v, double d, math::ColumnVectorReference<ElementType> w, ElementType& b) const
     {
         w.CopyFrom(v);
-        b = d;
+        b = static_cast<ElementType>(d);
     }
+
+    // explicit instantiation
+    template double L2Regularizer::operator()(math::ColumnConstVectorReference<float> w, double b) const;
+    template double L2Regularizer::operator()(math::ColumnConstVectorReference<double> w, double b) const;
+    template double L2Regularizer::Conjugate(math::ColumnConstVectorReference<float> v, double d) const;
+    template double L2Regularizer::Conjugate(math::ColumnConstVectorReference<double> v, double d) const;
+    template void L2Regularizer::ConjugateGradient(math::ColumnConstVectorReference<float> v, math::ColumnVectorReference<float> w) const;
+    template void L2Regularizer::ConjugateGradient(math::ColumnConstVectorReference<double> v, math::ColumnVectorReference<double> w) const;
+    template void L2Regularizer::ConjugateGradient(math::ColumnConstVectorReference<float> v, double d, math::ColumnVectorReference<float> w, float& b) const;
+    template void L2Regularizer::ConjugateGradient(math::ColumnConstVectorReference<double> v, double d, math::ColumnVectorReference<double> w, double& b) const;
+}
 }
-}
\ No newline at end of file
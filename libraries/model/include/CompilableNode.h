@@ -44,6 +44,19 @@ namespace model
         /// <summary> Indicates if this node is able to compile itself to code. </summary>
         virtual bool IsCompilable() const { return true; }
 
+        /// <summary>
+        /// Returns the input whose memory the given output may share, so that the node computes in place. A node may
+        /// only return an input of the same type and size as the output, and only if it reads each element of that
+        /// input before it writes the element at the same position of the output, and reads no other element after
+        /// that. The compiler only shares the memory if no other node reads the input. The default implementation
+        /// returns `nullptr`, meaning the output always gets memory of its own.
+        /// </summary>
+        ///
+        /// <param name="output"> One of the output ports of this node. </param>
+        ///
+        /// <returns> The input port, or `nullptr` if the output can't share memory with an input. </returns>
+        virtual const InputPortBase* GetInPlaceInput(const OutputPortBase& output) const { return nullptr; }
+
     protected:
         CompilableNode(const std::vector<InputPortBase*>& inputs, const std::vector<OutputPortBase*>& outputs)
             : Node(inputs, outputs) {}
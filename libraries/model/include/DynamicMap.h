@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "ExecutionContext.h"
+#include "ExecutionPlan.h"
 #include "InputNode.h"
 #include "ModelTransformer.h"
 #include "Node.h"
@@ -17,12 +19,15 @@
 #include "DataVector.h"
 
 // utilities
+#include "ConformingVector.h"
 #include "Exception.h"
 #include "IArchivable.h"
 #include "StlIndexValueIterator.h"
 #include "TypeTraits.h"
 
 // stl
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -32,6 +37,8 @@ namespace ell
 {
 namespace model
 {
+    class ModelOptimizer;
+
     /// <summary> Class that wraps a model and its designated outputs </summary>
     class DynamicMap : public utilities::IArchivable
     {
@@ -70,20 +77,53 @@ namespace model
         /// <returns> The `Model` </returns>
         Model& GetModel() { return _model; }
 
-        /// <summary> Computes the map's output from input values </summary>
+        /// <summary>
+        /// Computes the map's output from input values. The values of the ports are kept in an
+        /// execution context for the call, so several threads can compute the same map at the same
+        /// time, as long as none of its nodes keeps a history of its inputs (such as moving averages
+        /// and delays) and the map is not compiled. After the call, the values are moved into the
+        /// ports under a lock of the map, so once all the calls are done the ports hold the values of
+        /// the call that finished last.
+        /// </summary>
         ///
         /// <param name="inputValues"> The input to the map </param>
         /// <returns> A vector of output values </returns>
         template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType> OutputConcept = 1, utilities::IsFundamental<InputType> InputConcept = 1>
         std::vector<OutputType> Compute(const std::vector<InputType>& inputValues) const;
 
-        /// <summary> Computes the map's output from input values </summary>
+        /// <summary> Computes the map's output from input values. </summary>
         ///
         /// <param name="inputValues"> The input to the map </param>
         /// <returns> A vector of output values </returns>
         template <typename OutputVectorType, typename InputVectorType, data::IsDataVector<OutputVectorType> OutputConcept = true, data::IsDataVector<InputVectorType> InputConcept = true>
         OutputVectorType Compute(const InputVectorType& inputValues) const;
 
+        /// <summary>
+        /// Computes the map's output from input values, reading from and writing to buffers owned by
+        /// the caller. `inputValues` holds GetInputSize() values and `outputValues` receives
+        /// GetOutputSize() values. No vector is returned, and a compiled map reads the input buffer
+        /// directly, so computing a compiled map this way does not allocate memory. The value types
+        /// must match the map's input and output types.
+        /// </summary>
+        ///
+        /// <param name="inputValues"> The input to the map </param>
+        /// <param name="outputValues"> The buffer that receives the output of the map </param>
+        template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType> OutputConcept = 1, utilities::IsFundamental<InputType> InputConcept = 1>
+        void Compute(const InputType* inputValues, OutputType* outputValues) const;
+
+        /// <summary>
+        /// Computes the map's output for a batch of inputs, one row after the other. The rows are
+        /// stored back to back, so `inputValues` holds N * GetInputSize() values and `outputValues`
+        /// is resized to hold N * GetOutputSize() values. Each row is read from `inputValues` and
+        /// written to `outputValues` in place, without a vector per row. The value types must match
+        /// the map's input and output types.
+        /// </summary>
+        ///
+        /// <param name="inputValues"> The rows of input to the map </param>
+        /// <param name="outputValues"> The vector that receives the rows of output </param>
+        template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType> OutputConcept = 1, utilities::IsFundamental<InputType> InputConcept = 1>
+        void ComputeBatch(const std::vector<InputType>& inputValues, std::vector<OutputType>& outputValues) const;
+
         /// <summary> Returns the size of the map's input </summary>
         ///
         /// <returns> The dimensionality of the map's input port </returns>
@@ -111,6 +151,16 @@ namespace model
         /// <param name="context"> The TransformContext to use during the transformation </param>
         void Transform(const std::function<void(const Node&, ModelTransformer&)>& transformFunction, const TransformContext& context);
 
+        /// <summary> Sets how the map computes independent parts of its model on several threads. </summary>
+        ///
+        /// <param name="parameters"> The parallel execution parameters. </param>
+        void SetParallelExecutionParameters(const ParallelExecutionParameters& parameters);
+
+        /// <summary> Returns the parameters for computing independent parts of the model on several threads. </summary>
+        ///
+        /// <returns> The parallel execution parameters. </returns>
+        const ParallelExecutionParameters& GetParallelExecutionParameters() const { return _parallelExecutionParameters; }
+
         //
         // ELL-Internal routines for getting information about inputs / outputs of the map
         // and doing type-safe operations.
@@ -274,6 +324,9 @@ namespace model
         template <typename DataVectorType, data::IsDataVector<DataVectorType> Concept = true>
         DataVectorType ComputeOutput(const PortElementsBase& elements) const;
 
+        template <typename ValueType>
+        void ComputeOutput(const PortElementsBase& elements, ValueType* outputValues) const;
+
         void AddInput(const std::string& inputName, InputNodeBase* inputNode);
         void AddOutput(const std::string& outputName, PortElementsBase outputElements);
         void Prune(); // prune away unused parts of internal model
@@ -287,13 +340,50 @@ namespace model
         virtual void SetNodeInput(InputNode<float>* node, const std::vector<float>& inputValues) const;
         virtual void SetNodeInput(InputNode<double>* node, const std::vector<double>& inputValues) const;
 
+        virtual void SetNodeInput(InputNode<bool>* node, const bool* inputValues) const;
+        virtual void SetNodeInput(InputNode<int>* node, const int* inputValues) const;
+        virtual void SetNodeInput(InputNode<int64_t>* node, const int64_t* inputValues) const;
+        virtual void SetNodeInput(InputNode<float>* node, const float* inputValues) const;
+        virtual void SetNodeInput(InputNode<double>* node, const double* inputValues) const;
+
         virtual std::vector<bool> ComputeBoolOutput(const PortElementsBase& outputs) const;
         virtual std::vector<int> ComputeIntOutput(const PortElementsBase& outputs) const;
         virtual std::vector<int64_t> ComputeInt64Output(const PortElementsBase& outputs) const;
         virtual std::vector<float> ComputeFloatOutput(const PortElementsBase& outputs) const;
         virtual std::vector<double> ComputeDoubleOutput(const PortElementsBase& outputs) const;
 
+        virtual void ComputeBoolOutput(const PortElementsBase& outputs, bool* outputValues) const;
+        virtual void ComputeIntOutput(const PortElementsBase& outputs, int* outputValues) const;
+        virtual void ComputeInt64Output(const PortElementsBase& outputs, int64_t* outputValues) const;
+        virtual void ComputeFloatOutput(const PortElementsBase& outputs, float* outputValues) const;
+        virtual void ComputeDoubleOutput(const PortElementsBase& outputs, double* outputValues) const;
+
     private:
+        friend class ModelOptimizer;
+
+        // an execution context of the map, which is current on the calling thread for the lifetime of the scope
+        class ComputeScope
+        {
+        public:
+            ComputeScope(const DynamicMap& map);
+
+            ComputeScope(const ComputeScope&) = delete;
+
+            ComputeScope& operator=(const ComputeScope&) = delete;
+
+            // gives the context back to the map, and moves its values into the ports if the computation is done
+            ~ComputeScope();
+
+            // marks the computation as done
+            void Done() { _isDone = true; }
+
+        private:
+            const DynamicMap& _map;
+            std::unique_ptr<ExecutionContext> _context;
+            ExecutionContext::Scope _scope;
+            bool _isDone = false;
+        };
+
         Model _model;
 
         std::vector<InputNodeBase*> _inputNodes;
@@ -304,8 +394,16 @@ namespace model
         std::vector<std::string> _outputNames;
         std::unordered_map<std::string, PortElementsBase> _outputElementsMap;
 
+        // plans for the sets of outputs computed so far, built on first use and discarded when the model changes
+        mutable ExecutionPlanCache _executionPlans;
+
+        ParallelExecutionParameters _parallelExecutionParameters;
+        std::shared_ptr<utilities::ThreadPool> _threadPool;
+
         std::vector<const Node*> GetOutputNodes();
         void FixTransformedIO(ModelTransformer& transformer);
+        const ExecutionPlan& GetExecutionPlan(const PortElementsBase& elements) const;
+        void ExecutePlan(const PortElementsBase& elements) const;
     };
 
     /// <summary> A serialization context used during model deserialization. Wraps an existing `SerializationContext`
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ExecutionContext.h (model)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    class OutputPortBase;
+
+    template <typename ValueType>
+    class OutputPort;
+
+    /// <summary>
+    /// The values of the output ports of a model during one computation, kept apart from the model
+    /// itself. While a context is current on a thread, output ports read and write their values in
+    /// the context instead of in the ports, and input nodes take their input from the context. The
+    /// context has storage for a fixed set of ports, and each port finds its values by its execution
+    /// index, which is its position in the set, so no lookup by port is needed. A context can be
+    /// reused for one computation after the other, and the storage of the values is reused with it.
+    /// Nodes that keep a history of their inputs (such as moving averages and delays) still keep it in
+    /// the node, which all the contexts share.
+    /// </summary>
+    class ExecutionContext
+    {
+    public:
+        /// <summary> Constructs a context with storage for the values of a set of output ports. </summary>
+        ///
+        /// <param name="ports"> The output ports, each of which must have its position in the set as its execution index. </param>
+        ExecutionContext(const std::vector<const OutputPortBase*>& ports);
+
+        ExecutionContext(const ExecutionContext&) = delete;
+
+        ExecutionContext& operator=(const ExecutionContext&) = delete;
+
+        /// <summary> Starts a new computation, after which no values are set in this context. </summary>
+        void Reset() { ++_computation; }
+
+        /// <summary> Marks the values of an output port as set in this context, and returns their storage. </summary>
+        ///
+        /// <typeparam name="ValueType"> The type of the port values. </typeparam>
+        /// <param name="port"> The output port. </param>
+        ///
+        /// <returns> The storage for the values, which the caller overwrites, or nullptr if this context has no storage for the port. </returns>
+        template <typename ValueType>
+        std::vector<ValueType>* SetOutput(const OutputPort<ValueType>& port);
+
+        /// <summary> Returns the values of an output port in this context. </summary>
+        ///
+        /// <typeparam name="ValueType"> The type of the port values. </typeparam>
+        /// <param name="port"> The output port. </param>
+        ///
+        /// <returns> The values, or nullptr if this context has no storage for the port. </returns>
+        template <typename ValueType>
+        const std::vector<ValueType>* GetOutput(const OutputPort<ValueType>& port) const;
+
+        /// <summary> Checks if the values of an output port were set in the current computation. </summary>
+        ///
+        /// <typeparam name="ValueType"> The type of the port values. </typeparam>
+        /// <param name="port"> The output port. </param>
+        ///
+        /// <returns> true if the values were set. </returns>
+        template <typename ValueType>
+        bool HasOutput(const OutputPort<ValueType>& port) const;
+
+        /// <summary>
+        /// Exchanges the values set in the current computation with the values held by the ports
+        /// themselves, so that they can still be read from the ports after the computation. No
+        /// memory is allocated, and the storage that the ports held is reused by the next computation.
+        /// </summary>
+        void MoveOutputsToPorts();
+
+        /// <summary> Returns the context that is current on the calling thread. </summary>
+        ///
+        /// <returns> The current context, or nullptr if the ports hold their own values. </returns>
+        static ExecutionContext* GetCurrent();
+
+        /// <summary> Makes a context current on the calling thread for the lifetime of the scope. </summary>
+        class Scope
+        {
+        public:
+            /// <summary> Makes a context current. </summary>
+            ///
+            /// <param name="context"> The context, or nullptr to let the ports hold their own values. </param>
+            Scope(ExecutionContext* context);
+
+            Scope(const Scope&) = delete;
+
+            Scope& operator=(const Scope&) = delete;
+
+            /// <summary> Restores the context that was current before. </summary>
+            ~Scope();
+
+        private:
+            ExecutionContext* _previousContext;
+        };
+
+    private:
+        struct BufferBase
+        {
+            virtual ~BufferBase() = default;
+            const OutputPortBase* port = nullptr;
+            size_t computation = 0;
+        };
+
+        template <typename ValueType>
+        struct Buffer : public BufferBase
+        {
+            std::vector<ValueType> values;
+        };
+
+        template <typename ValueType>
+        Buffer<ValueType>* GetBuffer(const OutputPort<ValueType>& port) const;
+
+        template <typename ValueType>
+        void AddBuffer(const OutputPortBase& port);
+
+        template <typename ValueType>
+        void MoveOutputToPort(BufferBase& buffer);
+
+        std::vector<std::unique_ptr<BufferBase>> _buffers;
+        size_t _computation = 1;
+    };
+}
+}
+
+#include "../tcc/ExecutionContext.tcc"
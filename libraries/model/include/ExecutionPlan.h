@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ExecutionPlan.h (model)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ExecutionContext.h"
+#include "Node.h"
+#include "PortElements.h"
+
+// utilities
+#include "ThreadPool.h"
+
+// stl
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    class Model;
+
+    /// <summary> Parameters for computing a model on several threads. </summary>
+    struct ParallelExecutionParameters
+    {
+        /// <summary> The number of threads, or 0 for one per hardware thread. With one thread, the nodes are computed in order on the calling thread. </summary>
+        size_t numThreads = 1;
+
+        /// <summary> The smallest estimated cost, in port elements, of the work that is handed to a thread at once. Cheaper nodes that become ready together are batched. </summary>
+        size_t minTaskCost = 1024;
+    };
+
+    /// <summary>
+    /// The nodes that are needed to compute a set of outputs of a model, sorted once in dependency
+    /// order. Executing the plan computes each node in turn, without traversing the model graph. A plan
+    /// refers to the nodes of the model it was made from, and it remains valid as long as the model
+    /// exists, because the inputs of a node never change after the node is added to a model.
+    ///
+    /// For parallel execution, the plan also groups the nodes into tasks, each a chain of nodes that
+    /// depend only on the one before them, and records the dependencies between the tasks. A task
+    /// is started as soon as the tasks it depends on are done, so independent branches of the model
+    /// are computed at the same time.
+    /// </summary>
+    class ExecutionPlan
+    {
+    public:
+        ExecutionPlan() = default;
+
+        /// <summary> Constructs the plan for computing the outputs of a set of nodes. </summary>
+        ///
+        /// <param name="model"> The model that contains the nodes. </param>
+        /// <param name="outputNodes"> The nodes whose outputs the plan computes. </param>
+        ExecutionPlan(const Model& model, const std::vector<const Node*>& outputNodes);
+
+        /// <summary> Constructs the plan for computing a set of output elements. </summary>
+        ///
+        /// <param name="model"> The model that contains the elements. </param>
+        /// <param name="elements"> The output elements that the plan computes. </param>
+        ExecutionPlan(const Model& model, const PortElementsBase& elements);
+
+        /// <summary> Computes all the nodes in the plan, in dependency order. </summary>
+        void Execute() const;
+
+        /// <summary> Computes all the nodes in the plan on the threads of a thread pool and on the calling thread, which waits until they are done. </summary>
+        ///
+        /// <param name="threadPool"> The thread pool. </param>
+        /// <param name="minTaskCost"> The smallest estimated cost, in port elements, of the work that is handed to a thread at once. </param>
+        void Execute(utilities::ThreadPool& threadPool, size_t minTaskCost) const;
+
+        /// <summary> Computes all the nodes in the plan and returns the values of a set of output elements. </summary>
+        ///
+        /// <typeparam name="ValueType"> The type of the output values. </typeparam>
+        /// <param name="elements"> The output elements, which must be computed by this plan. </param>
+        ///
+        /// <returns> The output values. </returns>
+        template <typename ValueType>
+        std::vector<ValueType> ComputeOutput(const PortElementsBase& elements) const;
+
+        /// <summary> Returns the nodes in the plan, in the order in which they are computed. </summary>
+        ///
+        /// <returns> The nodes. </returns>
+        const std::vector<const Node*>& GetNodes() const { return _nodes; }
+
+        /// <summary> Returns the number of tasks that the nodes are grouped into for parallel execution. </summary>
+        ///
+        /// <returns> The number of tasks. </returns>
+        size_t NumTasks() const { return _tasks.size(); }
+
+        /// <summary> Returns the nodes whose outputs the plan computes, sorted by address. </summary>
+        ///
+        /// <returns> The output nodes. </returns>
+        const std::vector<const Node*>& GetOutputNodes() const { return _outputNodes; }
+
+        /// <summary> Returns the nodes that own a set of output elements, sorted by address, in the form returned by GetOutputNodes. </summary>
+        ///
+        /// <param name="elements"> The output elements. </param>
+        ///
+        /// <returns> The nodes. </returns>
+        static std::vector<const Node*> GetOutputNodes(const PortElementsBase& elements);
+
+    private:
+        // a chain of nodes, each of which is the only dependent of the one before it
+        struct Task
+        {
+            std::vector<const Node*> nodes;
+            std::vector<size_t> dependents;
+            size_t numDependencies = 0;
+            size_t cost = 0;
+        };
+
+        class ParallelExecution;
+
+        void BuildTasks();
+
+        std::vector<const Node*> _nodes;
+        std::vector<const Node*> _outputNodes;
+        std::vector<Task> _tasks;
+        std::vector<size_t> _initialTasks;
+    };
+
+    /// <summary>
+    /// The execution plans of a model, one for each set of output nodes that was computed, built on
+    /// first use, and the execution contexts for computing the model. The first time a context is
+    /// needed, every output port of the model is given its execution index, and contexts that are
+    /// released are kept for reuse, so a computation neither looks up its ports nor allocates their
+    /// storage again. The cache can be used by several threads at the same time. A copy of a cache
+    /// is empty, because the plans refer to the nodes of one model.
+    /// </summary>
+    class ExecutionPlanCache
+    {
+    public:
+        ExecutionPlanCache() = default;
+
+        /// <summary> Constructs an empty cache. </summary>
+        ExecutionPlanCache(const ExecutionPlanCache&) {}
+
+        /// <summary> Move constructor, which takes the plans of the other cache. </summary>
+        ///
+        /// <param name="other"> The other cache. </param>
+        ExecutionPlanCache(ExecutionPlanCache&& other);
+
+        /// <summary> Removes the plans from this cache. </summary>
+        ExecutionPlanCache& operator=(const ExecutionPlanCache&);
+
+        /// <summary> Move assignment, which takes the plans of the other cache. </summary>
+        ///
+        /// <param name="other"> The other cache. </param>
+        ExecutionPlanCache& operator=(ExecutionPlanCache&& other);
+
+        /// <summary> Returns the plan for computing a set of output elements, and builds it if it is not in the cache. </summary>
+        ///
+        /// <param name="model"> The model that contains the elements. </param>
+        /// <param name="elements"> The output elements. </param>
+        ///
+        /// <returns> The plan, which remains valid until the cache is cleared. </returns>
+        const ExecutionPlan& GetPlan(const Model& model, const PortElementsBase& elements);
+
+        /// <summary> Returns an execution context with storage for the values of every output port of the model, ready for a new computation. </summary>
+        ///
+        /// <param name="model"> The model. </param>
+        ///
+        /// <returns> A context that was released before, or a new one if there is none. </returns>
+        std::unique_ptr<ExecutionContext> GetContext(const Model& model);
+
+        /// <summary>
+        /// Keeps an execution context for reuse, and optionally moves the values of its computation
+        /// into the output ports first. Contexts that are released at the same time move their values
+        /// one after the other, so the ports always hold the values of one whole computation.
+        /// </summary>
+        ///
+        /// <param name="context"> The context, which must have been returned by GetContext. </param>
+        /// <param name="moveOutputsToPorts"> Whether to move the values of the context into the ports. </param>
+        void ReleaseContext(std::unique_ptr<ExecutionContext> context, bool moveOutputsToPorts);
+
+        /// <summary> Removes the plans and the contexts from this cache, which must be done whenever the model changes. </summary>
+        void Clear();
+
+    private:
+        std::mutex _mutex;
+        std::vector<std::unique_ptr<ExecutionPlan>> _plans;
+        std::vector<const OutputPortBase*> _ports;
+        std::vector<std::unique_ptr<ExecutionContext>> _contexts;
+    };
+
+    /// <summary> Copies the current values of a set of output elements, one range at a time. </summary>
+    ///
+    /// <typeparam name="ValueType"> The type of the output values. </typeparam>
+    /// <param name="elements"> The output elements. </param>
+    ///
+    /// <returns> The output values. </returns>
+    template <typename ValueType>
+    std::vector<ValueType> GetOutputValues(const PortElementsBase& elements);
+
+    /// <summary> Copies the current values of a set of output elements into a buffer, one range at a time. </summary>
+    ///
+    /// <typeparam name="ValueType"> The type of the output values. </typeparam>
+    /// <param name="elements"> The output elements. </param>
+    /// <param name="outputValues"> The buffer that receives the output values, which must hold elements.Size() values. </param>
+    template <typename ValueType>
+    void CopyOutputValues(const PortElementsBase& elements, ValueType* outputValues);
+}
+}
+
+#include "../tcc/ExecutionPlan.tcc"
@@ -29,7 +29,9 @@
 #include "TypeName.h"
 
 // stl
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -96,6 +98,32 @@ namespace model
         /// <returns> A string with the function prototype </returns>
         virtual std::string GetCodeHeaderString() const override;
 
+        using DynamicMap::Compute;
+
+        /// <summary>
+        /// Computes the map's output from input values, reading from and writing to buffers owned by
+        /// the caller. The compiled function reads `inputValues` and writes its output straight into
+        /// `outputValues`, so nothing is allocated or copied. The value types must match the map's
+        /// input and output types.
+        /// </summary>
+        ///
+        /// <param name="inputValues"> The input to the map, which holds GetInputSize() values </param>
+        /// <param name="outputValues"> The buffer that receives the GetOutputSize() values of the output </param>
+        template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType> OutputConcept = 1, utilities::IsFundamental<InputType> InputConcept = 1>
+        void Compute(const InputType* inputValues, OutputType* outputValues) const;
+
+        /// <summary>
+        /// Computes the map's output for a batch of inputs with a single call to the emitted batch
+        /// function, which loops over the rows in the generated code. The rows are stored back to
+        /// back, so `inputValues` holds N * GetInputSize() values and `outputValues` is resized to
+        /// hold N * GetOutputSize() values. The value types must match the map's input and output types.
+        /// </summary>
+        ///
+        /// <param name="inputValues"> The rows of input to the map </param>
+        /// <param name="outputValues"> The vector that receives the rows of output </param>
+        template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType> OutputConcept = 1, utilities::IsFundamental<InputType> InputConcept = 1>
+        void ComputeBatch(const std::vector<InputType>& inputValues, std::vector<OutputType>& outputValues) const;
+
         /// <summary> Gets the name of this type (for serialization). </summary>
         ///
         /// <returns> The name of this type. </returns>
@@ -180,12 +208,24 @@ namespace model
         virtual void SetNodeInput(model::InputNode<float>* node, const std::vector<float>& inputValues) const override;
         virtual void SetNodeInput(model::InputNode<double>* node, const std::vector<double>& inputValues) const override;
 
+        virtual void SetNodeInput(model::InputNode<bool>* node, const bool* inputValues) const override;
+        virtual void SetNodeInput(model::InputNode<int>* node, const int* inputValues) const override;
+        virtual void SetNodeInput(model::InputNode<int64_t>* node, const int64_t* inputValues) const override;
+        virtual void SetNodeInput(model::InputNode<float>* node, const float* inputValues) const override;
+        virtual void SetNodeInput(model::InputNode<double>* node, const double* inputValues) const override;
+
         virtual std::vector<bool> ComputeBoolOutput(const model::PortElementsBase& outputs) const override;
         virtual std::vector<int> ComputeIntOutput(const model::PortElementsBase& outputs) const override;
         virtual std::vector<int64_t> ComputeInt64Output(const model::PortElementsBase& outputs) const override;
         virtual std::vector<float> ComputeFloatOutput(const model::PortElementsBase& outputs) const override;
         virtual std::vector<double> ComputeDoubleOutput(const model::PortElementsBase& outputs) const override;
 
+        virtual void ComputeBoolOutput(const model::PortElementsBase& outputs, bool* outputValues) const override;
+        virtual void ComputeIntOutput(const model::PortElementsBase& outputs, int* outputValues) const override;
+        virtual void ComputeInt64Output(const model::PortElementsBase& outputs, int64_t* outputValues) const override;
+        virtual void ComputeFloatOutput(const model::PortElementsBase& outputs, float* outputValues) const override;
+        virtual void ComputeDoubleOutput(const model::PortElementsBase& outputs, double* outputValues) const override;
+
     private:
         friend class IRMapCompiler;
     
@@ -201,10 +241,15 @@ namespace model
         void SetComputeFunction() const;
         template <typename InputType>
         void SetComputeFunctionForInputType() const;
+        uint64_t ResolveComputeFunction() const;
+        uint64_t ResolveComputeBatchFunction() const;
 
         template <typename InputType>
         using ComputeFunction = std::function<void(const InputType*)>;
 
+        template <typename InputType, typename OutputType>
+        using ComputeBatchFunction = void (*)(int32_t, const InputType*, OutputType*);
+
         std::string _moduleName = "ELL";
         std::unique_ptr<emitters::IRModuleEmitter> _module;
 
@@ -10,6 +10,7 @@
 
 #include "IRCompiledMap.h"
 #include "MapCompiler.h"
+#include "MemoryPlan.h"
 
 // emitters
 #include "EmitterException.h"
@@ -56,6 +57,22 @@ namespace model
         /// <returns> The CompilerParameters struct used by the IR emitter to control code generation. </returns>
         emitters::CompilerParameters GetCompilerParameters() const { return GetModule().GetCompilerParameters(); }
 
+        /// <summary> Gets the name of the emitted function that evaluates a map on a batch of inputs. </summary>
+        ///
+        /// <param name="predictFunctionName"> The name of the function that evaluates the map on a single input. </param>
+        ///
+        /// <returns> The name of the batch function. </returns>
+        static std::string GetPredictBatchFunctionName(const std::string& predictFunctionName);
+
+        /// <summary>
+        /// Gets the plan for sharing the memory of the port values of the map that was compiled, if `sharePortMemory`
+        /// is set. The size of the arena is the peak memory taken by the port values that aren't function arguments,
+        /// constants or scalars.
+        /// </summary>
+        ///
+        /// <returns> The memory plan, which is empty if the port memory isn't shared. </returns>
+        const MemoryPlan& GetMemoryPlan() const { return _memoryPlan; }
+
         //
         // Routines useful to Node implementers
         //
@@ -146,6 +163,7 @@ namespace model
         virtual void OnEndCompileModel(const Model& model) override;
         virtual void OnBeginCompileNode(const Node& node) override;
         virtual void OnEndCompileNode(const Node& node) override;
+        virtual std::vector<const Node*> GetNodeCompileOrder(const Model& model) override;
         virtual void PushScope() override;
         virtual void PopScope() override;
         virtual emitters::ModuleEmitter* GetModuleEmitter() override { return &_moduleEmitter; }
@@ -167,9 +185,16 @@ namespace model
         void EmitGetInputSizeFunction(const DynamicMap& map);
         void EmitGetOutputSizeFunction(const DynamicMap& map);
         void EmitGetNumNodesFunction(const DynamicMap& map);
+        void EmitPredictBatchFunction(const DynamicMap& map);
+        void AllocatePortMemory(const Model& model);
+        const OutputPortBase* GetInPlaceInputPort(const OutputPortBase& output) const;
+        bool TryComputeInPlace(const OutputPortBase& output);
+        bool IsPortMemoryShared() const { return _memoryPlan.NumPorts() > 0; }
 
         // stack of node regions
         std::vector<NodeMap<emitters::IRBlockRegion*>> _nodeRegions;
+
+        MemoryPlan _memoryPlan;
     };
 }
 }
@@ -73,16 +73,21 @@ namespace model
         /// <param name="size"> The input size </param>
         InputNode(size_t size);
 
-        /// <summary> Sets the value output by this node </summary>
+        /// <summary> Sets the value output by this node, or by this node in the current execution context </summary>
         ///
         /// <param name="inputValues"> The value for this node to output </param>
         void SetInput(ValueType inputValue);
 
-        /// <summary> Sets the value output by this node </summary>
+        /// <summary> Sets the value output by this node, or by this node in the current execution context </summary>
         ///
         /// <param name="inputValues"> The values for this node to output </param>
         void SetInput(std::vector<ValueType> inputValues);
 
+        /// <summary> Sets the value output by this node, or by this node in the current execution context </summary>
+        ///
+        /// <param name="inputValues"> A buffer that holds the Size() values for this node to output </param>
+        void SetInput(const ValueType* inputValues);
+
         /// <summary> Gets the name of this type (for serialization). </summary>
         ///
         /// <returns> The name of this type. </returns>
@@ -17,6 +17,7 @@
 // model
 #include "DynamicMap.h"
 #include "Model.h"
+#include "ModelOptimizer.h"
 #include "Node.h"
 #include "OutputPort.h"
 #include "PortElements.h"
@@ -25,6 +26,7 @@
 #include <stack>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace ell
 {
@@ -36,6 +38,10 @@ namespace model
         std::string mapFunctionName = "predict";
         bool inlineNodes = false;
         bool fuseLinearFunctionNodes = false;
+        bool optimizeModel = true;
+        bool sharePortMemory = false; // keep the port values of the compiled map in one arena, reusing the memory of ports that are no longer needed
+        size_t portMemoryAlignment = 16;
+        bool computeInPlace = true; // let the nodes that support it write their output over an input that no other node reads
         bool profile = false;
 
         emitters::CompilerParameters compilerSettings;
@@ -58,6 +64,14 @@ namespace model
         /// <returns> The MapCompilerParameters struct used by the map compiler to control code generation. </returns>
         MapCompilerParameters GetMapCompilerParameters() const { return _parameters; }
 
+        /// <summary>
+        /// Gets the optimization passes that run on the refined map before it is compiled, if `optimizeModel` is set.
+        /// Initially only holds common subexpression elimination; passes that need specific node types can be added.
+        /// </summary>
+        ///
+        /// <returns> The model optimizer used by the map compiler. </returns>
+        ModelOptimizer& GetModelOptimizer() { return _optimizer; }
+
         //
         // Routines for Node implementers
         //
@@ -114,6 +128,7 @@ namespace model
         virtual void OnEndCompileModel(const Model& model) {}
         virtual void OnBeginCompileNode(const Node& node) {}
         virtual void OnEndCompileNode(const Node& node) {}
+        virtual std::vector<const Node*> GetNodeCompileOrder(const Model& model);
         virtual void PushScope();
         virtual void PopScope();
         virtual emitters::ModuleEmitter* GetModuleEmitter() = 0;
@@ -132,6 +147,7 @@ namespace model
         emitters::Variable* AllocateNodeFunctionArgument(emitters::ModuleEmitter& emitter, const PortElementBase& element, ArgType argType);
 
         MapCompilerParameters _parameters;
+        ModelOptimizer _optimizer;
         // map from ports to runtime variables, for all ports in the model
         // stored as a stack, with the top of the stack being the innermost scope
         std::vector<std::unordered_map<const Port*, emitters::Variable*>> _portToVarMaps; // Do we need separate elementToVarMaps?
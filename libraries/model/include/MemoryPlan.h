@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MemoryPlan.h (model)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Node.h"
+#include "OutputPort.h"
+
+// stl
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    class Model;
+
+    /// <summary>
+    /// A plan for keeping the values of the output ports of a model in one shared block of memory, the arena. The
+    /// plan first picks an order for the nodes that keeps few port values alive at once. In that order, a port is
+    /// alive from the node that writes it to the last node that reads it, and ports that are never alive at the same
+    /// time are given overlapping regions of the arena. Each region starts at a multiple of the alignment. A port that
+    /// is computed in place overwrites the port it is computed from, and takes the same region.
+    /// </summary>
+    class MemoryPlan
+    {
+    public:
+        /// <summary> A function that indicates if a port is stored in the arena. </summary>
+        using PortFilter = std::function<bool(const OutputPortBase&)>;
+
+        /// <summary> A function that returns the port a port may overwrite, or `nullptr` if the port isn't computed in place. </summary>
+        using PortAlias = std::function<const OutputPortBase*(const OutputPortBase&)>;
+
+        MemoryPlan() = default;
+
+        /// <summary> Constructs the plan for a model. </summary>
+        ///
+        /// <param name="model"> The model. </param>
+        /// <param name="portFilter"> Indicates which output ports are stored in the arena. The other ports keep their own memory. </param>
+        /// <param name="alignment"> The alignment, in bytes, of the region of each port in the arena. </param>
+        /// <param name="portAlias"> Indicates which port each port may overwrite. A port only overwrites another one if
+        /// both are stored in the arena, and if its node is the only one that reads the other port. </param>
+        MemoryPlan(const Model& model, const PortFilter& portFilter, size_t alignment, const PortAlias& portAlias = nullptr);
+
+        /// <summary> Returns the nodes of the model, in the order in which they must be computed for the plan to be valid. </summary>
+        ///
+        /// <returns> The nodes. </returns>
+        const std::vector<const Node*>& GetNodes() const { return _nodes; }
+
+        /// <summary> Indicates if a port is stored in the arena. </summary>
+        ///
+        /// <param name="port"> The port. </param>
+        ///
+        /// <returns> true if the port is stored in the arena. </returns>
+        bool HasPort(const OutputPortBase& port) const { return _offsets.find(&port) != _offsets.end(); }
+
+        /// <summary> Returns the offset of the region of a port in the arena. </summary>
+        ///
+        /// <param name="port"> The port, which must be stored in the arena. </param>
+        ///
+        /// <returns> The offset, in bytes. </returns>
+        size_t GetPortOffset(const OutputPortBase& port) const;
+
+        /// <summary> Returns the port that a port overwrites, if it is computed in place. </summary>
+        ///
+        /// <param name="port"> The port. </param>
+        ///
+        /// <returns> The overwritten port, or `nullptr` if the port isn't computed in place. </returns>
+        const OutputPortBase* GetOverwrittenPort(const OutputPortBase& port) const;
+
+        /// <summary> Returns the number of ports stored in the arena. </summary>
+        ///
+        /// <returns> The number of ports. </returns>
+        size_t NumPorts() const { return _offsets.size(); }
+
+        /// <summary> Returns the size of the arena, which is the peak memory taken by the ports stored in it. </summary>
+        ///
+        /// <returns> The size, in bytes. </returns>
+        size_t GetArenaSize() const { return _arenaSize; }
+
+        /// <summary> Returns the memory that the ports stored in the arena would take if each had memory of its own. </summary>
+        ///
+        /// <returns> The size, in bytes. </returns>
+        size_t GetUnsharedSize() const { return _unsharedSize; }
+
+        /// <summary> Returns the memory taken by the values of a port. </summary>
+        ///
+        /// <param name="port"> The port. </param>
+        ///
+        /// <returns> The size, in bytes. </returns>
+        static size_t GetPortMemorySize(const OutputPortBase& port);
+
+    private:
+        std::vector<const Node*> _nodes;
+        std::unordered_map<const OutputPortBase*, size_t> _offsets;
+        std::unordered_map<const OutputPortBase*, const OutputPortBase*> _overwrittenPorts;
+        size_t _arenaSize = 0;
+        size_t _unsharedSize = 0;
+    };
+}
+}
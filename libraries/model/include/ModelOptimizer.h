@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ModelOptimizer.h (model)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Model.h"
+#include "ModelTransformer.h"
+#include "Node.h"
+
+// stl
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    class DynamicMap;
+
+    /// <summary>
+    /// Base class for graph-level optimizations. A pass rewrites a model one node at a time, in dependency order,
+    /// into the model being built by a ModelTransformer. Nodes that the pass leaves without dependents are removed
+    /// by dead-node elimination after the pass is done.
+    /// </summary>
+    class ModelOptimizationPass
+    {
+    public:
+        virtual ~ModelOptimizationPass() = default;
+
+        /// <summary> Gets the name of this pass. </summary>
+        ///
+        /// <returns> The name of this pass. </returns>
+        virtual std::string GetName() const = 0;
+
+        /// <summary> Prepares the pass to transform a model. Called before the first node of the model is transformed. </summary>
+        ///
+        /// <param name="model"> The model about to be transformed. </param>
+        virtual void Initialize(const Model& model) {}
+
+        /// <summary> Transforms a node, either by copying it or by replacing it with other nodes in the new model. </summary>
+        ///
+        /// <param name="node"> The node to transform. </param>
+        /// <param name="transformer"> The transformer building the new model. </param>
+        virtual void TransformNode(const Node& node, ModelTransformer& transformer) = 0;
+    };
+
+    /// <summary>
+    /// Common subexpression elimination. Merges pure nodes that have the same type, the same inputs and the same
+    /// archived properties, which also removes duplicate constants.
+    /// </summary>
+    class CommonSubexpressionEliminationPass : public ModelOptimizationPass
+    {
+    public:
+        /// <summary> Gets the name of this pass. </summary>
+        ///
+        /// <returns> The name of this pass. </returns>
+        virtual std::string GetName() const override { return "CommonSubexpressionElimination"; }
+
+        /// <summary> Prepares the pass to transform a model. </summary>
+        ///
+        /// <param name="model"> The model about to be transformed. </param>
+        virtual void Initialize(const Model& model) override;
+
+        /// <summary> Copies a node, unless an identical node is already in the new model. </summary>
+        ///
+        /// <param name="node"> The node to transform. </param>
+        /// <param name="transformer"> The transformer building the new model. </param>
+        virtual void TransformNode(const Node& node, ModelTransformer& transformer) override;
+
+    private:
+        struct Candidate
+        {
+            const Node* node;
+            std::string signature;
+        };
+
+        const std::string& GetSignature(Candidate& candidate);
+
+        // candidate nodes in the new model, grouped by type and inputs
+        std::unordered_map<std::string, std::vector<Candidate>> _candidates;
+    };
+
+    /// <summary> A sequence of optimization passes to run on a map before it is computed or compiled. </summary>
+    class ModelOptimizer
+    {
+    public:
+        /// <summary> Adds a pass to the end of the sequence. </summary>
+        ///
+        /// <param name="pass"> The pass to add. </param>
+        void AddPass(std::unique_ptr<ModelOptimizationPass> pass);
+
+        /// <summary> Gets the number of passes in the sequence. </summary>
+        ///
+        /// <returns> The number of passes. </returns>
+        size_t NumPasses() const { return _passes.size(); }
+
+        /// <summary> Gets a pass by index. </summary>
+        ///
+        /// <param name="index"> The index of the pass. </param>
+        ///
+        /// <returns> The pass. </returns>
+        ModelOptimizationPass& GetPass(size_t index) { return *_passes[index]; }
+
+        /// <summary>
+        /// Optimizes the model wrapped by a map. Runs the passes in order, removing the nodes that the outputs of
+        /// the map do not depend on after each pass, and repeats the sequence until the model stops shrinking.
+        /// </summary>
+        ///
+        /// <param name="map"> The map to optimize. </param>
+        /// <param name="context"> The TransformContext to use during the transformations. </param>
+        /// <param name="maxIterations"> The maximum number of times to run the sequence of passes. </param>
+        void Optimize(DynamicMap& map, const TransformContext& context, int maxIterations = 10);
+
+    private:
+        std::vector<std::unique_ptr<ModelOptimizationPass>> _passes;
+    };
+}
+}
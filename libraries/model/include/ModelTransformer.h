@@ -256,6 +256,12 @@ namespace model
         template <typename ValueType>
         void MapNodeOutput(const OutputPort<ValueType>& oldPort, const PortElementsBase& newElements);
 
+        /// <summary> Sets up an old-to-new model output mapping. Called by code that transforms nodes of unknown type. </summary>
+        ///
+        /// <param name="oldPort"> The port in the old model to map to the new model. </param>
+        /// <param name="newElements"> The elements in the new model to be mapped from the old model. </param>
+        void MapNodeOutput(const OutputPortBase& oldPort, const PortElementsBase& newElements);
+
         /// <summary> Get the context used by the transformer. Called by node implementors </summary>
         ///
         /// <returns> The context in use by the transformer. </returns>
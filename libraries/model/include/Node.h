@@ -140,6 +140,12 @@ namespace model
         /// <summary> Indicates if this node is able to compile itself to code. </summary>
         virtual bool IsCompilable() const { return false; }
 
+        /// <summary>
+        /// Indicates if the outputs of this node depend only on its inputs and on the properties it writes to an archive.
+        /// Optimization passes may evaluate a pure node ahead of time or merge it with an identical node.
+        /// </summary>
+        virtual bool IsPure() const { return false; }
+
         /// <summary> Makes a copy of this node into the model being constructed by the transformer </summary>
         ///
         /// <param name="transformer"> The `ModelTransformer` object currently creating a new model </param>
@@ -164,6 +170,7 @@ namespace model
         void AddOutputPort(OutputPortBase* output);
 
     private:
+        friend class ExecutionPlan;
         friend class Model;
         friend class ModelTransformer;
         void AddDependent(const Node* dependent) const;
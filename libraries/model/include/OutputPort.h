@@ -8,13 +8,16 @@
 
 #pragma once
 
+#include "ExecutionContext.h"
 #include "Port.h"
 
 // utilities
 #include "IArchivable.h"
 
 // stl
+#include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace ell
@@ -58,6 +61,16 @@ namespace model
         /// <returns> Returns true if the port is referenced by another node. </returns>
         bool IsReferenced() const { return _isReferenced; }
 
+        /// <summary> Returns the index of this port's values in the execution contexts of its map. </summary>
+        ///
+        /// <returns> The execution index. </returns>
+        size_t GetExecutionIndex() const { return _executionIndex; }
+
+        /// <summary> Sets the index of this port's values in the execution contexts of its map. </summary>
+        ///
+        /// <param name="index"> The execution index. </param>
+        void SetExecutionIndex(size_t index) const { _executionIndex = index; }
+
         /// <summary> Gets the name of this type (for serialization). </summary>
         ///
         /// <returns> The name of this type. </returns>
@@ -93,6 +106,7 @@ namespace model
     protected:
         size_t _size = 0;
         mutable bool _isReferenced;
+        mutable size_t _executionIndex = std::numeric_limits<size_t>::max();
     };
 
     /// <summary> Represents an output from a node </summary>
@@ -110,10 +124,10 @@ namespace model
         /// <param name="size"> The size of this port </param>
         OutputPort(const class Node* node, std::string name, size_t size);
 
-        /// <summary> Returns the cached output from this port </summary>
+        /// <summary> Returns the cached output from this port, or its output in the current execution context </summary>
         ///
         /// <returns> The cached output from this port </returns>
-        const std::vector<ValueType>& GetOutput() const { return _cachedOutput; }
+        const std::vector<ValueType>& GetOutput() const;
 
         /// <summary> Returns one element of the cached output from this port </summary>
         ///
@@ -133,7 +147,7 @@ namespace model
         /// <returns> The output element, converted to a `double`. </returns>
         virtual double GetDoubleOutput(size_t index) const override;
 
-        /// <summary> Sets the cached output from this port </summary>
+        /// <summary> Sets the cached output from this port, or its output in the current execution context </summary>
         ///
         /// <param name=values> The values this port should output </param>
         void SetOutput(std::vector<ValueType> values) const;
@@ -159,6 +173,8 @@ namespace model
         virtual void ReadFromArchive(utilities::Unarchiver& archiver) override;
 
     private:
+        friend class ExecutionContext;
+
         mutable std::vector<ValueType> _cachedOutput;
     };
 }
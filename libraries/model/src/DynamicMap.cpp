@@ -58,6 +58,10 @@ namespace model
         }
 
         FixTransformedIO(transformer);
+
+        // the copies share the worker threads
+        _parallelExecutionParameters = other._parallelExecutionParameters;
+        _threadPool = other._threadPool;
     }
 
     DynamicMap& DynamicMap::operator=(DynamicMap other)
@@ -91,29 +95,89 @@ namespace model
         node->SetInput(inputValues);
     }
 
+    void DynamicMap::SetNodeInput(InputNode<bool>* node, const bool* inputValues) const
+    {
+        node->SetInput(inputValues);
+    }
+
+    void DynamicMap::SetNodeInput(InputNode<int>* node, const int* inputValues) const
+    {
+        node->SetInput(inputValues);
+    }
+
+    void DynamicMap::SetNodeInput(InputNode<int64_t>* node, const int64_t* inputValues) const
+    {
+        node->SetInput(inputValues);
+    }
+
+    void DynamicMap::SetNodeInput(InputNode<float>* node, const float* inputValues) const
+    {
+        node->SetInput(inputValues);
+    }
+
+    void DynamicMap::SetNodeInput(InputNode<double>* node, const double* inputValues) const
+    {
+        node->SetInput(inputValues);
+    }
+
     std::vector<bool> DynamicMap::ComputeBoolOutput(const PortElementsBase& outputs) const
     {
-        return _model.ComputeOutput<bool>(outputs);
+        ExecutePlan(outputs);
+        return GetOutputValues<bool>(outputs);
     }
 
     std::vector<int> DynamicMap::ComputeIntOutput(const PortElementsBase& outputs) const
     {
-        return _model.ComputeOutput<int>(outputs);
+        ExecutePlan(outputs);
+        return GetOutputValues<int>(outputs);
     }
 
     std::vector<int64_t> DynamicMap::ComputeInt64Output(const PortElementsBase& outputs) const
     {
-        return _model.ComputeOutput<int64_t>(outputs);
+        ExecutePlan(outputs);
+        return GetOutputValues<int64_t>(outputs);
     }
 
     std::vector<float> DynamicMap::ComputeFloatOutput(const PortElementsBase& outputs) const
     {
-        return _model.ComputeOutput<float>(outputs);
+        ExecutePlan(outputs);
+        return GetOutputValues<float>(outputs);
     }
 
     std::vector<double> DynamicMap::ComputeDoubleOutput(const PortElementsBase& outputs) const
     {
-        return _model.ComputeOutput<double>(outputs);
+        ExecutePlan(outputs);
+        return GetOutputValues<double>(outputs);
+    }
+
+    void DynamicMap::ComputeBoolOutput(const PortElementsBase& outputs, bool* outputValues) const
+    {
+        ExecutePlan(outputs);
+        CopyOutputValues(outputs, outputValues);
+    }
+
+    void DynamicMap::ComputeIntOutput(const PortElementsBase& outputs, int* outputValues) const
+    {
+        ExecutePlan(outputs);
+        CopyOutputValues(outputs, outputValues);
+    }
+
+    void DynamicMap::ComputeInt64Output(const PortElementsBase& outputs, int64_t* outputValues) const
+    {
+        ExecutePlan(outputs);
+        CopyOutputValues(outputs, outputValues);
+    }
+
+    void DynamicMap::ComputeFloatOutput(const PortElementsBase& outputs, float* outputValues) const
+    {
+        ExecutePlan(outputs);
+        CopyOutputValues(outputs, outputValues);
+    }
+
+    void DynamicMap::ComputeDoubleOutput(const PortElementsBase& outputs, double* outputValues) const
+    {
+        ExecutePlan(outputs);
+        CopyOutputValues(outputs, outputValues);
     }
 
     template <>
@@ -146,6 +210,36 @@ namespace model
         return ComputeDoubleOutput(elements);
     }
 
+    template <>
+    void DynamicMap::ComputeOutput<bool>(const PortElementsBase& elements, bool* outputValues) const
+    {
+        ComputeBoolOutput(elements, outputValues);
+    }
+
+    template <>
+    void DynamicMap::ComputeOutput<int>(const PortElementsBase& elements, int* outputValues) const
+    {
+        ComputeIntOutput(elements, outputValues);
+    }
+
+    template <>
+    void DynamicMap::ComputeOutput<int64_t>(const PortElementsBase& elements, int64_t* outputValues) const
+    {
+        ComputeInt64Output(elements, outputValues);
+    }
+
+    template <>
+    void DynamicMap::ComputeOutput<float>(const PortElementsBase& elements, float* outputValues) const
+    {
+        ComputeFloatOutput(elements, outputValues);
+    }
+
+    template <>
+    void DynamicMap::ComputeOutput<double>(const PortElementsBase& elements, double* outputValues) const
+    {
+        ComputeDoubleOutput(elements, outputValues);
+    }
+
     void DynamicMap::AddInput(const std::string& inputName, InputNodeBase* inputNode)
     {
         _inputNodes.push_back(inputNode);
@@ -165,6 +259,7 @@ namespace model
         assert(index >= 0 && index <= _outputElements.size() && "Error: Resetting unset output");
         _outputElements[index] = outputElements;
         _outputElementsMap[_outputNames[index]] = outputElements;
+        _executionPlans.Clear();
     }
 
     void swap(DynamicMap& a, DynamicMap& b)
@@ -177,6 +272,47 @@ namespace model
         swap(a._outputElements, b._outputElements);
         swap(a._outputNames, b._outputNames);
         swap(a._outputElementsMap, b._outputElementsMap);
+        swap(a._executionPlans, b._executionPlans);
+        swap(a._parallelExecutionParameters, b._parallelExecutionParameters);
+        swap(a._threadPool, b._threadPool);
+    }
+
+    DynamicMap::ComputeScope::ComputeScope(const DynamicMap& map)
+        : _map(map), _context(map._executionPlans.GetContext(map._model)), _scope(_context.get())
+    {
+    }
+
+    DynamicMap::ComputeScope::~ComputeScope()
+    {
+        // a computation that failed leaves the ports as they were
+        _map._executionPlans.ReleaseContext(std::move(_context), _isDone);
+    }
+
+    const ExecutionPlan& DynamicMap::GetExecutionPlan(const PortElementsBase& elements) const
+    {
+        return _executionPlans.GetPlan(_model, elements);
+    }
+
+    void DynamicMap::ExecutePlan(const PortElementsBase& elements) const
+    {
+        const auto& plan = GetExecutionPlan(elements);
+        if (_threadPool != nullptr)
+        {
+            plan.Execute(*_threadPool, _parallelExecutionParameters.minTaskCost);
+        }
+        else
+        {
+            plan.Execute();
+        }
+    }
+
+    void DynamicMap::SetParallelExecutionParameters(const ParallelExecutionParameters& parameters)
+    {
+        if (parameters.numThreads != _parallelExecutionParameters.numThreads || _threadPool == nullptr)
+        {
+            _threadPool = parameters.numThreads == 1 ? nullptr : std::make_shared<utilities::ThreadPool>(parameters.numThreads);
+        }
+        _parallelExecutionParameters = parameters;
     }
 
     std::vector<const Node*> DynamicMap::GetOutputNodes()
@@ -232,6 +368,7 @@ namespace model
         auto minimalModel = transformer.CopyModel(_model, outputNodeVec, context);
         FixTransformedIO(transformer);
         _model = std::move(minimalModel);
+        _executionPlans.Clear();
     }
 
     size_t DynamicMap::GetInputSize() const
@@ -262,6 +399,7 @@ namespace model
         FixTransformedIO(transformer);
 
         _model = std::move(refinedModel);
+        _executionPlans.Clear();
         Prune();
     }
 
@@ -271,6 +409,7 @@ namespace model
         auto refinedModel = transformer.TransformModel(_model, transformFunction, context);
         FixTransformedIO(transformer);
         _model = std::move(refinedModel);
+        _executionPlans.Clear();
     }
 
     void DynamicMap::WriteToArchive(utilities::Archiver& archiver) const
@@ -296,6 +435,7 @@ namespace model
 
         // Unarchive the model
         archiver["model"] >> _model;
+        _executionPlans.Clear();
 
         // Unarchive the inputs
         std::vector<utilities::UniqueId> inputIds;
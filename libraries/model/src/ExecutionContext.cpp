@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ExecutionContext.cpp (model)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ExecutionContext.h"
+#include "OutputPort.h"
+
+// utilities
+#include "Exception.h"
+
+// stl
+#include <cstdint>
+#include <utility>
+
+namespace ell
+{
+namespace model
+{
+    namespace
+    {
+        thread_local ExecutionContext* currentContext = nullptr;
+    }
+
+    ExecutionContext::ExecutionContext(const std::vector<const OutputPortBase*>& ports)
+    {
+        _buffers.reserve(ports.size());
+        for (auto port : ports)
+        {
+            switch (port->GetType())
+            {
+            case Port::PortType::smallReal:
+                AddBuffer<float>(*port);
+                break;
+            case Port::PortType::real:
+                AddBuffer<double>(*port);
+                break;
+            case Port::PortType::integer:
+                AddBuffer<int>(*port);
+                break;
+            case Port::PortType::bigInt:
+                AddBuffer<int64_t>(*port);
+                break;
+            case Port::PortType::boolean:
+                AddBuffer<bool>(*port);
+                break;
+            default:
+                throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch, "unsupported output port type");
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void ExecutionContext::AddBuffer(const OutputPortBase& port)
+    {
+        auto buffer = std::make_unique<Buffer<ValueType>>();
+        buffer->port = &port;
+        _buffers.push_back(std::move(buffer));
+    }
+
+    template <typename ValueType>
+    void ExecutionContext::MoveOutputToPort(BufferBase& buffer)
+    {
+        const auto& port = static_cast<const OutputPort<ValueType>&>(*buffer.port);
+        std::swap(static_cast<Buffer<ValueType>&>(buffer).values, port._cachedOutput);
+    }
+
+    void ExecutionContext::MoveOutputsToPorts()
+    {
+        for (auto& buffer : _buffers)
+        {
+            if (buffer->computation != _computation)
+            {
+                continue;
+            }
+
+            switch (buffer->port->GetType())
+            {
+            case Port::PortType::smallReal:
+                MoveOutputToPort<float>(*buffer);
+                break;
+            case Port::PortType::real:
+                MoveOutputToPort<double>(*buffer);
+                break;
+            case Port::PortType::integer:
+                MoveOutputToPort<int>(*buffer);
+                break;
+            case Port::PortType::bigInt:
+                MoveOutputToPort<int64_t>(*buffer);
+                break;
+            case Port::PortType::boolean:
+                MoveOutputToPort<bool>(*buffer);
+                break;
+            default:
+                throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch, "unsupported output port type");
+            }
+
+            // the buffer now holds the old values of the port
+            buffer->computation = 0;
+        }
+    }
+
+    ExecutionContext* ExecutionContext::GetCurrent()
+    {
+        return currentContext;
+    }
+
+    ExecutionContext::Scope::Scope(ExecutionContext* context)
+        : _previousContext(currentContext)
+    {
+        currentContext = context;
+    }
+
+    ExecutionContext::Scope::~Scope()
+    {
+        currentContext = _previousContext;
+    }
+}
+}
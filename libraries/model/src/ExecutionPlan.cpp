@@ -0,0 +1,399 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ExecutionPlan.cpp (model)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ExecutionPlan.h"
+#include "ExecutionContext.h"
+#include "InputPort.h"
+#include "Model.h"
+#include "OutputPort.h"
+
+// utilities
+#include "Exception.h"
+
+// stl
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace ell
+{
+namespace model
+{
+    ExecutionPlan::ExecutionPlan(const Model& model, const std::vector<const Node*>& outputNodes)
+        : _outputNodes(outputNodes)
+    {
+        std::sort(_outputNodes.begin(), _outputNodes.end());
+        _outputNodes.erase(std::unique(_outputNodes.begin(), _outputNodes.end()), _outputNodes.end());
+
+        auto iterator = model.GetNodeIterator(_outputNodes);
+        while (iterator.IsValid())
+        {
+            _nodes.push_back(iterator.Get());
+            iterator.Next();
+        }
+        BuildTasks();
+    }
+
+    ExecutionPlan::ExecutionPlan(const Model& model, const PortElementsBase& elements)
+        : ExecutionPlan(model, GetOutputNodes(elements))
+    {
+    }
+
+    void ExecutionPlan::Execute() const
+    {
+        for (auto node : _nodes)
+        {
+            node->Compute();
+        }
+    }
+
+    //
+    // Parallel execution
+    //
+
+    // the state of one parallel execution of a plan
+    class ExecutionPlan::ParallelExecution
+    {
+    public:
+        ParallelExecution(const ExecutionPlan& plan, utilities::ThreadPool& threadPool, size_t minTaskCost)
+            : _plan(plan), _threadPool(threadPool), _minTaskCost(minTaskCost), _context(ExecutionContext::GetCurrent()), _numRemainingDependencies(new std::atomic<size_t>[plan._tasks.size()])
+        {
+            for (size_t taskIndex = 0; taskIndex < plan._tasks.size(); ++taskIndex)
+            {
+                _numRemainingDependencies[taskIndex] = plan._tasks[taskIndex].numDependencies;
+            }
+        }
+
+        void Run()
+        {
+            // the calling thread runs a share of the work and then waits for the rest
+            _numPendingBatches = 1;
+            RunBatch(Dispatch(_plan._initialTasks));
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _isDone.wait(lock, [this]() { return _numPendingBatches == 0; });
+            if (_exception != nullptr)
+            {
+                std::rethrow_exception(_exception);
+            }
+        }
+
+    private:
+        // runs a batch of tasks, and then the ready tasks that are not handed to other threads
+        void RunBatch(std::vector<size_t> batch)
+        {
+            // the worker threads compute in the context of the calling thread
+            ExecutionContext::Scope scope(_context);
+            while (!batch.empty())
+            {
+                std::vector<size_t> readyTasks;
+                for (auto taskIndex : batch)
+                {
+                    if (!RunTask(taskIndex))
+                    {
+                        break;
+                    }
+
+                    for (auto dependent : _plan._tasks[taskIndex].dependents)
+                    {
+                        if (--_numRemainingDependencies[dependent] == 0)
+                        {
+                            readyTasks.push_back(dependent);
+                        }
+                    }
+                }
+                batch = Dispatch(readyTasks);
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_numPendingBatches == 0)
+            {
+                _isDone.notify_all();
+            }
+        }
+
+        // computes the nodes of a task, and returns false if this or another task failed
+        bool RunTask(size_t taskIndex)
+        {
+            if (_hasFailed)
+            {
+                return false;
+            }
+
+            try
+            {
+                for (auto node : _plan._tasks[taskIndex].nodes)
+                {
+                    node->Compute();
+                }
+                return true;
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_exception == nullptr)
+                {
+                    _exception = std::current_exception();
+                }
+                _hasFailed = true;
+                return false;
+            }
+        }
+
+        // splits the ready tasks into batches of at least the minimal cost, submits all but the last one to the thread pool, and returns the last one
+        std::vector<size_t> Dispatch(const std::vector<size_t>& readyTasks)
+        {
+            std::vector<size_t> batch;
+            size_t batchCost = 0;
+            for (auto taskIndex : readyTasks)
+            {
+                if (batchCost >= _minTaskCost)
+                {
+                    Submit(std::move(batch));
+                    batch.clear();
+                    batchCost = 0;
+                }
+                batch.push_back(taskIndex);
+                batchCost += _plan._tasks[taskIndex].cost;
+            }
+            return batch;
+        }
+
+        void Submit(std::vector<size_t> batch)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                ++_numPendingBatches;
+            }
+            _threadPool.Submit([this, batch]() { RunBatch(batch); });
+        }
+
+        const ExecutionPlan& _plan;
+        utilities::ThreadPool& _threadPool;
+        size_t _minTaskCost;
+        ExecutionContext* _context;
+        std::unique_ptr<std::atomic<size_t>[]> _numRemainingDependencies;
+        std::atomic<bool> _hasFailed{ false };
+
+        std::mutex _mutex;
+        std::condition_variable _isDone;
+        size_t _numPendingBatches = 0;
+        std::exception_ptr _exception;
+    };
+
+    void ExecutionPlan::Execute(utilities::ThreadPool& threadPool, size_t minTaskCost) const
+    {
+        if (threadPool.NumThreads() < 2 || _tasks.size() < 2)
+        {
+            Execute();
+            return;
+        }
+
+        ParallelExecution execution(*this, threadPool, minTaskCost);
+        execution.Run();
+    }
+
+    void ExecutionPlan::BuildTasks()
+    {
+        std::unordered_map<const Node*, size_t> nodeIndices;
+        for (size_t nodeIndex = 0; nodeIndex < _nodes.size(); ++nodeIndex)
+        {
+            nodeIndices[_nodes[nodeIndex]] = nodeIndex;
+        }
+
+        // find the distinct parents of each node, and count the dependents of each node within the plan
+        std::vector<std::vector<size_t>> parents(_nodes.size());
+        std::vector<size_t> numDependents(_nodes.size(), 0);
+        for (size_t nodeIndex = 0; nodeIndex < _nodes.size(); ++nodeIndex)
+        {
+            for (auto parent : _nodes[nodeIndex]->GetParentNodes())
+            {
+                auto parentIndex = nodeIndices.find(parent);
+                if (parentIndex == nodeIndices.end())
+                {
+                    throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "execution plan is missing the parent of a node");
+                }
+                parents[nodeIndex].push_back(parentIndex->second);
+            }
+            std::sort(parents[nodeIndex].begin(), parents[nodeIndex].end());
+            parents[nodeIndex].erase(std::unique(parents[nodeIndex].begin(), parents[nodeIndex].end()), parents[nodeIndex].end());
+            for (auto parentIndex : parents[nodeIndex])
+            {
+                ++numDependents[parentIndex];
+            }
+        }
+
+        // a node continues the task of its parent if it is the only dependent of its only parent
+        std::vector<size_t> nodeTasks(_nodes.size());
+        for (size_t nodeIndex = 0; nodeIndex < _nodes.size(); ++nodeIndex)
+        {
+            const auto& nodeParents = parents[nodeIndex];
+            size_t taskIndex;
+            if (nodeParents.size() == 1 && numDependents[nodeParents[0]] == 1)
+            {
+                taskIndex = nodeTasks[nodeParents[0]];
+            }
+            else
+            {
+                taskIndex = _tasks.size();
+                _tasks.emplace_back();
+
+                std::vector<size_t> parentTasks;
+                for (auto parentIndex : nodeParents)
+                {
+                    parentTasks.push_back(nodeTasks[parentIndex]);
+                }
+                std::sort(parentTasks.begin(), parentTasks.end());
+                parentTasks.erase(std::unique(parentTasks.begin(), parentTasks.end()), parentTasks.end());
+                for (auto parentTask : parentTasks)
+                {
+                    _tasks[parentTask].dependents.push_back(taskIndex);
+                }
+                _tasks[taskIndex].numDependencies = parentTasks.size();
+            }
+
+            // estimate the cost of computing a node by the number of elements that it reads and writes
+            const Node* node = _nodes[nodeIndex];
+            size_t cost = 1;
+            for (auto input : node->GetInputPorts())
+            {
+                cost += input->Size();
+            }
+            for (auto output : node->GetOutputPorts())
+            {
+                cost += output->Size();
+            }
+
+            nodeTasks[nodeIndex] = taskIndex;
+            _tasks[taskIndex].nodes.push_back(node);
+            _tasks[taskIndex].cost += cost;
+        }
+
+        for (size_t taskIndex = 0; taskIndex < _tasks.size(); ++taskIndex)
+        {
+            if (_tasks[taskIndex].numDependencies == 0)
+            {
+                _initialTasks.push_back(taskIndex);
+            }
+        }
+    }
+
+    std::vector<const Node*> ExecutionPlan::GetOutputNodes(const PortElementsBase& elements)
+    {
+        std::vector<const Node*> outputNodes;
+        for (const auto& range : elements.GetRanges())
+        {
+            outputNodes.push_back(range.ReferencedPort()->GetNode());
+        }
+        std::sort(outputNodes.begin(), outputNodes.end());
+        outputNodes.erase(std::unique(outputNodes.begin(), outputNodes.end()), outputNodes.end());
+        return outputNodes;
+    }
+
+    //
+    // ExecutionPlanCache
+    //
+
+    ExecutionPlanCache::ExecutionPlanCache(ExecutionPlanCache&& other)
+    {
+        std::lock_guard<std::mutex> lock(other._mutex);
+        _plans = std::move(other._plans);
+        _ports = std::move(other._ports);
+        _contexts = std::move(other._contexts);
+    }
+
+    ExecutionPlanCache& ExecutionPlanCache::operator=(const ExecutionPlanCache&)
+    {
+        Clear();
+        return *this;
+    }
+
+    ExecutionPlanCache& ExecutionPlanCache::operator=(ExecutionPlanCache&& other)
+    {
+        if (this != &other)
+        {
+            std::lock(_mutex, other._mutex);
+            std::lock_guard<std::mutex> lock(_mutex, std::adopt_lock);
+            std::lock_guard<std::mutex> otherLock(other._mutex, std::adopt_lock);
+            _plans = std::move(other._plans);
+            _ports = std::move(other._ports);
+            _contexts = std::move(other._contexts);
+            other._plans.clear();
+            other._ports.clear();
+            other._contexts.clear();
+        }
+        return *this;
+    }
+
+    const ExecutionPlan& ExecutionPlanCache::GetPlan(const Model& model, const PortElementsBase& elements)
+    {
+        auto outputNodes = ExecutionPlan::GetOutputNodes(elements);
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const auto& plan : _plans)
+        {
+            if (plan->GetOutputNodes() == outputNodes)
+            {
+                return *plan;
+            }
+        }
+
+        _plans.push_back(std::make_unique<ExecutionPlan>(model, outputNodes));
+        return *_plans.back();
+    }
+
+    std::unique_ptr<ExecutionContext> ExecutionPlanCache::GetContext(const Model& model)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_ports.empty())
+        {
+            model.Visit([this](const Node& node) {
+                for (auto port : node.GetOutputPorts())
+                {
+                    port->SetExecutionIndex(_ports.size());
+                    _ports.push_back(port);
+                }
+            });
+        }
+
+        std::unique_ptr<ExecutionContext> context;
+        if (_contexts.empty())
+        {
+            context = std::make_unique<ExecutionContext>(_ports);
+        }
+        else
+        {
+            context = std::move(_contexts.back());
+            _contexts.pop_back();
+            context->Reset();
+        }
+        return context;
+    }
+
+    void ExecutionPlanCache::ReleaseContext(std::unique_ptr<ExecutionContext> context, bool moveOutputsToPorts)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (moveOutputsToPorts)
+        {
+            context->MoveOutputsToPorts();
+        }
+        _contexts.push_back(std::move(context));
+    }
+
+    void ExecutionPlanCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _plans.clear();
+        _ports.clear();
+        _contexts.clear();
+    }
+}
+}
@@ -24,6 +24,7 @@
 #include "llvm/Transforms/Utils/Cloning.h"
 
 // stl
+#include <algorithm>
 #include <sstream>
 
 namespace ell
@@ -96,6 +97,18 @@ namespace model
         }
     }
 
+    uint64_t IRCompiledMap::ResolveComputeFunction() const
+    {
+        EnsureExecutionEngine();
+        return _executionEngine->ResolveFunctionAddress(_functionName);
+    }
+
+    uint64_t IRCompiledMap::ResolveComputeBatchFunction() const
+    {
+        EnsureExecutionEngine();
+        return _executionEngine->ResolveFunctionAddress(IRMapCompiler::GetPredictBatchFunctionName(_functionName));
+    }
+
     void IRCompiledMap::SetNodeInput(model::InputNode<bool>* node, const std::vector<bool>& inputValues) const
     {
         EnsureExecutionEngine();
@@ -156,6 +169,66 @@ namespace model
         std::get<ComputeFunction<double>>(_computeInputFunction)(inputValues.data());
     }
 
+    void IRCompiledMap::SetNodeInput(model::InputNode<bool>* node, const bool* inputValues) const
+    {
+        EnsureExecutionEngine();
+        if (GetInput(0)->GetOutputPort().GetType() != node->GetOutputPort().GetType())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        // the compiled function reads the caller's buffer directly
+        std::get<ComputeFunction<bool>>(_computeInputFunction)(inputValues);
+    }
+
+    void IRCompiledMap::SetNodeInput(model::InputNode<int>* node, const int* inputValues) const
+    {
+        EnsureExecutionEngine();
+        if (GetInput(0)->GetOutputPort().GetType() != node->GetOutputPort().GetType())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        // the compiled function reads the caller's buffer directly
+        std::get<ComputeFunction<int>>(_computeInputFunction)(inputValues);
+    }
+
+    void IRCompiledMap::SetNodeInput(model::InputNode<int64_t>* node, const int64_t* inputValues) const
+    {
+        EnsureExecutionEngine();
+        if (GetInput(0)->GetOutputPort().GetType() != node->GetOutputPort().GetType())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        // the compiled function reads the caller's buffer directly
+        std::get<ComputeFunction<int64_t>>(_computeInputFunction)(inputValues);
+    }
+
+    void IRCompiledMap::SetNodeInput(model::InputNode<float>* node, const float* inputValues) const
+    {
+        EnsureExecutionEngine();
+        if (GetInput(0)->GetOutputPort().GetType() != node->GetOutputPort().GetType())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        // the compiled function reads the caller's buffer directly
+        std::get<ComputeFunction<float>>(_computeInputFunction)(inputValues);
+    }
+
+    void IRCompiledMap::SetNodeInput(model::InputNode<double>* node, const double* inputValues) const
+    {
+        EnsureExecutionEngine();
+        if (GetInput(0)->GetOutputPort().GetType() != node->GetOutputPort().GetType())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        // the compiled function reads the caller's buffer directly
+        std::get<ComputeFunction<double>>(_computeInputFunction)(inputValues);
+    }
+
     std::vector<bool> IRCompiledMap::ComputeBoolOutput(const model::PortElementsBase& outputs) const
     {
         EnsureExecutionEngine();
@@ -212,6 +285,66 @@ namespace model
         return std::get<utilities::ConformingVector<double>>(_cachedOutput);
     }
 
+    void IRCompiledMap::ComputeBoolOutput(const model::PortElementsBase& outputs, bool* outputValues) const
+    {
+        EnsureExecutionEngine();
+        if (GetOutput(0).GetPortType() != model::Port::PortType::boolean)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        const auto& output = std::get<utilities::ConformingVector<bool>>(_cachedOutput);
+        std::copy(output.begin(), output.end(), outputValues);
+    }
+
+    void IRCompiledMap::ComputeIntOutput(const model::PortElementsBase& outputs, int* outputValues) const
+    {
+        EnsureExecutionEngine();
+        if (GetOutput(0).GetPortType() != model::Port::PortType::integer)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        const auto& output = std::get<utilities::ConformingVector<int>>(_cachedOutput);
+        std::copy(output.begin(), output.end(), outputValues);
+    }
+
+    void IRCompiledMap::ComputeInt64Output(const model::PortElementsBase& outputs, int64_t* outputValues) const
+    {
+        EnsureExecutionEngine();
+        if (GetOutput(0).GetPortType() != model::Port::PortType::bigInt)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        const auto& output = std::get<utilities::ConformingVector<int64_t>>(_cachedOutput);
+        std::copy(output.begin(), output.end(), outputValues);
+    }
+
+    void IRCompiledMap::ComputeFloatOutput(const model::PortElementsBase& outputs, float* outputValues) const
+    {
+        EnsureExecutionEngine();
+        if (GetOutput(0).GetPortType() != model::Port::PortType::smallReal)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        const auto& output = std::get<utilities::ConformingVector<float>>(_cachedOutput);
+        std::copy(output.begin(), output.end(), outputValues);
+    }
+
+    void IRCompiledMap::ComputeDoubleOutput(const model::PortElementsBase& outputs, double* outputValues) const
+    {
+        EnsureExecutionEngine();
+        if (GetOutput(0).GetPortType() != model::Port::PortType::real)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        const auto& output = std::get<utilities::ConformingVector<double>>(_cachedOutput);
+        std::copy(output.begin(), output.end(), outputValues);
+    }
+
     void IRCompiledMap::WriteCode(const std::string& filePath) const
     {
         _module->WriteToFile(filePath);
@@ -16,6 +16,9 @@
 #include "EmitterException.h"
 #include "Variable.h"
 
+// stl
+#include <unordered_set>
+
 namespace ell
 {
 namespace model
@@ -84,11 +87,20 @@ namespace model
         return GetMapCompilerParameters().mapFunctionName;
     }
 
+    std::string IRMapCompiler::GetPredictBatchFunctionName(const std::string& predictFunctionName)
+    {
+        return predictFunctionName + "_batch";
+    }
+
     IRCompiledMap IRMapCompiler::Compile(DynamicMap map)
     {
         EnsureValidMap(map);
         model::TransformContext context{ [](const model::Node& node) { return node.IsCompilable() ? model::NodeAction::compile : model::NodeAction::refine; } };
         map.Refine(context);
+        if (GetMapCompilerParameters().optimizeModel)
+        {
+            GetModelOptimizer().Optimize(map, context);
+        }
 
         // Now the model ready for compiling
         if (GetMapCompilerParameters().profile)
@@ -118,6 +130,7 @@ namespace model
         EmitGetInputSizeFunction(map);
         EmitGetOutputSizeFunction(map);
         EmitGetNumNodesFunction(map);
+        EmitPredictBatchFunction(map);
     }
 
     void IRMapCompiler::EmitGetInputSizeFunction(const DynamicMap& map)
@@ -154,6 +167,45 @@ namespace model
         _moduleEmitter.EndFunction();
     }
 
+    void IRMapCompiler::EmitPredictBatchFunction(const DynamicMap& map)
+    {
+        auto inputSize = map.GetInputSize();
+        auto outputSize = map.GetOutputSize();
+        auto inputType = PortTypeToVariableType(map.GetInput(0)->GetOutputPort().GetType());
+        auto outputType = PortTypeToVariableType(map.GetOutput(0).GetPortType());
+        emitters::NamedVariableTypeList args = { { "count", emitters::VariableType::Int32 }, { "input", emitters::GetPointerType(inputType) }, { "output", emitters::GetPointerType(outputType) } };
+
+        auto predictFunctionName = GetPredictFunctionName();
+        auto functionName = GetPredictBatchFunctionName(predictFunctionName);
+        auto function = _moduleEmitter.BeginFunction(functionName, emitters::VariableType::Void, args);
+        function.InsertMetadata(emitters::c_declareInHeaderTagName);
+        function.InsertMetadata(emitters::c_predictBatchFunctionTagName, std::to_string(inputSize));
+        std::vector<std::string> comments = { std::string("Input size: count * ") + std::to_string(inputSize), std::string("Output size: count * ") + std::to_string(outputSize) };
+        _moduleEmitter.SetFunctionComments(functionName, comments);
+
+        auto arguments = function.Arguments().begin();
+        llvm::Argument& count = *(arguments++);
+        llvm::Argument& input = *(arguments++);
+        llvm::Argument& output = *arguments;
+
+        // The rows are laid out back to back, and the loop over them runs in the emitted code
+        auto forLoop = function.ForLoop();
+        forLoop.Begin(&count);
+        {
+            // The offsets are 64-bit, so batches may hold more than 2^31 values
+            auto rowIndex = function.CastValue<int, int64_t>(forLoop.LoadIterationVariable());
+            auto inputOffset = function.Operator(emitters::TypedOperator::multiply, rowIndex, function.Literal(static_cast<int64_t>(inputSize)));
+            auto outputOffset = function.Operator(emitters::TypedOperator::multiply, rowIndex, function.Literal(static_cast<int64_t>(outputSize)));
+
+            // The predict function takes a scalar input by value
+            auto rowInput = inputSize == 1 ? function.ValueAt(&input, inputOffset) : function.PointerOffset(&input, inputOffset);
+            function.Call(predictFunctionName, { rowInput, function.PointerOffset(&output, outputOffset) });
+        }
+        forLoop.End();
+
+        _moduleEmitter.EndFunction();
+    }
+
     //
     // Node implementor methods:
     //
@@ -192,9 +244,115 @@ namespace model
         currentFunction.InsertMetadata(emitters::c_declareInHeaderTagName);
         currentFunction.InsertMetadata(emitters::c_predictFunctionTagName);
 
+        if (GetMapCompilerParameters().sharePortMemory)
+        {
+            AllocatePortMemory(model);
+        }
+
         _profiler.StartModel(currentFunction);
     }
 
+    void IRMapCompiler::AllocatePortMemory(const Model& model)
+    {
+        // Function arguments, constants and scalars keep their own variables
+        auto portFilter = [this](const OutputPortBase& port) {
+            return port.Size() > 1 && port.GetNode()->NumInputPorts() > 0 && GetVariableForPort(port) == nullptr;
+        };
+        MemoryPlan::PortAlias portAlias = nullptr;
+        if (GetMapCompilerParameters().computeInPlace)
+        {
+            portAlias = [this](const OutputPortBase& port) { return GetInPlaceInputPort(port); };
+        }
+        _memoryPlan = MemoryPlan(model, portFilter, GetMapCompilerParameters().portMemoryAlignment, portAlias);
+        if (!IsPortMemoryShared())
+        {
+            return;
+        }
+
+        auto pArena = GetModule().GlobalArena("portMemory", _memoryPlan.GetArenaSize(), GetMapCompilerParameters().portMemoryAlignment);
+        for (auto node : _memoryPlan.GetNodes())
+        {
+            for (auto port : node->GetOutputPorts())
+            {
+                if (_memoryPlan.HasPort(*port))
+                {
+                    auto pVar = GetModule().Variables().AddVectorVariable(emitters::VariableScope::global, PortTypeToVariableType(port->GetType()), port->Size());
+                    GetModule().EmitGlobalVectorInArena(*pVar, pArena, _memoryPlan.GetPortOffset(*port));
+                    SetVariableForPort(*port, pVar);
+                }
+            }
+        }
+
+        auto functionName = GetModule().GetCurrentFunction().GetFunctionName();
+        auto comments = GetModule().GetFunctionComments(functionName);
+        comments.push_back("Port memory: " + std::to_string(_memoryPlan.GetArenaSize()) + " bytes (" + std::to_string(_memoryPlan.GetUnsharedSize()) + " bytes unshared)");
+        GetModule().SetFunctionComments(functionName, comments);
+    }
+
+    const OutputPortBase* IRMapCompiler::GetInPlaceInputPort(const OutputPortBase& output) const
+    {
+        auto node = dynamic_cast<const CompilableNode*>(output.GetNode());
+        auto input = node == nullptr ? nullptr : node->GetInPlaceInput(output);
+        if (input == nullptr || output.Size() <= 1 || input->Size() != output.Size() || input->GetType() != output.GetType() || !input->GetInputElements().IsFullPortOutput())
+        {
+            return nullptr;
+        }
+
+        // The values of constants and of the map's inputs are needed again on the next call
+        auto inputPort = input->GetInputElements().GetRanges()[0].ReferencedPort();
+        auto inputNode = inputPort->GetNode();
+        if (inputNode->NumInputPorts() == 0)
+        {
+            return nullptr;
+        }
+
+        // The input must not be read by any other port, or the other port would see the overwritten values
+        size_t numReaders = 0;
+        std::unordered_set<const Node*> dependentNodes(inputNode->GetDependentNodes().begin(), inputNode->GetDependentNodes().end());
+        for (auto dependentNode : dependentNodes)
+        {
+            for (auto dependentInput : dependentNode->GetInputPorts())
+            {
+                for (const auto& range : dependentInput->GetInputElements().GetRanges())
+                {
+                    if (range.ReferencedPort() == inputPort)
+                    {
+                        ++numReaders;
+                        break;
+                    }
+                }
+            }
+        }
+        return numReaders == 1 ? inputPort : nullptr;
+    }
+
+    bool IRMapCompiler::TryComputeInPlace(const OutputPortBase& output)
+    {
+        if (!GetMapCompilerParameters().computeInPlace || GetVariableForPort(output) != nullptr)
+        {
+            return false;
+        }
+
+        auto inputPort = GetInPlaceInputPort(output);
+        auto pInputVar = inputPort == nullptr ? nullptr : GetVariableForPort(*inputPort);
+        if (pInputVar == nullptr || !pInputVar->IsGlobal() || !pInputVar->IsVector() || pInputVar->HasInitValue())
+        {
+            return false;
+        }
+
+        // A node with several outputs can't write all of them over the same input
+        for (auto port : output.GetNode()->GetOutputPorts())
+        {
+            if (port != &output && GetVariableForPort(*port) == pInputVar)
+            {
+                return false;
+            }
+        }
+
+        SetVariableForPort(output, pInputVar);
+        return true;
+    }
+
     void IRMapCompiler::OnEndCompileModel(const Model& model)
     {
         auto& currentFunction = GetModule().GetCurrentFunction();
@@ -209,6 +367,24 @@ namespace model
             currentFunction.AddRegion(currentFunction.GetCurrentBlock());
         }
 
+        // A port in the arena starts out with the values of the ports that used its memory before, so it is
+        // cleared for the nodes that don't write all of their outputs, like those with padded outputs. A port
+        // computed in place keeps the values of the port it overwrites, which the node still has to read.
+        for (auto port : node.GetOutputPorts())
+        {
+            if (_memoryPlan.HasPort(*port))
+            {
+                if (_memoryPlan.GetOverwrittenPort(*port) == nullptr)
+                {
+                    currentFunction.MemorySet<uint8_t>(EnsurePortEmitted(*port), 0, currentFunction.Literal<uint8_t>(0), MemoryPlan::GetPortMemorySize(*port));
+                }
+            }
+            else if (!IsPortMemoryShared())
+            {
+                TryComputeInPlace(*port);
+            }
+        }
+
         _profiler.InitNode(currentFunction, node);
         _profiler.StartNode(currentFunction, node);
     }
@@ -227,6 +403,12 @@ namespace model
         }
     }
 
+    std::vector<const Node*> IRMapCompiler::GetNodeCompileOrder(const Model& model)
+    {
+        // The memory plan is only valid if the nodes are computed in its order
+        return IsPortMemoryShared() ? _memoryPlan.GetNodes() : MapCompiler::GetNodeCompileOrder(model);
+    }
+
     void IRMapCompiler::PushScope()
     {
         MapCompiler::PushScope();
@@ -318,6 +500,12 @@ namespace model
 
     bool IRMapCompiler::TryMergeNodeIntoRegion(emitters::IRBlockRegion* pDestRegion, const Node& src)
     {
+        // Moving the code of a node would change the lifetimes of the ports in the memory plan
+        if (IsPortMemoryShared())
+        {
+            return false;
+        }
+
         auto& currentFunction = GetModule().GetCurrentFunction();
 
         emitters::IRBlockRegion* pSrcRegion = GetCurrentNodeBlocks().Get(src);
@@ -335,7 +523,7 @@ namespace model
     emitters::IRBlockRegion* IRMapCompiler::GetMergeableNodeRegion(const PortElementBase& element)
     {
         const Node* pNode = nullptr;
-        if (HasSingleDescendant(element))
+        if (HasSingleDescendant(element) && !IsPortMemoryShared())
         {
             emitters::Variable* pVar = GetVariableForElement(element);
             if (pVar != nullptr && !pVar->IsLiteral())
@@ -18,6 +18,7 @@ namespace model
     MapCompiler::MapCompiler(const MapCompilerParameters& settings)
         : _parameters(settings)
     {
+        _optimizer.AddPass(std::make_unique<CommonSubexpressionEliminationPass>());
         PushScope();
     }
 
@@ -42,20 +43,28 @@ namespace model
 
     void MapCompiler::CompileNodes(Model& model)
     {
-        model.Visit([this](const Node& node) {
-            if (!node.IsCompilable())
+        for (auto node : GetNodeCompileOrder(model))
+        {
+            if (!node->IsCompilable())
             {
-                std::string typeName = node.GetRuntimeTypeName();
+                std::string typeName = node->GetRuntimeTypeName();
                 throw emitters::EmitterException(emitters::EmitterError::notSupported, std::string("Uncompilable node type: " + typeName));
             }
 
-            auto compilableNode = const_cast<CompilableNode*>(dynamic_cast<const CompilableNode*>(&node));
+            auto compilableNode = const_cast<CompilableNode*>(dynamic_cast<const CompilableNode*>(node));
             assert(compilableNode != nullptr && "Got null compilable node");
 
-            OnBeginCompileNode(node);
+            OnBeginCompileNode(*node);
             compilableNode->CompileNode(*this);
-            OnEndCompileNode(node);
-        });
+            OnEndCompileNode(*node);
+        }
+    }
+
+    std::vector<const Node*> MapCompiler::GetNodeCompileOrder(const Model& model)
+    {
+        std::vector<const Node*> nodes;
+        model.Visit([&nodes](const Node& node) { nodes.push_back(&node); });
+        return nodes;
     }
 
     emitters::Variable* MapCompiler::AllocatePortVariable(const OutputPortBase& port)
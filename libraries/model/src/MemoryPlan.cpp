@@ -0,0 +1,379 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MemoryPlan.cpp (model)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MemoryPlan.h"
+#include "InputPort.h"
+#include "Model.h"
+
+// utilities
+#include "Exception.h"
+
+// stl
+#include <algorithm>
+#include <cstdint>
+#include <set>
+
+namespace ell
+{
+namespace model
+{
+    namespace
+    {
+        // A region of the arena, with the ports stored in it and the nodes that write and read it, as indices into the
+        // nodes of the model. The region holds one port, followed by the ports computed in place from it, if any.
+        struct PlannedBuffer
+        {
+            std::vector<const OutputPortBase*> ports;
+            size_t size;
+            size_t writer;
+            std::vector<size_t> readers;
+        };
+
+        size_t RoundUp(size_t value, size_t alignment)
+        {
+            return ((value + alignment - 1) / alignment) * alignment;
+        }
+
+        std::vector<size_t> GetNodePositions(const std::vector<size_t>& order)
+        {
+            std::vector<size_t> positions(order.size());
+            for (size_t position = 0; position < order.size(); ++position)
+            {
+                positions[order[position]] = position;
+            }
+            return positions;
+        }
+
+        // the first and last positions, in the order given by the node positions, at which a buffer is alive
+        std::pair<size_t, size_t> GetLifetime(const PlannedBuffer& buffer, const std::vector<size_t>& positions)
+        {
+            auto start = positions[buffer.writer];
+            auto end = start;
+            for (auto reader : buffer.readers)
+            {
+                end = std::max(end, positions[reader]);
+            }
+            return { start, end };
+        }
+
+        // the largest total size of the buffers that are alive at the same time, when the nodes are computed in the given order
+        size_t GetPeakSize(const std::vector<PlannedBuffer>& buffers, const std::vector<size_t>& order)
+        {
+            auto positions = GetNodePositions(order);
+            std::vector<int64_t> sizeChanges(order.size() + 1, 0);
+            for (const auto& buffer : buffers)
+            {
+                auto lifetime = GetLifetime(buffer, positions);
+                sizeChanges[lifetime.first] += buffer.size;
+                sizeChanges[lifetime.second + 1] -= buffer.size;
+            }
+
+            int64_t size = 0;
+            int64_t peakSize = 0;
+            for (auto change : sizeChanges)
+            {
+                size += change;
+                peakSize = std::max(peakSize, size);
+            }
+            return static_cast<size_t>(peakSize);
+        }
+
+        // A dependency order chosen one node at a time: among the nodes whose parents are done, the next one is the
+        // node that adds the least to the memory in use, counting the buffers it writes first and the buffers it reads last.
+        std::vector<size_t> GetGreedyOrder(const std::vector<std::vector<size_t>>& parents, const std::vector<PlannedBuffer>& buffers)
+        {
+            auto numNodes = parents.size();
+            std::vector<std::vector<size_t>> children(numNodes);
+            std::vector<size_t> numRemainingParents(numNodes);
+            for (size_t nodeIndex = 0; nodeIndex < numNodes; ++nodeIndex)
+            {
+                for (auto parent : parents[nodeIndex])
+                {
+                    children[parent].push_back(nodeIndex);
+                }
+                numRemainingParents[nodeIndex] = parents[nodeIndex].size();
+            }
+
+            std::vector<std::vector<size_t>> writtenBuffers(numNodes);
+            std::vector<std::vector<size_t>> readBuffers(numNodes);
+            std::vector<size_t> numRemainingReaders(buffers.size());
+            for (size_t bufferIndex = 0; bufferIndex < buffers.size(); ++bufferIndex)
+            {
+                writtenBuffers[buffers[bufferIndex].writer].push_back(bufferIndex);
+                for (auto reader : buffers[bufferIndex].readers)
+                {
+                    readBuffers[reader].push_back(bufferIndex);
+                }
+                numRemainingReaders[bufferIndex] = buffers[bufferIndex].readers.size();
+            }
+
+            // ties go to the node that comes first in the original order
+            std::set<size_t> readyNodes;
+            for (size_t nodeIndex = 0; nodeIndex < numNodes; ++nodeIndex)
+            {
+                if (numRemainingParents[nodeIndex] == 0)
+                {
+                    readyNodes.insert(nodeIndex);
+                }
+            }
+
+            std::vector<size_t> order;
+            while (!readyNodes.empty())
+            {
+                auto bestNode = *readyNodes.begin();
+                int64_t bestSizeChange = 0;
+                bool isFirst = true;
+                for (auto nodeIndex : readyNodes)
+                {
+                    int64_t sizeChange = 0;
+                    for (auto bufferIndex : writtenBuffers[nodeIndex])
+                    {
+                        sizeChange += buffers[bufferIndex].size;
+                    }
+                    for (auto bufferIndex : readBuffers[nodeIndex])
+                    {
+                        if (numRemainingReaders[bufferIndex] == 1)
+                        {
+                            sizeChange -= buffers[bufferIndex].size;
+                        }
+                    }
+
+                    if (isFirst || sizeChange < bestSizeChange)
+                    {
+                        bestNode = nodeIndex;
+                        bestSizeChange = sizeChange;
+                        isFirst = false;
+                    }
+                }
+
+                order.push_back(bestNode);
+                readyNodes.erase(bestNode);
+                for (auto bufferIndex : readBuffers[bestNode])
+                {
+                    --numRemainingReaders[bufferIndex];
+                }
+                for (auto child : children[bestNode])
+                {
+                    if (--numRemainingParents[child] == 0)
+                    {
+                        readyNodes.insert(child);
+                    }
+                }
+            }
+            return order;
+        }
+
+        // Moves the ports that are computed in place into the buffer of the port they overwrite. A port may only
+        // overwrite a port that is read by no other node, and that no other port overwrites.
+        std::vector<PlannedBuffer> MergeInPlacePorts(const std::vector<PlannedBuffer>& portBuffers, const std::unordered_map<const OutputPortBase*, size_t>& portIndices, const MemoryPlan::PortAlias& portAlias)
+        {
+            std::vector<size_t> bufferIndices(portBuffers.size());
+            std::vector<bool> isOverwritten(portBuffers.size(), false);
+            std::vector<PlannedBuffer> buffers;
+
+            // the ports are in the order of their nodes, so the buffer of an overwritten port is known by then
+            for (size_t portIndex = 0; portIndex < portBuffers.size(); ++portIndex)
+            {
+                const auto& portBuffer = portBuffers[portIndex];
+                auto overwrittenPort = portAlias ? portAlias(*portBuffer.ports.front()) : nullptr;
+                auto overwrittenIndex = overwrittenPort == nullptr ? portIndices.end() : portIndices.find(overwrittenPort);
+                if (overwrittenIndex != portIndices.end() && !isOverwritten[overwrittenIndex->second] && portBuffers[overwrittenIndex->second].readers == std::vector<size_t>{ portBuffer.writer })
+                {
+                    isOverwritten[overwrittenIndex->second] = true;
+                    bufferIndices[portIndex] = bufferIndices[overwrittenIndex->second];
+
+                    auto& buffer = buffers[bufferIndices[portIndex]];
+                    buffer.ports.push_back(portBuffer.ports.front());
+                    buffer.size = std::max(buffer.size, portBuffer.size);
+                    buffer.readers.insert(buffer.readers.end(), portBuffer.readers.begin(), portBuffer.readers.end());
+                    std::sort(buffer.readers.begin(), buffer.readers.end());
+                    buffer.readers.erase(std::unique(buffer.readers.begin(), buffer.readers.end()), buffer.readers.end());
+                }
+                else
+                {
+                    bufferIndices[portIndex] = buffers.size();
+                    buffers.push_back(portBuffer);
+                }
+            }
+            return buffers;
+        }
+    }
+
+    MemoryPlan::MemoryPlan(const Model& model, const PortFilter& portFilter, size_t alignment, const PortAlias& portAlias)
+    {
+        if (alignment == 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "alignment must be positive");
+        }
+
+        std::vector<const Node*> nodes;
+        std::unordered_map<const Node*, size_t> nodeIndices;
+        auto iterator = model.GetNodeIterator();
+        while (iterator.IsValid())
+        {
+            nodeIndices[iterator.Get()] = nodes.size();
+            nodes.push_back(iterator.Get());
+            iterator.Next();
+        }
+
+        // find the ports stored in the arena, each in a buffer of its own for now, and the distinct parents of each node
+        std::vector<PlannedBuffer> portBuffers;
+        std::unordered_map<const OutputPortBase*, size_t> portIndices;
+        std::vector<std::vector<size_t>> parents(nodes.size());
+        for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+        {
+            for (auto port : nodes[nodeIndex]->GetOutputPorts())
+            {
+                if (port->Size() > 0 && portFilter(*port))
+                {
+                    portIndices[port] = portBuffers.size();
+                    portBuffers.push_back({ { port }, RoundUp(GetPortMemorySize(*port), alignment), nodeIndex, {} });
+                    _unsharedSize += portBuffers.back().size;
+                }
+            }
+
+            for (auto parent : nodes[nodeIndex]->GetParentNodes())
+            {
+                parents[nodeIndex].push_back(nodeIndices.at(parent));
+            }
+            std::sort(parents[nodeIndex].begin(), parents[nodeIndex].end());
+            parents[nodeIndex].erase(std::unique(parents[nodeIndex].begin(), parents[nodeIndex].end()), parents[nodeIndex].end());
+        }
+
+        // the parents come before their children, so every port read by a node is known by then
+        for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+        {
+            for (auto input : nodes[nodeIndex]->GetInputPorts())
+            {
+                for (const auto& range : input->GetInputElements().GetRanges())
+                {
+                    auto portIndex = portIndices.find(range.ReferencedPort());
+                    if (portIndex != portIndices.end())
+                    {
+                        auto& readers = portBuffers[portIndex->second].readers;
+                        if (readers.empty() || readers.back() != nodeIndex)
+                        {
+                            readers.push_back(nodeIndex);
+                        }
+                    }
+                }
+            }
+        }
+
+        auto buffers = MergeInPlacePorts(portBuffers, portIndices, portAlias);
+
+        // keep the original order, unless the greedy one needs less memory
+        std::vector<size_t> order(nodes.size());
+        for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+        {
+            order[nodeIndex] = nodeIndex;
+        }
+        auto greedyOrder = GetGreedyOrder(parents, buffers);
+        if (GetPeakSize(buffers, greedyOrder) < GetPeakSize(buffers, order))
+        {
+            order = greedyOrder;
+        }
+
+        for (auto nodeIndex : order)
+        {
+            _nodes.push_back(nodes[nodeIndex]);
+        }
+
+        // Place the largest buffers first, each one at the lowest offset where it doesn't overlap the region of a
+        // buffer that is alive at the same time
+        auto positions = GetNodePositions(order);
+        std::vector<std::pair<size_t, size_t>> lifetimes;
+        std::vector<size_t> buffersBySize;
+        for (size_t bufferIndex = 0; bufferIndex < buffers.size(); ++bufferIndex)
+        {
+            lifetimes.push_back(GetLifetime(buffers[bufferIndex], positions));
+            buffersBySize.push_back(bufferIndex);
+        }
+        std::stable_sort(buffersBySize.begin(), buffersBySize.end(), [&buffers, &lifetimes](size_t a, size_t b) {
+            return buffers[a].size > buffers[b].size || (buffers[a].size == buffers[b].size && lifetimes[a].first < lifetimes[b].first);
+        });
+
+        std::vector<size_t> placedBuffers;
+        std::vector<size_t> bufferOffsets(buffers.size(), 0);
+        for (auto bufferIndex : buffersBySize)
+        {
+            std::vector<size_t> overlappingBuffers;
+            for (auto placedBuffer : placedBuffers)
+            {
+                if (lifetimes[placedBuffer].first <= lifetimes[bufferIndex].second && lifetimes[bufferIndex].first <= lifetimes[placedBuffer].second)
+                {
+                    overlappingBuffers.push_back(placedBuffer);
+                }
+            }
+            std::sort(overlappingBuffers.begin(), overlappingBuffers.end(), [&bufferOffsets](size_t a, size_t b) { return bufferOffsets[a] < bufferOffsets[b]; });
+
+            size_t offset = 0;
+            for (auto overlappingBuffer : overlappingBuffers)
+            {
+                if (offset + buffers[bufferIndex].size <= bufferOffsets[overlappingBuffer])
+                {
+                    break;
+                }
+                offset = std::max(offset, bufferOffsets[overlappingBuffer] + buffers[overlappingBuffer].size);
+            }
+
+            bufferOffsets[bufferIndex] = offset;
+            placedBuffers.push_back(bufferIndex);
+            for (auto port : buffers[bufferIndex].ports)
+            {
+                _offsets[port] = offset;
+            }
+            _arenaSize = std::max(_arenaSize, offset + buffers[bufferIndex].size);
+        }
+
+        // the ports computed in place share the region of the port they overwrite
+        for (const auto& buffer : buffers)
+        {
+            for (size_t index = 1; index < buffer.ports.size(); ++index)
+            {
+                _overwrittenPorts[buffer.ports[index]] = buffer.ports[index - 1];
+            }
+        }
+    }
+
+    const OutputPortBase* MemoryPlan::GetOverwrittenPort(const OutputPortBase& port) const
+    {
+        auto overwrittenPort = _overwrittenPorts.find(&port);
+        return overwrittenPort == _overwrittenPorts.end() ? nullptr : overwrittenPort->second;
+    }
+
+    size_t MemoryPlan::GetPortOffset(const OutputPortBase& port) const
+    {
+        auto offset = _offsets.find(&port);
+        if (offset == _offsets.end())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "port is not stored in the arena");
+        }
+        return offset->second;
+    }
+
+    size_t MemoryPlan::GetPortMemorySize(const OutputPortBase& port)
+    {
+        switch (port.GetType())
+        {
+            case Port::PortType::boolean:
+                return port.Size() * sizeof(uint8_t);
+            case Port::PortType::integer:
+                return port.Size() * sizeof(int32_t);
+            case Port::PortType::bigInt:
+                return port.Size() * sizeof(int64_t);
+            case Port::PortType::smallReal:
+                return port.Size() * sizeof(float);
+            case Port::PortType::real:
+                return port.Size() * sizeof(double);
+            default:
+                throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch, "Port type not supported");
+        }
+    }
+}
+}
@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ModelOptimizer.cpp (model)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ModelOptimizer.h"
+#include "DynamicMap.h"
+#include "InputPort.h"
+#include "OutputPort.h"
+
+// utilities
+#include "Exception.h"
+#include "JsonArchiver.h"
+
+// stl
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace ell
+{
+namespace model
+{
+    namespace
+    {
+        // Returns the node in the new model that a node was copied to, or nullptr if the copy
+        // isn't a single node whose output ports correspond one-to-one to the old node's ports
+        const Node* GetCopiedNode(const Node& node, ModelTransformer& transformer)
+        {
+            const Node* newNode = nullptr;
+            const auto& outputs = node.GetOutputPorts();
+            for (size_t index = 0; index < outputs.size(); ++index)
+            {
+                auto newElements = transformer.GetCorrespondingOutputs(*outputs[index]);
+                if (newElements.NumRanges() != 1 || !newElements.GetRanges()[0].IsFullPortRange())
+                {
+                    return nullptr;
+                }
+
+                auto newPort = newElements.GetRanges()[0].ReferencedPort();
+                auto portNode = newPort->GetNode();
+                if ((newNode != nullptr && portNode != newNode) || portNode->NumOutputPorts() != outputs.size() || portNode->GetOutputPort(index) != newPort)
+                {
+                    return nullptr;
+                }
+                newNode = portNode;
+            }
+
+            if (newNode == nullptr || !newNode->IsPure() || newNode->GetRuntimeTypeName() != node.GetRuntimeTypeName())
+            {
+                return nullptr;
+            }
+            return newNode;
+        }
+
+        // Nodes with the same type and the same input elements are candidates for merging
+        std::string GetCandidateKey(const Node& node)
+        {
+            std::stringstream key;
+            key << node.GetRuntimeTypeName();
+            for (auto input : node.GetInputPorts())
+            {
+                key << ";";
+                for (const auto& range : input->GetInputElements().GetRanges())
+                {
+                    key << " " << range.ReferencedPort()->GetNode()->GetId() << "." << range.ReferencedPort()->GetName() << "[" << range.GetStartIndex() << ":" << range.Size() << "]";
+                }
+            }
+            return key.str();
+        }
+    }
+
+    //
+    // CommonSubexpressionEliminationPass
+    //
+    void CommonSubexpressionEliminationPass::Initialize(const Model& model)
+    {
+        _candidates.clear();
+    }
+
+    void CommonSubexpressionEliminationPass::TransformNode(const Node& node, ModelTransformer& transformer)
+    {
+        node.Copy(transformer);
+        if (!node.IsPure())
+        {
+            return;
+        }
+
+        auto newNode = GetCopiedNode(node, transformer);
+        if (newNode == nullptr)
+        {
+            return;
+        }
+
+        auto& candidates = _candidates[GetCandidateKey(*newNode)];
+        Candidate newCandidate{ newNode, "" };
+        for (auto& candidate : candidates)
+        {
+            if (GetSignature(candidate) == GetSignature(newCandidate))
+            {
+                // Use the earlier node; the copy is left without dependents and is removed later
+                for (size_t index = 0; index < node.NumOutputPorts(); ++index)
+                {
+                    transformer.MapNodeOutput(*node.GetOutputPort(index), PortElementsBase(*candidate.node->GetOutputPort(index)));
+                }
+                return;
+            }
+        }
+        candidates.push_back(std::move(newCandidate));
+    }
+
+    const std::string& CommonSubexpressionEliminationPass::GetSignature(Candidate& candidate)
+    {
+        if (candidate.signature.empty())
+        {
+            // The values are written with enough digits to tell apart any two different numbers
+            std::stringstream stream;
+            stream << std::setprecision(std::numeric_limits<double>::max_digits10);
+            utilities::JsonArchiver archiver(stream);
+            archiver << *candidate.node;
+
+            // The node's own id is the only thing that differs between identical nodes
+            auto signature = stream.str();
+            auto id = "\"" + to_string(candidate.node->GetId()) + "\"";
+            for (auto position = signature.find(id); position != std::string::npos; position = signature.find(id, position))
+            {
+                signature.replace(position, id.size(), "\"\"");
+            }
+            candidate.signature = signature;
+        }
+        return candidate.signature;
+    }
+
+    //
+    // ModelOptimizer
+    //
+    void ModelOptimizer::AddPass(std::unique_ptr<ModelOptimizationPass> pass)
+    {
+        if (pass == nullptr)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::nullReference, "Optimization pass is null");
+        }
+        _passes.push_back(std::move(pass));
+    }
+
+    void ModelOptimizer::Optimize(DynamicMap& map, const TransformContext& context, int maxIterations)
+    {
+        if (maxIterations <= 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "maxIterations must be positive");
+        }
+
+        // Removing the nodes that don't contribute to the outputs is always done, even with no passes
+        map.Prune();
+        for (int i = 0; i < maxIterations && !_passes.empty(); ++i)
+        {
+            auto previousSize = map.GetModel().Size();
+            for (auto& pass : _passes)
+            {
+                pass->Initialize(map.GetModel());
+                map.Transform([&pass](const Node& node, ModelTransformer& transformer) { pass->TransformNode(node, transformer); }, context);
+                map.Prune();
+            }
+
+            if (map.GetModel().Size() >= previousSize)
+            {
+                break;
+            }
+        }
+    }
+}
+}
@@ -258,6 +258,11 @@ namespace model
         return _elementsMap.GetCorrespondingPortElements(elements);
     }
 
+    void ModelTransformer::MapNodeOutput(const OutputPortBase& oldPort, const PortElementsBase& newElements)
+    {
+        _elementsMap.MapNodeOutput(&oldPort, newElements);
+    }
+
     InputNodeBase* ModelTransformer::GetCorrespondingInputNode(const InputNodeBase* inputNode)
     {
         return GetCorrespondingInputNodeAs(inputNode);
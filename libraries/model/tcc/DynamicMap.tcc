@@ -23,20 +23,111 @@ namespace model
         {
             return x != 0;
         }
+
+        // std::vector<bool> doesn't store its values contiguously, so boolean batches are copied through a buffer
+        template <typename ValueType>
+        const ValueType* GetBatchData(const std::vector<ValueType>& values, utilities::ConformingVector<ValueType>& buffer)
+        {
+            return values.data();
+        }
+
+        inline const bool* GetBatchData(const std::vector<bool>& values, utilities::ConformingVector<bool>& buffer)
+        {
+            buffer.assign(values.begin(), values.end());
+            return (const bool*)buffer.data();
+        }
+
+        template <typename ValueType>
+        ValueType* GetBatchData(std::vector<ValueType>& values, utilities::ConformingVector<ValueType>& buffer)
+        {
+            return values.data();
+        }
+
+        inline bool* GetBatchData(std::vector<bool>& values, utilities::ConformingVector<bool>& buffer)
+        {
+            buffer.resize(values.size());
+            return (bool*)buffer.data();
+        }
+
+        template <typename ValueType>
+        void CopyBatchData(const utilities::ConformingVector<ValueType>& buffer, std::vector<ValueType>& values)
+        {
+        }
+
+        inline void CopyBatchData(const utilities::ConformingVector<bool>& buffer, std::vector<bool>& values)
+        {
+            std::copy(buffer.begin(), buffer.end(), values.begin());
+        }
     }
 
     template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType>, utilities::IsFundamental<InputType>>
     std::vector<OutputType> DynamicMap::Compute(const std::vector<InputType>& inputValues) const
     {
+        // the input and the port values of this call are kept apart from those of other calls
+        ComputeScope scope(*this);
         SetInputValue(0, inputValues);
-        return ComputeOutput<OutputType>(GetOutput(0));
+        auto output = ComputeOutput<OutputType>(GetOutput(0));
+        scope.Done();
+        return output;
     }
 
     template <typename OutputVectorType, typename InputVectorType, data::IsDataVector<OutputVectorType>, data::IsDataVector<InputVectorType>>
     OutputVectorType DynamicMap::Compute(const InputVectorType& inputValues) const
     {
+        ComputeScope scope(*this);
         SetInputValue(GetInput(0), inputValues);
-        return ComputeOutput<OutputVectorType>(GetOutput(0));
+        auto output = ComputeOutput<OutputVectorType>(GetOutput(0));
+        scope.Done();
+        return output;
+    }
+
+    template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType>, utilities::IsFundamental<InputType>>
+    void DynamicMap::Compute(const InputType* inputValues, OutputType* outputValues) const
+    {
+        auto node = dynamic_cast<InputNode<InputType>*>(GetInput(0));
+        if (node == nullptr || GetOutput(0).GetPortType() != Port::GetPortType<OutputType>())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        ComputeScope scope(*this);
+        SetNodeInput(node, inputValues);
+        ComputeOutput(GetOutput(0), outputValues);
+        scope.Done();
+    }
+
+    template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType>, utilities::IsFundamental<InputType>>
+    void DynamicMap::ComputeBatch(const std::vector<InputType>& inputValues, std::vector<OutputType>& outputValues) const
+    {
+        auto node = dynamic_cast<InputNode<InputType>*>(GetInput(0));
+        if (node == nullptr || GetOutput(0).GetPortType() != Port::GetPortType<OutputType>())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        auto inputSize = GetInputSize();
+        auto outputSize = GetOutputSize();
+        if (inputSize == 0 || inputValues.size() % inputSize != 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "batch input size must be a multiple of the map's input size");
+        }
+        auto numRows = inputValues.size() / inputSize;
+        outputValues.resize(numRows * outputSize);
+
+        // each row is read from and written to the batch in place, and one context serves all of
+        // the rows, since each row overwrites every port value it reads
+        utilities::ConformingVector<InputType> inputBuffer;
+        utilities::ConformingVector<OutputType> outputBuffer;
+        auto inputData = DynamicMapImpl::GetBatchData(inputValues, inputBuffer);
+        auto outputData = DynamicMapImpl::GetBatchData(outputValues, outputBuffer);
+        ComputeScope scope(*this);
+        for (size_t rowIndex = 0; rowIndex < numRows; ++rowIndex)
+        {
+            SetNodeInput(node, inputData + rowIndex * inputSize);
+            ComputeOutput(GetOutput(0), outputData + rowIndex * outputSize);
+        }
+        scope.Done();
+        DynamicMapImpl::CopyBatchData(outputBuffer, outputValues);
     }
 
     //
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ExecutionContext.tcc (model)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace ell
+{
+namespace model
+{
+    template <typename ValueType>
+    std::vector<ValueType>* ExecutionContext::SetOutput(const OutputPort<ValueType>& port)
+    {
+        auto buffer = GetBuffer(port);
+        if (buffer == nullptr)
+        {
+            return nullptr;
+        }
+        buffer->computation = _computation;
+        return &buffer->values;
+    }
+
+    template <typename ValueType>
+    const std::vector<ValueType>* ExecutionContext::GetOutput(const OutputPort<ValueType>& port) const
+    {
+        auto buffer = GetBuffer(port);
+        return buffer == nullptr ? nullptr : &buffer->values;
+    }
+
+    template <typename ValueType>
+    bool ExecutionContext::HasOutput(const OutputPort<ValueType>& port) const
+    {
+        auto buffer = GetBuffer(port);
+        return buffer != nullptr && buffer->computation == _computation;
+    }
+
+    template <typename ValueType>
+    ExecutionContext::Buffer<ValueType>* ExecutionContext::GetBuffer(const OutputPort<ValueType>& port) const
+    {
+        // a port that was added to the model after the context was made has no storage in it
+        auto index = port.GetExecutionIndex();
+        if (index >= _buffers.size() || _buffers[index]->port != &port)
+        {
+            return nullptr;
+        }
+        return static_cast<Buffer<ValueType>*>(_buffers[index].get());
+    }
+}
+}
@@ -0,0 +1,47 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ExecutionPlan.tcc (model)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "OutputPort.h"
+
+namespace ell
+{
+namespace model
+{
+    template <typename ValueType>
+    std::vector<ValueType> ExecutionPlan::ComputeOutput(const PortElementsBase& elements) const
+    {
+        Execute();
+        return GetOutputValues<ValueType>(elements);
+    }
+
+    template <typename ValueType>
+    std::vector<ValueType> GetOutputValues(const PortElementsBase& elements)
+    {
+        std::vector<ValueType> result;
+        result.reserve(elements.Size());
+        for (const auto& range : elements.GetRanges())
+        {
+            const auto& output = static_cast<const OutputPort<ValueType>*>(range.ReferencedPort())->GetOutput();
+            auto begin = output.begin() + range.GetStartIndex();
+            result.insert(result.end(), begin, begin + range.Size());
+        }
+        return result;
+    }
+
+    template <typename ValueType>
+    void CopyOutputValues(const PortElementsBase& elements, ValueType* outputValues)
+    {
+        for (const auto& range : elements.GetRanges())
+        {
+            const auto& output = static_cast<const OutputPort<ValueType>*>(range.ReferencedPort())->GetOutput();
+            auto begin = output.begin() + range.GetStartIndex();
+            outputValues = std::copy(begin, begin + range.Size(), outputValues);
+        }
+    }
+}
+}
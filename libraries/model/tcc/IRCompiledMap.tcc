@@ -10,6 +10,55 @@ namespace ell
 {
 namespace model
 {
+    template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType>, utilities::IsFundamental<InputType>>
+    void IRCompiledMap::Compute(const InputType* inputValues, OutputType* outputValues) const
+    {
+        if (GetInput(0)->GetOutputPort().GetType() != Port::GetPortType<InputType>() || GetOutput(0).GetPortType() != Port::GetPortType<OutputType>())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        // The predict function takes a scalar input by value
+        auto functionPointer = ResolveComputeFunction();
+        if (GetInputSize() == 1)
+        {
+            reinterpret_cast<void (*)(const InputType, OutputType*)>(functionPointer)(*inputValues, outputValues);
+        }
+        else
+        {
+            reinterpret_cast<void (*)(const InputType*, OutputType*)>(functionPointer)(inputValues, outputValues);
+        }
+    }
+
+    template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType>, utilities::IsFundamental<InputType>>
+    void IRCompiledMap::ComputeBatch(const std::vector<InputType>& inputValues, std::vector<OutputType>& outputValues) const
+    {
+        if (GetInput(0)->GetOutputPort().GetType() != Port::GetPortType<InputType>() || GetOutput(0).GetPortType() != Port::GetPortType<OutputType>())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        auto inputSize = GetInputSize();
+        if (inputSize == 0 || inputValues.size() % inputSize != 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "batch input size must be a multiple of the map's input size");
+        }
+        auto numRows = inputValues.size() / inputSize;
+
+        // the compiled function takes the number of rows as a 32-bit integer
+        if (numRows > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "batch has too many rows");
+        }
+        outputValues.resize(numRows * GetOutputSize());
+
+        auto computeBatch = reinterpret_cast<ComputeBatchFunction<InputType, OutputType>>(ResolveComputeBatchFunction());
+        utilities::ConformingVector<InputType> inputBuffer;
+        utilities::ConformingVector<OutputType> outputBuffer;
+        computeBatch(static_cast<int32_t>(numRows), DynamicMapImpl::GetBatchData(inputValues, inputBuffer), DynamicMapImpl::GetBatchData(outputValues, outputBuffer));
+        DynamicMapImpl::CopyBatchData(outputBuffer, outputValues);
+    }
+
     template <typename InputType>
     void IRCompiledMap::SetComputeFunctionForInputType() const
     {
@@ -74,6 +74,10 @@ namespace model
         EnsureValidMap(map);
         model::TransformContext context{ [](const model::Node& node) { return node.IsCompilable() ? model::NodeAction::compile : model::NodeAction::refine; } };
         map.Refine(context);
+        if (GetMapCompilerParameters().optimizeModel)
+        {
+            GetModelOptimizer().Optimize(map, context);
+        }
 
         if (GetMapCompilerParameters().profile)
         {
@@ -28,12 +28,40 @@ namespace model
     void InputNode<ValueType>::SetInput(std::vector<ValueType> inputValues)
     {
         assert(_output.Size() == inputValues.size());
+
+        // in an execution context, the input is only set for the computation in that context
+        auto context = ExecutionContext::GetCurrent();
+        auto output = context != nullptr ? context->SetOutput(_output) : nullptr;
+        if (output != nullptr)
+        {
+            *output = std::move(inputValues);
+            return;
+        }
         _inputValues = inputValues;
     }
 
+    template <typename ValueType>
+    void InputNode<ValueType>::SetInput(const ValueType* inputValues)
+    {
+        // the storage of the context is reused from one computation to the next
+        auto context = ExecutionContext::GetCurrent();
+        auto output = context != nullptr ? context->SetOutput(_output) : nullptr;
+        if (output != nullptr)
+        {
+            output->assign(inputValues, inputValues + Size());
+            return;
+        }
+        _inputValues.assign(inputValues, inputValues + Size());
+    }
+
     template <typename ValueType>
     void InputNode<ValueType>::Compute() const
     {
+        auto context = ExecutionContext::GetCurrent();
+        if (context != nullptr && context->HasOutput(_output))
+        {
+            return;
+        }
         _output.SetOutput(_inputValues);
     }
 
@@ -49,15 +49,15 @@ namespace model
     template <typename ValueType>
     std::vector<ValueType> InputPort<ValueType>::GetValue() const
     {
+        // copy one range at a time, instead of looking up the range of each element
         std::vector<ValueType> result;
-        size_t size = Size();
-        result.reserve(size);
-        for (size_t index = 0; index < size; ++index)
+        result.reserve(Size());
+        for (const auto& range : _input.GetRanges())
         {
-            auto element = _input.GetElement(index);
-            auto typedOutput = static_cast<const OutputPort<ValueType>*>(element.ReferencedPort());
-            auto temp = typedOutput->GetOutput(element.GetIndex());
-            result.push_back(temp);
+            auto typedOutput = static_cast<const OutputPort<ValueType>*>(range.ReferencedPort());
+            const auto& output = typedOutput->GetOutput();
+            auto begin = output.begin() + range.GetStartIndex();
+            result.insert(result.end(), begin, begin + range.Size());
         }
 
         if (Size() != result.size())
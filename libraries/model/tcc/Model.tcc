@@ -74,14 +74,13 @@ namespace model
         VisitSubset(nodes, compute);
 
         // Now construct the output
-        auto numElements = elements.Size();
-        std::vector<ValueType> result(numElements);
-        for (size_t index = 0; index < numElements; ++index)
+        std::vector<ValueType> result;
+        result.reserve(elements.Size());
+        for (const auto& range : elements.GetRanges())
         {
-            auto element = elements.GetElement(index);
-            auto port = element.ReferencedPort();
-            auto portOutput = port->GetOutput()[element.GetIndex()];
-            result[index] = portOutput;
+            const auto& portOutput = static_cast<const OutputPort<ValueType>*>(range.ReferencedPort())->GetOutput();
+            auto begin = portOutput.begin() + range.GetStartIndex();
+            result.insert(result.end(), begin, begin + range.Size());
         }
         return result;
     }
@@ -19,30 +19,44 @@ namespace model
     {
     }
 
+    template <typename ValueType>
+    const std::vector<ValueType>& OutputPort<ValueType>::GetOutput() const
+    {
+        auto context = ExecutionContext::GetCurrent();
+        auto output = context != nullptr ? context->GetOutput(*this) : nullptr;
+        return output != nullptr ? *output : _cachedOutput;
+    }
+
     template <typename ValueType>
     ValueType OutputPort<ValueType>::GetOutput(size_t index) const
     {
-        return _cachedOutput[index];
+        return GetOutput()[index];
     }
 
     template <typename ValueType>
     std::vector<double> OutputPort<ValueType>::GetDoubleOutput() const
     {
-        std::vector<double> result;
-        std::copy(_cachedOutput.begin(), _cachedOutput.end(), result.begin());
-        return result;
+        const auto& output = GetOutput();
+        return std::vector<double>(output.begin(), output.end());
     }
 
     template <typename ValueType>
     double OutputPort<ValueType>::GetDoubleOutput(size_t index) const
     {
-        return static_cast<double>(_cachedOutput[index]);
+        return static_cast<double>(GetOutput()[index]);
     }
 
     template <typename ValueType>
     void OutputPort<ValueType>::SetOutput(std::vector<ValueType> values) const
     {
-        _cachedOutput = values;
+        auto context = ExecutionContext::GetCurrent();
+        auto output = context != nullptr ? context->SetOutput(*this) : nullptr;
+        if (output != nullptr)
+        {
+            *output = std::move(values);
+            return;
+        }
+        _cachedOutput = std::move(values);
     }
 
     template <typename ValueType>
@@ -20,6 +20,7 @@ void TestCompilableDotProductNode();
 void TestCompilableDelayNode();
 void TestCompilableDTWDistanceNode();
 void TestCompilableMulticlassDTW();
+void TestCompilableFeatureHashingNode();
 void TestCompilableScalarSumNode();
 void TestCompilableSumNode();
 void TestCompilableUnaryOperationNode();
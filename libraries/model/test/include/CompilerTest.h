@@ -40,3 +40,7 @@ void TestSteppableMap(bool runJit = false);
 void TestMultiOutputMap();
 void TestMultiOutputMap2();
 void TestCompiledMapMove();
+void TestCompiledMapComputeBatch();
+void TestCompiledMapComputeBuffers();
+void TestCompiledMapSharedPortMemory();
+void TestCompiledMapComputeInPlace();
@@ -10,6 +10,12 @@
 void TestDynamicMapCreate();
 void TestDynamicMapCompute();
 void TestDynamicMapComputeDataVector();
+void TestDynamicMapComputeBatch();
+void TestDynamicMapComputeBuffers();
 void TestDynamicMapRefine();
+void TestDynamicMapOptimize();
+void TestDynamicMapExecutionPlan();
+void TestDynamicMapParallelCompute();
+void TestDynamicMapConcurrentCompute();
 void TestDynamicMapSerialization();
 void TestSteppableMapCompute();
@@ -19,3 +19,5 @@ void TestCopyModel();
 
 void TestRefineSplitOutputs();
 void TestCustomRefine();
+
+void TestMemoryPlan();
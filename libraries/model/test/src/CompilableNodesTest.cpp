@@ -34,6 +34,7 @@
 #include "DelayNode.h"
 #include "DotProductNode.h"
 #include "ExtremalValueNode.h"
+#include "FeatureHashingNode.h"
 #include "FullyConnectedLayerNode.h"
 #include "IRNode.h"
 #include "MultiplexerNode.h"
@@ -213,6 +214,36 @@ void TestCompilableDTWDistanceNode()
     VerifyCompiledOutput(map, compiledMap, signal, "DTWDistanceNode");
 }
 
+void TestCompilableFeatureHashingNode()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(8);
+    auto hashingNode = model.AddNode<nodes::FeatureHashingNode<double>>(inputNode->output, 2);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", hashingNode->output } });
+    model::IRMapCompiler compiler;
+    auto compiledMap = compiler.Compile(map);
+
+    // compare output
+    std::vector<std::vector<double>> signal = { { 1, 2, 3, 4, 5, 6, 7, 8 }, { 0, 0, 1, 0, 0, 0, 0, 0 }, { -1, 2, -3, 4, -5, 6, -7, 8 } };
+    VerifyCompiledOutput(map, compiledMap, signal, "FeatureHashingNode");
+
+    // an input too large for lookup tables is hashed in the emitted code
+    model::Model largeModel;
+    const size_t largeInputSize = 5000;
+    auto largeInputNode = largeModel.AddNode<model::InputNode<double>>(largeInputSize);
+    auto largeHashingNode = largeModel.AddNode<nodes::FeatureHashingNode<double>>(largeInputNode->output, 10);
+    auto largeMap = model::DynamicMap(largeModel, { { "input", largeInputNode } }, { { "output", largeHashingNode->output } });
+    auto largeCompiledMap = compiler.Compile(largeMap);
+
+    std::vector<std::vector<double>> largeSignal(2, std::vector<double>(largeInputSize));
+    for (size_t index = 0; index < largeInputSize; ++index)
+    {
+        largeSignal[0][index] = static_cast<double>(index % 7);
+        largeSignal[1][index] = index % 3 == 0 ? -1.0 : 0.5;
+    }
+    VerifyCompiledOutput(largeMap, largeCompiledMap, largeSignal, "FeatureHashingNode with a large input");
+}
+
 class LabeledPrototype
 {
 public:
@@ -19,6 +19,7 @@
 
 // nodes
 #include "AccumulatorNode.h"
+#include "BinaryOperationNode.h"
 #include "ConstantNode.h"
 #include "DelayNode.h"
 #include "DotProductNode.h"
@@ -27,6 +28,7 @@
 #include "SinkNode.h"
 #include "SourceNode.h"
 #include "SumNode.h"
+#include "UnaryOperationNode.h"
 
 // emitters
 #include "EmitterException.h"
@@ -197,6 +199,114 @@ void TestCompiledMapMove()
     VerifyCompiledOutput(map, compiledMap2, signal, " moved compiled map");
 }
 
+void TestCompiledMapComputeBatch()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto sumNode = model.AddNode<nodes::SumNode<double>>(inputNode->output);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", sumNode->output } });
+    model::IRMapCompiler compiler;
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 3, 4, 5 }, { 2, 3, 2 }, { 1, 5, 3 } };
+    std::vector<double> batchInput;
+    std::vector<double> expectedOutput;
+    for (const auto& input : signal)
+    {
+        batchInput.insert(batchInput.end(), input.begin(), input.end());
+        auto output = map.Compute<double>(input);
+        expectedOutput.insert(expectedOutput.end(), output.begin(), output.end());
+    }
+
+    std::vector<double> computedBatchOutput;
+    map.ComputeBatch(batchInput, computedBatchOutput);
+    std::vector<double> compiledBatchOutput;
+    compiledMap.ComputeBatch(batchInput, compiledBatchOutput);
+    testing::ProcessTest("Testing compute batch of compiled map", testing::IsEqual(computedBatchOutput, expectedOutput) && testing::IsEqual(compiledBatchOutput, expectedOutput));
+}
+
+void TestCompiledMapComputeBuffers()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto accumNode = model.AddNode<nodes::AccumulatorNode<double>>(inputNode->output);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", accumNode->output } });
+    model::IRMapCompiler compiler;
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 3, 4, 5 }, { 2, 3, 2 }, { 1, 5, 3 } };
+    std::vector<double> outputBuffer(compiledMap.GetOutputSize());
+    bool ok = true;
+    for (const auto& input : signal)
+    {
+        auto expectedOutput = map.Compute<double>(input);
+        compiledMap.Compute(input.data(), outputBuffer.data());
+        ok = ok && testing::IsEqual(outputBuffer, expectedOutput);
+    }
+    testing::ProcessTest("Testing compute of compiled map with caller-provided buffers", ok);
+}
+
+void TestCompiledMapSharedPortMemory()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(4);
+    auto constantNode = model.AddNode<nodes::ConstantNode<double>>(std::vector<double>{ 1, 2, 3, 4 });
+    const model::OutputPort<double>* output = &inputNode->output;
+    for (int index = 0; index < 4; ++index)
+    {
+        auto operation = index % 2 == 0 ? emitters::BinaryOperationType::add : emitters::BinaryOperationType::coordinatewiseMultiply;
+        output = &model.AddNode<nodes::BinaryOperationNode<double>>(*output, constantNode->output, operation)->output;
+    }
+    auto sumNode = model.AddNode<nodes::SumNode<double>>(*output);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", sumNode->output } });
+
+    model::MapCompilerParameters settings;
+    settings.sharePortMemory = true;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+    const auto& plan = compiler.GetMemoryPlan();
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3, 4 }, { 4, 5, 6, 7 }, { 7, 8, 9, 10 } };
+    bool ok = plan.NumPorts() == 4 && plan.GetArenaSize() < plan.GetUnsharedSize();
+    for (const auto& input : signal)
+    {
+        ok = ok && testing::IsEqual(compiledMap.Compute<double>(input), map.Compute<double>(input));
+    }
+    testing::ProcessTest("Testing compiled map with shared port memory", ok);
+}
+
+void TestCompiledMapComputeInPlace()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(8);
+    auto addNode = model.AddNode<nodes::BinaryOperationNode<double>>(inputNode->output, inputNode->output, emitters::BinaryOperationType::add);
+    auto sqrtNode1 = model.AddNode<nodes::UnaryOperationNode<double>>(addNode->output, emitters::UnaryOperationType::sqrt);
+    auto sqrtNode2 = model.AddNode<nodes::UnaryOperationNode<double>>(sqrtNode1->output, emitters::UnaryOperationType::sqrt);
+    auto sumNode = model.AddNode<nodes::SumNode<double>>(sqrtNode2->output);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", sumNode->output } });
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3, 4, 5, 6, 7, 8 }, { 4, 5, 6, 7, 8, 9, 10, 11 } };
+    for (auto sharePortMemory : { false, true })
+    {
+        for (auto computeInPlace : { false, true })
+        {
+            model::MapCompilerParameters settings;
+            settings.sharePortMemory = sharePortMemory;
+            settings.computeInPlace = computeInPlace;
+            model::IRMapCompiler compiler(settings);
+            auto compiledMap = compiler.Compile(map);
+
+            // The square roots overwrite the sum, so the three ports fit in the memory of one
+            bool ok = !sharePortMemory || compiler.GetMemoryPlan().GetArenaSize() == (computeInPlace ? 64 : 128);
+            for (const auto& input : signal)
+            {
+                ok = ok && testing::IsEqual(compiledMap.Compute<double>(input), map.Compute<double>(input));
+            }
+            testing::ProcessTest(std::string("Testing compiled map computed in place") + (computeInPlace ? "" : " (disabled)") + (sharePortMemory ? " with shared port memory" : ""), ok);
+        }
+    }
+}
+
 typedef void (*MapPredictFunction)(double*, double*);
 
 void TestBinaryVector(bool expanded, bool runJit)
@@ -485,7 +595,7 @@ model::DynamicMap MakeLinearPredictor()
 {
     // make a linear predictor
     size_t dim = 3;
-    predictors::LinearPredictor predictor(dim);
+    predictors::LinearPredictor<double> predictor(dim);
     predictor.GetBias() = 2.0;
     predictor.GetWeights() = math::ColumnVector<double>{ 3.0, 4.0, 5.0 };
 
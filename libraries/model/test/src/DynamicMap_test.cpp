@@ -14,13 +14,18 @@
 
 // model
 #include "DynamicMap.h"
+#include "ExecutionPlan.h"
 #include "InputNode.h"
 #include "Model.h"
+#include "ModelOptimizer.h"
 #include "OutputNode.h"
 #include "PortElements.h"
 #include "SteppableMap.h"
 
 // nodes
+#include "BinaryOperationNode.h"
+#include "ConstantFoldingPass.h"
+#include "ConstantNode.h"
 #include "ExtremalValueNode.h"
 #include "MovingAverageNode.h"
 #include "SourceNode.h"
@@ -35,9 +40,11 @@
 #include "testing.h"
 
 // stl
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <thread>
 #include <tuple>
@@ -108,6 +115,90 @@ void TestDynamicMapComputeDataVector()
     testing::ProcessTest("Testing map compute 2", testing::IsEqual(resultValues[0], 8.5) && testing::IsEqual(resultValues[1], 10.5));
 }
 
+void TestDynamicMapComputeBatch()
+{
+    auto model = GetSimpleModel();
+    auto inputNodes = model.GetNodesByType<model::InputNode<double>>();
+    auto outputNodes = model.GetNodesByType<model::OutputNode<double>>();
+    auto map = model::DynamicMap(model, { { "doubleInput", inputNodes[0] } }, { { "doubleOutput", outputNodes[0]->output } });
+    auto batchMap = model::DynamicMap(model, { { "doubleInput", inputNodes[0] } }, { { "doubleOutput", outputNodes[0]->output } });
+
+    auto signal = std::vector<std::vector<double>>{ { 1.0, 2.0, 3.0 },
+                                                    { 4.0, 5.0, 6.0 },
+                                                    { 7.0, 8.0, 9.0 },
+                                                    { 10.0, 11.0, 12.0 } };
+    std::vector<double> batchInput;
+    std::vector<double> expectedOutput;
+    for (const auto& sample : signal)
+    {
+        batchInput.insert(batchInput.end(), sample.begin(), sample.end());
+        auto output = map.Compute<double>(sample);
+        expectedOutput.insert(expectedOutput.end(), output.begin(), output.end());
+    }
+
+    std::vector<double> batchOutput;
+    batchMap.ComputeBatch(batchInput, batchOutput);
+    testing::ProcessTest("Testing map compute batch", testing::IsEqual(batchOutput, expectedOutput) && testing::IsEqual(batchOutput[6], 8.5) && testing::IsEqual(batchOutput[7], 10.5));
+
+    bool threwSizeMismatch = false;
+    try
+    {
+        batchMap.ComputeBatch(std::vector<double>(batchInput.begin(), batchInput.end() - 1), batchOutput);
+    }
+    catch (const utilities::InputException&)
+    {
+        threwSizeMismatch = true;
+    }
+    testing::ProcessTest("Testing map compute batch with a partial row", threwSizeMismatch);
+
+    bool threwTypeMismatch = false;
+    try
+    {
+        std::vector<float> floatOutput;
+        batchMap.ComputeBatch(std::vector<float>(batchInput.begin(), batchInput.end()), floatOutput);
+    }
+    catch (const utilities::InputException&)
+    {
+        threwTypeMismatch = true;
+    }
+    testing::ProcessTest("Testing map compute batch with mismatched value types", threwTypeMismatch);
+}
+
+void TestDynamicMapComputeBuffers()
+{
+    auto model = GetSimpleModel();
+    auto inputNodes = model.GetNodesByType<model::InputNode<double>>();
+    auto outputNodes = model.GetNodesByType<model::OutputNode<double>>();
+    auto map = model::DynamicMap(model, { { "doubleInput", inputNodes[0] } }, { { "doubleOutput", outputNodes[0]->output } });
+    auto bufferMap = model::DynamicMap(model, { { "doubleInput", inputNodes[0] } }, { { "doubleOutput", outputNodes[0]->output } });
+
+    auto signal = std::vector<std::vector<double>>{ { 1.0, 2.0, 3.0 },
+                                                    { 4.0, 5.0, 6.0 },
+                                                    { 7.0, 8.0, 9.0 },
+                                                    { 10.0, 11.0, 12.0 } };
+    std::vector<double> outputBuffer(bufferMap.GetOutputSize());
+    bool ok = true;
+    for (const auto& sample : signal)
+    {
+        auto expectedOutput = map.Compute<double>(sample);
+        bufferMap.Compute(sample.data(), outputBuffer.data());
+        ok = ok && testing::IsEqual(outputBuffer, expectedOutput);
+    }
+    testing::ProcessTest("Testing map compute with caller-provided buffers", ok && testing::IsEqual(outputBuffer[0], 8.5) && testing::IsEqual(outputBuffer[1], 10.5));
+
+    bool threwTypeMismatch = false;
+    try
+    {
+        std::vector<float> floatOutputBuffer(bufferMap.GetOutputSize());
+        bufferMap.Compute(signal[0].data(), floatOutputBuffer.data());
+    }
+    catch (const utilities::InputException&)
+    {
+        threwTypeMismatch = true;
+    }
+    testing::ProcessTest("Testing map compute with a buffer of the wrong type", threwTypeMismatch);
+}
+
 void TestDynamicMapRefine()
 {
     auto model = GetSimpleModel();
@@ -140,6 +231,225 @@ void TestDynamicMapRefine()
     testing::ProcessTest("Testing refined map compute", testing::IsEqual(resultValues1, resultValues2));
 }
 
+void TestDynamicMapOptimize()
+{
+    // out = (in + c1 * c3) + (in + c2 * c3), where c1 and c2 are equal, plus an unused branch
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto constant1 = model.AddNode<nodes::ConstantNode<double>>(std::vector<double>{ 1.0, 2.0, 3.0 });
+    auto constant2 = model.AddNode<nodes::ConstantNode<double>>(std::vector<double>{ 1.0, 2.0, 3.0 });
+    auto constant3 = model.AddNode<nodes::ConstantNode<double>>(std::vector<double>{ 2.0, 2.0, 2.0 });
+    auto scale1 = model.AddNode<nodes::BinaryOperationNode<double>>(constant1->output, constant3->output, emitters::BinaryOperationType::coordinatewiseMultiply);
+    auto scale2 = model.AddNode<nodes::BinaryOperationNode<double>>(constant2->output, constant3->output, emitters::BinaryOperationType::coordinatewiseMultiply);
+    auto sum1 = model.AddNode<nodes::BinaryOperationNode<double>>(inputNode->output, scale1->output, emitters::BinaryOperationType::add);
+    auto sum2 = model.AddNode<nodes::BinaryOperationNode<double>>(inputNode->output, scale2->output, emitters::BinaryOperationType::add);
+    model.AddNode<nodes::BinaryOperationNode<double>>(inputNode->output, constant1->output, emitters::BinaryOperationType::subtract);
+    auto total = model.AddNode<nodes::BinaryOperationNode<double>>(sum1->output, sum2->output, emitters::BinaryOperationType::add);
+    auto outputNode = model.AddNode<model::OutputNode<double>>(total->output);
+
+    auto map1 = model::DynamicMap(model, { { "doubleInput", inputNode } }, { { "doubleOutput", outputNode->output } });
+    auto map2 = model::DynamicMap(model, { { "doubleInput", inputNode } }, { { "doubleOutput", outputNode->output } });
+
+    model::ModelOptimizer optimizer;
+    optimizer.AddPass(std::make_unique<model::CommonSubexpressionEliminationPass>());
+    optimizer.AddPass(std::make_unique<nodes::ConstantFoldingPass>());
+    model::TransformContext context;
+    optimizer.Optimize(map2, context);
+
+    // what remains is the input, the folded constant, the shared sum, the total and the output
+    testing::ProcessTest("Testing optimized map size", map2.GetModel().Size() == 5 && map2.GetModel().GetNodesByType<nodes::ConstantNode<double>>().size() == 1);
+
+    auto input = std::vector<std::vector<double>>{ { 1.0, 2.0, 3.0 },
+                                                   { 4.0, 5.0, 6.0 } };
+    bool ok = true;
+    for (const auto& inVec : input)
+    {
+        ok = ok && testing::IsEqual(map1.Compute<double>(inVec), map2.Compute<double>(inVec));
+    }
+    testing::ProcessTest("Testing optimized map compute", ok && testing::IsEqual(map2.Compute<double>(input[0]), std::vector<double>{ 6.0, 12.0, 18.0 }));
+
+    // constants that only differ after the 6th digit must not be merged
+    model::Model model2;
+    auto inputNode2 = model2.AddNode<model::InputNode<double>>(1);
+    auto constant4 = model2.AddNode<nodes::ConstantNode<double>>(std::vector<double>{ 0.1234567 });
+    auto constant5 = model2.AddNode<nodes::ConstantNode<double>>(std::vector<double>{ 0.1234568 });
+    auto sum3 = model2.AddNode<nodes::BinaryOperationNode<double>>(inputNode2->output, constant4->output, emitters::BinaryOperationType::add);
+    auto sum4 = model2.AddNode<nodes::BinaryOperationNode<double>>(inputNode2->output, constant5->output, emitters::BinaryOperationType::add);
+    auto difference = model2.AddNode<nodes::BinaryOperationNode<double>>(sum4->output, sum3->output, emitters::BinaryOperationType::subtract);
+    auto outputNode2 = model2.AddNode<model::OutputNode<double>>(difference->output);
+
+    auto map3 = model::DynamicMap(model2, { { "doubleInput", inputNode2 } }, { { "doubleOutput", outputNode2->output } });
+    model::ModelOptimizer optimizer2;
+    optimizer2.AddPass(std::make_unique<model::CommonSubexpressionEliminationPass>());
+    optimizer2.Optimize(map3, context);
+    auto result = map3.Compute<double>(std::vector<double>{ 1.0 });
+    testing::ProcessTest("Testing optimized map keeps nearly equal constants", map3.GetModel().GetNodesByType<nodes::ConstantNode<double>>().size() == 2 && result.size() == 1 && result[0] > 0.0);
+}
+
+void TestDynamicMapExecutionPlan()
+{
+    auto model = GetSimpleModel();
+    auto inputNodes = model.GetNodesByType<model::InputNode<double>>();
+    auto outputNodes = model.GetNodesByType<model::OutputNode<double>>();
+    assert(outputNodes.size() == 1);
+
+    auto map1 = model::DynamicMap(model, { { "doubleInput", inputNodes[0] } }, { { "doubleOutput", outputNodes[0]->output } });
+    auto map2 = map1;
+
+    auto input = std::vector<std::vector<double>>{ { 1.0, 2.0, 3.0 },
+                                                   { 4.0, 5.0, 6.0 },
+                                                   { 7.0, 8.0, 9.0 },
+                                                   { 10.0, 11.0, 12.0 } };
+    std::vector<double> resultValues1;
+    std::vector<double> resultValues2;
+    for (size_t index = 0; index < input.size(); ++index)
+    {
+        // refining the model halfway through must discard the plan that was built for the original model
+        if (index == 2)
+        {
+            model::TransformContext context;
+            map2.Refine(context);
+        }
+
+        map1.SetInputValue("doubleInput", input[index]);
+        map2.SetInputValue("doubleInput", input[index]);
+        resultValues1 = map1.ComputeOutput<double>("doubleOutput");
+        resultValues2 = map2.ComputeOutput<double>("doubleOutput");
+    }
+
+    auto plan = model::ExecutionPlan(map1.GetModel(), map1.GetOutput(0));
+    testing::ProcessTest("Testing execution plan size", plan.GetNodes().size() == map1.GetModel().Size() && plan.GetOutputNodes().size() == 1);
+    testing::ProcessTest("Testing execution plan compute", testing::IsEqual(resultValues1[0], 8.5) && testing::IsEqual(resultValues1[1], 10.5));
+    testing::ProcessTest("Testing execution plan compute after refine", testing::IsEqual(resultValues1, resultValues2));
+}
+
+void TestDynamicMapParallelCompute()
+{
+    // a model with many independent branches
+    model::Model model;
+    auto in = model.AddNode<model::InputNode<double>>(3);
+    std::vector<model::PortElements<double>> branchOutputs;
+    for (int branch = 0; branch < 16; ++branch)
+    {
+        const model::OutputPort<double>* extremum;
+        if (branch % 2 == 0)
+        {
+            extremum = &model.AddNode<nodes::ArgMinNode<double>>(in->output)->val;
+        }
+        else
+        {
+            extremum = &model.AddNode<nodes::ArgMaxNode<double>>(in->output)->val;
+        }
+        auto mean = model.AddNode<nodes::MovingAverageNode<double>>(*extremum, branch % 4 + 1);
+        branchOutputs.push_back(mean->output);
+    }
+    auto out = model.AddNode<model::OutputNode<double>>(model::PortElements<double>(branchOutputs));
+
+    auto map1 = model::DynamicMap(model, { { "doubleInput", in } }, { { "doubleOutput", out->output } });
+    auto map2 = map1;
+    model::ParallelExecutionParameters parameters;
+    parameters.numThreads = 4;
+    parameters.minTaskCost = 1;
+    map2.SetParallelExecutionParameters(parameters);
+
+    auto input = std::vector<std::vector<double>>{ { 1.0, 2.0, 3.0 },
+                                                   { 4.0, 5.0, 6.0 },
+                                                   { 7.0, 8.0, 9.0 },
+                                                   { 10.0, 11.0, 12.0 } };
+    std::vector<double> resultValues1;
+    std::vector<double> resultValues2;
+    for (const auto& inVec : input)
+    {
+        map1.SetInputValue("doubleInput", inVec);
+        map2.SetInputValue("doubleInput", inVec);
+        resultValues1 = map1.ComputeOutput<double>("doubleOutput");
+        resultValues2 = map2.ComputeOutput<double>("doubleOutput");
+    }
+
+    auto plan = model::ExecutionPlan(map2.GetModel(), map2.GetOutput(0));
+    testing::ProcessTest("Testing execution plan tasks", plan.NumTasks() > 16);
+    testing::ProcessTest("Testing parallel map compute", resultValues1.size() == 16 && testing::IsEqual(resultValues1, resultValues2));
+}
+
+void TestDynamicMapConcurrentCompute()
+{
+    model::Model model;
+    auto in = model.AddNode<model::InputNode<double>>(3);
+    auto minAndArgMin = model.AddNode<nodes::ArgMinNode<double>>(in->output);
+    auto maxAndArgMax = model.AddNode<nodes::ArgMaxNode<double>>(in->output);
+    auto out = model.AddNode<model::OutputNode<double>>(model::PortElements<double>({ minAndArgMin->val, maxAndArgMax->val }));
+    auto map = model::DynamicMap(model, { { "doubleInput", in } }, { { "doubleOutput", out->output } });
+
+    const int numThreads = 8;
+    const int numIterations = 200;
+    for (size_t numMapThreads : { 1, 4 })
+    {
+        model::ParallelExecutionParameters parameters;
+        parameters.numThreads = numMapThreads;
+        parameters.minTaskCost = 1;
+        map.SetParallelExecutionParameters(parameters);
+
+        // each thread computes the map on its own inputs
+        std::vector<std::thread> threads;
+        std::vector<int> numErrors(numThreads, 0);
+        for (int threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+        {
+            threads.emplace_back([&map, &numErrors, threadIndex]() {
+                for (int iteration = 0; iteration < numIterations; ++iteration)
+                {
+                    double value = threadIndex * numIterations + iteration;
+                    auto result = map.Compute<double>(std::vector<double>{ value + 1, value, value + 2 });
+                    if (result != std::vector<double>{ value, value + 2 })
+                    {
+                        ++numErrors[threadIndex];
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        testing::ProcessTest("Testing concurrent map compute", std::all_of(numErrors.begin(), numErrors.end(), [](int x) { return x == 0; }));
+    }
+
+    // once the calls are done, the output port holds the values of the last one
+    map.Compute<double>(std::vector<double>{ 5, 4, 6 });
+    testing::ProcessTest("Testing port output after map compute", map.GetOutput(0).GetElement(0).ReferencedPort()->GetDoubleOutput() == std::vector<double>{ 4, 6 });
+
+    // two different maps computed at the same time each keep the values of their own calls in their ports
+    model::Model model2;
+    auto in2 = model2.AddNode<model::InputNode<double>>(3);
+    auto constant = model2.AddNode<nodes::ConstantNode<double>>(std::vector<double>{ 1.0, 2.0, 3.0 });
+    auto sum = model2.AddNode<nodes::BinaryOperationNode<double>>(in2->output, constant->output, emitters::BinaryOperationType::add);
+    auto out2 = model2.AddNode<model::OutputNode<double>>(sum->output);
+    auto map2 = model::DynamicMap(model2, { { "doubleInput", in2 } }, { { "doubleOutput", out2->output } });
+
+    std::vector<int> numPortErrors(2, 0);
+    std::vector<std::thread> threads;
+    for (int mapIndex = 0; mapIndex < 2; ++mapIndex)
+    {
+        threads.emplace_back([&map, &map2, &numPortErrors, mapIndex]() {
+            const auto& threadMap = mapIndex == 0 ? map : map2;
+            for (int iteration = 0; iteration < numIterations; ++iteration)
+            {
+                double value = iteration;
+                auto result = threadMap.Compute<double>(std::vector<double>{ value + 1, value, value + 2 });
+                if (threadMap.GetOutput(0).GetElement(0).ReferencedPort()->GetDoubleOutput() != result)
+                {
+                    ++numPortErrors[mapIndex];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    testing::ProcessTest("Testing port output after concurrent compute of two maps", numPortErrors[0] == 0 && numPortErrors[1] == 0);
+}
+
 void TestDynamicMapSerialization()
 {
     auto model = GetSimpleModel();
@@ -12,16 +12,20 @@
 // model
 #include "InputNode.h"
 #include "InputPort.h"
+#include "MemoryPlan.h"
 #include "Model.h"
 #include "ModelTransformer.h"
 #include "OutputNode.h"
 #include "OutputPort.h"
 
 // nodes
+#include "BinaryOperationNode.h"
 #include "ConstantNode.h"
 #include "DotProductNode.h"
 #include "ExtremalValueNode.h"
 #include "MovingAverageNode.h"
+#include "SumNode.h"
+#include "UnaryOperationNode.h"
 #include "ValueSelectorNode.h"
 
 // common
@@ -348,3 +352,80 @@ void TestCustomRefine()
     auto model2 = transformer.RefineModel(model, context2);
     testing::ProcessTest("testing custom refine function", model1.Size() == 4 && model2.Size() == 3);
 }
+
+void TestMemoryPlan()
+{
+    auto allPorts = [](const model::OutputPortBase& port) { return port.GetNode()->NumInputPorts() > 0; };
+
+    // In a chain of nodes, two buffers are enough
+    model::Model chainModel;
+    auto chainInput = chainModel.AddNode<model::InputNode<double>>(8);
+    const model::OutputPort<double>* chainOutput = &chainInput->output;
+    for (int index = 0; index < 4; ++index)
+    {
+        chainOutput = &chainModel.AddNode<nodes::BinaryOperationNode<double>>(*chainOutput, *chainOutput, emitters::BinaryOperationType::add)->output;
+    }
+    model::MemoryPlan chainPlan(chainModel, allPorts, 16);
+    testing::ProcessTest("Testing memory plan of a chain", chainPlan.NumPorts() == 4 && chainPlan.GetUnsharedSize() == 4 * 64 && chainPlan.GetArenaSize() == 2 * 64);
+
+    // Two branches, each reduced to a scalar
+    model::Model model;
+    auto input = model.AddNode<model::InputNode<double>>(8);
+    auto branch1 = model.AddNode<nodes::BinaryOperationNode<double>>(input->output, input->output, emitters::BinaryOperationType::add);
+    auto branch2 = model.AddNode<nodes::BinaryOperationNode<double>>(input->output, input->output, emitters::BinaryOperationType::coordinatewiseMultiply);
+    auto sum1 = model.AddNode<nodes::SumNode<double>>(branch1->output);
+    auto sum2 = model.AddNode<nodes::SumNode<double>>(branch2->output);
+    model.AddNode<nodes::BinaryOperationNode<double>>(sum1->output, sum2->output, emitters::BinaryOperationType::add);
+    model::MemoryPlan plan(model, allPorts, 8);
+
+    // The nodes must come after their parents, and the ports a node reads must not share memory with the ports it writes
+    bool ok = plan.GetNodes().size() == model.Size();
+    std::unordered_map<const model::Node*, size_t> positions;
+    for (auto node : plan.GetNodes())
+    {
+        for (auto parent : node->GetParentNodes())
+        {
+            ok = ok && positions.find(parent) != positions.end();
+        }
+        positions[node] = positions.size();
+
+        for (auto output : node->GetOutputPorts())
+        {
+            for (auto input : node->GetInputPorts())
+            {
+                for (const auto& range : input->GetInputElements().GetRanges())
+                {
+                    auto inputPort = range.ReferencedPort();
+                    if (plan.HasPort(*inputPort) && plan.HasPort(*output))
+                    {
+                        auto inputBegin = plan.GetPortOffset(*inputPort);
+                        auto outputBegin = plan.GetPortOffset(*output);
+                        ok = ok && (inputBegin + model::MemoryPlan::GetPortMemorySize(*inputPort) <= outputBegin || outputBegin + model::MemoryPlan::GetPortMemorySize(*output) <= inputBegin);
+                    }
+                }
+            }
+        }
+    }
+
+    // One branch is reduced before the other one is computed
+    ok = ok && plan.NumPorts() == 5 && plan.GetUnsharedSize() == 2 * 64 + 3 * 8 && plan.GetArenaSize() <= 64 + 3 * 8;
+    testing::ProcessTest("Testing memory plan of a branching model", ok);
+
+    // A chain of nodes computed in place needs a single buffer, unless another node still reads the overwritten port
+    auto inPlacePorts = [](const model::OutputPortBase& port) -> const model::OutputPortBase* {
+        auto node = dynamic_cast<const model::CompilableNode*>(port.GetNode());
+        auto input = node == nullptr ? nullptr : node->GetInPlaceInput(port);
+        return input == nullptr ? nullptr : input->GetInputElements().GetRanges()[0].ReferencedPort();
+    };
+    model::Model inPlaceModel;
+    auto inPlaceInput = inPlaceModel.AddNode<model::InputNode<double>>(8);
+    auto sum = inPlaceModel.AddNode<nodes::BinaryOperationNode<double>>(inPlaceInput->output, inPlaceInput->output, emitters::BinaryOperationType::add);
+    auto sqrtNode = inPlaceModel.AddNode<nodes::UnaryOperationNode<double>>(sum->output, emitters::UnaryOperationType::sqrt);
+    auto expNode = inPlaceModel.AddNode<nodes::UnaryOperationNode<double>>(sqrtNode->output, emitters::UnaryOperationType::exp);
+    model::MemoryPlan inPlacePlan(inPlaceModel, allPorts, 16, inPlacePorts);
+    testing::ProcessTest("Testing memory plan of a chain computed in place", inPlacePlan.NumPorts() == 3 && inPlacePlan.GetUnsharedSize() == 3 * 64 && inPlacePlan.GetArenaSize() == 64 && inPlacePlan.GetOverwrittenPort(expNode->output) == &sqrtNode->output && inPlacePlan.GetOverwrittenPort(sqrtNode->output) == &sum->output && inPlacePlan.GetOverwrittenPort(sum->output) == nullptr);
+
+    inPlaceModel.AddNode<nodes::BinaryOperationNode<double>>(expNode->output, sqrtNode->output, emitters::BinaryOperationType::add);
+    model::MemoryPlan sharedInputPlan(inPlaceModel, allPorts, 16, inPlacePorts);
+    testing::ProcessTest("Testing memory plan of a port computed in place from a port read twice", sharedInputPlan.GetOverwrittenPort(expNode->output) == nullptr && sharedInputPlan.GetOverwrittenPort(sqrtNode->output) == &sum->output && sharedInputPlan.GetPortOffset(expNode->output) != sharedInputPlan.GetPortOffset(sqrtNode->output));
+}
@@ -39,6 +39,7 @@ int main()
 
         TestCopyModel();
         TestRefineSplitOutputs();
+        TestMemoryPlan();
 
         // PortElements tests
         TestSlice();
@@ -49,7 +50,13 @@ int main()
         TestDynamicMapCreate();
         TestDynamicMapCompute();
         TestDynamicMapComputeDataVector();
+        TestDynamicMapComputeBatch();
+        TestDynamicMapComputeBuffers();
         TestDynamicMapRefine();
+        TestDynamicMapOptimize();
+        TestDynamicMapExecutionPlan();
+        TestDynamicMapParallelCompute();
+        TestDynamicMapConcurrentCompute();
         TestDynamicMapSerialization();
         TestSteppableMapCompute();
 
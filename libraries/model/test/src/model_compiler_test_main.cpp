@@ -28,6 +28,10 @@ void TestIRCompiler()
     TestSimpleMap(false);
     TestSimpleMap(true);
     TestCompiledMapMove();
+    TestCompiledMapComputeBatch();
+    TestCompiledMapComputeBuffers();
+    TestCompiledMapSharedPortMemory();
+    TestCompiledMapComputeInPlace();
     TestBinaryScalar();
     TestBinaryVector(true);
     TestBinaryVector(false);
@@ -56,6 +60,7 @@ void TestIRCompiler()
     TestCompilableDelayNode();
     TestCompilableDTWDistanceNode();
     TestCompilableMulticlassDTW();
+    TestCompilableFeatureHashingNode();
     TestCompilableScalarSumNode();
     TestCompilableSumNode();
     TestCompilableUnaryOperationNode();
@@ -81,6 +81,9 @@ namespace nodes
         /// <summary> Makes a copy of this node in the model being constructed by the transformer </summary>
         virtual void Copy(model::ModelTransformer& transformer) const override;
 
+        /// <summary> Indicates that the output of this node depends only on its inputs and its archived properties. </summary>
+        virtual bool IsPure() const override { return true; }
+
         /// <summary> Gets the predicate performed by this node </summary>
         ///
         /// <returns> The predicate </returns>
@@ -218,11 +218,45 @@ namespace nodes
         bool CanUseVectorTypes() const { return true; }
     };
 
+    //
+    // Description of a broadcast function node that is independent of its function type, used to fuse chains of them
+    //
+    template <typename ValueType>
+    struct BroadcastFunctionStage
+    {
+        /// <summary> Computes the function of a primary value and its secondary values (on the host machine). </summary>
+        using ComputeFunction = std::function<ValueType(ValueType, const std::vector<ValueType>&)>;
+
+        /// <summary> Emits IR to compute the function of a primary value and its secondary values. </summary>
+        using CompileFunction = std::function<llvm::Value*(emitters::IRFunctionEmitter&, llvm::Value*, const std::vector<llvm::Value*>&)>;
+
+        model::PortElements<ValueType> primaryInput;
+        std::vector<model::PortElements<ValueType>> secondaryInputs; // empty elements for an absent input
+        PortMemoryLayout inputLayout;
+        PortMemoryLayout outputLayout;
+        size_t broadcastDimension = 0;
+        ComputeFunction compute;
+        CompileFunction compile;
+    };
+
+    /// <summary> Interface for nodes that can be fused with the elementwise nodes around them. </summary>
+    template <typename ValueType>
+    class IFusableBroadcastFunctionNode
+    {
+    public:
+        virtual ~IFusableBroadcastFunctionNode() = default;
+
+        /// <summary> Gets the inputs, memory layouts and function of this node. </summary>
+        ///
+        /// <returns> The stage that computes the same thing as this node. </returns>
+        virtual BroadcastFunctionStage<ValueType> GetFunctionStage() const = 0;
+    };
+
     //
     // Base class for broadcast nodes
     //
     template <typename ValueType, typename FunctionType>
-    class BroadcastFunctionNode : public model::CompilableNode
+    class BroadcastFunctionNode : public model::CompilableNode, public IFusableBroadcastFunctionNode<ValueType>
     {
     public:
         /// <summary> Returns the size of the primary input. </summary>
@@ -234,6 +268,18 @@ namespace nodes
         /// <summary> Returns the number of secondary input ports. </summary>
         virtual int NumSecondaryInputs() const = 0;
 
+        /// <summary> Gets the inputs, memory layouts and function of this node. </summary>
+        ///
+        /// <returns> The stage that computes the same thing as this node. </returns>
+        virtual BroadcastFunctionStage<ValueType> GetFunctionStage() const override;
+
+        /// <summary> Returns the primary input if its memory layout matches the output's and neither has padding. </summary>
+        ///
+        /// <param name="output"> The output port. </param>
+        ///
+        /// <returns> The primary input, or `nullptr` if the output can't share its memory. </returns>
+        virtual const model::InputPortBase* GetInPlaceInput(const model::OutputPortBase& output) const override;
+
     protected:
         BroadcastFunctionNode(const std::vector<model::InputPortBase*>& inputs, const std::vector<model::OutputPortBase*>& outputs);
 
@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ConstantFoldingPass.h (nodes)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// model
+#include "Model.h"
+#include "ModelOptimizer.h"
+#include "ModelTransformer.h"
+#include "Node.h"
+#include "OutputPort.h"
+
+// stl
+#include <string>
+#include <unordered_set>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary>
+    /// An optimization pass that evaluates pure nodes whose inputs are all constant, and replaces each of them
+    /// with a ConstantNode that holds its output.
+    /// </summary>
+    class ConstantFoldingPass : public model::ModelOptimizationPass
+    {
+    public:
+        /// <summary> Gets the name of this pass. </summary>
+        ///
+        /// <returns> The name of this pass. </returns>
+        virtual std::string GetName() const override { return "ConstantFolding"; }
+
+        /// <summary> Prepares the pass to transform a model. </summary>
+        ///
+        /// <param name="model"> The model about to be transformed. </param>
+        virtual void Initialize(const model::Model& model) override;
+
+        /// <summary> Replaces a node with constants if its inputs are constant, and copies it otherwise. </summary>
+        ///
+        /// <param name="node"> The node to transform. </param>
+        /// <param name="transformer"> The transformer building the new model. </param>
+        virtual void TransformNode(const model::Node& node, model::ModelTransformer& transformer) override;
+
+    private:
+        template <typename ValueType>
+        void FoldOutput(const model::OutputPortBase& port, model::ModelTransformer& transformer);
+
+        const model::Model* _model = nullptr;
+
+        // nodes of the old model whose outputs are known ahead of time
+        std::unordered_set<const model::Node*> _constantNodes;
+    };
+}
+}
@@ -82,6 +82,9 @@ namespace nodes
         /// <param name="transformer"> The `ModelTransformer` currently copying the model </param>
         virtual void Copy(model::ModelTransformer& transformer) const override;
 
+        /// <summary> Indicates that the output of this node depends only on its inputs and its archived properties. </summary>
+        virtual bool IsPure() const override { return true; }
+
         /// <summary> Refines this node in the model being constructed by the transformer </summary>
         ///
         /// <param name="transformer"> The `ModelTransformer` currently refining the model </param>
@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ElementwiseFusionPass.h (nodes)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// model
+#include "Model.h"
+#include "ModelOptimizer.h"
+#include "ModelTransformer.h"
+#include "Node.h"
+#include "PortElements.h"
+
+// nodes
+#include "BroadcastFunctionNode.h"
+
+// stl
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary>
+    /// An optimization pass that replaces chains of elementwise nodes with a FusedBroadcastFunctionNode, which computes
+    /// the whole chain in one loop nest without writing the intermediate results to memory. A chain is made of broadcast
+    /// function nodes (as produced by refining the batch normalization, bias, scaling and activation layers) with matching
+    /// memory layouts, each of which is the only user of the one before it, and may end with square-root
+    /// UnaryOperationNodes when the data has no padding.
+    /// </summary>
+    class ElementwiseFusionPass : public model::ModelOptimizationPass
+    {
+    public:
+        /// <summary> Gets the name of this pass. </summary>
+        ///
+        /// <returns> The name of this pass. </returns>
+        virtual std::string GetName() const override { return "ElementwiseFusion"; }
+
+        /// <summary> Prepares the pass to transform a model. </summary>
+        ///
+        /// <param name="model"> The model about to be transformed. </param>
+        virtual void Initialize(const model::Model& model) override;
+
+        /// <summary> Copies a node, and adds a fused node if it ends a chain of elementwise nodes. </summary>
+        ///
+        /// <param name="node"> The node to transform. </param>
+        /// <param name="transformer"> The transformer building the new model. </param>
+        virtual void TransformNode(const model::Node& node, model::ModelTransformer& transformer) override;
+
+    private:
+        // the stages of the chain ending at each node of the old model, with their inputs in the new model
+        template <typename ValueType>
+        using ChainMap = std::unordered_map<const model::Node*, std::vector<BroadcastFunctionStage<ValueType>>>;
+
+        template <typename ValueType>
+        std::vector<BroadcastFunctionStage<ValueType>> GetChain(const model::PortElements<ValueType>& input, const ChainMap<ValueType>& chains) const;
+
+        template <typename ValueType>
+        bool FuseNode(const model::Node& node, model::ModelTransformer& transformer, ChainMap<ValueType>& chains);
+
+        ChainMap<float> _floatChains;
+        ChainMap<double> _doubleChains;
+    };
+}
+}
@@ -73,6 +73,9 @@ namespace nodes
         /// <param name="archiver"> The `Archiver` to get state from </param>
         virtual void ReadFromArchive(utilities::Unarchiver& archiver) override;
 
+        /// <summary> Indicates that the output of this node depends only on its inputs and its archived properties. </summary>
+        virtual bool IsPure() const override { return true; }
+
         /// <summary> Indicates if this is an argmin or argmax node </summary>
         ///
         /// <returns> `true` if this is an argmax node, `false` if is an argmin node </returns>
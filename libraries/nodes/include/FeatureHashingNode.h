@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FeatureHashingNode.h (nodes)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// model
+#include "CompilableNode.h"
+#include "CompilableNodeUtilities.h"
+#include "IRMapCompiler.h"
+#include "InputPort.h"
+#include "MapCompiler.h"
+#include "ModelTransformer.h"
+#include "Node.h"
+#include "OutputPort.h"
+#include "PortElements.h"
+
+// data
+#include "FeatureHasher.h"
+
+// utilities
+#include "TypeName.h"
+
+// stl
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary>
+    /// A node that maps its input vector into a fixed number of buckets with signed feature hashing.
+    /// It uses the same hash function as data::FeatureHasher, so a model that starts with this node
+    /// sees the same features as a predictor that was trained on hashed data. The input is a dense
+    /// vector that holds every raw feature, so the node suits data whose raw dimension is known and
+    /// moderate; sparse data with a huge or unbounded index space has to be hashed before it reaches
+    /// the model. The compiled node looks up the buckets and signs of small inputs in tables made at
+    /// compile time, and computes the hash of each index in the emitted code for larger inputs.
+    /// </summary>
+    template <typename ValueType>
+    class FeatureHashingNode : public model::CompilableNode
+    {
+    public:
+        /// @name Input and Output Ports
+        /// @{
+        static constexpr const char* inputPortName = "input";
+        static constexpr const char* outputPortName = "output";
+        const model::InputPort<ValueType>& input = _input;
+        const model::OutputPort<ValueType>& output = _output;
+        /// @}
+
+        /// <summary> Default Constructor </summary>
+        FeatureHashingNode();
+
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="input"> The signal to hash </param>
+        /// <param name="numBits"> The base 2 logarithm of the number of buckets, which is also the output size </param>
+        FeatureHashingNode(const model::PortElements<ValueType>& input, size_t numBits);
+
+        /// <summary> Gets the base 2 logarithm of the number of buckets. </summary>
+        ///
+        /// <returns> The number of bits. </returns>
+        size_t GetNumBits() const { return _hasher.NumBits(); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return utilities::GetCompositeTypeName<ValueType>("FeatureHashingNode"); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        virtual std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+        /// <summary> Adds an object's properties to an `Archiver` </summary>
+        ///
+        /// <param name="archiver"> The `Archiver` to add the values from the object to </param>
+        virtual void WriteToArchive(utilities::Archiver& archiver) const override;
+
+        /// <summary> Sets the internal state of the object according to the archiver passed in </summary>
+        ///
+        /// <param name="archiver"> The `Archiver` to get state from </param>
+        virtual void ReadFromArchive(utilities::Unarchiver& archiver) override;
+
+        /// <summary> Makes a copy of this node in the model being constructed by the transformer </summary>
+        ///
+        /// <param name="transformer"> The `ModelTransformer` currently copying the model </param>
+        virtual void Copy(model::ModelTransformer& transformer) const override;
+
+    protected:
+        virtual void Compute() const override;
+        virtual void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+
+    private:
+        // the largest input for which the compiled node looks up the buckets and signs in tables
+        static constexpr size_t maxLookupTableSize = 1024;
+
+        void CompileLoop(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function);
+        void CompileLookupLoop(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function);
+        void CompileHashingLoop(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function);
+        void CompileExpanded(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function);
+
+        model::InputPort<ValueType> _input;
+        model::OutputPort<ValueType> _output;
+
+        data::FeatureHasher _hasher;
+    };
+}
+}
+
+#include "../tcc/FeatureHashingNode.tcc"
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FusedBroadcastFunctionNode.h (nodes)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// model
+#include "CompilableNode.h"
+#include "IRMapCompiler.h"
+#include "InputPort.h"
+#include "ModelTransformer.h"
+#include "OutputPort.h"
+#include "PortElements.h"
+
+// nodes
+#include "BroadcastFunctionNode.h"
+#include "PortMemoryLayout.h"
+
+// utilities
+#include "Exception.h"
+#include "TypeName.h"
+
+// stl
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary>
+    /// A node that applies a chain of broadcast functions in a single pass over its input. Each element of the input is
+    /// read once, run through the functions in order, and written once to the output, so the intermediate results never
+    /// leave registers. Created by the ElementwiseFusionPass, and not archivable.
+    /// </summary>
+    template <typename ValueType>
+    class FusedBroadcastFunctionNode : public model::CompilableNode
+    {
+    public:
+        /// @name Input and Output Ports
+        /// @{
+        static constexpr const char* inputPortName = "input";
+        static constexpr const char* outputPortName = "output";
+        const model::InputPort<ValueType>& input = _input;
+        const model::OutputPort<ValueType>& output = _output;
+        /// @}
+
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="stages"> The functions to apply, in order. The primary input of the first stage is the input of
+        /// this node; the primary inputs of the other stages are ignored, and the output of each stage is used instead.
+        /// The output layout of each stage must match the input layout of the next one. </param>
+        FusedBroadcastFunctionNode(const std::vector<BroadcastFunctionStage<ValueType>>& stages);
+
+        /// <summary> Returns the number of functions applied by this node. </summary>
+        size_t NumStages() const { return _stages.size(); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return utilities::GetCompositeTypeName<ValueType>("FusedBroadcastFunctionNode"); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        virtual std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+        /// <summary> Makes a copy of this node in the model being constructed by the transformer </summary>
+        virtual void Copy(model::ModelTransformer& transformer) const override;
+
+        /// <summary> Returns the input if its memory layout matches the output's and neither has padding. </summary>
+        ///
+        /// <param name="output"> The output port. </param>
+        ///
+        /// <returns> The input, or `nullptr` if the output can't share its memory. </returns>
+        virtual const model::InputPortBase* GetInPlaceInput(const model::OutputPortBase& output) const override;
+
+    protected:
+        virtual void Compute() const override;
+        virtual void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        virtual void WriteToArchive(utilities::Archiver& archiver) const override;
+        virtual void ReadFromArchive(utilities::Unarchiver& archiver) override;
+
+    private:
+        void ComputeDimensionLoop(size_t dimension, std::vector<ValueType>& output, size_t prevInputDimensionOffset, size_t prevOutputDimensionOffset, std::vector<std::vector<ValueType>>& secondaryValues) const;
+        void EmitComputeDimensionLoop(emitters::IRFunctionEmitter& function, size_t dimension, llvm::Value* input, const std::vector<std::vector<llvm::Value*>>& secondaryInputs, llvm::Value* output, llvm::Value* prevInputDimensionOffset, llvm::Value* prevOutputDimensionOffset, std::vector<std::vector<llvm::Value*>>& secondaryValues) const;
+
+        // Inputs
+        model::InputPort<ValueType> _input;
+        std::vector<std::vector<std::unique_ptr<model::InputPort<ValueType>>>> _secondaryInputs; // per stage
+
+        // Output
+        model::OutputPort<ValueType> _output;
+
+        std::vector<BroadcastFunctionStage<ValueType>> _stages;
+        PortMemoryLayout _inputLayout;
+        PortMemoryLayout _outputLayout;
+    };
+}
+}
+
+#include "../tcc/FusedBroadcastFunctionNode.tcc"
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     LayoutPropagationPass.h (nodes)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// model
+#include "Model.h"
+#include "ModelOptimizer.h"
+#include "ModelTransformer.h"
+#include "Node.h"
+#include "PortElements.h"
+
+// nodes
+#include "BroadcastFunctionNode.h"
+#include "PortMemoryLayout.h"
+#include "ReorderDataNode.h"
+
+// stl
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary>
+    /// An optimization pass that removes ReorderDataNodes whose only purpose is to change the order of the dimensions
+    /// in memory. Two reorders in a row are folded into one, and reorders that don't change anything are dropped. When
+    /// a transpose (as produced by refining a convolutional layer) only feeds the image reshaping of the next
+    /// convolution, possibly through a chain of broadcast function nodes, the data is kept in the order of the
+    /// transpose's input instead: the chain is computed in that order by a FusedBroadcastFunctionNode, and the
+    /// ReshapeImageNode reads the image in that order.
+    /// </summary>
+    class LayoutPropagationPass : public model::ModelOptimizationPass
+    {
+    public:
+        /// <summary> Gets the name of this pass. </summary>
+        ///
+        /// <returns> The name of this pass. </returns>
+        virtual std::string GetName() const override { return "LayoutPropagation"; }
+
+        /// <summary> Prepares the pass to transform a model. </summary>
+        ///
+        /// <param name="model"> The model about to be transformed. </param>
+        virtual void Initialize(const model::Model& model) override;
+
+        /// <summary> Copies a node, and replaces it if it uses the output of a reorder that can be removed. </summary>
+        ///
+        /// <param name="node"> The node to transform. </param>
+        /// <param name="transformer"> The transformer building the new model. </param>
+        virtual void TransformNode(const model::Node& node, model::ModelTransformer& transformer) override;
+
+    private:
+        // the input of a reorder in the new model, after folding the reorders before it
+        template <typename ValueType>
+        struct ReorderSource
+        {
+            model::PortElements<ValueType> input;
+            DataShape inputShape;
+        };
+
+        // a transpose of unpadded data, and the broadcast stages after it, with their secondary inputs in the new model
+        template <typename ValueType>
+        struct TransposedChain
+        {
+            ReorderSource<ValueType> source;
+            PortMemoryLayout layout; // the layout of the transposed data, in its memory order
+            Shape memoryOrder; // the dimensions of the layout, in the memory order of the source
+            std::vector<BroadcastFunctionStage<ValueType>> stages;
+        };
+
+        template <typename ValueType>
+        struct PassState
+        {
+            std::unordered_map<const model::Node*, ReorderSource<ValueType>> reorders;
+            std::unordered_map<const model::Node*, TransposedChain<ValueType>> chains;
+        };
+
+        template <typename ValueType>
+        bool TransformTypedNode(const model::Node& node, model::ModelTransformer& transformer, PassState<ValueType>& state);
+
+        template <typename ValueType>
+        bool TransformReorder(const model::Node& node, model::ModelTransformer& transformer, PassState<ValueType>& state);
+
+        template <typename ValueType>
+        bool TransformBroadcastFunction(const model::Node& node, model::ModelTransformer& transformer, PassState<ValueType>& state);
+
+        template <typename ValueType>
+        bool TransformReshapeImage(const model::Node& node, model::ModelTransformer& transformer, PassState<ValueType>& state);
+
+        template <typename ValueType>
+        const TransposedChain<ValueType>* GetChain(const model::PortElements<ValueType>& input, const PassState<ValueType>& state) const;
+
+        PassState<float> _floatState;
+        PassState<double> _doubleState;
+    };
+}
+}
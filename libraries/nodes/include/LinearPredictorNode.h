@@ -37,7 +37,7 @@ namespace nodes
         const model::OutputPort<double>& weightedElements = _weightedElements;
         /// @}
 
-        using LinearPredictor = predictors::LinearPredictor;
+        using LinearPredictor = predictors::LinearPredictor<double>;
 
         /// <summary> Default Constructor </summary>
         LinearPredictorNode();
@@ -96,6 +96,6 @@ namespace nodes
     /// <param name="transformer"> [in,out] The model transformer. </param>
     ///
     /// <returns> The node added to the model. </returns>
-    LinearPredictorNode* AddNodeToModelTransformer(const model::PortElements<double>& input, const predictors::LinearPredictor& predictor, model::ModelTransformer& transformer);
+    LinearPredictorNode* AddNodeToModelTransformer(const model::PortElements<double>& input, const predictors::LinearPredictor<double>& predictor, model::ModelTransformer& transformer);
 }
 }
@@ -70,5 +70,10 @@ namespace nodes
     /// <param name="layout1"> The first memory layout. </param>
     /// <param name="layout2"> The other memory layout. </param>
     bool PortMemoryLayoutsEqual(const PortMemoryLayout& layout1, const PortMemoryLayout& layout2);
+
+    /// <summary> Checks if a memory layout has padding, that is, if its active area is smaller than its allocated memory. </summary>
+    ///
+    /// <param name="layout"> The memory layout. </param>
+    bool HasPadding(const PortMemoryLayout& layout);
 }
 }
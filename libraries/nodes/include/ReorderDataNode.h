@@ -22,6 +22,7 @@
 // stl
 #include <algorithm>
 #include <array>
+#include <functional>
 #include <numeric>
 #include <string>
 #include <vector>
@@ -48,6 +49,12 @@ namespace nodes
         size_t GetStride(int dimension) const { return _stride[dimension]; }
         size_t GetOffset(int dimension) const { return _offset[dimension]; }
 
+        /// <summary> Indicates if there is padding around the entries in any dimension. </summary>
+        bool HasPadding() const;
+
+        /// <summary> Gets the dimensions, from the one with the largest stride to the one with the smallest stride. </summary>
+        std::array<size_t, Dimension> GetMemoryOrder() const;
+
         size_t GetEntryOffset(const std::array<int, Dimension>& location) const;
         bool IsOutOfBounds(const std::array<int, Dimension>& location) const;
 
@@ -79,6 +86,12 @@ namespace nodes
         size_t _totalSize = 0;
     };
 
+    /// <summary> Checks if two data shapes describe the same memory. </summary>
+    ///
+    /// <param name="shape1"> The first data shape. </param>
+    /// <param name="shape2"> The other data shape. </param>
+    bool DataShapesEqual(const DataShape& shape1, const DataShape& shape2);
+
     template <typename ValueType>
     class ReorderDataNode : public model::CompilableNode
     {
@@ -111,8 +124,17 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         virtual std::string GetRuntimeTypeName() const override { return GetTypeName(); }
 
+        /// <summary> Gets the memory shape of the input. </summary>
+        const DataShape& GetInputShape() const { return _inputShape; }
+
+        /// <summary> Gets the memory shape of the output. </summary>
+        const DataShape& GetOutputShape() const { return _outputShape; }
+
     protected:
         virtual void Copy(model::ModelTransformer& transformer) const override;
+
+        /// <summary> Indicates that the output of this node depends only on its inputs and its archived properties. </summary>
+        virtual bool IsPure() const override { return true; }
         virtual void Compute() const override;
         virtual void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
 
@@ -120,6 +142,15 @@ namespace nodes
         virtual void ReadFromArchive(utilities::Unarchiver& archiver) override;
 
     private:
+        // Emits code for each entry at the given location, in the current tile if the location is blocked
+        using EmitEntryFunction = std::function<void(const std::array<llvm::Value*, DataShape::Dimension>&)>;
+
+        // Emits loops over a box of locations, in the given order of dimensions. The locations of the blocked dimensions are relative to `blockBegin`.
+        void EmitLoopNest(emitters::IRFunctionEmitter& function, std::vector<size_t> dimensions, const std::array<int, DataShape::Dimension>& begin, const std::array<int, DataShape::Dimension>& end, const std::array<llvm::Value*, DataShape::Dimension>& blockBegin, std::array<llvm::Value*, DataShape::Dimension> location, const EmitEntryFunction& emitEntry) const;
+
+        // Emits loops over a box of locations, visiting the blocked dimensions one tile at a time
+        void EmitBlockedLoopNest(emitters::IRFunctionEmitter& function, const std::vector<size_t>& loopOrder, std::vector<size_t> blockedDimensions, int blockSize, std::array<int, DataShape::Dimension> begin, std::array<int, DataShape::Dimension> end, std::array<llvm::Value*, DataShape::Dimension> blockBegin, const EmitEntryFunction& emitEntry) const;
+
         // Input
         model::InputPort<ValueType> _input;
 
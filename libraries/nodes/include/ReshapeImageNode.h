@@ -16,6 +16,12 @@
 #include "Node.h"
 #include "Port.h"
 
+// nodes
+#include "PortMemoryLayout.h"
+
+// predictors
+#include "ConvolutionalLayer.h"
+
 // stl
 #include <algorithm>
 #include <array>
@@ -59,9 +65,37 @@ namespace nodes
                          size_t outputWidth,
                          size_t outputHeight);
 
+        /// <summary> Constructor for an input image whose dimensions are stored in another order. </summary>
+        ///
+        /// <param name="input"> The input image. </param>
+        /// <param name="inputMemoryLayout"> The memory layout of the input image, in row, column, channel order. </param>
+        /// <param name="inputMemoryOrder"> The dimensions of the input layout, from the outermost to the innermost in memory.
+        /// For instance, { 2, 0, 1 } is for an image stored one channel at a time. </param>
+        /// <param name="convolutionalParameters"> The convolutional parameters. </param>
+        /// <param name="outputWidth"> The output image width. </param>
+        /// <param name="outputHeight"> The output image height. </param>
+        ReshapeImageNode(const model::PortElements<ValueType>& input,
+                         const PortMemoryLayout& inputMemoryLayout,
+                         const Shape& inputMemoryOrder,
+                         const predictors::neural::ConvolutionalParameters& convolutionalParameters,
+                         size_t outputWidth,
+                         size_t outputHeight);
+
         /// <summary> Gets information about the input memory layout </summary>
         const PortMemoryLayout& GetInputMemoryLayout() const { return _inputMemoryLayout; }
 
+        /// <summary> Gets the dimensions of the input memory layout, from the outermost to the innermost in memory. </summary>
+        const Shape& GetInputMemoryOrder() const { return _inputMemoryOrder; }
+
+        /// <summary> Gets the convolutional parameters. </summary>
+        const predictors::neural::ConvolutionalParameters& GetConvolutionalParameters() const { return _convolutionalParameters; }
+
+        /// <summary> Gets the output image width. </summary>
+        size_t GetOutputWidth() const { return _outputWidth; }
+
+        /// <summary> Gets the output image height. </summary>
+        size_t GetOutputHeight() const { return _outputHeight; }
+
         /// <summary> Gets the name of this type (for serialization). </summary>
         ///
         /// <returns> The name of this type. </returns>
@@ -105,6 +139,7 @@ namespace nodes
         model::OutputPort<ValueType> _output;
 
         PortMemoryLayout _inputMemoryLayout;
+        Shape _inputMemoryOrder = { 0, 1, 2 };
         predictors::neural::ConvolutionalParameters _convolutionalParameters;
         size_t _outputWidth;
         size_t _outputHeight;
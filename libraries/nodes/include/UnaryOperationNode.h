@@ -78,6 +78,16 @@ namespace nodes
         /// <summary> Makes a copy of this node in the model being constructed by the transformer </summary>
         virtual void Copy(model::ModelTransformer& transformer) const override;
 
+        /// <summary> Indicates that the output of this node depends only on its inputs and its archived properties. </summary>
+        virtual bool IsPure() const override { return true; }
+
+        /// <summary> Returns the input, since each output value only depends on the input value at the same position. </summary>
+        ///
+        /// <param name="output"> The output port. </param>
+        ///
+        /// <returns> The input port. </returns>
+        virtual const model::InputPortBase* GetInPlaceInput(const model::OutputPortBase& output) const override { return &_input; }
+
         /// <summary> Gets the operation performed by this node </summary>
         ///
         /// <returns> The operation </returns>
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ConstantFoldingPass.cpp (nodes)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ConstantFoldingPass.h"
+#include "ConstantNode.h"
+
+// model
+#include "Port.h"
+
+// utilities
+#include "Exception.h"
+
+// stl
+#include <algorithm>
+#include <cstdint>
+
+namespace ell
+{
+namespace nodes
+{
+    namespace
+    {
+        bool CanFoldPortType(model::Port::PortType type)
+        {
+            switch (type)
+            {
+            case model::Port::PortType::smallReal:
+            case model::Port::PortType::real:
+            case model::Port::PortType::integer:
+            case model::Port::PortType::bigInt:
+            case model::Port::PortType::boolean:
+                return true;
+            default:
+                return false;
+            }
+        }
+    }
+
+    void ConstantFoldingPass::Initialize(const model::Model& model)
+    {
+        _model = &model;
+        _constantNodes.clear();
+    }
+
+    void ConstantFoldingPass::TransformNode(const model::Node& node, model::ModelTransformer& transformer)
+    {
+        auto parents = node.GetParentNodes();
+        bool isConstant = node.IsPure() && std::all_of(parents.begin(), parents.end(), [this](const model::Node* parent) { return _constantNodes.find(parent) != _constantNodes.end(); });
+        if (!isConstant)
+        {
+            node.Copy(transformer);
+            return;
+        }
+
+        _constantNodes.insert(&node);
+        const auto& outputs = node.GetOutputPorts();
+        bool canFold = node.NumInputPorts() > 0 && std::all_of(outputs.begin(), outputs.end(), [](const model::OutputPortBase* port) { return CanFoldPortType(port->GetType()); });
+        if (!canFold)
+        {
+            node.Copy(transformer);
+            return;
+        }
+
+        for (auto port : outputs)
+        {
+            switch (port->GetType())
+            {
+            case model::Port::PortType::smallReal:
+                FoldOutput<float>(*port, transformer);
+                break;
+            case model::Port::PortType::real:
+                FoldOutput<double>(*port, transformer);
+                break;
+            case model::Port::PortType::integer:
+                FoldOutput<int>(*port, transformer);
+                break;
+            case model::Port::PortType::bigInt:
+                FoldOutput<int64_t>(*port, transformer);
+                break;
+            case model::Port::PortType::boolean:
+                FoldOutput<bool>(*port, transformer);
+                break;
+            default:
+                throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "Unexpected port type in constant folding");
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void ConstantFoldingPass::FoldOutput(const model::OutputPortBase& port, model::ModelTransformer& transformer)
+    {
+        const auto& typedPort = static_cast<const model::OutputPort<ValueType>&>(port);
+        auto values = _model->ComputeOutput(typedPort);
+        auto newNode = transformer.AddNode<ConstantNode<ValueType>>(values);
+        transformer.MapNodeOutput(typedPort, newNode->output);
+    }
+}
+}
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ElementwiseFusionPass.cpp (nodes)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ElementwiseFusionPass.h"
+#include "FusedBroadcastFunctionNode.h"
+#include "UnaryOperationNode.h"
+
+// model
+#include "CompilableNodeUtilities.h"
+#include "OutputPort.h"
+
+// stl
+#include <cmath>
+
+namespace ell
+{
+namespace nodes
+{
+    namespace
+    {
+        template <typename ValueType>
+        BroadcastFunctionStage<ValueType> GetSqrtStage(const PortMemoryLayout& layout)
+        {
+            BroadcastFunctionStage<ValueType> stage;
+            stage.inputLayout = layout;
+            stage.outputLayout = layout;
+            stage.compute = [](ValueType x, const std::vector<ValueType>&) { return std::sqrt(x); };
+            stage.compile = [](emitters::IRFunctionEmitter& function, llvm::Value* x, const std::vector<llvm::Value*>&) {
+                return function.Call(function.GetModule().GetRuntime().GetSqrtFunction<ValueType>(), { x });
+            };
+            return stage;
+        }
+    }
+
+    void ElementwiseFusionPass::Initialize(const model::Model& model)
+    {
+        _floatChains.clear();
+        _doubleChains.clear();
+    }
+
+    void ElementwiseFusionPass::TransformNode(const model::Node& node, model::ModelTransformer& transformer)
+    {
+        // The copy is kept even if the node is fused, in case the outputs of the map refer to it. Otherwise it's removed
+        // after the pass, along with the rest of the chain.
+        node.Copy(transformer);
+        if (!FuseNode(node, transformer, _floatChains))
+        {
+            FuseNode(node, transformer, _doubleChains);
+        }
+    }
+
+    template <typename ValueType>
+    std::vector<BroadcastFunctionStage<ValueType>> ElementwiseFusionPass::GetChain(const model::PortElements<ValueType>& input, const ChainMap<ValueType>& chains) const
+    {
+        if (!input.IsFullPortOutput())
+        {
+            return {};
+        }
+
+        auto parent = input.GetElement(0).ReferencedPort()->GetNode();
+        auto iter = chains.find(parent);
+        if (iter == chains.end() || !model::HasSingleDescendant(*parent))
+        {
+            return {};
+        }
+        return iter->second;
+    }
+
+    template <typename ValueType>
+    bool ElementwiseFusionPass::FuseNode(const model::Node& node, model::ModelTransformer& transformer, ChainMap<ValueType>& chains)
+    {
+        std::vector<BroadcastFunctionStage<ValueType>> chain;
+        const model::OutputPort<ValueType>* output = nullptr;
+        if (auto fusableNode = dynamic_cast<const IFusableBroadcastFunctionNode<ValueType>*>(&node))
+        {
+            auto stage = fusableNode->GetFunctionStage();
+            if (!ShapesEqual(stage.inputLayout.size, stage.outputLayout.size))
+            {
+                return false;
+            }
+
+            chain = GetChain(stage.primaryInput, chains);
+            if (!chain.empty() && !PortMemoryLayoutsEqual(chain.back().outputLayout, stage.inputLayout))
+            {
+                chain.clear();
+            }
+
+            stage.primaryInput = transformer.TransformPortElements(stage.primaryInput);
+            for (auto& secondaryInput : stage.secondaryInputs)
+            {
+                secondaryInput = transformer.TransformPortElements(secondaryInput);
+            }
+            chain.push_back(stage);
+            output = static_cast<const model::OutputPort<ValueType>*>(node.GetOutputPort(0));
+        }
+        else if (auto unaryNode = dynamic_cast<const UnaryOperationNode<ValueType>*>(&node))
+        {
+            // Only square root is compilable
+            if (unaryNode->GetOperation() != emitters::UnaryOperationType::sqrt)
+            {
+                return false;
+            }
+
+            // Elementwise nodes that aren't broadcast function nodes also compute the padding, so they can only be
+            // fused when there isn't any
+            chain = GetChain(unaryNode->input.GetPortElements(), chains);
+            if (chain.empty() || HasPadding(chain.back().outputLayout))
+            {
+                return false;
+            }
+            chain.push_back(GetSqrtStage<ValueType>(chain.back().outputLayout));
+            output = &unaryNode->output;
+        }
+        else
+        {
+            return false;
+        }
+
+        chains[&node] = chain;
+        if (chain.size() > 1)
+        {
+            auto newNode = transformer.AddNode<FusedBroadcastFunctionNode<ValueType>>(chain);
+            transformer.MapNodeOutput(*output, newNode->output);
+        }
+        return true;
+    }
+}
+}
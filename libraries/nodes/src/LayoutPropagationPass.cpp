@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     LayoutPropagationPass.cpp (nodes)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "LayoutPropagationPass.h"
+#include "FusedBroadcastFunctionNode.h"
+#include "ReshapeImageNode.h"
+
+// model
+#include "CompilableNodeUtilities.h"
+#include "OutputPort.h"
+
+// stl
+#include <algorithm>
+
+namespace ell
+{
+namespace nodes
+{
+    namespace
+    {
+        // Indicates if reordering with shapes inputShape -> middleShape -> outputShape gives the same result as
+        // reordering with inputShape -> outputShape. The first reorder sets the entries past the end of its input to
+        // zero, so the middle shape must not cut off entries that the output would otherwise get from the input.
+        bool CanFoldReorders(const DataShape& inputShape, const DataShape& middleShape, const DataShape& outputShape)
+        {
+            for (int dimension = 0; dimension < DataShape::Dimension; ++dimension)
+            {
+                auto inputEnd = inputShape.GetExtent(dimension) + inputShape.GetOffset(dimension);
+                if (std::min(outputShape.GetExtent(dimension), inputEnd) > middleShape.GetExtent(dimension))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Indicates if a reorder only changes the order of the dimensions of unpadded data
+        bool IsTranspose(const DataShape& inputShape, const DataShape& outputShape)
+        {
+            if (inputShape.HasPadding() || outputShape.HasPadding() || inputShape.GetMemoryOrder() == outputShape.GetMemoryOrder())
+            {
+                return false;
+            }
+
+            for (int dimension = 0; dimension < DataShape::Dimension; ++dimension)
+            {
+                if (inputShape.GetExtent(dimension) != outputShape.GetExtent(dimension))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Returns the layout with its dimensions in the given order
+        PortMemoryLayout PermuteLayout(const PortMemoryLayout& layout, const Shape& order)
+        {
+            Shape size;
+            Shape stride;
+            Shape offset;
+            for (auto dimension : order)
+            {
+                size.push_back(layout.size[dimension]);
+                stride.push_back(layout.stride[dimension]);
+                offset.push_back(layout.offset[dimension]);
+            }
+            return { size, stride, offset };
+        }
+    }
+
+    void LayoutPropagationPass::Initialize(const model::Model& model)
+    {
+        _floatState = {};
+        _doubleState = {};
+    }
+
+    void LayoutPropagationPass::TransformNode(const model::Node& node, model::ModelTransformer& transformer)
+    {
+        // As in the elementwise fusion pass, the copy is kept in case the outputs of the map refer to it, and is
+        // removed after the pass otherwise.
+        node.Copy(transformer);
+        if (!TransformTypedNode(node, transformer, _floatState))
+        {
+            TransformTypedNode(node, transformer, _doubleState);
+        }
+    }
+
+    template <typename ValueType>
+    bool LayoutPropagationPass::TransformTypedNode(const model::Node& node, model::ModelTransformer& transformer, PassState<ValueType>& state)
+    {
+        return TransformReorder(node, transformer, state) || TransformBroadcastFunction(node, transformer, state) || TransformReshapeImage(node, transformer, state);
+    }
+
+    template <typename ValueType>
+    const LayoutPropagationPass::TransposedChain<ValueType>* LayoutPropagationPass::GetChain(const model::PortElements<ValueType>& input, const PassState<ValueType>& state) const
+    {
+        if (!input.IsFullPortOutput())
+        {
+            return nullptr;
+        }
+
+        auto parent = input.GetElement(0).ReferencedPort()->GetNode();
+        auto iter = state.chains.find(parent);
+        if (iter == state.chains.end() || !model::HasSingleDescendant(*parent))
+        {
+            return nullptr;
+        }
+        return &iter->second;
+    }
+
+    template <typename ValueType>
+    bool LayoutPropagationPass::TransformReorder(const model::Node& node, model::ModelTransformer& transformer, PassState<ValueType>& state)
+    {
+        auto reorderNode = dynamic_cast<const ReorderDataNode<ValueType>*>(&node);
+        if (reorderNode == nullptr)
+        {
+            return false;
+        }
+
+        // Fold this reorder into the one before it, if this is its only user
+        const auto& outputShape = reorderNode->GetOutputShape();
+        auto inputElements = reorderNode->input.GetPortElements();
+        ReorderSource<ValueType> source{ transformer.TransformPortElements(inputElements), reorderNode->GetInputShape() };
+        bool isFolded = false;
+        if (inputElements.IsFullPortOutput())
+        {
+            auto parent = inputElements.GetElement(0).ReferencedPort()->GetNode();
+            auto iter = state.reorders.find(parent);
+            if (iter != state.reorders.end() && model::HasSingleDescendant(*parent))
+            {
+                const auto& middleShape = static_cast<const ReorderDataNode<ValueType>*>(parent)->GetOutputShape();
+                if (DataShapesEqual(middleShape, reorderNode->GetInputShape()) && CanFoldReorders(iter->second.inputShape, middleShape, outputShape))
+                {
+                    source = iter->second;
+                    isFolded = true;
+                }
+            }
+        }
+        state.reorders[&node] = source;
+
+        if (DataShapesEqual(source.inputShape, outputShape) && !outputShape.HasPadding() && source.input.Size() == reorderNode->output.Size())
+        {
+            transformer.MapNodeOutput(reorderNode->output, source.input);
+            return true;
+        }
+
+        if (isFolded)
+        {
+            auto newNode = transformer.AddNode<ReorderDataNode<ValueType>>(source.input, source.inputShape, outputShape);
+            transformer.MapNodeOutput(reorderNode->output, newNode->output);
+        }
+
+        if (IsTranspose(source.inputShape, outputShape) && source.input.Size() == source.inputShape.GetMemorySize())
+        {
+            // The layout dimensions are numbered in the memory order of the output
+            auto outputOrder = outputShape.GetMemoryOrder();
+            auto inputOrder = source.inputShape.GetMemoryOrder();
+            TransposedChain<ValueType> chain;
+            chain.source = source;
+            for (auto dimension : outputOrder)
+            {
+                chain.layout.size.push_back(outputShape.GetExtent(dimension));
+            }
+            chain.layout.stride = chain.layout.size;
+            chain.layout.offset = Shape(DataShape::Dimension, 0);
+            for (auto dimension : inputOrder)
+            {
+                chain.memoryOrder.push_back(std::find(outputOrder.begin(), outputOrder.end(), dimension) - outputOrder.begin());
+            }
+            state.chains[&node] = chain;
+        }
+        return true;
+    }
+
+    template <typename ValueType>
+    bool LayoutPropagationPass::TransformBroadcastFunction(const model::Node& node, model::ModelTransformer& transformer, PassState<ValueType>& state)
+    {
+        auto fusableNode = dynamic_cast<const IFusableBroadcastFunctionNode<ValueType>*>(&node);
+        if (fusableNode == nullptr)
+        {
+            return false;
+        }
+
+        auto stage = fusableNode->GetFunctionStage();
+        auto chain = GetChain(stage.primaryInput, state);
+        if (chain == nullptr || !ShapesEqual(stage.inputLayout.size, stage.outputLayout.size))
+        {
+            return true;
+        }
+
+        const auto& previousLayout = chain->stages.empty() ? chain->layout : chain->stages.back().outputLayout;
+        if (!PortMemoryLayoutsEqual(previousLayout, stage.inputLayout))
+        {
+            return true;
+        }
+
+        for (auto& secondaryInput : stage.secondaryInputs)
+        {
+            secondaryInput = transformer.TransformPortElements(secondaryInput);
+        }
+        auto newChain = *chain;
+        newChain.stages.push_back(stage);
+        state.chains[&node] = newChain;
+        return true;
+    }
+
+    template <typename ValueType>
+    bool LayoutPropagationPass::TransformReshapeImage(const model::Node& node, model::ModelTransformer& transformer, PassState<ValueType>& state)
+    {
+        auto reshapeNode = dynamic_cast<const ReshapeImageNode<ValueType>*>(&node);
+        if (reshapeNode == nullptr)
+        {
+            return false;
+        }
+
+        auto chain = GetChain(reshapeNode->input.GetPortElements(), state);
+        if (chain == nullptr || reshapeNode->GetInputMemoryOrder() != Shape{ 0, 1, 2 })
+        {
+            return true;
+        }
+
+        const auto& inputLayout = reshapeNode->GetInputMemoryLayout();
+        const auto& previousLayout = chain->stages.empty() ? chain->layout : chain->stages.back().outputLayout;
+        if (!PortMemoryLayoutsEqual(previousLayout, inputLayout))
+        {
+            return true;
+        }
+
+        // Compute the chain in the memory order of the transpose's input, and skip the transpose
+        const auto& memoryOrder = chain->memoryOrder;
+        auto newInput = chain->source.input;
+        if (!chain->stages.empty())
+        {
+            auto stages = chain->stages;
+            for (auto& stage : stages)
+            {
+                stage.inputLayout = PermuteLayout(stage.inputLayout, memoryOrder);
+                stage.outputLayout = PermuteLayout(stage.outputLayout, memoryOrder);
+                stage.broadcastDimension = std::find(memoryOrder.begin(), memoryOrder.end(), stage.broadcastDimension) - memoryOrder.begin();
+            }
+            stages.front().primaryInput = newInput;
+            auto fusedNode = transformer.AddNode<FusedBroadcastFunctionNode<ValueType>>(stages);
+            newInput = fusedNode->output;
+        }
+
+        auto newNode = transformer.AddNode<ReshapeImageNode<ValueType>>(newInput, inputLayout, memoryOrder, reshapeNode->GetConvolutionalParameters(), reshapeNode->GetOutputWidth(), reshapeNode->GetOutputHeight());
+        transformer.MapNodeOutput(reshapeNode->output, newNode->output);
+        return true;
+    }
+}
+}
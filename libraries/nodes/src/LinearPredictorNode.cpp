@@ -31,7 +31,7 @@ namespace nodes
     {
     }
 
-    LinearPredictorNode::LinearPredictorNode(const model::PortElements<double>& input, const predictors::LinearPredictor& predictor)
+    LinearPredictorNode::LinearPredictorNode(const model::PortElements<double>& input, const predictors::LinearPredictor<double>& predictor)
         : Node({ &_input }, { &_output, &_weightedElements }), _input(this, input, inputPortName), _output(this, outputPortName, 1), _weightedElements(this, weightedElementsPortName, input.Size()), _predictor(predictor)
     {
         assert(input.Size() == predictor.Size());
@@ -83,7 +83,7 @@ namespace nodes
         _weightedElements.SetOutput(_predictor.GetWeightedElements(inputDataVector).ToArray());
     }
 
-    LinearPredictorNode* AddNodeToModelTransformer(const model::PortElements<double>& input, const predictors::LinearPredictor& predictor, model::ModelTransformer& transformer)
+    LinearPredictorNode* AddNodeToModelTransformer(const model::PortElements<double>& input, const predictors::LinearPredictor<double>& predictor, model::ModelTransformer& transformer)
     {
         return transformer.AddNode<LinearPredictorNode>(input, predictor);
     }
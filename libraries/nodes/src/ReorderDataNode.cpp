@@ -15,6 +15,7 @@
 
 // stl
 #include <algorithm>
+#include <numeric>
 
 namespace ell
 {
@@ -59,6 +60,19 @@ namespace nodes
         return _totalSize;
     }
 
+    bool DataShape::HasPadding() const
+    {
+        return std::any_of(_offset.begin(), _offset.end(), [](size_t offset) { return offset != 0; });
+    }
+
+    std::array<size_t, DataShape::Dimension> DataShape::GetMemoryOrder() const
+    {
+        std::array<size_t, Dimension> order;
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return _stride[a] > _stride[b]; });
+        return order;
+    }
+
     size_t DataShape::GetDataOffset() const
     {
         size_t result = 0;
@@ -124,6 +138,18 @@ namespace nodes
         return result;
     }
 
+    bool DataShapesEqual(const DataShape& shape1, const DataShape& shape2)
+    {
+        for (int index = 0; index < DataShape::Dimension; ++index)
+        {
+            if (shape1.GetExtent(index) != shape2.GetExtent(index) || shape1.GetStride(index) != shape2.GetStride(index) || shape1.GetOffset(index) != shape2.GetOffset(index))
+            {
+                return false;
+            }
+        }
+        return shape1.GetMemorySize() == shape2.GetMemorySize();
+    }
+
     void DataShape::WriteToArchive(utilities::Archiver& archiver) const
     {
         archiver["extent"] << std::vector<size_t>{_extent.begin(), _extent.end()};
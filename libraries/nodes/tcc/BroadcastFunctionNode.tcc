@@ -33,6 +33,18 @@ namespace nodes
         return ShapesEqual(layout1.stride, layout2.stride) && ShapesEqual(layout1.size, layout2.size) && ShapesEqual(layout1.offset, layout2.offset);
     }
 
+    inline bool HasPadding(const PortMemoryLayout& layout)
+    {
+        for (size_t index = 0; index < layout.size.size(); ++index)
+        {
+            if (layout.size[index] != layout.stride[index] || layout.offset[index] != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
     //
     // BroadcastUnaryFunction
     //
@@ -143,6 +155,36 @@ namespace nodes
         return result;
     }
 
+    template <typename ValueType, typename FunctionType>
+    BroadcastFunctionStage<ValueType> BroadcastFunctionNode<ValueType, FunctionType>::GetFunctionStage() const
+    {
+        BroadcastFunctionStage<ValueType> stage;
+        stage.primaryInput = GetPrimaryInput().GetPortElements();
+        for (int index = 0; index < NumSecondaryInputs(); ++index)
+        {
+            stage.secondaryInputs.push_back(GetSecondaryInput(index)->GetPortElements());
+        }
+        stage.inputLayout = GetInputLayout();
+        stage.outputLayout = GetOutputLayout();
+        stage.broadcastDimension = GetBroadcastDimension();
+
+        auto broadcastFunction = GetFunction();
+        stage.compute = [broadcastFunction](ValueType x, const std::vector<ValueType>& secondaryArgs) { return broadcastFunction.Compute(x, secondaryArgs); };
+        stage.compile = [broadcastFunction](emitters::IRFunctionEmitter& function, llvm::Value* x, const std::vector<llvm::Value*>& secondaryArgs) { return broadcastFunction.Compile(function, x, secondaryArgs); };
+        return stage;
+    }
+
+    template <typename ValueType, typename FunctionType>
+    const model::InputPortBase* BroadcastFunctionNode<ValueType, FunctionType>::GetInPlaceInput(const model::OutputPortBase& output) const
+    {
+        // Each output value is computed from the input value at the same position, as long as the layouts match
+        if (PortMemoryLayoutsEqual(_inputLayout, _outputLayout) && !HasPadding(_outputLayout))
+        {
+            return &GetPrimaryInput();
+        }
+        return nullptr;
+    }
+
     //
     // Arbitrary-depth nested loops are generated recursively. The EmitComputeDimensionLoop
     // function emits `numDimensions` nested loops of the form:
@@ -193,6 +235,7 @@ namespace nodes
             if (dimension != 0)
             {
                 thisInputDimensionOffset += prevInputDimensionOffset * inputStride[dimension];
+                thisOutputDimensionOffset += prevOutputDimensionOffset * outputStride[dimension];
             }
 
             if (dimension == broadcastDimension)
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FeatureHashingNode.tcc (nodes)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace ell
+{
+namespace nodes
+{
+    template <typename ValueType>
+    FeatureHashingNode<ValueType>::FeatureHashingNode()
+        : CompilableNode({ &_input }, { &_output }), _input(this, {}, inputPortName), _output(this, outputPortName, 0)
+    {
+    }
+
+    template <typename ValueType>
+    FeatureHashingNode<ValueType>::FeatureHashingNode(const model::PortElements<ValueType>& input, size_t numBits)
+        : CompilableNode({ &_input }, { &_output }), _input(this, input, inputPortName), _output(this, outputPortName, size_t(1) << numBits), _hasher(numBits)
+    {
+    }
+
+    template <typename ValueType>
+    void FeatureHashingNode<ValueType>::Compute() const
+    {
+        std::vector<ValueType> output(_output.Size());
+        for (size_t index = 0; index < _input.Size(); ++index)
+        {
+            output[_hasher.GetBucket(index)] += static_cast<ValueType>(_hasher.GetSign(index)) * _input[index];
+        }
+        _output.SetOutput(output);
+    }
+
+    template <typename ValueType>
+    void FeatureHashingNode<ValueType>::Copy(model::ModelTransformer& transformer) const
+    {
+        auto newPortElements = transformer.TransformPortElements(_input.GetPortElements());
+        auto newNode = transformer.AddNode<FeatureHashingNode<ValueType>>(newPortElements, _hasher.NumBits());
+        transformer.MapNodeOutput(output, newNode->output);
+    }
+
+    template <typename ValueType>
+    void FeatureHashingNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        static_assert(!std::is_same<ValueType, bool>(), "Cannot instantiate boolean feature hashing nodes");
+
+        // zero the output, since several inputs can be added to the same bucket
+        llvm::Value* pResult = compiler.EnsurePortEmitted(output);
+        auto zeroLoop = function.ForLoop();
+        zeroLoop.Begin(output.Size());
+        {
+            auto i = zeroLoop.LoadIterationVariable();
+            function.SetValueAt(pResult, i, function.Literal(static_cast<ValueType>(0)));
+        }
+        zeroLoop.End();
+
+        if (IsPureVector(input) && !compiler.GetCompilerParameters().unrollLoops)
+        {
+            CompileLoop(compiler, function);
+        }
+        else
+        {
+            CompileExpanded(compiler, function);
+        }
+    }
+
+    template <typename ValueType>
+    void FeatureHashingNode<ValueType>::CompileLoop(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        if (input.Size() <= maxLookupTableSize)
+        {
+            CompileLookupLoop(compiler, function);
+        }
+        else
+        {
+            CompileHashingLoop(compiler, function);
+        }
+    }
+
+    template <typename ValueType>
+    void FeatureHashingNode<ValueType>::CompileLookupLoop(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        llvm::Value* pInput = compiler.EnsurePortEmitted(input);
+        llvm::Value* pResult = compiler.EnsurePortEmitted(output);
+
+        // the hash function is evaluated at compile time, and the emitted code looks up its values in two tables
+        auto inputSize = input.Size();
+        std::vector<int> buckets(inputSize);
+        std::vector<ValueType> signs(inputSize);
+        for (size_t index = 0; index < inputSize; ++index)
+        {
+            buckets[index] = static_cast<int>(_hasher.GetBucket(index));
+            signs[index] = static_cast<ValueType>(_hasher.GetSign(index));
+        }
+
+        emitters::Variable* pVarBuckets = function.GetModule().Variables().AddVariable<emitters::LiteralVectorVariable<int>>(buckets);
+        emitters::Variable* pVarSigns = function.GetModule().Variables().AddVariable<emitters::LiteralVectorVariable<ValueType>>(signs);
+        llvm::Value* pBuckets = function.GetModule().EnsureEmitted(*pVarBuckets);
+        llvm::Value* pSigns = function.GetModule().EnsureEmitted(*pVarSigns);
+
+        auto forLoop = function.ForLoop();
+        forLoop.Begin(inputSize);
+        {
+            auto i = forLoop.LoadIterationVariable();
+            auto bucket = function.ValueAt(pBuckets, i);
+            auto signedValue = function.Operator(emitters::GetMultiplyForValueType<ValueType>(), function.ValueAt(pInput, i), function.ValueAt(pSigns, i));
+            auto sum = function.Operator(emitters::GetAddForValueType<ValueType>(), function.ValueAt(pResult, bucket), signedValue);
+            function.SetValueAt(pResult, bucket, sum);
+        }
+        forLoop.End();
+    }
+
+    template <typename ValueType>
+    void FeatureHashingNode<ValueType>::CompileHashingLoop(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        llvm::Value* pInput = compiler.EnsurePortEmitted(input);
+        llvm::Value* pResult = compiler.EnsurePortEmitted(output);
+
+        // the emitted code computes the finalization mix of MurmurHash3 of each index, as data::FeatureHasher does
+        auto shift = function.Literal<int64_t>(33);
+        auto multiplier1 = function.Literal(static_cast<int64_t>(0xff51afd7ed558ccdULL));
+        auto multiplier2 = function.Literal(static_cast<int64_t>(0xc4ceb3fe1a85ec53ULL));
+        auto mask = function.Literal(static_cast<int64_t>(_hasher.NumBuckets() - 1));
+        auto zero = function.Literal<int64_t>(0);
+
+        auto forLoop = function.ForLoop();
+        forLoop.Begin(input.Size());
+        {
+            auto i = forLoop.LoadIterationVariable();
+            auto key = function.CastValue<int, int64_t>(i);
+            key = function.Operator(emitters::TypedOperator::logicalXor, key, function.Operator(emitters::TypedOperator::logicalShiftRight, key, shift));
+            key = function.Operator(emitters::TypedOperator::multiply, key, multiplier1);
+            key = function.Operator(emitters::TypedOperator::logicalXor, key, function.Operator(emitters::TypedOperator::logicalShiftRight, key, shift));
+            key = function.Operator(emitters::TypedOperator::multiply, key, multiplier2);
+            key = function.Operator(emitters::TypedOperator::logicalXor, key, function.Operator(emitters::TypedOperator::logicalShiftRight, key, shift));
+
+            // the low bits select the bucket, and the top bit, which is the sign bit of the mix, selects the sign
+            auto bucket = function.Operator(emitters::TypedOperator::logicalAnd, key, mask);
+            auto inputValue = function.ValueAt(pInput, i);
+            auto bucketValue = function.ValueAt(pResult, bucket);
+            auto sum = function.Select(function.Comparison(emitters::TypedComparison::lessThan, key, zero),
+                                       function.Operator(emitters::GetSubtractForValueType<ValueType>(), bucketValue, inputValue),
+                                       function.Operator(emitters::GetAddForValueType<ValueType>(), bucketValue, inputValue));
+            function.SetValueAt(pResult, bucket, sum);
+        }
+        forLoop.End();
+    }
+
+    template <typename ValueType>
+    void FeatureHashingNode<ValueType>::CompileExpanded(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        llvm::Value* pResult = compiler.EnsurePortEmitted(output);
+
+        for (size_t index = 0; index < input.Size(); ++index)
+        {
+            llvm::Value* inputValue = compiler.LoadPortElementVariable(input.GetInputElement(index));
+            auto bucket = function.Literal(static_cast<int>(_hasher.GetBucket(index)));
+            auto op = _hasher.GetSign(index) > 0 ? emitters::GetAddForValueType<ValueType>() : emitters::GetSubtractForValueType<ValueType>();
+            auto sum = function.Operator(op, function.ValueAt(pResult, bucket), inputValue);
+            function.SetValueAt(pResult, bucket, sum);
+        }
+    }
+
+    template <typename ValueType>
+    void FeatureHashingNode<ValueType>::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        Node::WriteToArchive(archiver);
+        archiver[inputPortName] << _input;
+        archiver["numBits"] << _hasher.NumBits();
+    }
+
+    template <typename ValueType>
+    void FeatureHashingNode<ValueType>::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        Node::ReadFromArchive(archiver);
+        archiver[inputPortName] >> _input;
+        size_t numBits = 0;
+        archiver["numBits"] >> numBits;
+        _hasher = data::FeatureHasher(numBits);
+        _output.SetSize(_hasher.NumBuckets());
+    }
+}
+}
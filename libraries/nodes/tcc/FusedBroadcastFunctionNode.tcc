@@ -0,0 +1,277 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FusedBroadcastFunctionNode.tcc (nodes)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace ell
+{
+namespace nodes
+{
+    template <typename ValueType>
+    FusedBroadcastFunctionNode<ValueType>::FusedBroadcastFunctionNode(const std::vector<BroadcastFunctionStage<ValueType>>& stages)
+        : CompilableNode({ &_input }, { &_output }), _input(this, stages.empty() ? model::PortElements<ValueType>{} : stages.front().primaryInput, inputPortName), _output(this, outputPortName, 0), _stages(stages)
+    {
+        if (stages.empty())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Fused node needs at least one function");
+        }
+
+        _inputLayout = stages.front().inputLayout;
+        _outputLayout = stages.back().outputLayout;
+        for (size_t index = 0; index < stages.size(); ++index)
+        {
+            const auto& stage = stages[index];
+            if (!ShapesEqual(stage.inputLayout.size, _inputLayout.size) || !ShapesEqual(stage.outputLayout.size, _inputLayout.size))
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Input and output active area sizes don't match");
+            }
+
+            if (index > 0 && !PortMemoryLayoutsEqual(stages[index - 1].outputLayout, stage.inputLayout))
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Output layout of a function doesn't match the input layout of the next one");
+            }
+        }
+
+        auto&& inputStride = _inputLayout.stride;
+        size_t totalInputSize = std::accumulate(inputStride.begin(), inputStride.end(), 1, std::multiplies<size_t>());
+        if (_input.Size() < totalInputSize)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Primary input too small");
+        }
+
+        auto&& outputStride = _outputLayout.stride;
+        _output.SetSize(std::accumulate(outputStride.begin(), outputStride.end(), 1, std::multiplies<size_t>()));
+
+        // The ports own the input elements from here on
+        _secondaryInputs.resize(stages.size());
+        for (size_t stageIndex = 0; stageIndex < stages.size(); ++stageIndex)
+        {
+            const auto& secondaryInputs = stages[stageIndex].secondaryInputs;
+            for (size_t index = 0; index < secondaryInputs.size(); ++index)
+            {
+                auto portName = "secondaryInput" + std::to_string(stageIndex) + "_" + std::to_string(index);
+                _secondaryInputs[stageIndex].emplace_back(std::make_unique<model::InputPort<ValueType>>(this, secondaryInputs[index], portName));
+                AddInputPort(_secondaryInputs[stageIndex].back().get());
+            }
+            _stages[stageIndex].primaryInput = {};
+            _stages[stageIndex].secondaryInputs.clear();
+        }
+    }
+
+    template <typename ValueType>
+    void FusedBroadcastFunctionNode<ValueType>::Copy(model::ModelTransformer& transformer) const
+    {
+        auto stages = _stages;
+        stages.front().primaryInput = transformer.TransformPortElements(_input.GetPortElements());
+        for (size_t stageIndex = 0; stageIndex < stages.size(); ++stageIndex)
+        {
+            for (const auto& secondaryInput : _secondaryInputs[stageIndex])
+            {
+                stages[stageIndex].secondaryInputs.push_back(transformer.TransformPortElements(secondaryInput->GetPortElements()));
+            }
+        }
+        auto newNode = transformer.AddNode<FusedBroadcastFunctionNode<ValueType>>(stages);
+        transformer.MapNodeOutput(output, newNode->output);
+    }
+
+    template <typename ValueType>
+    const model::InputPortBase* FusedBroadcastFunctionNode<ValueType>::GetInPlaceInput(const model::OutputPortBase& output) const
+    {
+        if (PortMemoryLayoutsEqual(_inputLayout, _outputLayout) && !HasPadding(_outputLayout))
+        {
+            return &_input;
+        }
+        return nullptr;
+    }
+
+    //
+    // The nested loops are the same as BroadcastFunctionNode's, except that the secondary values of every stage are
+    // loaded at that stage's broadcast dimension, and the innermost loop applies all of the stages:
+    //
+    //  x = input[inputOffset];
+    //  x = f1(x, secondaryValues1);
+    //  x = f2(x, secondaryValues2);
+    //  ...
+    //  output[outputOffset] = x;
+    //
+
+    // Note: secondaryValues is passed by non-const reference to avoid copies. It doesn't function as an output parameter.
+    template <typename ValueType>
+    void FusedBroadcastFunctionNode<ValueType>::ComputeDimensionLoop(size_t dimension, std::vector<ValueType>& output, size_t prevInputDimensionOffset, size_t prevOutputDimensionOffset, std::vector<std::vector<ValueType>>& secondaryValues) const
+    {
+        const auto numDimensions = _inputLayout.size.size();
+        auto&& inputStride = _inputLayout.stride;
+        auto&& inputOffset = _inputLayout.offset;
+        auto&& inputSize = _inputLayout.size;
+        auto&& outputStride = _outputLayout.stride;
+        auto&& outputOffset = _outputLayout.offset;
+
+        for (size_t loopIndex = 0; loopIndex < inputSize[dimension]; ++loopIndex)
+        {
+            size_t thisInputDimensionOffset = loopIndex + inputOffset[dimension];
+            size_t thisOutputDimensionOffset = loopIndex + outputOffset[dimension];
+            if (dimension != 0)
+            {
+                thisInputDimensionOffset += prevInputDimensionOffset * inputStride[dimension];
+                thisOutputDimensionOffset += prevOutputDimensionOffset * outputStride[dimension];
+            }
+
+            for (size_t stageIndex = 0; stageIndex < _stages.size(); ++stageIndex)
+            {
+                if (_stages[stageIndex].broadcastDimension != dimension)
+                {
+                    continue;
+                }
+
+                const auto& secondaryInputs = _secondaryInputs[stageIndex];
+                for (size_t index = 0; index < secondaryInputs.size(); ++index)
+                {
+                    if (secondaryInputs[index]->Size() > 0) // input is present
+                    {
+                        secondaryValues[stageIndex][index] = (*secondaryInputs[index])[loopIndex];
+                    }
+                }
+            }
+
+            if (dimension < numDimensions - 1)
+            {
+                // Recursive call to compute the nested loop
+                ComputeDimensionLoop(dimension + 1, output, thisInputDimensionOffset, thisOutputDimensionOffset, secondaryValues);
+            }
+            else
+            {
+                // We're in the innermost loop --- compute the value
+                auto value = _input[thisInputDimensionOffset];
+                for (size_t stageIndex = 0; stageIndex < _stages.size(); ++stageIndex)
+                {
+                    value = _stages[stageIndex].compute(value, secondaryValues[stageIndex]);
+                }
+                output[thisOutputDimensionOffset] = value;
+            }
+        }
+    }
+
+    // Note: secondaryValues is passed by non-const reference to avoid copies. It doesn't function as an output parameter.
+    template <typename ValueType>
+    void FusedBroadcastFunctionNode<ValueType>::EmitComputeDimensionLoop(emitters::IRFunctionEmitter& function,
+                                                                        size_t dimension,
+                                                                        llvm::Value* input, const std::vector<std::vector<llvm::Value*>>& secondaryInputs,
+                                                                        llvm::Value* output,
+                                                                        llvm::Value* prevInputDimensionOffset, llvm::Value* prevOutputDimensionOffset,
+                                                                        std::vector<std::vector<llvm::Value*>>& secondaryValues) const
+    {
+        const auto numDimensions = _inputLayout.size.size();
+        auto&& inputStride = _inputLayout.stride;
+        auto&& inputOffset = _inputLayout.offset;
+        auto&& inputSize = _inputLayout.size;
+        auto&& outputStride = _outputLayout.stride;
+        auto&& outputOffset = _outputLayout.offset;
+
+        auto loop = function.ForLoop();
+        loop.Begin(inputSize[dimension]);
+        {
+            auto loopIndex = loop.LoadIterationVariable();
+
+            llvm::Value* thisInputDimensionOffset = function.Operator(emitters::GetAddForValueType<int>(), loopIndex, function.Literal<int>(inputOffset[dimension]));
+            llvm::Value* thisOutputDimensionOffset = function.Operator(emitters::GetAddForValueType<int>(), loopIndex, function.Literal<int>(outputOffset[dimension]));
+            if (dimension != 0)
+            {
+                auto scaledInputDimensionOffset = function.Operator(emitters::GetMultiplyForValueType<int>(), prevInputDimensionOffset, function.Literal<int>(inputStride[dimension]));
+                thisInputDimensionOffset = function.Operator(emitters::GetAddForValueType<int>(), scaledInputDimensionOffset, thisInputDimensionOffset);
+
+                auto scaledOutputDimensionOffset = function.Operator(emitters::GetMultiplyForValueType<int>(), prevOutputDimensionOffset, function.Literal<int>(outputStride[dimension]));
+                thisOutputDimensionOffset = function.Operator(emitters::GetAddForValueType<int>(), scaledOutputDimensionOffset, thisOutputDimensionOffset);
+            }
+
+            for (size_t stageIndex = 0; stageIndex < _stages.size(); ++stageIndex)
+            {
+                if (_stages[stageIndex].broadcastDimension != dimension)
+                {
+                    continue;
+                }
+
+                for (size_t index = 0; index < secondaryInputs[stageIndex].size(); ++index)
+                {
+                    auto secondaryInput = secondaryInputs[stageIndex][index];
+                    if (_secondaryInputs[stageIndex][index]->Size() == 1) // scalar
+                    {
+                        secondaryValues[stageIndex][index] = secondaryInput;
+                    }
+                    else
+                    {
+                        secondaryValues[stageIndex][index] = secondaryInput == nullptr ? nullptr : function.ValueAt(secondaryInput, loopIndex);
+                    }
+                }
+            }
+
+            if (dimension < numDimensions - 1)
+            {
+                // Recursive call to emit nested loop
+                EmitComputeDimensionLoop(function, dimension + 1, input, secondaryInputs, output, thisInputDimensionOffset, thisOutputDimensionOffset, secondaryValues);
+            }
+            else
+            {
+                // We're in the innermost loop --- compute the value, keeping the intermediate results in registers
+                auto value = function.ValueAt(input, thisInputDimensionOffset);
+                for (size_t stageIndex = 0; stageIndex < _stages.size(); ++stageIndex)
+                {
+                    value = _stages[stageIndex].compile(function, value, secondaryValues[stageIndex]);
+                }
+                function.SetValueAt(output, thisOutputDimensionOffset, value);
+            }
+        }
+        loop.End();
+    }
+
+    template <typename ValueType>
+    void FusedBroadcastFunctionNode<ValueType>::Compute() const
+    {
+        auto output = std::vector<ValueType>(_output.Size());
+        std::vector<std::vector<ValueType>> secondaryValues;
+        for (const auto& secondaryInputs : _secondaryInputs)
+        {
+            secondaryValues.emplace_back(secondaryInputs.size(), static_cast<ValueType>(0));
+        }
+
+        ComputeDimensionLoop(0, output, 0, 0, secondaryValues);
+        _output.SetOutput(output);
+    }
+
+    template <typename ValueType>
+    void FusedBroadcastFunctionNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        llvm::Value* pInput = compiler.EnsurePortEmitted(input);
+        llvm::Value* pOutput = compiler.EnsurePortEmitted(output);
+
+        std::vector<std::vector<llvm::Value*>> secondaryInputs;
+        std::vector<std::vector<llvm::Value*>> secondaryValues;
+        for (const auto& stageInputs : _secondaryInputs)
+        {
+            std::vector<llvm::Value*> stageSecondaryInputs;
+            for (const auto& secondaryInput : stageInputs)
+            {
+                stageSecondaryInputs.push_back(secondaryInput->Size() > 0 ? compiler.EnsurePortEmitted(*secondaryInput) : nullptr);
+            }
+            secondaryInputs.push_back(stageSecondaryInputs);
+            secondaryValues.emplace_back(stageInputs.size(), nullptr);
+        }
+
+        EmitComputeDimensionLoop(function, 0, pInput, secondaryInputs, pOutput, nullptr, nullptr, secondaryValues);
+    }
+
+    template <typename ValueType>
+    void FusedBroadcastFunctionNode<ValueType>::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "FusedBroadcastFunctionNode can't be archived");
+    }
+
+    template <typename ValueType>
+    void FusedBroadcastFunctionNode<ValueType>::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "FusedBroadcastFunctionNode can't be archived");
+    }
+}
+}
@@ -71,42 +71,134 @@ namespace nodes
         _output.SetOutput(output);
     }
 
+    //
+    // The output is computed as a cache-blocked transpose. The entries that are inside the bounds of the input are
+    // copied in tiles of blockSize x blockSize entries of the two dimensions with the smallest input and output
+    // strides, so that the reads and the writes of a tile stay in the cache, and the writes of each row of a tile are
+    // contiguous. The rest of the output entries are set to zero by separate loops.
+    //
     template <typename ValueType>
     void ReorderDataNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
     {
         llvm::Value* pInput = compiler.EnsurePortEmitted(this->input);
         llvm::Value* pOutput = compiler.EnsurePortEmitted(this->output);
 
-        int outputSize = _outputShape.GetMemorySize();
-        auto zLoop = function.ForLoop();
-        zLoop.Begin(_outputShape.GetExtent(2));
+        // The output entries at a location past the end of the input, in any dimension, are zero
+        const int numDimensions = DataShape::Dimension;
+        std::array<int, DataShape::Dimension> outputExtent;
+        std::array<int, DataShape::Dimension> copyExtent;
+        for (int dimension = 0; dimension < numDimensions; ++dimension)
+        {
+            outputExtent[dimension] = _outputShape.GetExtent(dimension);
+            copyExtent[dimension] = std::min<int>(outputExtent[dimension], _inputShape.GetExtent(dimension) + _inputShape.GetOffset(dimension));
+        }
+
+        auto outputOrder = _outputShape.GetMemoryOrder();
+        auto inputOrder = _inputShape.GetMemoryOrder();
+        for (int zeroDimension = 0; zeroDimension < numDimensions; ++zeroDimension)
         {
-            llvm::Value* z = zLoop.LoadIterationVariable();
-            auto yLoop = function.ForLoop();
-            yLoop.Begin(_outputShape.GetExtent(1));
+            if (copyExtent[zeroDimension] < outputExtent[zeroDimension])
             {
-                llvm::Value* y = yLoop.LoadIterationVariable();
-                for (int x = 0; x < _outputShape.GetExtent(0); ++x)
+                std::array<int, DataShape::Dimension> begin = { 0, 0, 0 };
+                begin[zeroDimension] = copyExtent[zeroDimension];
+                EmitLoopNest(function, { outputOrder.begin(), outputOrder.end() }, begin, outputExtent, {}, {}, [this, pOutput, &function](const std::array<llvm::Value*, DataShape::Dimension>& location) {
+                    function.SetValueAt(pOutput, _outputShape.EmitGetEntryOffset(function, location), function.Literal<ValueType>(0));
+                });
+            }
+        }
+
+        auto copyEntry = [this, pInput, pOutput, &function](const std::array<llvm::Value*, DataShape::Dimension>& location) {
+            auto value = function.ValueAt(pInput, _inputShape.EmitGetEntryOffset(function, location));
+            function.SetValueAt(pOutput, _outputShape.EmitGetEntryOffset(function, location), value);
+        };
+
+        // Visit the output in memory order, unless the input and output have different innermost dimensions. In that
+        // case, the two innermost dimensions are visited one tile at a time.
+        const int blockSize = 16;
+        std::vector<size_t> loopOrder(outputOrder.begin(), outputOrder.end());
+        std::vector<size_t> blockedDimensions;
+        auto outputInnerDimension = outputOrder[numDimensions - 1];
+        auto inputInnerDimension = inputOrder[numDimensions - 1];
+        if (outputInnerDimension != inputInnerDimension && copyExtent[outputInnerDimension] > 1 && copyExtent[inputInnerDimension] > 1)
+        {
+            loopOrder.clear();
+            for (auto dimension : outputOrder)
+            {
+                if (dimension != outputInnerDimension && dimension != inputInnerDimension)
                 {
-                    auto outputIndex = _outputShape.EmitGetEntryOffset(function, { function.Literal<int>(x), y, z });
-                    auto oob = _inputShape.EmitIsOutOfBounds(function, { function.Literal<int>(x), y, z });
-                    auto ifOob = function.If();
-                    ifOob.If(oob);
-                    {
-                        function.SetValueAt(pOutput, outputIndex, function.Literal<ValueType>(0));
-                    }
-                    ifOob.Else();
-                    {
-                        auto inputIndex = _inputShape.EmitGetEntryOffset(function, { function.Literal<int>(x), y, z });
-                        llvm::Value* value = function.ValueAt(pInput, inputIndex);
-                        function.SetValueAt(pOutput, outputIndex, value);
-                    }
-                    ifOob.End();
+                    loopOrder.push_back(dimension);
                 }
             }
-            yLoop.End();
+            loopOrder.push_back(inputInnerDimension);
+            loopOrder.push_back(outputInnerDimension);
+            blockedDimensions = { inputInnerDimension, outputInnerDimension };
+        }
+
+        EmitBlockedLoopNest(function, loopOrder, blockedDimensions, blockSize, { 0, 0, 0 }, copyExtent, {}, copyEntry);
+    }
+
+    template <typename ValueType>
+    void ReorderDataNode<ValueType>::EmitLoopNest(emitters::IRFunctionEmitter& function, std::vector<size_t> dimensions, const std::array<int, DataShape::Dimension>& begin, const std::array<int, DataShape::Dimension>& end, const std::array<llvm::Value*, DataShape::Dimension>& blockBegin, std::array<llvm::Value*, DataShape::Dimension> location, const EmitEntryFunction& emitEntry) const
+    {
+        if (dimensions.empty())
+        {
+            emitEntry(location);
+            return;
+        }
+
+        // The location is relative to the beginning of the current tile, if the dimension is blocked
+        auto dimension = dimensions.front();
+        dimensions.erase(dimensions.begin());
+        auto loop = function.ForLoop();
+        loop.Begin(begin[dimension], end[dimension], 1);
+        {
+            location[dimension] = loop.LoadIterationVariable();
+            if (blockBegin[dimension] != nullptr)
+            {
+                location[dimension] = function.Operator(emitters::TypedOperator::add, blockBegin[dimension], location[dimension]);
+            }
+            EmitLoopNest(function, dimensions, begin, end, blockBegin, location, emitEntry);
+        }
+        loop.End();
+    }
+
+    template <typename ValueType>
+    void ReorderDataNode<ValueType>::EmitBlockedLoopNest(emitters::IRFunctionEmitter& function, const std::vector<size_t>& loopOrder, std::vector<size_t> blockedDimensions, int blockSize, std::array<int, DataShape::Dimension> begin, std::array<int, DataShape::Dimension> end, std::array<llvm::Value*, DataShape::Dimension> blockBegin, const EmitEntryFunction& emitEntry) const
+    {
+        if (blockedDimensions.empty())
+        {
+            EmitLoopNest(function, loopOrder, begin, end, blockBegin, {}, emitEntry);
+            return;
+        }
+
+        // A loop over the full tiles of the first blocked dimension, then the partial tile at the end
+        auto dimension = blockedDimensions.front();
+        blockedDimensions.erase(blockedDimensions.begin());
+        auto numFullBlocks = (end[dimension] - begin[dimension]) / blockSize;
+        auto remainderBegin = begin[dimension] + numFullBlocks * blockSize;
+        auto remainderEnd = end[dimension];
+        if (numFullBlocks > 0)
+        {
+            auto blockLoop = function.ForLoop();
+            blockLoop.Begin(numFullBlocks);
+            {
+                auto blockIndex = blockLoop.LoadIterationVariable();
+                auto blockOffset = function.Operator(emitters::TypedOperator::multiply, blockIndex, function.Literal<int>(blockSize));
+                blockBegin[dimension] = function.Operator(emitters::TypedOperator::add, blockOffset, function.Literal<int>(begin[dimension]));
+                begin[dimension] = 0;
+                end[dimension] = blockSize;
+                EmitBlockedLoopNest(function, loopOrder, blockedDimensions, blockSize, begin, end, blockBegin, emitEntry);
+            }
+            blockLoop.End();
+        }
+
+        if (remainderBegin < remainderEnd)
+        {
+            blockBegin[dimension] = nullptr;
+            begin[dimension] = remainderBegin;
+            end[dimension] = remainderEnd;
+            EmitBlockedLoopNest(function, loopOrder, blockedDimensions, blockSize, begin, end, blockBegin, emitEntry);
         }
-        zLoop.End();
     }
 
     template <typename ValueType>
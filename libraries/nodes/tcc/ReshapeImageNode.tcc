@@ -49,24 +49,35 @@ namespace nodes
         //
         // Functions
         //
+
+        // Returns the distance in memory between consecutive entries along each (row, column, channel) dimension
+        Shape GetMemoryIncrements(const PortMemoryLayout& inputLayout, const Shape& memoryOrder)
+        {
+            Shape increments(memoryOrder.size());
+            size_t increment = 1;
+            for (auto index = memoryOrder.size(); index > 0; --index)
+            {
+                auto dimension = memoryOrder[index - 1];
+                increments[dimension] = increment;
+                increment *= inputLayout.stride[dimension];
+            }
+            return increments;
+        }
+
         llvm::Value* GetValueFromVolume(emitters::IRFunctionEmitter& function,
                                         llvm::Value* inputVolume,
                                         const PortMemoryLayout& inputLayout,
+                                        const Shape& inputMemoryOrder,
                                         const predictors::neural::ConvolutionalParameters& convParams,
                                         llvm::Value* valueRow, llvm::Value* valueColumn, llvm::Value* valueChannel)
         {
-            const auto inputHeight = inputLayout.size[0];
-            const auto inputWidth = inputLayout.size[1];
-            const auto inputDepth = inputLayout.size[2];
-            const auto rowStride = inputLayout.stride[0];
-            const auto columnStride = inputLayout.stride[1];
-            const auto channelStride = inputLayout.stride[2];
-
-            // row, column, channel order
-            // index = (valueRow * inputWidth*inputDepth) + (valueColumn * inputDepth) + valueChannel;
-            auto index1 = function.Operator(times, valueRow, function.Literal<int>(columnStride * channelStride));
-            auto index2 = function.Operator(times, valueColumn, function.Literal<int>(channelStride));
-            auto index = function.Operator(plus, index1, function.Operator(plus, index2, valueChannel));
+            // index = (valueRow * rowIncrement) + (valueColumn * columnIncrement) + (valueChannel * channelIncrement),
+            // which is (valueRow * inputWidth*inputDepth) + (valueColumn * inputDepth) + valueChannel in row, column, channel order
+            const auto increments = GetMemoryIncrements(inputLayout, inputMemoryOrder);
+            auto index1 = function.Operator(times, valueRow, function.Literal<int>(increments[0]));
+            auto index2 = function.Operator(times, valueColumn, function.Literal<int>(increments[1]));
+            auto index3 = increments[2] == 1 ? valueChannel : function.Operator(times, valueChannel, function.Literal<int>(increments[2]));
+            auto index = function.Operator(plus, index1, function.Operator(plus, index2, index3));
 
             return function.ValueAt(inputVolume, index);
         }
@@ -143,6 +154,7 @@ namespace nodes
         llvm::Value* GetValueFromPaddedVolume(emitters::IRFunctionEmitter& function,
                                               llvm::Value* inputVolume,
                                               const PortMemoryLayout& inputLayout,
+                                              const Shape& inputMemoryOrder,
                                               const predictors::neural::ConvolutionalParameters& convParams,
                                               size_t convPadding,
                                               llvm::Value* inputRow, llvm::Value* inputCol, llvm::Value* inputChannel)
@@ -155,6 +167,11 @@ namespace nodes
             const int extraPadding = convPadding - inputPadding; // amount by which the convolution's desired padding exceeds input's
             if (extraPadding > 0) // known at compile-time
             {
+                if (inputMemoryOrder != Shape{ 0, 1, 2 })
+                {
+                    throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "Extra padding is only implemented for images in row, column, channel order");
+                }
+
                 auto getValueFunction = EmitGetValueFromPaddedVolumeFunction<ValueType>(function.GetModule());
                 return function.Call(getValueFunction, { inputVolume, inputRow, inputCol, inputChannel, function.Literal<int>(inputWidth), function.Literal<int>(inputHeight), function.Literal<int>(inputDepth), function.Literal<int>(extraPadding) });
             }
@@ -164,7 +181,7 @@ namespace nodes
                 inputRow = function.Operator(plus, inputRow, function.Literal<int>(extraPadding));
                 inputCol = function.Operator(plus, inputCol, function.Literal<int>(extraPadding));
             }
-            return GetValueFromVolume(function, inputVolume, inputLayout, convParams, inputRow, inputCol, inputChannel);
+            return GetValueFromVolume(function, inputVolume, inputLayout, inputMemoryOrder, convParams, inputRow, inputCol, inputChannel);
         }
 
         // TODO: emit this as a function in the module
@@ -172,6 +189,7 @@ namespace nodes
         void EmitReceptiveFieldToColumns(emitters::IRFunctionEmitter& function,
                                          llvm::Value* inputVolume,
                                          const PortMemoryLayout& inputLayout,
+                                         const Shape& inputMemoryOrder,
                                          const predictors::neural::ConvolutionalParameters& convParams,
                                          size_t outputWidth,
                                          size_t outputHeight,
@@ -331,7 +349,7 @@ namespace nodes
                             auto entryRow = function.Operator(plus, inputRow, fieldRow);
                             auto entryColumn = function.Operator(plus, inputColumn, fieldColumn);
 
-                            auto volumeValue = GetValueFromPaddedVolume<ValueType>(function, inputVolume, inputLayout, convParams, padding, entryRow, entryColumn, fieldDepth);
+                            auto volumeValue = GetValueFromPaddedVolume<ValueType>(function, inputVolume, inputLayout, inputMemoryOrder, convParams, padding, entryRow, entryColumn, fieldDepth);
                             function.SetValueAt(outputMatrix, outputIndex, volumeValue);
                         }
                         columnLoop.End();
@@ -358,18 +376,55 @@ namespace nodes
     {
     }
 
+    template<typename ValueType>
+    ReshapeImageNode<ValueType>::ReshapeImageNode(const model::PortElements<ValueType>& input, const PortMemoryLayout& inputMemoryLayout, const Shape& inputMemoryOrder, const predictors::neural::ConvolutionalParameters& convolutionalParameters, size_t outputWidth, size_t outputHeight)
+        : ReshapeImageNode(input, inputMemoryLayout, convolutionalParameters, outputWidth, outputHeight)
+    {
+        auto sortedOrder = inputMemoryOrder;
+        std::sort(sortedOrder.begin(), sortedOrder.end());
+        if (sortedOrder != Shape{ 0, 1, 2 })
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Input memory order must be a permutation of the row, column and channel dimensions");
+        }
+        _inputMemoryOrder = inputMemoryOrder;
+    }
+
     template<typename ValueType>
     void ReshapeImageNode<ValueType>::Copy(model::ModelTransformer& transformer) const
     {
         auto newPortElements = transformer.TransformPortElements(_input.GetPortElements());
-        auto newNode = transformer.AddNode<ReshapeImageNode>(newPortElements, GetInputMemoryLayout(), _convolutionalParameters, _outputWidth, _outputHeight);
+        auto newNode = transformer.AddNode<ReshapeImageNode>(newPortElements, GetInputMemoryLayout(), GetInputMemoryOrder(), _convolutionalParameters, _outputWidth, _outputHeight);
         transformer.MapNodeOutput(this->output, newNode->output);
     }
 
     template<typename ValueType>
     void ReshapeImageNode<ValueType>::Compute() const
     {
-        throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented);
+        // Same as the emitted code: each output row holds one entry of the receptive field, for each output pixel
+        const auto inputDepth = _inputMemoryLayout.size[2];
+        const auto filterWidth = _convolutionalParameters.receptiveField;
+        const auto fieldVolumeSize = filterWidth * filterWidth * inputDepth;
+        const auto stride = _convolutionalParameters.stride;
+        const auto increments = GetMemoryIncrements(_inputMemoryLayout, _inputMemoryOrder);
+
+        std::vector<ValueType> output(_output.Size());
+        for (size_t f = 0; f < fieldVolumeSize; ++f)
+        {
+            const auto fieldDepth = f % inputDepth;
+            const auto fieldColumn = (f / inputDepth) % filterWidth;
+            const auto fieldRow = (f / inputDepth) / filterWidth;
+            for (size_t outputImageRow = 0; outputImageRow < _outputHeight; ++outputImageRow)
+            {
+                for (size_t outputImageColumn = 0; outputImageColumn < _outputWidth; ++outputImageColumn)
+                {
+                    const auto entryRow = outputImageRow * stride + fieldRow;
+                    const auto entryColumn = outputImageColumn * stride + fieldColumn;
+                    const auto inputIndex = entryRow * increments[0] + entryColumn * increments[1] + fieldDepth * increments[2];
+                    output[(f * _outputHeight + outputImageRow) * _outputWidth + outputImageColumn] = _input[inputIndex];
+                }
+            }
+        }
+        _output.SetOutput(output);
     }
 
     template<typename ValueType>
@@ -382,7 +437,7 @@ namespace nodes
         assert(inputLayout.size.size() == 3);
 
         // Re-shape input
-        EmitReceptiveFieldToColumns<ValueType>(function, pInput, inputLayout, _convolutionalParameters, _outputWidth, _outputHeight, pOutput);
+        EmitReceptiveFieldToColumns<ValueType>(function, pInput, inputLayout, _inputMemoryOrder, _convolutionalParameters, _outputWidth, _outputHeight, pOutput);
     }
 } // nodes
 } // ell
@@ -19,6 +19,7 @@ void TestBinaryOperationNodeCompute();
 void TestLinearPredictorNodeCompute();
 void TestDemultiplexerNodeCompute();
 void TestDTWDistanceNodeCompute();
+void TestFeatureHashingNodeCompute();
 void TestSourceNodeCompute();
 void TestSinkNodeCompute();
 
@@ -29,3 +30,7 @@ void TestSimpleForestPredictorNodeRefine();
 void TestDemultiplexerNodeRefine();
 void TestMatrixVectorProductRefine();
 void TestProtoNNPredictorNode();
+
+// Optimization
+void TestElementwiseFusionPass();
+void TestLayoutPropagationPass();
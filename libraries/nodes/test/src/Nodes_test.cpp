@@ -11,14 +11,21 @@
 
 // nodes
 #include "AccumulatorNode.h"
+#include "ActivationLayerNode.h"
 #include "BatchNormalizationLayerNode.h"
 #include "BiasLayerNode.h"
 #include "BinaryOperationNode.h"
+#include "BroadcastFunctionNode.h"
+#include "ConstantNode.h"
 #include "DTWDistanceNode.h"
 #include "DelayNode.h"
 #include "DemultiplexerNode.h"
+#include "ElementwiseFusionPass.h"
+#include "FeatureHashingNode.h"
 #include "ForestPredictorNode.h"
+#include "FusedBroadcastFunctionNode.h"
 #include "L2NormNode.h"
+#include "LayoutPropagationPass.h"
 #include "LinearPredictorNode.h"
 #include "MatrixVectorProductNode.h"
 #include "MovingAverageNode.h"
@@ -26,15 +33,23 @@
 #include "NeuralNetworkLayerNode.h"
 #include "NeuralNetworkPredictorNode.h"
 #include "ProtoNNPredictorNode.h"
+#include "ReorderDataNode.h"
+#include "ReshapeImageNode.h"
 #include "SinkNode.h"
 #include "SourceNode.h"
 #include "UnaryOperationNode.h"
 
 // model
+#include "DynamicMap.h"
 #include "InputNode.h"
 #include "Model.h"
+#include "ModelOptimizer.h"
 #include "Node.h"
 
+// data
+#include "FeatureHasher.h"
+#include "StlIndexValueIterator.h"
+
 // predictors
 #include "LinearPredictor.h"
 #include "NeuralNetworkPredictor.h"
@@ -49,9 +64,12 @@
 #include "testing.h"
 
 // stl
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <iostream>
+#include <memory>
+#include <numeric>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -285,7 +303,7 @@ void TestBinaryOperationNodeCompute()
 void TestLinearPredictorNodeCompute()
 {
     const int dim = 10;
-    predictors::LinearPredictor predictor(dim);
+    predictors::LinearPredictor<double> predictor(dim);
 
     model::Model model;
     auto inputNode = model.AddNode<model::InputNode<double>>(dim);
@@ -468,7 +486,7 @@ void TestLinearPredictorNodeRefine()
 {
     // make a linear predictor
     size_t dim = 3;
-    predictors::LinearPredictor predictor(dim);
+    predictors::LinearPredictor<double> predictor(dim);
     predictor.GetBias() = 2.0;
     predictor.GetWeights() = math::ColumnVector<double>{ 3.0, 4.0, 5.0 };
 
@@ -548,6 +566,30 @@ void TestDTWDistanceNodeCompute()
     }
 }
 
+void TestFeatureHashingNodeCompute()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(10);
+    auto hashingNode = model.AddNode<nodes::FeatureHashingNode<double>>(inputNode->output, 3);
+    testing::ProcessTest("Testing FeatureHashingNode output size", hashingNode->output.Size() == 8);
+
+    // the node must agree with the hasher that is used when loading hashed training data
+    data::FeatureHasher hasher(3);
+    std::vector<std::vector<double>> signal = { { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }, { 0, 0, 0, 1, 0, 0, 0, 0, 0, 0 }, { -1, 0, 2.5, 0, 0, 3, 0, 0, 0, -4 } };
+    for (const auto& inputValue : signal)
+    {
+        std::vector<double> expectedOutput(hasher.NumBuckets());
+        for (const auto& entry : hasher.Hash(data::MakeVectorIndexValueIterator<data::IterationPolicy::skipZeros>(inputValue)))
+        {
+            expectedOutput[entry.index] = entry.value;
+        }
+
+        inputNode->SetInput(inputValue);
+        std::vector<double> outputVec = model.ComputeOutput(hashingNode->output);
+        testing::ProcessTest("Testing FeatureHashingNode compute", testing::IsEqual(outputVec, expectedOutput));
+    }
+}
+
 void TestMatrixVectorProductRefine()
 {
     math::ColumnMatrix<double> w(2, 3);
@@ -661,3 +703,143 @@ void TestProtoNNPredictorNode()
     testing::ProcessTest("Testing protonnPredictor node refine", testing::IsEqual(refinedLabelOutput, computeLabelOutput));
     testing::ProcessTest("Testing protonnPredictor node refine", testing::IsEqual(refinedScoreOutput, computeScoreOutput));
 }
+
+void TestElementwiseFusionPass()
+{
+    // out = sqrt(relu(in * scale + bias)) * scale2 + bias2, with the last function writing into a padded output
+    PortMemoryLayout inputLayout({ 2, 3, 2 }, { 2, 3, 2 }, { 0, 0, 0 });
+    PortMemoryLayout outputLayout({ 2, 3, 2 }, { 4, 5, 2 }, { 1, 1, 0 });
+    std::vector<double> scale = { 2.0, -1.0 };
+    std::vector<double> bias = { 0.5, 1.0 };
+    std::vector<double> scale2 = { 1.0, 2.0, 3.0 };
+    std::vector<double> bias2 = { -1.0, 0.0, 1.0 };
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(12);
+    auto scaleNode = model.AddNode<ConstantNode<double>>(scale);
+    auto biasNode = model.AddNode<ConstantNode<double>>(bias);
+    auto scale2Node = model.AddNode<ConstantNode<double>>(scale2);
+    auto bias2Node = model.AddNode<ConstantNode<double>>(bias2);
+    auto linearNode = model.AddNode<BroadcastLinearFunctionNode<double>>(inputNode->output, inputLayout, scaleNode->output, biasNode->output, 2, inputLayout);
+    auto reluNode = model.AddNode<BroadcastUnaryFunctionNode<double, ReLUActivationFunction<double>>>(linearNode->output, inputLayout, inputLayout);
+    auto sqrtNode = model.AddNode<UnaryOperationNode<double>>(reluNode->output, emitters::UnaryOperationType::sqrt);
+    auto linearNode2 = model.AddNode<BroadcastLinearFunctionNode<double>>(sqrtNode->output, inputLayout, scale2Node->output, bias2Node->output, 1, outputLayout);
+
+    auto map1 = model::DynamicMap(model, { { "input", inputNode } }, { { "output", linearNode2->output } });
+    auto map2 = model::DynamicMap(model, { { "input", inputNode } }, { { "output", linearNode2->output } });
+
+    model::ModelOptimizer optimizer;
+    optimizer.AddPass(std::make_unique<ElementwiseFusionPass>());
+    model::TransformContext context;
+    optimizer.Optimize(map2, context);
+
+    // what remains is the input, the constants and the fused node
+    auto fusedNodes = map2.GetModel().GetNodesByType<FusedBroadcastFunctionNode<double>>();
+    testing::ProcessTest("Testing elementwise fusion pass", map2.GetModel().Size() == 6 && fusedNodes.size() == 1 && fusedNodes[0]->NumStages() == 4);
+
+    std::vector<double> input(12);
+    std::vector<double> expected(4 * 5 * 2);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            for (size_t k = 0; k < 2; ++k)
+            {
+                auto value = static_cast<double>(i * 6 + j * 2 + k) - 4.0;
+                input[(i * 3 + j) * 2 + k] = value;
+                expected[((i + 1) * 5 + (j + 1)) * 2 + k] = std::sqrt(std::max(0.0, value * scale[k] + bias[k])) * scale2[j] + bias2[j];
+            }
+        }
+    }
+    auto output1 = map1.Compute<double>(input);
+    auto output2 = map2.Compute<double>(input);
+    testing::ProcessTest("Testing elementwise fusion pass compute", testing::IsEqual(output1, expected) && testing::IsEqual(output2, expected));
+}
+
+void TestLayoutPropagationPass()
+{
+    // A 3 x 4 image with 2 channels, stored one channel at a time
+    DataShape channelMajorShape({ 4, 3, 2 });
+    DataShape interleavedShape({ 4, 3, 2 }, { 0, 0, 0 }, { 2, 0, 1 });
+    DataShape columnMajorShape({ 4, 3, 2 }, { 0, 0, 0 }, { 1, 0, 2 });
+    std::vector<double> input(24);
+    std::iota(input.begin(), input.end(), 1.0);
+    model::TransformContext context;
+
+    // Two reorders in a row are folded into one, and reorders that undo each other are removed
+    {
+        model::Model model;
+        auto inputNode = model.AddNode<model::InputNode<double>>(24);
+        auto reorderNode1 = model.AddNode<ReorderDataNode<double>>(inputNode->output, channelMajorShape, interleavedShape);
+        auto reorderNode2 = model.AddNode<ReorderDataNode<double>>(reorderNode1->output, interleavedShape, columnMajorShape);
+        auto reorderNode3 = model.AddNode<ReorderDataNode<double>>(reorderNode2->output, columnMajorShape, channelMajorShape);
+
+        auto map1 = model::DynamicMap(model, { { "input", inputNode } }, { { "output", reorderNode2->output } });
+        auto map2 = model::DynamicMap(model, { { "input", inputNode } }, { { "output", reorderNode2->output } });
+        auto map3 = model::DynamicMap(model, { { "input", inputNode } }, { { "output", reorderNode3->output } });
+
+        model::ModelOptimizer optimizer;
+        optimizer.AddPass(std::make_unique<LayoutPropagationPass>());
+        optimizer.Optimize(map2, context);
+        optimizer.Optimize(map3, context);
+
+        auto reorderNodes = map2.GetModel().GetNodesByType<ReorderDataNode<double>>();
+        testing::ProcessTest("Testing layout propagation pass folding", reorderNodes.size() == 1 && map3.GetModel().GetNodesByType<ReorderDataNode<double>>().empty());
+        testing::ProcessTest("Testing layout propagation pass folding compute", testing::IsEqual(map1.Compute<double>(input), map2.Compute<double>(input)) && testing::IsEqual(map3.Compute<double>(input), input));
+    }
+
+    // The image is scaled and padded in the interleaved order before being reshaped for a 3 x 3 convolution, so it can
+    // be kept one channel at a time instead
+    {
+        PortMemoryLayout imageLayout({ 3, 4, 2 }, { 3, 4, 2 }, { 0, 0, 0 });
+        PortMemoryLayout paddedImageLayout({ 3, 4, 2 }, { 5, 6, 2 }, { 1, 1, 0 });
+        std::vector<double> scale = { 2.0, -1.0 };
+        std::vector<double> bias = { 0.5, 1.0 };
+        predictors::neural::ConvolutionalParameters convParams{ 3, 1, predictors::neural::ConvolutionMethod::columnwise, 1 };
+
+        model::Model model;
+        auto inputNode = model.AddNode<model::InputNode<double>>(24);
+        auto scaleNode = model.AddNode<ConstantNode<double>>(scale);
+        auto biasNode = model.AddNode<ConstantNode<double>>(bias);
+        auto reorderNode = model.AddNode<ReorderDataNode<double>>(inputNode->output, channelMajorShape, interleavedShape);
+        auto linearNode = model.AddNode<BroadcastLinearFunctionNode<double>>(reorderNode->output, imageLayout, scaleNode->output, biasNode->output, 2, paddedImageLayout);
+        auto reshapeNode = model.AddNode<ReshapeImageNode<double>>(linearNode->output, paddedImageLayout, convParams, 4, 3);
+
+        auto map1 = model::DynamicMap(model, { { "input", inputNode } }, { { "output", reshapeNode->output } });
+        auto map2 = model::DynamicMap(model, { { "input", inputNode } }, { { "output", reshapeNode->output } });
+
+        model::ModelOptimizer optimizer;
+        optimizer.AddPass(std::make_unique<LayoutPropagationPass>());
+        optimizer.Optimize(map2, context);
+
+        auto reshapeNodes = map2.GetModel().GetNodesByType<ReshapeImageNode<double>>();
+        auto fusedNodes = map2.GetModel().GetNodesByType<FusedBroadcastFunctionNode<double>>();
+        testing::ProcessTest("Testing layout propagation pass", map2.GetModel().GetNodesByType<ReorderDataNode<double>>().empty() && fusedNodes.size() == 1 && reshapeNodes.size() == 1 && reshapeNodes[0]->GetInputMemoryOrder() == Shape({ 2, 0, 1 }));
+
+        // Each output row holds one (row, column, channel) entry of the 3 x 3 receptive field, for each output pixel
+        std::vector<double> expected(18 * 12);
+        for (size_t fieldRow = 0; fieldRow < 3; ++fieldRow)
+        {
+            for (size_t fieldColumn = 0; fieldColumn < 3; ++fieldColumn)
+            {
+                for (size_t channel = 0; channel < 2; ++channel)
+                {
+                    for (size_t row = 0; row < 3; ++row)
+                    {
+                        for (size_t column = 0; column < 4; ++column)
+                        {
+                            int imageRow = static_cast<int>(row + fieldRow) - 1;
+                            int imageColumn = static_cast<int>(column + fieldColumn) - 1;
+                            bool isPadding = imageRow < 0 || imageRow >= 3 || imageColumn < 0 || imageColumn >= 4;
+                            auto value = isPadding ? 0.0 : input[(channel * 3 + imageRow) * 4 + imageColumn] * scale[channel] + bias[channel];
+                            expected[(((fieldRow * 3 + fieldColumn) * 2 + channel) * 3 + row) * 4 + column] = value;
+                        }
+                    }
+                }
+            }
+        }
+        auto output1 = map1.Compute<double>(input);
+        auto output2 = map2.Compute<double>(input);
+        testing::ProcessTest("Testing layout propagation pass compute", testing::IsEqual(output1, expected) && testing::IsEqual(output2, expected));
+    }
+}
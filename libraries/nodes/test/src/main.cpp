@@ -40,6 +40,7 @@ int main()
         TestLinearPredictorNodeCompute();
         TestDemultiplexerNodeCompute();
         TestDTWDistanceNodeCompute();
+        TestFeatureHashingNodeCompute();
         TestSourceNodeCompute();
         TestSinkNodeCompute();
 
@@ -71,6 +72,12 @@ int main()
         TestDemultiplexerNodeRefine();
         TestMatrixVectorProductRefine();
         TestProtoNNPredictorNode();
+
+        //
+        // Optimization tests
+        //
+        TestElementwiseFusionPass();
+        TestLayoutPropagationPass();
     }
     catch (const utilities::Exception& exception)
     {
@@ -16,62 +16,82 @@ namespace ell
 {
 namespace predictors
 {
-    LinearPredictor::LinearPredictor()
+    template <typename ElementType>
+    LinearPredictor<ElementType>::LinearPredictor()
         : _w(0), _b(0)
     {
     }
 
-    LinearPredictor::LinearPredictor(size_t dim)
+    template <typename ElementType>
+    LinearPredictor<ElementType>::LinearPredictor(size_t dim)
         : _w(dim), _b(0)
     {
     }
 
-    LinearPredictor::LinearPredictor(const math::ColumnVector<double>& weights, double bias)
+    template <typename ElementType>
+    LinearPredictor<ElementType>::LinearPredictor(const math::ColumnVector<ElementType>& weights, ElementType bias)
         : _w(weights), _b(bias)
     {
     }
 
-    void LinearPredictor::Reset()
+    template <typename ElementType>
+    void LinearPredictor<ElementType>::Reset()
     {
         _w.Reset();
         _b = 0;
     }
 
-    void LinearPredictor::Resize(size_t size)
+    template <typename ElementType>
+    void LinearPredictor<ElementType>::Resize(size_t size)
     {
         _w.Resize(size);
     }
 
-    double LinearPredictor::Predict(const DataVectorType& dataVector) const
+    template <typename ElementType>
+    ElementType LinearPredictor<ElementType>::Predict(const DataVectorType& dataVector) const
     {
         return _w * dataVector + _b;
     }
 
-    auto LinearPredictor::GetWeightedElements(const DataVectorType& dataVector) const -> DataVectorType
+    template <typename ElementType>
+    ElementType LinearPredictor<ElementType>::Predict(const data::IDataVector& dataVector) const
+    {
+        return _w * dataVector + _b;
+    }
+
+    template <typename ElementType>
+    auto LinearPredictor<ElementType>::GetWeightedElements(const DataVectorType& dataVector) const -> DataVectorType
     {
         auto transformation = [&](data::IndexValue indexValue) -> double { return indexValue.value * _w[indexValue.index]; };
-        return dataVector.TransformAs<data::IterationPolicy::skipZeros,DataVectorType>(transformation);
+        return dataVector.template TransformAs<data::IterationPolicy::skipZeros, DataVectorType>(transformation);
     }
 
-    void LinearPredictor::Scale(double scalar)
+    template <typename ElementType>
+    void LinearPredictor<ElementType>::Scale(ElementType scalar)
     {
         _w *= scalar; 
         _b *= scalar;
     }
 
-    void LinearPredictor::WriteToArchive(utilities::Archiver& archiver) const
+    template <typename ElementType>
+    void LinearPredictor<ElementType>::WriteToArchive(utilities::Archiver& archiver) const
     {
         auto w = _w.ToArray();
         archiver["w"] << w;
         archiver["b"] << _b;
     }
 
-    void LinearPredictor::ReadFromArchive(utilities::Unarchiver& archiver)
+    template <typename ElementType>
+    void LinearPredictor<ElementType>::ReadFromArchive(utilities::Unarchiver& archiver)
     {
-        std::vector<double> w;
+        std::vector<ElementType> w;
         archiver["w"] >> w;
-        _w = math::ColumnVector<double>(std::move(w));
+        _w = math::ColumnVector<ElementType>(std::move(w));
         archiver["b"] >> _b;
     }
+
+    // explicit instantiation
+    template class LinearPredictor<float>;
+    template class LinearPredictor<double>;
 }
 }
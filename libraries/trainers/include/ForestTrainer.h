@@ -12,6 +12,7 @@
 
 // data
 #include "Dataset.h"
+#include "DatasetView.h"
 #include "DenseDataVector.h"
 
 // predictors
@@ -116,7 +117,7 @@ namespace trainers
     public:
         using PredictorType = typename predictors::ForestPredictor<SplitRuleType, EdgePredictorType>;
         using DataVectorType = typename PredictorType::DataVectorType;
-        using TrainerExampleType = data::Example<DataVectorType, TrainerMetadata>;
+        using TrainerDatasetType = data::DatasetView<DataVectorType, TrainerMetadata>;
 
         /// <summary> Constructs an instance of ForestTrainer. </summary>
         ///
@@ -205,7 +206,7 @@ namespace trainers
         SplitCandidatePriorityQueue _queue;
 
         // the data set
-        data::Dataset<TrainerExampleType> _dataset;
+        TrainerDatasetType _dataset;
     };
 }
 }
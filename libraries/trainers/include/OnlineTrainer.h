@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     OnlineTrainer.h (trainers)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ITrainer.h"
+#include "SGDTrainer.h"
+
+// predictors
+#include "LinearPredictor.h"
+
+// data
+#include "Dataset.h"
+#include "Example.h"
+
+// stl
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace ell
+{
+namespace trainers
+{
+    /// <summary> Parameters for the online trainer. </summary>
+    struct OnlineTrainerParameters
+    {
+        /// <summary> The number of examples that are collected before the internal trainer performs an update. </summary>
+        size_t batchSize;
+
+        /// <summary> The number of internal trainer updates between consecutive predictor snapshots. </summary>
+        size_t publishPeriod;
+    };
+
+    /// <summary>
+    /// Wraps an incremental trainer so that it can learn from a stream of examples while other
+    /// threads make predictions. Examples are added one at a time and collected into small
+    /// batches, and each batch is handed to the internal trainer for a single update, by setting
+    /// the batch as its dataset. Only the SGD trainers (SGDTrainer, SparseDataSGDTrainer and
+    /// SparseDataCenteredSGDTrainer) keep their state across such updates, so the internal trainer
+    /// must be one of them; other trainers, such as SDCATrainer, are rejected. Every few
+    /// updates, a copy of the internal trainer's predictor is published as an immutable snapshot by
+    /// atomically swapping a shared pointer. Readers only ever see complete snapshots and never
+    /// wait for training or for the copy; a snapshot stays alive for as long as some reader holds
+    /// on to it. The atomic shared pointer functions are not lock-free, though: the standard
+    /// library guards them with a small internal lock, held only while the pointer is copied and
+    /// its reference count is updated, so readers that call GetSnapshot() at the same moment as
+    /// each other or as a publication take turns for that long. AddExample() and Flush() must be
+    /// called from a single training thread, whereas GetSnapshot() can be called from any thread.
+    /// </summary>
+    ///
+    /// <typeparam name="PredictorType"> The predictor type. </typeparam>
+    template <typename PredictorType>
+    class OnlineTrainer
+    {
+    public:
+        using InternalTrainerType = ITrainer<PredictorType>;
+
+        /// <summary> Constructs an instance of OnlineTrainer, and publishes the internal trainer's current predictor. </summary>
+        ///
+        /// <param name="internalTrainer"> An SGD trainer, or else the constructor throws. </param>
+        /// <param name="parameters"> The online trainer parameters. </param>
+        OnlineTrainer(std::unique_ptr<InternalTrainerType>&& internalTrainer, const OnlineTrainerParameters& parameters);
+
+        /// <summary> Adds an example, and updates the internal trainer once a full batch of examples is available. </summary>
+        ///
+        /// <param name="example"> The example. </param>
+        void AddExample(const data::AutoSupervisedExample& example);
+
+        /// <summary> Updates the internal trainer with any examples that have not been used yet and publishes a new snapshot. </summary>
+        void Flush();
+
+        /// <summary>
+        /// Gets the most recently published predictor. This function is thread-safe and does not
+        /// block on training, but it is not lock-free: it takes the short internal lock of the
+        /// atomic shared pointer functions.
+        /// </summary>
+        ///
+        /// <returns> A shared pointer to an immutable predictor. </returns>
+        std::shared_ptr<const PredictorType> GetSnapshot() const { return std::atomic_load(&_snapshot); }
+
+        /// <summary> Gets the number of snapshots published so far, including the initial one. </summary>
+        ///
+        /// <returns> The number of snapshots. </returns>
+        size_t NumSnapshots() const { return _numSnapshots.load(); }
+
+    private:
+        void UpdateInternalTrainer();
+        void Publish();
+
+        std::unique_ptr<InternalTrainerType> _internalTrainer;
+        OnlineTrainerParameters _parameters;
+
+        data::AutoSupervisedDataset _batch;
+        size_t _numUpdatesSincePublish = 0;
+
+        std::shared_ptr<const PredictorType> _snapshot;
+        std::atomic<size_t> _numSnapshots;
+    };
+
+    // friendly name
+    using OnlineLinearTrainer = OnlineTrainer<predictors::LinearPredictor<double>>;
+}
+}
+
+#include "../tcc/OnlineTrainer.tcc"
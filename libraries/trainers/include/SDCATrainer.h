@@ -15,7 +15,7 @@
 
 // data
 #include "Dataset.h"
-#include "Example.h"
+#include "DatasetView.h"
 
 // math
 #include "Vector.h"
@@ -47,12 +47,15 @@ namespace trainers
 
     /// <summary> Implements the stochastic dual coordinate ascent linear trainer. </summary>
     ///
+    /// <typeparam name="ElementType"> The type of the weights of the trained predictor. </typeparam>
     /// <typeparam name="LossFunctionType"> Loss function type. </typeparam>
     /// <typeparam name="RegularizerType"> Regularizer type. </typeparam>
-    template<typename LossFunctionType, typename RegularizerType>
-    class SDCATrainer : public ITrainer<predictors::LinearPredictor>
+    template<typename ElementType, typename LossFunctionType, typename RegularizerType>
+    class SDCATrainer : public ITrainer<predictors::LinearPredictor<ElementType>>
     {
     public:
+        using PredictorType = predictors::LinearPredictor<ElementType>;
+
         /// <summary> Constructs an instance of SDCATrainer. </summary>
         ///
         /// <param name="lossFunction"> The loss function. </param>
@@ -71,12 +74,12 @@ namespace trainers
         /// <summary> Gets the trained predictor. </summary>
         ///
         /// <returns> A const reference to the predictor. </returns>
-        virtual const predictors::LinearPredictor& GetPredictor() const override { return _predictor; }
+        virtual const PredictorType& GetPredictor() const override { return _predictor; }
 
         /// <summary> Gets information on the trained predictor. </summary>
         ///
         /// <returns> Information on the trained predictor. </returns>
-        double GetPredictorInfo() const { return _predictorInfo; }
+        const SDCAPredictorInfo& GetPredictorInfo() const { return _predictorInfo; }
 
     private:
         struct TrainerMetadata
@@ -93,10 +96,9 @@ namespace trainers
             double dualVariable = 0;
         };
 
-        using DataVectorType = typename predictors::LinearPredictor::DataVectorType;
-        using TrainerExampleType = data::Example<DataVectorType, TrainerMetadata>;
+        using DataVectorType = typename PredictorType::DataVectorType;
 
-        void Step(TrainerExampleType& x);
+        void Step(const DataVectorType& dataVector, TrainerMetadata& metadata);
         void ComputeObjectives();
         void ResizeTo(const data::AutoDataVector& x);
 
@@ -106,12 +108,12 @@ namespace trainers
         std::default_random_engine _random;
         double _inverseScaledRegularization;
 
-        data::Dataset<TrainerExampleType> _dataset;
+        data::DatasetView<DataVectorType, TrainerMetadata> _dataset;
 
-        predictors::LinearPredictor _predictor;
+        PredictorType _predictor;
         SDCAPredictorInfo _predictorInfo;
 
-        math::ColumnVector<double> _v;
+        math::ColumnVector<ElementType> _v;
         double _d = 0;
         math::RowVector<double> _a;
     };
@@ -122,13 +124,14 @@ namespace trainers
 
     /// <summary> Makes a SDCA linear trainer. </summary>
     ///
+    /// <typeparam name="ElementType"> The type of the weights of the trained predictor. </typeparam>
     /// <typeparam name="LossFunctionType"> Type of loss function to use. </typeparam>
     /// <param name="lossFunction"> The loss function. </param>
     /// <param name="parameters"> The trainer parameters. </param>
     ///
     /// <returns> A linear trainer </returns>
-    template <typename LossFunctionType, typename RegularizerType>
-    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor>> MakeSDCATrainer(const LossFunctionType& lossFunction, const RegularizerType& regularizer, const SDCATrainerParameters& parameters);
+    template <typename ElementType, typename LossFunctionType, typename RegularizerType>
+    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor<ElementType>>> MakeSDCATrainer(const LossFunctionType& lossFunction, const RegularizerType& regularizer, const SDCATrainerParameters& parameters);
 }
 }
 
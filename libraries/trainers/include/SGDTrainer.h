@@ -14,14 +14,18 @@
 #include "LinearPredictor.h"
 
 // data
+#include "ArenaDataset.h"
+#include "BinaryDataset.h"
 #include "Dataset.h"
-#include "Example.h"
+#include "DatasetView.h"
+#include "QuantizedDataset.h"
 
 // stl
 #include <cstddef>
 #include <memory>
 #include <random>
 #include <string>
+#include <vector>
 
 namespace ell
 {
@@ -35,37 +39,100 @@ namespace trainers
     };
 
     /// <summary>
-    /// Implements the averaged stochastic gradient descent algorithm on an L2 regularized empirical
-    /// loss. This class must be have a derived class that implements DoFirstStep(), DoNextStep(), and CalculatePredictors().
+    /// The interface of the averaged stochastic gradient descent trainers on an L2 regularized
+    /// empirical loss. The epochs and steps are implemented by SGDTrainerEpochs.
     /// </summary>
-    /// <typeparam name="DerivedType"> The derived class (curiously recurring template pattern). </typeparam>
-    class SGDTrainerBase : public ITrainer<predictors::LinearPredictor>
+    ///
+    /// <typeparam name="ElementType"> The type of the weights of the trained predictor. </typeparam>
+    template <typename ElementType>
+    class SGDTrainerBase : public ITrainer<predictors::LinearPredictor<ElementType>>
     {
     public:
-        using PredictorType = predictors::LinearPredictor;
+        using PredictorType = predictors::LinearPredictor<ElementType>;
 
-        /// <summary> Sets the trainer's dataset. </summary>
+        /// <summary>
+        /// Updates the state of the trainer by performing a learning epoch over a stream of examples,
+        /// instead of the dataset. The examples are visited in the order of the stream and are not
+        /// stored, so the stream can be larger than memory.
+        /// </summary>
         ///
-        /// <param name="anyDataset"> A dataset. </param>
-        virtual void SetDataset(const data::AnyDataset& anyDataset) override;
+        /// <param name="exampleIterator"> An iterator over the examples of the epoch. </param>
+        virtual void Update(data::AutoSupervisedExampleIterator exampleIterator) = 0;
 
-        /// <summary> Updates the state of the trainer by performing a learning epoch. </summary>
-        virtual void Update() override;
+        using ITrainer<PredictorType>::Update;
 
         /// <summary> Returns The averaged predictor. </summary>
         ///
         /// <returns> A const reference to the averaged predictor. </returns>
-        virtual const predictors::LinearPredictor& GetPredictor() const override { return GetAveragedPredictor(); }
+        virtual const PredictorType& GetPredictor() const override { return GetAveragedPredictor(); }
 
     protected:
         // Instances of the base class cannot be created directly
         SGDTrainerBase(std::string randomSeedString);
-        virtual void DoFirstStep(const data::AutoDataVector& x, double y, double weight) = 0;
-        virtual void DoNextStep(const data::AutoDataVector& x, double y, double weight) = 0;
         virtual const PredictorType& GetAveragedPredictor() const = 0;
 
-        data::AutoSupervisedDataset _dataset;
         std::default_random_engine _random;
+    };
+
+    /// <summary>
+    /// Implements the epochs of an SGD trainer. The kind of dataset is resolved once per epoch, and
+    /// each example is passed to the FirstStep and NextStep function templates of the derived
+    /// trainer, which are called directly on the type of its data vector.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> The type of the weights of the trained predictor. </typeparam>
+    /// <typeparam name="TrainerType"> The derived trainer type. </typeparam>
+    template <typename ElementType, typename TrainerType>
+    class SGDTrainerEpochs : public SGDTrainerBase<ElementType>
+    {
+    public:
+        /// <summary>
+        /// Sets the trainer's dataset. The rows of an ArenaDataset, a BinaryDataset or a QuantizedDataset
+        /// are read in place during the updates, without copying them. AnyDataset does not own the
+        /// dataset it refers to, so the trainer keeps only a pointer to such a dataset: the caller must
+        /// keep the dataset alive and unchanged until the last call to Update(), or until SetDataset()
+        /// is called again. The examples of other datasets are shared with the trainer, which keeps
+        /// them alive. The dot products with the rows of a QuantizedDataset are computed directly from
+        /// the codes.
+        /// </summary>
+        ///
+        /// <param name="anyDataset"> A dataset. </param>
+        virtual void SetDataset(const data::AnyDataset& anyDataset) override;
+
+        /// <summary> Updates the state of the trainer by performing a learning epoch. </summary>
+        virtual void Update() override;
+
+        /// <summary> Updates the state of the trainer by performing a learning epoch over a stream of examples. </summary>
+        ///
+        /// <param name="exampleIterator"> An iterator over the examples of the epoch. </param>
+        virtual void Update(data::AutoSupervisedExampleIterator exampleIterator) override;
+
+    protected:
+        using SGDTrainerBase<ElementType>::SGDTrainerBase;
+
+    private:
+        template <typename ExampleIteratorType>
+        void DoEpoch(ExampleIteratorType& exampleIterator);
+
+        template <typename DataVectorType>
+        void DoStep(const DataVectorType& x, const data::WeightLabel& weightLabel);
+
+        template <typename DatasetType>
+        bool SetRowDataset(const data::AnyDataset& anyDataset, const DatasetType*& rowDataset);
+
+        template <typename DatasetType>
+        void UpdateRows(const DatasetType& rowDataset);
+
+        data::DatasetView<data::AutoDataVector, data::WeightLabel> _dataset;
+
+        // the rows of an ArenaDataset, a BinaryDataset or a QuantizedDataset are read in place, instead of through _dataset;
+        // these datasets are owned by the caller, see SetDataset()
+        const data::ArenaDataset* _arenaDataset = nullptr;
+        const data::BinaryDataset* _binaryDataset = nullptr;
+        const data::ByteQuantizedDataset* _byteQuantizedDataset = nullptr;
+        const data::ShortQuantizedDataset* _shortQuantizedDataset = nullptr;
+        std::vector<size_t> _rows;
+
         bool _firstIteration = true;
     };
 
@@ -75,12 +142,13 @@ namespace trainers
 
     /// <summary> Implements the steps of a simple sgd linear trainer. </summary>
     ///
+    /// <typeparam name="ElementType"> The type of the weights of the trained predictor. </typeparam>
     /// <typeparam name="LossFunctionType"> Loss function type. </typeparam>
-    template <typename LossFunctionType>
-    class SGDTrainer : public SGDTrainerBase
+    template <typename ElementType, typename LossFunctionType>
+    class SGDTrainer : public SGDTrainerEpochs<ElementType, SGDTrainer<ElementType, LossFunctionType>>
     {
     public:
-        using SGDTrainerBase::PredictorType;
+        using typename SGDTrainerBase<ElementType>::PredictorType;
 
         /// <summary> Constructs an SGD linear trainer. </summary>
         ///
@@ -98,11 +166,15 @@ namespace trainers
         /// <returns> A const reference to the averaged predictor. </returns>
         virtual const PredictorType& GetAveragedPredictor() const override { return _averagedPredictor; }
 
-    protected:
-        virtual void DoFirstStep(const data::AutoDataVector& x, double y, double weight) override;
-        virtual void DoNextStep(const data::AutoDataVector& x, double y, double weight) override;
-
     private:
+        friend class SGDTrainerEpochs<ElementType, SGDTrainer<ElementType, LossFunctionType>>;
+
+        template <typename DataVectorType>
+        void FirstStep(const DataVectorType& x, double y, double weight);
+
+        template <typename DataVectorType>
+        void NextStep(const DataVectorType& x, double y, double weight);
+
         LossFunctionType _lossFunction;
         SGDTrainerParameters _parameters;
 
@@ -110,7 +182,7 @@ namespace trainers
         PredictorType _lastPredictor;
         PredictorType _averagedPredictor;
 
-        void ResizeTo(const data::AutoDataVector& x);
+        void ResizeTo(const data::IDataVector& x);
     };
 
     //
@@ -119,12 +191,13 @@ namespace trainers
 
     /// <summary> Implements the steps of Sparse Data Stochastic Gradient Descent. </summary>
     ///
+    /// <typeparam name="ElementType"> The type of the weights of the trained predictor. </typeparam>
     /// <typeparam name="LossFunctionType"> Loss function type. </typeparam>
-    template <typename LossFunctionType>
-    class SparseDataSGDTrainer : public SGDTrainerBase
+    template <typename ElementType, typename LossFunctionType>
+    class SparseDataSGDTrainer : public SGDTrainerEpochs<ElementType, SparseDataSGDTrainer<ElementType, LossFunctionType>>
     {
     public:
-        using SGDTrainerBase::PredictorType;
+        using typename SGDTrainerBase<ElementType>::PredictorType;
 
         /// <summary> Constructs an instance of SparseDataSGDTrainer. </summary>
         ///
@@ -142,27 +215,31 @@ namespace trainers
         /// <returns> A const reference to the averaged predictor. </returns>
         virtual const PredictorType& GetAveragedPredictor() const override;
 
-    protected:
-        virtual void DoFirstStep(const data::AutoDataVector& x, double y, double weight) override;
-        virtual void DoNextStep(const data::AutoDataVector& x, double y, double weight) override;
-
     private:
+        friend class SGDTrainerEpochs<ElementType, SparseDataSGDTrainer<ElementType, LossFunctionType>>;
+
+        template <typename DataVectorType>
+        void FirstStep(const DataVectorType& x, double y, double weight);
+
+        template <typename DataVectorType>
+        void NextStep(const DataVectorType& x, double y, double weight);
+
         LossFunctionType _lossFunction;
         SGDTrainerParameters _parameters;
 
         // these variables follow the notation in https://arxiv.org/abs/1612.09147
-        math::ColumnVector<double> _v;  // gradient sum - weights
-        math::ColumnVector<double> _u;  // harmonic-weighted gradient sum - weights
-        double _t = 0;                  // step counter
-        double _a = 0;                  // gradient sum - bias
-        double _h = 0;                  // harmonic number
-        double _c = 0;                  // 1/t-weighted sum of _a
+        math::ColumnVector<ElementType> _v;  // gradient sum - weights
+        math::ColumnVector<ElementType> _u;  // harmonic-weighted gradient sum - weights
+        double _t = 0;                       // step counter
+        double _a = 0;                       // gradient sum - bias
+        double _h = 0;                       // harmonic number
+        double _c = 0;                       // 1/t-weighted sum of _a
 
         // these variables are mutable because we calculate them in a lazy manner (only when `GetPredictor() const` is called)
         mutable PredictorType _lastPredictor;
         mutable PredictorType _averagedPredictor;
 
-        void ResizeTo(const data::AutoDataVector& x);
+        void ResizeTo(const data::IDataVector& x);
     };
 
     //
@@ -171,19 +248,20 @@ namespace trainers
 
     /// <summary> Implements the steps of Sparse Data Centered Stochastic Gradient Descent. </summary>
     ///
+    /// <typeparam name="ElementType"> The type of the weights of the trained predictor. </typeparam>
     /// <typeparam name="LossFunctionType"> Loss function type. </typeparam>
-    template <typename LossFunctionType>
-    class SparseDataCenteredSGDTrainer : public SGDTrainerBase
+    template <typename ElementType, typename LossFunctionType>
+    class SparseDataCenteredSGDTrainer : public SGDTrainerEpochs<ElementType, SparseDataCenteredSGDTrainer<ElementType, LossFunctionType>>
     {
     public:
-        using SGDTrainerBase::PredictorType;
+        using typename SGDTrainerBase<ElementType>::PredictorType;
 
         /// <summary> Constructs an instance of SparseDataCenteredSGDTrainer. </summary>
         ///
         /// <param name="lossFunction"> The loss function. </param>
         /// <param name="center"> The center (mean) of the training set. </param>
         /// <param name="parameters"> Trainer parameters. </param>
-        SparseDataCenteredSGDTrainer(const LossFunctionType& lossFunction, math::RowVector<double> center, const SGDTrainerParameters& parameters);
+        SparseDataCenteredSGDTrainer(const LossFunctionType& lossFunction, math::RowVector<ElementType> center, const SGDTrainerParameters& parameters);
 
         /// <summary> Returns a const reference to the last predictor. </summary>
         ///
@@ -195,34 +273,38 @@ namespace trainers
         /// <returns> A const reference to the averaged predictor. </returns>
         virtual const PredictorType& GetAveragedPredictor() const override;
 
-    protected:
-        virtual void DoFirstStep(const data::AutoDataVector& x, double y, double weight) override;
-        virtual void DoNextStep(const data::AutoDataVector& x, double y, double weight) override;
-
     private:
+        friend class SGDTrainerEpochs<ElementType, SparseDataCenteredSGDTrainer<ElementType, LossFunctionType>>;
+
+        template <typename DataVectorType>
+        void FirstStep(const DataVectorType& x, double y, double weight);
+
+        template <typename DataVectorType>
+        void NextStep(const DataVectorType& x, double y, double weight);
+
         LossFunctionType _lossFunction;
         SGDTrainerParameters _parameters;
 
         // these variables follow the notation in https://arxiv.org/abs/1612.09147
-        math::ColumnVector<double> _v;  // gradient sum - weights
-        math::ColumnVector<double> _u;  // harmonic-weighted gradient sum - weights
-        double _t = 0;                  // step counter
-        double _a = 0;                  // gradient sum - bias
-        double _h = 0;                  // harmonic number
-        double _c = 0;                  // 1/t-weighted sum of _a
+        math::ColumnVector<ElementType> _v;  // gradient sum - weights
+        math::ColumnVector<ElementType> _u;  // harmonic-weighted gradient sum - weights
+        double _t = 0;                       // step counter
+        double _a = 0;                       // gradient sum - bias
+        double _h = 0;                       // harmonic number
+        double _c = 0;                       // 1/t-weighted sum of _a
 
         double _z = 0;
         double _r = 0;
         double _s = 0;
 
-        math::RowVector<double> _center;
+        math::RowVector<ElementType> _center;
         double _theta;
 
         // these variables are mutable because we calculate them in a lazy manner (only when `GetPredictor() const` is called)
         mutable PredictorType _lastPredictor;
         mutable PredictorType _averagedPredictor;
 
-        void ResizeTo(const data::AutoDataVector& x);
+        void ResizeTo(const data::IDataVector& x);
     };
 
     //
@@ -231,34 +313,37 @@ namespace trainers
 
     /// <summary> Makes a SGD linear trainer. </summary>
     ///
+    /// <typeparam name="ElementType"> The type of the weights of the trained predictor. </typeparam>
     /// <typeparam name="LossFunctionType"> Type of loss function to use. </typeparam>
     /// <param name="lossFunction"> The loss function. </param>
     /// <param name="parameters"> The trainer parameters. </param>
     ///
     /// <returns> A linear trainer </returns>
-    template <typename LossFunctionType>
-    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor>> MakeSGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters);
+    template <typename ElementType, typename LossFunctionType>
+    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor<ElementType>>> MakeSGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters);
 
     /// <summary> Makes a SparseDataSGD linear trainer. </summary>
     ///
+    /// <typeparam name="ElementType"> The type of the weights of the trained predictor. </typeparam>
     /// <typeparam name="LossFunctionType"> Type of loss function to use. </typeparam>
     /// <param name="lossFunction"> The loss function. </param>
     /// <param name="parameters"> The trainer parameters. </param>
     ///
     /// <returns> A linear trainer </returns>
-    template <typename LossFunctionType>
-    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor>> MakeSparseDataSGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters);
+    template <typename ElementType, typename LossFunctionType>
+    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor<ElementType>>> MakeSparseDataSGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters);
 
     /// <summary> Makes a SparseDataCenteredSGD linear trainer. </summary>
     ///
+    /// <typeparam name="ElementType"> The type of the weights of the trained predictor. </typeparam>
     /// <typeparam name="LossFunctionType"> Type of loss function to use. </typeparam>
     /// <param name="lossFunction"> The loss function. </param>
     /// <param name="center"> The center (mean) of the training set. </param>
     /// <param name="parameters"> The trainer parameters. </param>
     ///
     /// <returns> A linear trainer </returns>
-    template <typename LossFunctionType>
-    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor>> MakeSparseDataCenteredSGDTrainer(const LossFunctionType& lossFunction, math::RowVector<double> center, const SGDTrainerParameters& parameters);
+    template <typename ElementType, typename LossFunctionType>
+    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor<ElementType>>> MakeSparseDataCenteredSGDTrainer(const LossFunctionType& lossFunction, math::RowVector<ElementType> center, const SGDTrainerParameters& parameters);
 }
 }
 
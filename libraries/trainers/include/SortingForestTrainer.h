@@ -50,7 +50,7 @@ namespace trainers
         using typename ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::TrainerMetadata;
         using typename ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::PredictorType;
         using typename ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::DataVectorType;
-        using typename ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::TrainerExampleType;
+        using typename ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::TrainerDatasetType;
 
     protected:
         using ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::_dataset;
@@ -36,7 +36,6 @@ namespace trainers
     {
     public:
         using EvaluatingTrainerType = EvaluatingTrainer<PredictorType>;
-        using ExampleType = data::Example<typename PredictorType::DataVectorType, data::WeightLabel>;
 
         /// <summary> Constructs an instance of SweepingTrainer. </summary>
         ///
@@ -57,7 +56,6 @@ namespace trainers
         virtual const PredictorType& GetPredictor() const override;
 
     private:
-        data::Dataset<ExampleType> _dataset;
         std::vector<EvaluatingTrainerType> _evaluatingTrainers;
     };
 
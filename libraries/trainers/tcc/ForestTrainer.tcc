@@ -23,14 +23,13 @@ namespace trainers
     void ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::SetDataset(const data::AnyDataset& anyDataset)
     {
         // materialize a dataset of dense DataVectors with metadata that contains both strong and weak weight and lables for each example
-        _dataset = data::Dataset<TrainerExampleType>(anyDataset);
+        _dataset = TrainerDatasetType(anyDataset);
 
         // initalizes the special fields in the dataset metadata: weak weight and label, currentOutput
         for (size_t rowIndex = 0; rowIndex < _dataset.NumExamples(); ++rowIndex)
         {
-            auto& example = _dataset[rowIndex];
-            auto prediction = _forest.Predict(example.GetDataVector());
-            auto& metadata = example.GetMetadata();
+            auto prediction = _forest.Predict(_dataset.GetDataVector(rowIndex));
+            auto& metadata = _dataset.GetMetadata(rowIndex);
             metadata.currentOutput = prediction;
             metadata.weak = _booster.GetWeakWeightLabel(metadata.strong, prediction);
         }
@@ -88,7 +87,7 @@ namespace trainers
 
         for (size_t rowIndex = 0; rowIndex < _dataset.NumExamples(); ++rowIndex)
         {
-            auto& metadata = _dataset[rowIndex].GetMetadata();
+            auto& metadata = _dataset.GetMetadata(rowIndex);
             metadata.weak = _booster.GetWeakWeightLabel(metadata.strong, metadata.currentOutput);
             sums.Increment(metadata.weak);
         }
@@ -106,8 +105,7 @@ namespace trainers
     {
         for (size_t rowIndex = 0; rowIndex < _dataset.NumExamples(); ++rowIndex)
         {
-            auto& example = _dataset[rowIndex];
-            example.GetMetadata().currentOutput += value;
+            _dataset.GetMetadata(rowIndex).currentOutput += value;
         }
     }
 
@@ -116,8 +114,7 @@ namespace trainers
     {
         for (size_t rowIndex = range.firstIndex; rowIndex < range.firstIndex + range.size; ++rowIndex)
         {
-            auto& example = _dataset[rowIndex];
-            example.GetMetadata().currentOutput += edgePredictor.Predict(example.GetDataVector());
+            _dataset.GetMetadata(rowIndex).currentOutput += edgePredictor.Predict(_dataset.GetDataVector(rowIndex));
         }
     }
 
@@ -181,13 +178,13 @@ namespace trainers
     {
         if (splitRule.NumOutputs() == 2)
         {
-            _dataset.Partition([splitRule](const data::Example<DataVectorType, TrainerMetadata>& example) { return splitRule.Predict(example.GetDataVector()) == 0; },
+            _dataset.Partition([splitRule](const typename TrainerDatasetType::ExampleReference& example) { return splitRule.Predict(example.GetDataVector()) == 0; },
                                range.firstIndex,
                                range.size);
         }
         else
         {
-            _dataset.Sort([splitRule](const data::Example<DataVectorType, TrainerMetadata>& example) { return splitRule.Predict(example.GetDataVector()); },
+            _dataset.Sort([splitRule](const typename TrainerDatasetType::ExampleReference& example) { return splitRule.Predict(example.GetDataVector()); },
                           range.firstIndex,
                           range.size);
         }
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     OnlineTrainer.tcc (trainers)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// utilities
+#include "Exception.h"
+
+// stl
+#include <utility>
+
+namespace ell
+{
+namespace trainers
+{
+    namespace OnlineTrainerImpl
+    {
+        // only the SGD trainers keep their state when SetDataset() replaces their dataset
+        template <typename PredictorType>
+        bool IsIncrementalTrainer(const ITrainer<PredictorType>* trainer)
+        {
+            return false;
+        }
+
+        template <typename ElementType>
+        bool IsIncrementalTrainer(const ITrainer<predictors::LinearPredictor<ElementType>>* trainer)
+        {
+            return dynamic_cast<const SGDTrainerBase<ElementType>*>(trainer) != nullptr;
+        }
+    }
+
+    template <typename PredictorType>
+    OnlineTrainer<PredictorType>::OnlineTrainer(std::unique_ptr<InternalTrainerType>&& internalTrainer, const OnlineTrainerParameters& parameters)
+        : _internalTrainer(std::move(internalTrainer)), _parameters(parameters), _numSnapshots(0)
+    {
+        if (_internalTrainer == nullptr)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::nullReference, "online trainer requires an internal trainer");
+        }
+        if (!OnlineTrainerImpl::IsIncrementalTrainer(_internalTrainer.get()))
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "online trainer requires an SGD trainer, which keeps its state from one batch to the next");
+        }
+        if (_parameters.batchSize == 0 || _parameters.publishPeriod == 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "batch size and publish period must be positive");
+        }
+        Publish();
+    }
+
+    template <typename PredictorType>
+    void OnlineTrainer<PredictorType>::AddExample(const data::AutoSupervisedExample& example)
+    {
+        // copying the example shares its data vector
+        _batch.AddExample(example);
+        if (_batch.NumExamples() < _parameters.batchSize)
+        {
+            return;
+        }
+
+        UpdateInternalTrainer();
+        if (_numUpdatesSincePublish >= _parameters.publishPeriod)
+        {
+            Publish();
+        }
+    }
+
+    template <typename PredictorType>
+    void OnlineTrainer<PredictorType>::Flush()
+    {
+        if (_batch.NumExamples() > 0)
+        {
+            UpdateInternalTrainer();
+        }
+        Publish();
+    }
+
+    template <typename PredictorType>
+    void OnlineTrainer<PredictorType>::UpdateInternalTrainer()
+    {
+        _internalTrainer->SetDataset(_batch.GetAnyDataset());
+        _internalTrainer->Update();
+        ++_numUpdatesSincePublish;
+
+        // trainers build their own view of the dataset in SetDataset(), which shares the data vectors, so the batch can be discarded
+        _batch = data::AutoSupervisedDataset();
+    }
+
+    template <typename PredictorType>
+    void OnlineTrainer<PredictorType>::Publish()
+    {
+        // the copy is made on the training thread, readers only ever see the completed snapshot and
+        // contend with this store only for the pointer swap
+        auto snapshot = std::make_shared<const PredictorType>(_internalTrainer->GetPredictor());
+        std::atomic_store(&_snapshot, std::shared_ptr<const PredictorType>(std::move(snapshot)));
+        _numUpdatesSincePublish = 0;
+        ++_numSnapshots;
+    }
+}
+}
@@ -15,19 +15,19 @@ namespace ell
 {
 namespace trainers
 {
-    template<typename LossFunctionType, typename RegularizerType>
-    SDCATrainer<LossFunctionType, RegularizerType>::SDCATrainer(const LossFunctionType& lossFunction, const RegularizerType& regularizer, const SDCATrainerParameters& parameters)
+    template<typename ElementType, typename LossFunctionType, typename RegularizerType>
+    SDCATrainer<ElementType, LossFunctionType, RegularizerType>::SDCATrainer(const LossFunctionType& lossFunction, const RegularizerType& regularizer, const SDCATrainerParameters& parameters)
     : _lossFunction(lossFunction), _regularizer(regularizer), _parameters(parameters)
     {
         _random = utilities::GetRandomEngine(parameters.randomSeedString);
     }
 
-    template<typename LossFunctionType, typename RegularizerType>
-    void SDCATrainer<LossFunctionType, RegularizerType>::SetDataset(const data::AnyDataset& anyDataset)
+    template<typename ElementType, typename LossFunctionType, typename RegularizerType>
+    void SDCATrainer<ElementType, LossFunctionType, RegularizerType>::SetDataset(const data::AnyDataset& anyDataset)
     {
         DEBUG_THROW(_v.Norm0() != 0, utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "can only call SetDataset before updates"));
 
-        _dataset = data::Dataset<TrainerExampleType>(anyDataset);
+        _dataset = data::DatasetView<DataVectorType, TrainerMetadata>(anyDataset);
         auto numExamples = _dataset.NumExamples();
         _inverseScaledRegularization = 1.0 / (numExamples * _parameters.regularization);
 
@@ -37,16 +37,16 @@ namespace trainers
         // precompute the norm of each example
         for (size_t rowIndex = 0; rowIndex < numExamples; ++rowIndex)
         {
-            auto& example = _dataset[rowIndex];
-            example.GetMetadata().norm2Squared = example.GetDataVector().Norm2Squared();
+            auto& metadata = _dataset.GetMetadata(rowIndex);
+            metadata.norm2Squared = _dataset.GetDataVector(rowIndex).Norm2Squared();
 
-            auto label = example.GetMetadata().weightLabel.label;
+            auto label = metadata.weightLabel.label;
             _predictorInfo.primalObjective += _lossFunction(0, label) / numExamples;
         }
     }
 
-    template<typename LossFunctionType, typename RegularizerType>
-    void SDCATrainer<LossFunctionType, RegularizerType>::Update() 
+    template<typename ElementType, typename LossFunctionType, typename RegularizerType>
+    void SDCATrainer<ElementType, LossFunctionType, RegularizerType>::Update() 
     {
         if (_parameters.permute)
         {
@@ -56,27 +56,26 @@ namespace trainers
         // Iterate
         for (size_t i = 0; i < _dataset.NumExamples(); ++i)
         {
-            Step(_dataset[i]);
+            Step(_dataset.GetDataVector(i), _dataset.GetMetadata(i));
         }
 
         // Finish
         ComputeObjectives();
     }
 
-    template<typename LossFunctionType, typename RegularizerType>
-    SDCATrainer<LossFunctionType, RegularizerType>::TrainerMetadata::TrainerMetadata(const data::WeightLabel& original) : weightLabel(original)
+    template<typename ElementType, typename LossFunctionType, typename RegularizerType>
+    SDCATrainer<ElementType, LossFunctionType, RegularizerType>::TrainerMetadata::TrainerMetadata(const data::WeightLabel& original) : weightLabel(original)
     {}
 
-    template<typename LossFunctionType, typename RegularizerType>
-    void SDCATrainer<LossFunctionType, RegularizerType>::Step(TrainerExampleType& example)
+    template<typename ElementType, typename LossFunctionType, typename RegularizerType>
+    void SDCATrainer<ElementType, LossFunctionType, RegularizerType>::Step(const DataVectorType& dataVector, TrainerMetadata& metadata)
     {
-        const auto& dataVector = example.GetDataVector();
         ResizeTo(dataVector);
 
-        auto weightLabel = example.GetMetadata().weightLabel;
-        auto norm2Squared = example.GetMetadata().norm2Squared + 1; // add one because of bias term
+        auto weightLabel = metadata.weightLabel;
+        auto norm2Squared = metadata.norm2Squared + 1; // add one because of bias term
         auto lipschitz = norm2Squared * _inverseScaledRegularization;
-        auto dual = example.GetMetadata().dualVariable; 
+        auto dual = metadata.dualVariable; 
 
         if (lipschitz > 0)
         {
@@ -90,13 +89,13 @@ namespace trainers
                 _v.Transpose() += (-dualDiff * _inverseScaledRegularization) * dataVector;
                 _d += (-dualDiff * _inverseScaledRegularization);
                 _regularizer.ConjugateGradient(_v, _d, _predictor.GetWeights(), _predictor.GetBias());
-                example.GetMetadata().dualVariable = newDual;
+                metadata.dualVariable = newDual;
             }
         }
     }
 
-    template<typename LossFunctionType, typename RegularizerType>
-    void SDCATrainer<LossFunctionType, RegularizerType>::ComputeObjectives()
+    template<typename ElementType, typename LossFunctionType, typename RegularizerType>
+    void SDCATrainer<ElementType, LossFunctionType, RegularizerType>::ComputeObjectives()
     {
         double invSize = 1.0 / _dataset.NumExamples();
 
@@ -105,10 +104,10 @@ namespace trainers
 
         for (size_t i = 0; i < _dataset.NumExamples(); ++i)
         {
-            const auto& example = _dataset.GetExample(i);
-            auto label = example.GetMetadata().weightLabel.label;
-            auto prediction = _predictor.Predict(example.GetDataVector());
-            auto dualVariable = example.GetMetadata().dualVariable;
+            const auto& metadata = _dataset.GetMetadata(i);
+            auto label = metadata.weightLabel.label;
+            auto prediction = _predictor.Predict(_dataset.GetDataVector(i));
+            auto dualVariable = metadata.dualVariable;
 
             _predictorInfo.primalObjective += invSize * _lossFunction(prediction, label);
             _predictorInfo.dualObjective -= invSize * _lossFunction.Conjugate(dualVariable, label);
@@ -118,8 +117,8 @@ namespace trainers
         _predictorInfo.dualObjective -= _parameters.regularization * _regularizer.Conjugate(_v, _d);
     }
 
-    template<typename LossFunctionType, typename RegularizerType>
-    void SDCATrainer<LossFunctionType, RegularizerType>::ResizeTo(const data::AutoDataVector& x)
+    template<typename ElementType, typename LossFunctionType, typename RegularizerType>
+    void SDCATrainer<ElementType, LossFunctionType, RegularizerType>::ResizeTo(const data::AutoDataVector& x)
     {
         auto xSize = x.PrefixLength();
         if (xSize > _predictor.Size())
@@ -129,10 +128,10 @@ namespace trainers
         }
     }
 
-    template <typename LossFunctionType, typename RegularizerType>
-    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor>> MakeSDCATrainer(const LossFunctionType& lossFunction, const RegularizerType& regularizer, const SDCATrainerParameters& parameters)
+    template <typename ElementType, typename LossFunctionType, typename RegularizerType>
+    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor<ElementType>>> MakeSDCATrainer(const LossFunctionType& lossFunction, const RegularizerType& regularizer, const SDCATrainerParameters& parameters)
     {
-        return std::make_unique<SDCATrainer<LossFunctionType, RegularizerType>>(lossFunction, regularizer, parameters);
+        return std::make_unique<SDCATrainer<ElementType, LossFunctionType, RegularizerType>>(lossFunction, regularizer, parameters);
     }
 }
 }
\ No newline at end of file
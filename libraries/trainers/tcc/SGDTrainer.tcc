@@ -7,8 +7,11 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // stl
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <numeric>
+#include <random>
 
 // data
 #include "DataVector.h"
@@ -21,24 +24,151 @@ namespace trainers
 {
     // the code in this file follows the notation and pseudocode in https://arxiv.org/abs/1612.09147
 
+    //
+    // SGDTrainerEpochs
+    //
+
+    template <typename ElementType, typename TrainerType>
+    void SGDTrainerEpochs<ElementType, TrainerType>::SetDataset(const data::AnyDataset& anyDataset)
+    {
+        _arenaDataset = nullptr;
+        _binaryDataset = nullptr;
+        _byteQuantizedDataset = nullptr;
+        _shortQuantizedDataset = nullptr;
+        if (SetRowDataset(anyDataset, _arenaDataset) || SetRowDataset(anyDataset, _binaryDataset) || SetRowDataset(anyDataset, _byteQuantizedDataset) || SetRowDataset(anyDataset, _shortQuantizedDataset))
+        {
+            _dataset = data::DatasetView<data::AutoDataVector, data::WeightLabel>();
+            return;
+        }
+
+        _rows.clear();
+        _dataset = data::DatasetView<data::AutoDataVector, data::WeightLabel>(anyDataset);
+    }
+
+    template <typename ElementType, typename TrainerType>
+    void SGDTrainerEpochs<ElementType, TrainerType>::Update()
+    {
+        if (_arenaDataset != nullptr)
+        {
+            UpdateRows(*_arenaDataset);
+            return;
+        }
+        if (_binaryDataset != nullptr)
+        {
+            UpdateRows(*_binaryDataset);
+            return;
+        }
+        if (_byteQuantizedDataset != nullptr)
+        {
+            UpdateRows(*_byteQuantizedDataset);
+            return;
+        }
+        if (_shortQuantizedDataset != nullptr)
+        {
+            UpdateRows(*_shortQuantizedDataset);
+            return;
+        }
+
+        // permute the data
+        _dataset.RandomPermute(this->_random);
+
+        // get example iterator
+        auto exampleIterator = _dataset.GetExampleIterator();
+        DoEpoch(exampleIterator);
+    }
+
+    template <typename ElementType, typename TrainerType>
+    void SGDTrainerEpochs<ElementType, TrainerType>::Update(data::AutoSupervisedExampleIterator exampleIterator)
+    {
+        DoEpoch(exampleIterator);
+    }
+
+    template <typename ElementType, typename TrainerType>
+    template <typename ExampleIteratorType>
+    void SGDTrainerEpochs<ElementType, TrainerType>::DoEpoch(ExampleIteratorType& exampleIterator)
+    {
+        while (exampleIterator.IsValid())
+        {
+            auto example = exampleIterator.Get();
+            DoStep(example.GetDataVector(), example.GetMetadata());
+            exampleIterator.Next();
+        }
+    }
+
+    template <typename ElementType, typename TrainerType>
+    template <typename DataVectorType>
+    void SGDTrainerEpochs<ElementType, TrainerType>::DoStep(const DataVectorType& x, const data::WeightLabel& weightLabel)
+    {
+        auto& trainer = static_cast<TrainerType&>(*this);
+
+        // first iteration handled separately
+        if (_firstIteration)
+        {
+            trainer.FirstStep(x, weightLabel.label, weightLabel.weight);
+            _firstIteration = false;
+        }
+        else
+        {
+            trainer.NextStep(x, weightLabel.label, weightLabel.weight);
+        }
+    }
+
+    template <typename ElementType, typename TrainerType>
+    template <typename DatasetType>
+    bool SGDTrainerEpochs<ElementType, TrainerType>::SetRowDataset(const data::AnyDataset& anyDataset, const DatasetType*& rowDataset)
+    {
+        rowDataset = anyDataset.GetDataset<DatasetType>();
+        if (rowDataset == nullptr)
+        {
+            return false;
+        }
+
+        auto fromIndex = anyDataset.GetFromIndex();
+        auto size = anyDataset.NumExamples();
+        auto endIndex = (size == 0 || fromIndex + size > rowDataset->NumExamples()) ? rowDataset->NumExamples() : fromIndex + size;
+        _rows.resize(endIndex - fromIndex);
+        std::iota(_rows.begin(), _rows.end(), fromIndex);
+        return true;
+    }
+
+    template <typename ElementType, typename TrainerType>
+    template <typename DatasetType>
+    void SGDTrainerEpochs<ElementType, TrainerType>::UpdateRows(const DatasetType& rowDataset)
+    {
+        // permute the rows the same way that DatasetView::RandomPermute permutes its examples
+        auto numRows = _rows.size();
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            std::uniform_int_distribution<size_t> dist(i, numRows - 1);
+            std::swap(_rows[i], _rows[dist(this->_random)]);
+        }
+
+        for (auto index : _rows)
+        {
+            DoStep(rowDataset.GetRow(index), rowDataset.GetMetadata(index));
+        }
+    }
+
     //
     // SGDTrainer
     //
 
-    template <typename LossFunctionType>
-    SGDTrainer<LossFunctionType>::SGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters)
-        : SGDTrainerBase(parameters.randomSeedString), _lossFunction(lossFunction), _parameters(parameters)
+    template <typename ElementType, typename LossFunctionType>
+    SGDTrainer<ElementType, LossFunctionType>::SGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters)
+        : SGDTrainerEpochs<ElementType, SGDTrainer<ElementType, LossFunctionType>>(parameters.randomSeedString), _lossFunction(lossFunction), _parameters(parameters)
     {
     }
 
-    template<typename LossFunctionType>
-    void SGDTrainer<LossFunctionType>::DoFirstStep(const data::AutoDataVector& x, double y, double weight)
+    template <typename ElementType, typename LossFunctionType>
+    template <typename DataVectorType>
+    void SGDTrainer<ElementType, LossFunctionType>::FirstStep(const DataVectorType& x, double y, double weight)
     {
-        DoNextStep(x, y, weight);
+        NextStep(x, y, weight);
     }
 
-    template<typename LossFunctionType>
-    void SGDTrainer<LossFunctionType>::DoNextStep(const data::AutoDataVector& x, double y, double weight)
+    template <typename ElementType, typename LossFunctionType>
+    template <typename DataVectorType>
+    void SGDTrainer<ElementType, LossFunctionType>::NextStep(const DataVectorType& x, double y, double weight)
     {
         ResizeTo(x);
         ++_t;
@@ -51,7 +181,7 @@ namespace trainers
 
         // get abbreviated names
         auto& lastW = _lastPredictor.GetWeights();
-        double& lastB = _lastPredictor.GetBias();
+        auto& lastB = _lastPredictor.GetBias();
 
         // update the (last) predictor
         double scaleCoefficient = 1.0 - 1.0 / _t;
@@ -65,7 +195,7 @@ namespace trainers
 
         // get abbreviated names
         auto& averagedW = _averagedPredictor.GetWeights();
-        double& averagedB = _averagedPredictor.GetBias();
+        auto& averagedB = _averagedPredictor.GetBias();
 
         // update the average predictor
         averagedW *= scaleCoefficient;
@@ -75,8 +205,8 @@ namespace trainers
         averagedB += lastB / _t;
     }
 
-    template <typename LossFunctionType>
-    void SGDTrainer<LossFunctionType>::ResizeTo(const data::AutoDataVector& x)
+    template <typename ElementType, typename LossFunctionType>
+    void SGDTrainer<ElementType, LossFunctionType>::ResizeTo(const data::IDataVector& x)
     {
         auto xSize = x.PrefixLength();
         if (xSize > _lastPredictor.Size())
@@ -90,14 +220,15 @@ namespace trainers
     // SparseDataSGDTrainer
     // 
 
-    template<typename LossFunctionType>
-    SparseDataSGDTrainer<LossFunctionType>::SparseDataSGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters)
-        : SGDTrainerBase(parameters.randomSeedString), _lossFunction(lossFunction), _parameters(parameters)
+    template<typename ElementType, typename LossFunctionType>
+    SparseDataSGDTrainer<ElementType, LossFunctionType>::SparseDataSGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters)
+        : SGDTrainerEpochs<ElementType, SparseDataSGDTrainer<ElementType, LossFunctionType>>(parameters.randomSeedString), _lossFunction(lossFunction), _parameters(parameters)
     {
     }
 
-    template<typename LossFunctionType>
-    void SparseDataSGDTrainer<LossFunctionType>::DoFirstStep(const data::AutoDataVector& x, double y, double weight)
+    template <typename ElementType, typename LossFunctionType>
+    template <typename DataVectorType>
+    void SparseDataSGDTrainer<ElementType, LossFunctionType>::FirstStep(const DataVectorType& x, double y, double weight)
     {
         ResizeTo(x);
         _t = 1.0;
@@ -108,8 +239,9 @@ namespace trainers
         _h = 1.0;
     }
 
-    template<typename LossFunctionType>
-    void SparseDataSGDTrainer<LossFunctionType>::DoNextStep(const data::AutoDataVector& x, double y, double weight)
+    template <typename ElementType, typename LossFunctionType>
+    template <typename DataVectorType>
+    void SparseDataSGDTrainer<ElementType, LossFunctionType>::NextStep(const DataVectorType& x, double y, double weight)
     {
         ResizeTo(x);
         ++_t;
@@ -130,8 +262,8 @@ namespace trainers
         _h += 1.0 / _t;
     }
 
-    template<typename LossFunctionType>
-    auto SparseDataSGDTrainer<LossFunctionType>::GetLastPredictor() const -> const PredictorType&
+    template<typename ElementType, typename LossFunctionType>
+    auto SparseDataSGDTrainer<ElementType, LossFunctionType>::GetLastPredictor() const -> const PredictorType&
     {
         const double lambda = _parameters.regularization;
         _lastPredictor.Resize(_v.Size());
@@ -140,8 +272,8 @@ namespace trainers
         return _lastPredictor;
     }
 
-    template<typename LossFunctionType>
-    auto SparseDataSGDTrainer<LossFunctionType>::GetAveragedPredictor() const -> const PredictorType&
+    template<typename ElementType, typename LossFunctionType>
+    auto SparseDataSGDTrainer<ElementType, LossFunctionType>::GetAveragedPredictor() const -> const PredictorType&
     {
         const double lambda = _parameters.regularization;
         _averagedPredictor.Resize(_v.Size());
@@ -151,8 +283,8 @@ namespace trainers
         return _averagedPredictor;
     }
 
-    template <typename LossFunctionType>
-    inline void SparseDataSGDTrainer<LossFunctionType>::ResizeTo(const data::AutoDataVector& x)
+    template <typename ElementType, typename LossFunctionType>
+    inline void SparseDataSGDTrainer<ElementType, LossFunctionType>::ResizeTo(const data::IDataVector& x)
     {
         auto xSize = x.PrefixLength();
         if (xSize > _v.Size())
@@ -166,15 +298,16 @@ namespace trainers
     // SparseDataCenteredSGDTrainer
     // 
 
-    template<typename LossFunctionType>
-    SparseDataCenteredSGDTrainer<LossFunctionType>::SparseDataCenteredSGDTrainer(const LossFunctionType& lossFunction, math::RowVector<double> center, const SGDTrainerParameters& parameters)
-        : SGDTrainerBase(parameters.randomSeedString), _lossFunction(lossFunction), _parameters(parameters), _center(std::move(center))
+    template<typename ElementType, typename LossFunctionType>
+    SparseDataCenteredSGDTrainer<ElementType, LossFunctionType>::SparseDataCenteredSGDTrainer(const LossFunctionType& lossFunction, math::RowVector<ElementType> center, const SGDTrainerParameters& parameters)
+        : SGDTrainerEpochs<ElementType, SparseDataCenteredSGDTrainer<ElementType, LossFunctionType>>(parameters.randomSeedString), _lossFunction(lossFunction), _parameters(parameters), _center(std::move(center))
     {
         _theta = 1 + _center.Norm2Squared();
     }
 
-    template<typename LossFunctionType>
-    void SparseDataCenteredSGDTrainer<LossFunctionType>::DoFirstStep(const data::AutoDataVector& x, double y, double weight) 
+    template <typename ElementType, typename LossFunctionType>
+    template <typename DataVectorType>
+    void SparseDataCenteredSGDTrainer<ElementType, LossFunctionType>::FirstStep(const DataVectorType& x, double y, double weight)
     {
         ResizeTo(x);
         _t = 1.0;
@@ -193,8 +326,9 @@ namespace trainers
         _s = _r;
     }
 
-    template<typename LossFunctionType>
-    void SparseDataCenteredSGDTrainer<LossFunctionType>::DoNextStep(const data::AutoDataVector& x, double y, double weight) 
+    template <typename ElementType, typename LossFunctionType>
+    template <typename DataVectorType>
+    void SparseDataCenteredSGDTrainer<ElementType, LossFunctionType>::NextStep(const DataVectorType& x, double y, double weight)
     { 
         ResizeTo(x);
         ++_t;
@@ -221,8 +355,8 @@ namespace trainers
         _s += _r / _t;
     }
 
-    template<typename LossFunctionType>
-    auto SparseDataCenteredSGDTrainer<LossFunctionType>::GetLastPredictor() const -> const PredictorType&
+    template<typename ElementType, typename LossFunctionType>
+    auto SparseDataCenteredSGDTrainer<ElementType, LossFunctionType>::GetLastPredictor() const -> const PredictorType&
     {
         const double lambda = _parameters.regularization;
         _lastPredictor.Resize(_v.Size());
@@ -231,8 +365,8 @@ namespace trainers
         return _lastPredictor;
     }
 
-    template<typename LossFunctionType>
-    auto SparseDataCenteredSGDTrainer<LossFunctionType>::GetAveragedPredictor() const -> const PredictorType&
+    template<typename ElementType, typename LossFunctionType>
+    auto SparseDataCenteredSGDTrainer<ElementType, LossFunctionType>::GetAveragedPredictor() const -> const PredictorType&
     {
         const double lambda = _parameters.regularization;
         const double coeff = 1.0 / (lambda * _t);
@@ -245,8 +379,8 @@ namespace trainers
         return _averagedPredictor;
     }
 
-    template <typename LossFunctionType>
-    inline void SparseDataCenteredSGDTrainer<LossFunctionType>::ResizeTo(const data::AutoDataVector& x)
+    template <typename ElementType, typename LossFunctionType>
+    inline void SparseDataCenteredSGDTrainer<ElementType, LossFunctionType>::ResizeTo(const data::IDataVector& x)
     {
         auto xSize = x.PrefixLength();
         if (xSize > _v.Size())
@@ -260,22 +394,22 @@ namespace trainers
     // Helper functions
     //
 
-    template <typename LossFunctionType>
-    std::unique_ptr<ITrainer<predictors::LinearPredictor>> MakeSGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters)
+    template <typename ElementType, typename LossFunctionType>
+    std::unique_ptr<ITrainer<predictors::LinearPredictor<ElementType>>> MakeSGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters)
     {
-        return std::make_unique<SGDTrainer<LossFunctionType>>(lossFunction, parameters);
+        return std::make_unique<SGDTrainer<ElementType, LossFunctionType>>(lossFunction, parameters);
     }
 
-    template <typename LossFunctionType>
-    std::unique_ptr<ITrainer<predictors::LinearPredictor>> MakeSparseDataSGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters)
+    template <typename ElementType, typename LossFunctionType>
+    std::unique_ptr<ITrainer<predictors::LinearPredictor<ElementType>>> MakeSparseDataSGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters)
     {
-        return std::make_unique<SparseDataSGDTrainer<LossFunctionType>>(lossFunction, parameters);
+        return std::make_unique<SparseDataSGDTrainer<ElementType, LossFunctionType>>(lossFunction, parameters);
     }
 
-    template <typename LossFunctionType>
-    std::unique_ptr<ITrainer<predictors::LinearPredictor>> MakeSparseDataCenteredSGDTrainer(const LossFunctionType& lossFunction, math::RowVector<double> center, const SGDTrainerParameters& parameters)
+    template <typename ElementType, typename LossFunctionType>
+    std::unique_ptr<ITrainer<predictors::LinearPredictor<ElementType>>> MakeSparseDataCenteredSGDTrainer(const LossFunctionType& lossFunction, math::RowVector<ElementType> center, const SGDTrainerParameters& parameters)
     {
-        return std::make_unique<SparseDataCenteredSGDTrainer<LossFunctionType>>(lossFunction, std::move(center), parameters);
+        return std::make_unique<SparseDataCenteredSGDTrainer<ElementType, LossFunctionType>>(lossFunction, std::move(center), parameters);
     }
 }
 }
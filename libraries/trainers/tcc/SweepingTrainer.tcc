@@ -20,7 +20,10 @@ namespace trainers
     template <typename PredictorType>
     void SweepingTrainer<PredictorType>::SetDataset(const data::AnyDataset& anyDataset)
     {
-        _dataset = data::Dataset<ExampleType>(anyDataset);
+        for (auto& evaluatingTrainer : _evaluatingTrainers)
+        {
+            evaluatingTrainer.SetDataset(anyDataset);
+        }
     }
 
     template <typename PredictorType>
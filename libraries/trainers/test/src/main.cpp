@@ -10,15 +10,32 @@
 #include "MakeTrainer.h"
 
 // data
+#include "ArenaDataset.h"
+#include "BinaryDataset.h"
 #include "Dataset.h"
+#include "PrefetchingExampleIterator.h"
+#include "QuantizedDataset.h"
+
+// functions
+#include "LogLoss.h"
 
 // trainers
 #include "SDCATrainer.h"
+#include "SGDTrainer.h"
 #include "MeanCalculator.h"
+#include "OnlineTrainer.h"
 
 // utilities
 #include "testing.h"
 
+// stl
+#include <atomic>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace ell;
 
 /// Runs all tests
@@ -46,6 +63,165 @@ void TestSDCATrainer()
     return;
 }
 
+void TestFloatSGDTrainer()
+{
+    data::AutoSupervisedDataset dataset;
+    dataset.AddExample({ { 1.0, 0.0, 2.0, 0.0, 3.0 },{ 1.0, 1.0 } });
+    dataset.AddExample({ { 0.0, 4.0, 5.0, 6.0, 7.0 },{ 1.0, -1.0 } });
+    dataset.AddExample({ { 8.0, 0.0, 9.0 },{ 1.0, 1.0 } });
+    dataset.AddExample({ { 0.0, 10.0 },{ 1.0, -1.0 } });
+
+    auto doubleTrainer = trainers::MakeSGDTrainer<double>(functions::LogLoss(), { 1.0e-2, "XYZ" });
+    auto floatTrainer = trainers::MakeSGDTrainer<float>(functions::LogLoss(), { 1.0e-2, "XYZ" });
+    doubleTrainer->SetDataset(dataset.GetAnyDataset());
+    floatTrainer->SetDataset(dataset.GetAnyDataset());
+    for (int epoch = 0; epoch < 5; ++epoch)
+    {
+        doubleTrainer->Update();
+        floatTrainer->Update();
+    }
+
+    // both trainers see the examples in the same order, so the float predictor should match the double predictor up to rounding
+    const auto& doublePredictor = doubleTrainer->GetPredictor();
+    const auto& floatPredictor = floatTrainer->GetPredictor();
+    bool isClose = doublePredictor.Size() == floatPredictor.Size() && testing::IsEqual(static_cast<float>(doublePredictor.GetBias()), floatPredictor.GetBias(), 1.0e-4f);
+    for (size_t i = 0; i < floatPredictor.Size(); ++i)
+    {
+        isClose = isClose && testing::IsEqual(static_cast<float>(doublePredictor.GetWeights()[i]), floatPredictor.GetWeights()[i], 1.0e-4f);
+    }
+    testing::ProcessTest("TestFloatSGDTrainer", isClose);
+}
+
+void TestArenaSGDTrainer()
+{
+    data::AutoSupervisedDataset dataset;
+    dataset.AddExample({ { 1.0, 0.0, 2.0, 0.0, 3.0 },{ 1.0, 1.0 } });
+    dataset.AddExample({ { 0.0, 4.0, 5.0, 6.0, 7.0 },{ 1.0, -1.0 } });
+    dataset.AddExample({ { 8.0, 0.0, 9.0 },{ 1.0, 1.0 } });
+    dataset.AddExample({ { 0.0, 10.0 },{ 1.0, -1.0 } });
+    data::ArenaDataset arenaDataset(dataset.GetExampleIterator());
+
+    // the trainer reads the arena rows in place, and sees the examples in the same order as the in-memory dataset
+    trainers::SGDTrainer<double, functions::LogLoss> trainer(functions::LogLoss(), { 1.0e-2, "XYZ" });
+    trainers::SGDTrainer<double, functions::LogLoss> arenaTrainer(functions::LogLoss(), { 1.0e-2, "XYZ" });
+    trainers::SparseDataSGDTrainer<double, functions::LogLoss> sparseTrainer(functions::LogLoss(), { 1.0e-2, "XYZ" });
+    trainers::SparseDataSGDTrainer<double, functions::LogLoss> sparseArenaTrainer(functions::LogLoss(), { 1.0e-2, "XYZ" });
+    trainer.SetDataset(dataset.GetAnyDataset());
+    arenaTrainer.SetDataset(arenaDataset.GetAnyDataset());
+    sparseTrainer.SetDataset(dataset.GetAnyDataset());
+    sparseArenaTrainer.SetDataset(arenaDataset.GetAnyDataset());
+    for (int epoch = 0; epoch < 5; ++epoch)
+    {
+        trainer.Update();
+        arenaTrainer.Update();
+        sparseTrainer.Update();
+        sparseArenaTrainer.Update();
+    }
+
+    auto isEqual = [](const predictors::LinearPredictor<double>& a, const predictors::LinearPredictor<double>& b) {
+        return a.Size() == b.Size() && testing::IsEqual(a.GetBias(), b.GetBias()) && a.GetWeights() == b.GetWeights();
+    };
+    testing::ProcessTest("TestArenaSGDTrainer", isEqual(trainer.GetPredictor(), arenaTrainer.GetPredictor()) && isEqual(sparseTrainer.GetPredictor(), sparseArenaTrainer.GetPredictor()));
+}
+
+void TestBinarySGDTrainer()
+{
+    data::AutoSupervisedDataset dataset;
+    dataset.AddExample({ { 1.0, 0.0, 2.0, 0.0, 3.0 },{ 1.0, 1.0 } });
+    dataset.AddExample({ { 0.0, 4.0, 5.0, 6.0, 7.0 },{ 1.0, -1.0 } });
+    dataset.AddExample({ { 8.0, 0.0, 9.0 },{ 1.0, 1.0 } });
+    dataset.AddExample({ { 0.0, 10.0 },{ 1.0, -1.0 } });
+
+    std::string filename = "binarySGDTrainerTest.bin";
+    {
+        std::ofstream stream(filename, std::ios::binary);
+        data::WriteBinaryDataset(stream, dataset.GetExampleIterator());
+    }
+    data::BinaryDataset binaryDataset(filename);
+
+    // the trainer reads the rows of the mapped file in place, and sees the examples in the same order as the in-memory dataset
+    trainers::SGDTrainer<double, functions::LogLoss> trainer(functions::LogLoss(), { 1.0e-2, "XYZ" });
+    trainers::SGDTrainer<double, functions::LogLoss> binaryTrainer(functions::LogLoss(), { 1.0e-2, "XYZ" });
+    trainer.SetDataset(dataset.GetAnyDataset());
+    binaryTrainer.SetDataset(binaryDataset.GetAnyDataset());
+    for (int epoch = 0; epoch < 5; ++epoch)
+    {
+        trainer.Update();
+        binaryTrainer.Update();
+    }
+
+    const auto& predictor = trainer.GetPredictor();
+    const auto& binaryPredictor = binaryTrainer.GetPredictor();
+    testing::ProcessTest("TestBinarySGDTrainer", predictor.Size() == binaryPredictor.Size() && testing::IsEqual(predictor.GetBias(), binaryPredictor.GetBias()) && predictor.GetWeights() == binaryPredictor.GetWeights());
+}
+
+void TestQuantizedSGDTrainer()
+{
+    data::AutoSupervisedDataset dataset;
+    dataset.AddExample({ { 1.0, 0.0, 2.0, 0.0, 3.0 },{ 1.0, 1.0 } });
+    dataset.AddExample({ { 0.0, 4.0, 5.0, 6.0, 7.0 },{ 1.0, -1.0 } });
+    dataset.AddExample({ { 8.0, 0.0, 9.0 },{ 1.0, 1.0 } });
+    dataset.AddExample({ { 0.0, 10.0 },{ 1.0, -1.0 } });
+    data::ByteQuantizedDataset quantizedDataset(dataset.GetAnyDataset());
+    data::AutoSupervisedDataset dequantizedDataset(quantizedDataset.GetExampleIterator<data::AutoSupervisedExample>());
+
+    // the trainer reads the quantized rows in place, and learns the same predictor as from a dequantized copy
+    trainers::SGDTrainer<double, functions::LogLoss> trainer(functions::LogLoss(), { 1.0e-2, "XYZ" });
+    trainers::SGDTrainer<double, functions::LogLoss> quantizedTrainer(functions::LogLoss(), { 1.0e-2, "XYZ" });
+    trainers::SparseDataCenteredSGDTrainer<double, functions::LogLoss> centeredTrainer(functions::LogLoss(), math::RowVector<double>{ 1.0, 2.0, 3.0, 1.0, 2.0 }, { 1.0e-2, "XYZ" });
+    trainers::SparseDataCenteredSGDTrainer<double, functions::LogLoss> centeredQuantizedTrainer(functions::LogLoss(), math::RowVector<double>{ 1.0, 2.0, 3.0, 1.0, 2.0 }, { 1.0e-2, "XYZ" });
+    trainer.SetDataset(dequantizedDataset.GetAnyDataset());
+    quantizedTrainer.SetDataset(quantizedDataset.GetAnyDataset());
+    centeredTrainer.SetDataset(dequantizedDataset.GetAnyDataset());
+    centeredQuantizedTrainer.SetDataset(quantizedDataset.GetAnyDataset());
+    for (int epoch = 0; epoch < 5; ++epoch)
+    {
+        trainer.Update();
+        quantizedTrainer.Update();
+        centeredTrainer.Update();
+        centeredQuantizedTrainer.Update();
+    }
+
+    auto isEqual = [](const predictors::LinearPredictor<double>& a, const predictors::LinearPredictor<double>& b) {
+        bool isClose = a.Size() == b.Size() && testing::IsEqual(a.GetBias(), b.GetBias());
+        for (size_t i = 0; isClose && i < a.Size(); ++i)
+        {
+            isClose = testing::IsEqual(a.GetWeights()[i], b.GetWeights()[i]);
+        }
+        return isClose;
+    };
+    testing::ProcessTest("TestQuantizedSGDTrainer", isEqual(trainer.GetPredictor(), quantizedTrainer.GetPredictor()) && isEqual(centeredTrainer.GetPredictor(), centeredQuantizedTrainer.GetPredictor()));
+}
+
+void TestStreamingSGDTrainer()
+{
+    data::AutoSupervisedDataset dataset;
+    dataset.AddExample({ { 1.0, 0.0, 2.0, 0.0, 3.0 },{ 1.0, 1.0 } });
+    dataset.AddExample({ { 0.0, 4.0, 5.0, 6.0, 7.0 },{ 1.0, -1.0 } });
+    dataset.AddExample({ { 8.0, 0.0, 9.0 },{ 1.0, 1.0 } });
+    dataset.AddExample({ { 0.0, 10.0 },{ 1.0, -1.0 } });
+
+    // the stream visits the examples in the order that the in-memory trainer permutes them to, with a generator seeded the same way
+    std::string randomSeedString = "XYZ";
+    std::seed_seq seed(randomSeedString.begin(), randomSeedString.end());
+    std::default_random_engine random(seed);
+    data::AutoSupervisedDataset permutedDataset(dataset.GetExampleIterator());
+
+    trainers::SGDTrainer<double, functions::LogLoss> trainer(functions::LogLoss(), { 1.0e-2, randomSeedString });
+    trainers::SGDTrainer<double, functions::LogLoss> streamingTrainer(functions::LogLoss(), { 1.0e-2, randomSeedString });
+    trainer.SetDataset(dataset.GetAnyDataset());
+    for (int epoch = 0; epoch < 5; ++epoch)
+    {
+        trainer.Update();
+        permutedDataset.RandomPermute(random);
+        streamingTrainer.Update(data::MakePrefetchingExampleIterator(permutedDataset.GetExampleIterator()));
+    }
+
+    const auto& predictor = trainer.GetPredictor();
+    const auto& streamingPredictor = streamingTrainer.GetPredictor();
+    testing::ProcessTest("TestStreamingSGDTrainer", predictor.Size() == streamingPredictor.Size() && testing::IsEqual(predictor.GetBias(), streamingPredictor.GetBias()) && predictor.GetWeights() == streamingPredictor.GetWeights());
+}
+
 void TestMeanCalculator()
 {
     data::AutoSupervisedDataset dataset;
@@ -60,8 +236,122 @@ void TestMeanCalculator()
     testing::ProcessTest("TestMeanCalculator", mean == r);
 }
 
+void TestOnlineTrainer()
+{
+    auto internalTrainer = common::MakeSGDTrainer({ common::LossFunctionArguments::LossFunction::log }, { 1.0e-3, "XYZ" });
+    trainers::OnlineLinearTrainer trainer(std::move(internalTrainer), { 4, 2 });
+
+    // a serving thread keeps reading snapshots while the trainer learns
+    std::atomic<bool> isTraining(true);
+    bool snapshotsAreValid = true;
+    std::thread reader([&]() {
+        while (isTraining)
+        {
+            auto snapshot = trainer.GetSnapshot();
+            snapshotsAreValid = snapshotsAreValid && snapshot != nullptr && snapshot->Size() <= 3;
+        }
+    });
+
+    for (int i = 0; i < 100; ++i)
+    {
+        double label = (i % 2) ? 1.0 : -1.0;
+        trainer.AddExample({ { label, 0.5 * label, 1.0 }, { 1.0, label } });
+    }
+    trainer.Flush();
+    isTraining = false;
+    reader.join();
+
+    // one initial snapshot, one every 2 batches of 4 examples, and one on flush
+    testing::ProcessTest("TestOnlineTrainer snapshot count", trainer.NumSnapshots() == 1 + 12 + 1);
+    testing::ProcessTest("TestOnlineTrainer snapshots", snapshotsAreValid && trainer.GetSnapshot()->GetWeights()[0] > 0);
+
+    // SDCA can't take a new dataset after it has been updated, so it is rejected up front
+    bool isRejected = false;
+    try
+    {
+        trainers::OnlineLinearTrainer sdcaTrainer(common::MakeSDCATrainer({ common::LossFunctionArguments::LossFunction::log }, { 1.0e-4, 1.0e-8, 20, false, "XYZ" }), { 4, 2 });
+    }
+    catch (const utilities::InputException&)
+    {
+        isRejected = true;
+    }
+    testing::ProcessTest("TestOnlineTrainer rejects SDCA", isRejected);
+}
+
+void TestOnlineTrainerConcurrentReaders()
+{
+    auto internalTrainer = common::MakeSGDTrainer({ common::LossFunctionArguments::LossFunction::log }, { 1.0e-3, "XYZ" });
+    trainers::OnlineLinearTrainer trainer(std::move(internalTrainer), { 1, 1 });
+
+    // several serving threads read snapshots while a new one is published after every example; each
+    // reader holds on to its previous snapshot, which must not change or be freed while it is held
+    const int numReaders = 4;
+    std::atomic<int> numStartedReaders(0);
+    std::atomic<bool> isTraining(true);
+    std::vector<int> numDistinctSnapshots(numReaders, 0);
+    std::vector<int> numInvalidSnapshots(numReaders, 0);
+    std::vector<std::thread> readers;
+    for (int readerIndex = 0; readerIndex < numReaders; ++readerIndex)
+    {
+        readers.emplace_back([&, readerIndex]() {
+            auto previous = trainer.GetSnapshot();
+            auto previousBias = previous->GetBias();
+            ++numStartedReaders;
+            bool isLastRead = false;
+            while (!isLastRead)
+            {
+                isLastRead = !isTraining;
+                auto snapshot = trainer.GetSnapshot();
+                bool isValid = snapshot != nullptr && snapshot->Size() <= 3 && previous->GetBias() == previousBias;
+                if (!isValid)
+                {
+                    ++numInvalidSnapshots[readerIndex];
+                }
+                if (snapshot != previous)
+                {
+                    ++numDistinctSnapshots[readerIndex];
+                    previous = snapshot;
+                    previousBias = snapshot->GetBias();
+                }
+            }
+        });
+    }
+
+    // start training once every reader holds the initial snapshot
+    while (numStartedReaders < numReaders)
+    {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < 2000; ++i)
+    {
+        double label = (i % 2) ? 1.0 : -1.0;
+        trainer.AddExample({ { label, 0.5 * label, 1.0 }, { 1.0, label } });
+    }
+    trainer.Flush();
+    isTraining = false;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    // every reader started with the initial snapshot and finished with the final one
+    bool isValid = trainer.NumSnapshots() == 1 + 2000 + 1;
+    for (int readerIndex = 0; readerIndex < numReaders; ++readerIndex)
+    {
+        isValid = isValid && numInvalidSnapshots[readerIndex] == 0 && numDistinctSnapshots[readerIndex] >= 1;
+    }
+    testing::ProcessTest("TestOnlineTrainerConcurrentReaders", isValid);
+}
+
 int main()
 {
     TestSDCATrainer();
+    TestFloatSGDTrainer();
+    TestArenaSGDTrainer();
+    TestBinarySGDTrainer();
+    TestQuantizedSGDTrainer();
+    TestStreamingSGDTrainer();
     TestMeanCalculator();
+    TestOnlineTrainer();
+    TestOnlineTrainerConcurrentReaders();
 }
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BackgroundProducer.h (utilities)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ell
+{
+namespace utilities
+{
+    /// <summary>
+    /// Runs a producer function on a background thread and hands the items it produces to a
+    /// consumer through a bounded queue. The background thread waits while the queue is full, so at
+    /// most maxQueuedItems + 2 items exist at a time: the queued items, the item being produced and
+    /// the item held by the consumer. The items are containers, such as std::vector, and empty items
+    /// are not delivered. If the producer function throws, the contents it added to the item before
+    /// the exception are still delivered, and then the exception is rethrown to the consumer.
+    /// </summary>
+    ///
+    /// <typeparam name="ItemType"> The type of the items, a container with an empty() member. </typeparam>
+    template <typename ItemType>
+    class BackgroundProducer
+    {
+    public:
+        /// <summary>
+        /// A function that fills an empty item, and returns false once the source has no more items.
+        /// It runs on the background thread.
+        /// </summary>
+        using ProduceFunction = std::function<bool(ItemType&)>;
+
+        /// <summary> Starts the background thread. </summary>
+        ///
+        /// <param name="produce"> The producer function. </param>
+        /// <param name="maxQueuedItems"> The maximal number of items that wait in the queue for the consumer. </param>
+        BackgroundProducer(ProduceFunction produce, size_t maxQueuedItems);
+
+        BackgroundProducer(const BackgroundProducer&) = delete;
+
+        BackgroundProducer& operator=(const BackgroundProducer&) = delete;
+
+        /// <summary> Stops the background thread, discarding any items that were not taken. </summary>
+        ~BackgroundProducer();
+
+        /// <summary>
+        /// Waits for the next item and moves it out of the queue. Once all of the items were taken,
+        /// rethrows the exception of the producer function, if it threw one.
+        /// </summary>
+        ///
+        /// <param name="item"> The item that receives the next item. </param>
+        ///
+        /// <returns> true if an item was taken, false if the producer has no more items. </returns>
+        bool Take(ItemType& item);
+
+    private:
+        void Produce();
+
+        ProduceFunction _produce;
+        size_t _maxQueuedItems;
+
+        // shared with the background thread
+        std::mutex _mutex;
+        std::condition_variable _itemAvailable;
+        std::condition_variable _spaceAvailable;
+        std::deque<ItemType> _queue;
+        std::exception_ptr _exception;
+        bool _isDone = false;
+        bool _isStopping = false;
+
+        std::thread _thread;
+    };
+}
+}
+
+#include "../tcc/BackgroundProducer.tcc"
@@ -8,6 +8,9 @@
 
 #pragma once
 
+// stl
+#include <cstddef>
+
 namespace ell
 {
 namespace utilities
@@ -38,6 +41,25 @@ namespace utilities
     template <typename ValueType>
     ParseResult Parse(const char*& pStr, ValueType& value);
 
+    /// <summary>
+    /// Parses a run of whitespace-separated "index:value" pairs into preallocated arrays, and
+    /// advances the string pointer past the parsed pairs. Parsing stops successfully at the end of
+    /// the string, at a comment, or after capacity pairs have been parsed, and stops with an error
+    /// at the first entry that is not of the form "index:value", where the pointer is left.
+    /// </summary>
+    ///
+    /// <typeparam name="IndexType"> Type of the indices. </typeparam>
+    /// <typeparam name="ValueType"> Type of the values. </typeparam>
+    /// <param name="pStr"> The string pointer. </param>
+    /// <param name="indices"> The array that receives the indices. </param>
+    /// <param name="values"> The array that receives the values. </param>
+    /// <param name="capacity"> The number of elements in each of the arrays. </param>
+    /// <param name="count"> [out] The number of pairs parsed. </param>
+    ///
+    /// <returns> A Result. </returns>
+    template <typename IndexType, typename ValueType>
+    ParseResult ParseIndexValuePairs(const char*& pStr, IndexType* indices, ValueType* values, size_t capacity, size_t& count);
+
     /// <summary> Advances pStr until it points to a non-whitespace character. </summary>
     ///
     /// <param name="pStr"> The string pointer. </param>
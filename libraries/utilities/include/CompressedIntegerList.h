@@ -10,6 +10,7 @@
 
 // stl
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <vector>
 
@@ -18,11 +19,14 @@ namespace ell
 namespace utilities
 {
     /// <summary> A non-decreasing list of nonegative integers, with a forward Iterator, stored in a
-    /// compressed delta enconding. </summary>
+    /// compressed delta enconding. The deltas are stored in groups of four: each group starts with a
+    /// control byte, whose four 2-bit fields give the number of bytes (1, 2, 4, or 8) of each delta,
+    /// followed by the bytes of the deltas. This layout lets the iterator decode a whole group
+    /// without branching on the individual deltas. </summary>
     class CompressedIntegerList
     {
     public:
-        /// <summary> A read-only forward std::iterator for the CompressedIntegerList. </summary>
+        /// <summary> A read-only forward std::iterator for the CompressedIntegerList, which decodes one group (block) of integers at a time. </summary>
         class Iterator
         {
         public:
@@ -37,7 +41,7 @@ namespace utilities
             /// <summary> Query if this object input stream valid. </summary>
             ///
             /// <returns> true if it succeeds, false if it fails. </returns>
-            bool IsValid() const { return _iter < _end; }
+            bool IsValid() const { return _blockIndex < _blockSize; }
 
             /// <summary> Proceeds to the Next iterate. </summary>
             void Next();
@@ -45,18 +49,36 @@ namespace utilities
             /// <summary> Returns the value of the current iterate. </summary>
             ///
             /// <returns> An size_t. </returns>
-            size_t Get() const { return _value; }
+            size_t Get() const { return _block[_blockIndex]; }
+
+            /// <summary> Returns the decoded integers from the current iterate to the end of the current block. </summary>
+            ///
+            /// <returns> Pointer to GetBlockSize() integers, the first of which is the current iterate. </returns>
+            const size_t* GetBlock() const { return _block + _blockIndex; }
+
+            /// <summary> Returns the number of integers from the current iterate to the end of the current block. </summary>
+            ///
+            /// <returns> The number of integers. </returns>
+            size_t GetBlockSize() const { return _blockSize - _blockIndex; }
+
+            /// <summary> Proceeds to the first iterate of the next block. </summary>
+            void NextBlock();
 
         private:
             // private ctor, can only be called from CompressedIntegerList class
-            Iterator(const uint8_t* iter, const uint8_t* end);
+            Iterator(const uint8_t* iter, const uint8_t* end, size_t size);
             friend class CompressedIntegerList;
 
+            void DecodeBlock();
+
             // members
-            const uint8_t* _iter;
-            const uint8_t* _end;
-            size_t _value;
-            size_t _iter_increment;
+            const uint8_t* _iter = nullptr;
+            const uint8_t* _end = nullptr;
+            size_t _remaining = 0;
+            size_t _value = 0;
+            size_t _block[4];
+            size_t _blockSize = 0;
+            size_t _blockIndex = 0;
         };
 
         /// <summary> Default Constructor. Constructs an empty list. </summary>
@@ -96,12 +118,13 @@ namespace utilities
         /// <summary> Returns an `Iterator` that points to the beginning of the list. </summary>
         ///
         /// <returns> The iterator. </returns>
-        Iterator GetIterator() const { return Iterator(_data.data(), _data.data() + _data.size()); }
+        Iterator GetIterator() const { return Iterator(_data.data(), _data.data() + _data.size(), _size); }
 
     private:
         std::vector<uint8_t> _data;
         size_t _last;
         size_t _size;
+        size_t _controlByteOffset; // the control byte of the last group
     };
 }
 }
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MemoryMappedFile.h (utilities)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <cstddef>
+#include <string>
+
+namespace ell
+{
+namespace utilities
+{
+    /// <summary> A read-only view of the contents of a file, which the operating system maps directly into memory. </summary>
+    class MemoryMappedFile
+    {
+    public:
+        /// <summary> Maps a file into memory. </summary>
+        ///
+        /// <param name="filepath"> The path of the file. </param>
+        MemoryMappedFile(const std::string& filepath);
+
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+        ~MemoryMappedFile();
+
+        /// <summary> Gets a pointer to the beginning of the file contents. </summary>
+        ///
+        /// <returns> Pointer to the file contents. </returns>
+        const char* GetData() const { return _pData; }
+
+        /// <summary> Gets the size of the file, in bytes. </summary>
+        ///
+        /// <returns> The size of the file. </returns>
+        size_t Size() const { return _size; }
+
+    private:
+        const char* _pData = nullptr;
+        size_t _size = 0;
+#ifdef _WIN32
+        void* _fileHandle = nullptr;
+        void* _mappingHandle = nullptr;
+#endif
+    };
+}
+}
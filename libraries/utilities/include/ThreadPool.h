@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool.h (utilities)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ell
+{
+namespace utilities
+{
+    /// <summary>
+    /// A fixed set of worker threads that run submitted tasks. Each worker has its own queue: a task
+    /// submitted by a worker goes to the back of that worker's queue, and the worker takes its next
+    /// task from the back of its own queue, so that dependent work stays on the same core. An idle
+    /// worker steals from the front of the other queues. Only the queues are locked to submit and take
+    /// tasks; the pool-wide lock is taken only to put an idle worker to sleep and to wake it up.
+    /// Tasks must not throw.
+    /// </summary>
+    class ThreadPool
+    {
+    public:
+        /// <summary> Starts the worker threads. </summary>
+        ///
+        /// <param name="numThreads"> The number of worker threads, or 0 for one per hardware thread. </param>
+        ThreadPool(size_t numThreads);
+
+        ThreadPool(const ThreadPool&) = delete;
+
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// <summary> Waits for the queued tasks to finish and stops the worker threads. </summary>
+        ~ThreadPool();
+
+        /// <summary> Returns the number of worker threads. </summary>
+        ///
+        /// <returns> The number of worker threads. </returns>
+        size_t NumThreads() const { return _threads.size(); }
+
+        /// <summary> Queues a task to run on one of the worker threads. </summary>
+        ///
+        /// <param name="task"> The task. </param>
+        void Submit(std::function<void()> task);
+
+    private:
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        void RunWorker(size_t workerIndex);
+        bool TryTakeTask(size_t workerIndex, std::function<void()>& task);
+
+        std::vector<std::unique_ptr<WorkerQueue>> _queues;
+        std::atomic<size_t> _nextQueue;
+
+        // the number of tasks in the queues, which changes under the lock of the queue that changes
+        std::atomic<size_t> _numQueuedTasks;
+
+        // idle workers sleep on the condition variable
+        std::mutex _mutex;
+        std::condition_variable _taskAvailable;
+        std::atomic<size_t> _numSleepingWorkers;
+        bool _isStopping = false;
+
+        std::vector<std::thread> _threads;
+    };
+}
+}
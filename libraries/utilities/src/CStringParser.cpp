@@ -9,17 +9,209 @@
 #include "CStringParser.h"
 
 // stl
-#include <cctype>
-#include <cstdlib>
-#include <stdexcept>
+#include <cstdint>
 
 namespace ell
 {
 namespace utilities
 {
+    namespace
+    {
+        // powers of ten that are exactly representable in a double and in a float
+        const double doublePowersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+        const float floatPowersOfTen[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+        const int maxSignificantDigits = 19; // every 19 digit number fits in a uint64_t
+
+        // a decimal number of the form (-1)^isNegative * mantissa * 10^exponent
+        struct DecimalNumber
+        {
+            uint64_t mantissa = 0;
+            int exponent = 0;
+            bool isNegative = false;
+        };
+
+        // scans [+-]digits[.digits][(e|E)[+-]digits], which is the decimal subset of what strtod accepts
+        bool ScanDecimalNumber(const char* pStr, const char*& pEnd, DecimalNumber& number)
+        {
+            if (*pStr == '+' || *pStr == '-')
+            {
+                number.isNegative = (*pStr == '-');
+                ++pStr;
+            }
+
+            // hexadecimal floating point
+            if (pStr[0] == '0' && (pStr[1] == 'x' || pStr[1] == 'X'))
+            {
+                return false;
+            }
+
+            bool hasDigits = false;
+            int numSignificantDigits = 0;
+            while (IsDigit(*pStr))
+            {
+                hasDigits = true;
+                if (number.mantissa != 0 || *pStr != '0')
+                {
+                    if (++numSignificantDigits > maxSignificantDigits)
+                    {
+                        return false;
+                    }
+                    number.mantissa = 10 * number.mantissa + static_cast<uint64_t>(*pStr - '0');
+                }
+                ++pStr;
+            }
+
+            if (*pStr == '.')
+            {
+                ++pStr;
+                while (IsDigit(*pStr))
+                {
+                    hasDigits = true;
+                    if (number.mantissa != 0 || *pStr != '0')
+                    {
+                        if (++numSignificantDigits > maxSignificantDigits)
+                        {
+                            return false;
+                        }
+                        number.mantissa = 10 * number.mantissa + static_cast<uint64_t>(*pStr - '0');
+                    }
+                    --number.exponent;
+                    ++pStr;
+                }
+            }
+
+            // inf, nan, and strings without digits are left to strtod
+            if (!hasDigits)
+            {
+                return false;
+            }
+
+            // the exponent is only consumed if it contains at least one digit
+            if (*pStr == 'e' || *pStr == 'E')
+            {
+                const char* pExponent = pStr + 1;
+                bool isExponentNegative = false;
+                if (*pExponent == '+' || *pExponent == '-')
+                {
+                    isExponentNegative = (*pExponent == '-');
+                    ++pExponent;
+                }
+
+                if (IsDigit(*pExponent))
+                {
+                    int exponent = 0;
+                    while (IsDigit(*pExponent))
+                    {
+                        if (exponent < 100000)
+                        {
+                            exponent = 10 * exponent + (*pExponent - '0');
+                        }
+                        ++pExponent;
+                    }
+                    number.exponent += isExponentNegative ? -exponent : exponent;
+                    pStr = pExponent;
+                }
+            }
+
+            pEnd = pStr;
+            return true;
+        }
+    }
+
+    bool TryParseDecimalFast(const char* pStr, const char*& pEnd, double& value)
+    {
+        DecimalNumber number;
+        if (!ScanDecimalNumber(pStr, pEnd, number))
+        {
+            return false;
+        }
+
+        // if both the mantissa and the power of ten are exact doubles, a single multiplication
+        // or division gives the correctly rounded result (Clinger's fast path)
+        double result;
+        if (number.mantissa == 0)
+        {
+            result = 0.0;
+        }
+        else if (number.mantissa <= (uint64_t(1) << 53) && number.exponent >= -22 && number.exponent <= 22)
+        {
+            result = static_cast<double>(number.mantissa);
+            result = number.exponent < 0 ? result / doublePowersOfTen[-number.exponent] : result * doublePowersOfTen[number.exponent];
+        }
+        else
+        {
+            return false;
+        }
+
+        value = number.isNegative ? -result : result;
+        return true;
+    }
+
+    bool TryParseDecimalFast(const char* pStr, const char*& pEnd, float& value)
+    {
+        DecimalNumber number;
+        if (!ScanDecimalNumber(pStr, pEnd, number))
+        {
+            return false;
+        }
+
+        float result;
+        if (number.mantissa == 0)
+        {
+            result = 0.0f;
+        }
+        else if (number.mantissa <= (uint64_t(1) << 24) && number.exponent >= -10 && number.exponent <= 10)
+        {
+            result = static_cast<float>(number.mantissa);
+            result = number.exponent < 0 ? result / floatPowersOfTen[-number.exponent] : result * floatPowersOfTen[number.exponent];
+        }
+        else
+        {
+            return false;
+        }
+
+        value = number.isNegative ? -result : result;
+        return true;
+    }
+
+    bool TryParseDecimalFast(const char* pStr, const char*& pEnd, uint64_t& magnitude, bool& isNegative)
+    {
+        isNegative = false;
+        if (*pStr == '+' || *pStr == '-')
+        {
+            isNegative = (*pStr == '-');
+            ++pStr;
+        }
+
+        // base 0 parsing reads a leading zero as octal or hexadecimal notation, so leave that to strtol
+        if (!IsDigit(*pStr) || (pStr[0] == '0' && (IsDigit(pStr[1]) || pStr[1] == 'x' || pStr[1] == 'X')))
+        {
+            return false;
+        }
+
+        const char* pBegin = pStr;
+        uint64_t result = 0;
+        while (IsDigit(*pStr))
+        {
+            result = 10 * result + static_cast<uint64_t>(*pStr - '0');
+            ++pStr;
+        }
+
+        // longer numbers might overflow, and are left to strtoul
+        if (pStr - pBegin > maxSignificantDigits)
+        {
+            return false;
+        }
+
+        magnitude = result;
+        pEnd = pStr;
+        return true;
+    }
+
     void TrimLeadingWhitespace(const char*& pStr)
     {
-        while (std::isspace(*pStr))
+        while (IsWhitespace(*pStr))
         {
             ++pStr;
         }
@@ -32,12 +224,13 @@ namespace utilities
 
     bool IsWhitespace(char c)
     {
-        return std::isspace(c) != 0;
+        // the characters that std::isspace accepts in the "C" locale
+        return c == ' ' || (c >= '\t' && c <= '\r');
     }
 
     bool IsDigit(char c)
     {
-        return std::isdigit(c) != 0;
+        return static_cast<unsigned int>(c - '0') < 10;
     }
 }
-}
\ No newline at end of file
+}
@@ -13,6 +13,7 @@
 
 // stl
 #include <cassert>
+#include <cstddef>
 #include <cstring>
 #include <limits>
 #include <stdexcept>
@@ -21,44 +22,78 @@ namespace ell
 {
 namespace utilities
 {
+    namespace
+    {
+        // the 2-bit code of a delta selects its number of bytes and the mask that extracts it from an 8-byte read
+        const int codeBytes[4] = { 1, 2, 4, 8 };
+        const uint64_t codeMasks[4] = { 0xff, 0xffff, 0xffffffff, 0xffffffffffffffff };
+        const size_t groupSize = 4;
+        const size_t maxGroupBytes = 4 * 8;
+    }
+
     void CompressedIntegerList::Iterator::Next()
     {
-        size_t delta;
-        _iter += _iter_increment;
-        uint8_t first_val = *_iter;
-
-        // chop off top 2 bits --- they encode the # of bytes needed for this delta
-        // 00 = 1 byte, 01 = 2 bytes, 10 = 4 bytes, 11 = 8 bytes
-        int total_bytes = 1 << ((first_val >> 6) & 0x03);
-        assert(total_bytes <= 8);
-        if (total_bytes == 1)
-        {
-            // first_val &= 0x3f; // this is commented out because we don't need to strip off the top 2 bits of first_val in this case, because they're always zero
-            delta = first_val;
-        }
-        else
+        ++_blockIndex;
+        if (_blockIndex >= _blockSize)
         {
-            // read in the Next bytes, shift them over to fit the 6 bits of first_val we're using, and Add first_val
-            delta = 0;
-            std::memcpy(&delta, _iter + 1, total_bytes - 1);
-            delta = (delta << 6) | (first_val & 0x3f);
+            DecodeBlock();
         }
+    }
 
-        _iter_increment = total_bytes;
-        _value += delta;
+    void CompressedIntegerList::Iterator::NextBlock()
+    {
+        DecodeBlock();
     }
 
-    CompressedIntegerList::Iterator::Iterator(const uint8_t* iter, const uint8_t* end)
-        : _iter(iter), _end(end), _value(0), _iter_increment(0)
+    void CompressedIntegerList::Iterator::DecodeBlock()
     {
-        if (IsValid())
+        _blockIndex = 0;
+        _blockSize = _remaining < groupSize ? _remaining : groupSize;
+        _remaining -= _blockSize;
+        if (_blockSize == 0)
         {
-            Next();
+            return;
         }
+
+        uint8_t control = *_iter;
+        ++_iter;
+
+        if (_blockSize == groupSize && _end - _iter >= static_cast<std::ptrdiff_t>(maxGroupBytes))
+        {
+            // a full group that is followed by enough bytes is decoded with 8-byte reads and masks, without branches
+            for (size_t i = 0; i < groupSize; ++i)
+            {
+                int code = (control >> (2 * i)) & 0x03;
+                uint64_t delta;
+                std::memcpy(&delta, _iter, sizeof(delta));
+                _value += static_cast<size_t>(delta & codeMasks[code]);
+                _block[i] = _value;
+                _iter += codeBytes[code];
+            }
+        }
+        else
+        {
+            // near the end of the data, read exactly the bytes of each delta
+            for (size_t i = 0; i < _blockSize; ++i)
+            {
+                int code = (control >> (2 * i)) & 0x03;
+                uint64_t delta = 0;
+                std::memcpy(&delta, _iter, codeBytes[code]);
+                _value += static_cast<size_t>(delta);
+                _block[i] = _value;
+                _iter += codeBytes[code];
+            }
+        }
+    }
+
+    CompressedIntegerList::Iterator::Iterator(const uint8_t* iter, const uint8_t* end, size_t size)
+        : _iter(iter), _end(end), _remaining(size)
+    {
+        DecodeBlock();
     }
 
     CompressedIntegerList::CompressedIntegerList()
-        : _last(std::numeric_limits<size_t>::max()), _size(0)
+        : _last(std::numeric_limits<size_t>::max()), _size(0), _controlByteOffset(0)
     {
     }
 
@@ -104,33 +139,38 @@ namespace utilities
         delta = value - _last;
         _last = value;
 
-        // figure out how many bits we need to represent this value
-        int log2bytes = 0;
-        if ((delta & 0xffffffffffffffc0) == 0)
+        // start a new group with an empty control byte
+        if (_size % groupSize == 0)
+        {
+            _controlByteOffset = _data.size();
+            _data.push_back(0);
+        }
+
+        // figure out how many bytes we need to represent this value
+        int code = 0;
+        if ((delta & 0xffffffffffffff00) == 0)
         {
-            log2bytes = 0; // just need 1 byte
+            code = 0; // just need 1 byte
         }
-        else if ((delta & 0xffffffffffffc000) == 0)
+        else if ((delta & 0xffffffffffff0000) == 0)
         {
-            log2bytes = 1; // two bytes
+            code = 1; // two bytes
         }
-        else if ((delta & 0xffffffffc0000000) == 0)
+        else if ((delta & 0xffffffff00000000) == 0)
         {
-            log2bytes = 2; // four bytes
+            code = 2; // four bytes
         }
         else
         {
-            log2bytes = 3; // 8 bytes
+            code = 3; // 8 bytes
         }
 
-        int total_bytes = 1 << log2bytes;
+        // record the length in the delta's 2-bit field of the control byte, and append the low-order bytes of the delta
+        _data[_controlByteOffset] |= static_cast<uint8_t>(code << (2 * (_size % groupSize)));
+        uint64_t write_val = delta;
+        int total_bytes = codeBytes[code];
         _data.resize(_data.size() + total_bytes); // make room for new data
-        uint8_t* buf = _data.data() + _data.size() - total_bytes; // get pointer to correct place in array
-        unsigned int mask = log2bytes << 6; // mask == log2(# bytes) shifted to be high-order 2 bits of a byte
-        // splice the data length encoding in as the top 2 bits of the first byte
-        // So, move all high-order bits of the delta over by 2 to make room, Add the mask, and Add the residual low-order bits of the delta
-        size_t write_val = ((delta << 2) & 0xffffffffffffff00) | mask | (delta & 0x3f);
-        std::memcpy(buf, &write_val, total_bytes);
+        std::memcpy(_data.data() + _data.size() - total_bytes, &write_val, total_bytes);
 
         ++_size;
     }
@@ -140,6 +180,7 @@ namespace utilities
         _data.resize(0);
         _last = UINT64_MAX;
         _size = 0;
+        _controlByteOffset = 0;
     }
 }
 }
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MemoryMappedFile.cpp (utilities)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MemoryMappedFile.h"
+
+// utilities
+#include "Exception.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ell
+{
+namespace utilities
+{
+#ifdef _WIN32
+    MemoryMappedFile::MemoryMappedFile(const std::string& filepath)
+    {
+        HANDLE fileHandle = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            throw SystemException(SystemExceptionErrors::fileNotFound, "error opening file " + filepath);
+        }
+        _fileHandle = fileHandle;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(fileHandle, &size))
+        {
+            CloseHandle(fileHandle);
+            throw SystemException(SystemExceptionErrors::fileNotFound, "error reading the size of file " + filepath);
+        }
+        _size = static_cast<size_t>(size.QuadPart);
+
+        // windows cannot map an empty file
+        if (_size == 0)
+        {
+            return;
+        }
+
+        HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle == nullptr)
+        {
+            CloseHandle(fileHandle);
+            throw SystemException(SystemExceptionErrors::fileNotFound, "error mapping file " + filepath);
+        }
+        _mappingHandle = mappingHandle;
+
+        _pData = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (_pData == nullptr)
+        {
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            throw SystemException(SystemExceptionErrors::fileNotFound, "error mapping file " + filepath);
+        }
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        if (_pData != nullptr)
+        {
+            UnmapViewOfFile(_pData);
+        }
+        if (_mappingHandle != nullptr)
+        {
+            CloseHandle(_mappingHandle);
+        }
+        CloseHandle(_fileHandle);
+    }
+#else
+    MemoryMappedFile::MemoryMappedFile(const std::string& filepath)
+    {
+        int fileDescriptor = open(filepath.c_str(), O_RDONLY);
+        if (fileDescriptor < 0)
+        {
+            throw SystemException(SystemExceptionErrors::fileNotFound, "error opening file " + filepath);
+        }
+
+        struct stat fileStatus;
+        if (fstat(fileDescriptor, &fileStatus) != 0)
+        {
+            close(fileDescriptor);
+            throw SystemException(SystemExceptionErrors::fileNotFound, "error reading the size of file " + filepath);
+        }
+        _size = static_cast<size_t>(fileStatus.st_size);
+
+        // mmap fails on an empty file
+        if (_size > 0)
+        {
+            void* pData = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+            if (pData == MAP_FAILED)
+            {
+                close(fileDescriptor);
+                throw SystemException(SystemExceptionErrors::fileNotFound, "error mapping file " + filepath);
+            }
+            _pData = static_cast<const char*>(pData);
+        }
+
+        // the mapping remains valid after the file descriptor is closed
+        close(fileDescriptor);
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        if (_pData != nullptr)
+        {
+            munmap(const_cast<char*>(_pData), _size);
+        }
+    }
+#endif
+}
+}
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool.cpp (utilities)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+
+// stl
+#include <algorithm>
+
+namespace ell
+{
+namespace utilities
+{
+    namespace
+    {
+        // the pool and queue of the worker that runs on the current thread, if any
+        thread_local const ThreadPool* currentPool = nullptr;
+        thread_local size_t currentWorkerIndex = 0;
+    }
+
+    ThreadPool::ThreadPool(size_t numThreads)
+        : _nextQueue(0), _numQueuedTasks(0), _numSleepingWorkers(0)
+    {
+        if (numThreads == 0)
+        {
+            numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        for (size_t workerIndex = 0; workerIndex < numThreads; ++workerIndex)
+        {
+            _queues.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        for (size_t workerIndex = 0; workerIndex < numThreads; ++workerIndex)
+        {
+            _threads.emplace_back([this, workerIndex]() { RunWorker(workerIndex); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isStopping = true;
+        }
+        _taskAvailable.notify_all();
+        for (auto& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::Submit(std::function<void()> task)
+    {
+        auto queueIndex = currentPool == this ? currentWorkerIndex : _nextQueue++ % _queues.size();
+        {
+            std::lock_guard<std::mutex> lock(_queues[queueIndex]->mutex);
+            _queues[queueIndex]->tasks.push_back(std::move(task));
+            ++_numQueuedTasks;
+        }
+
+        // a worker that goes to sleep counts itself before it checks for queued tasks, so either it sees this task or we see it
+        if (_numSleepingWorkers > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+            }
+            _taskAvailable.notify_one();
+        }
+    }
+
+    void ThreadPool::RunWorker(size_t workerIndex)
+    {
+        currentPool = this;
+        currentWorkerIndex = workerIndex;
+        while (true)
+        {
+            std::function<void()> task;
+            if (TryTakeTask(workerIndex, task))
+            {
+                task();
+                continue;
+            }
+
+            // sleep until a task is queued, or stop once the queues are empty
+            std::unique_lock<std::mutex> lock(_mutex);
+            ++_numSleepingWorkers;
+            _taskAvailable.wait(lock, [this]() { return _numQueuedTasks > 0 || _isStopping; });
+            --_numSleepingWorkers;
+            if (_isStopping && _numQueuedTasks == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    bool ThreadPool::TryTakeTask(size_t workerIndex, std::function<void()>& task)
+    {
+        {
+            auto& queue = *_queues[workerIndex];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                --_numQueuedTasks;
+                return true;
+            }
+        }
+
+        for (size_t offset = 1; offset < _queues.size(); ++offset)
+        {
+            auto& queue = *_queues[(workerIndex + offset) % _queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                --_numQueuedTasks;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+}
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BackgroundProducer.tcc (utilities)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// stl
+#include <algorithm>
+#include <utility>
+
+namespace ell
+{
+namespace utilities
+{
+    template <typename ItemType>
+    BackgroundProducer<ItemType>::BackgroundProducer(ProduceFunction produce, size_t maxQueuedItems)
+        : _produce(std::move(produce)), _maxQueuedItems(std::max(maxQueuedItems, size_t(1)))
+    {
+        _thread = std::thread([this]() { Produce(); });
+    }
+
+    template <typename ItemType>
+    BackgroundProducer<ItemType>::~BackgroundProducer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isStopping = true;
+        }
+        _spaceAvailable.notify_all();
+        _thread.join();
+    }
+
+    template <typename ItemType>
+    bool BackgroundProducer<ItemType>::Take(ItemType& item)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _itemAvailable.wait(lock, [this]() { return !_queue.empty() || _isDone; });
+
+        if (_queue.empty())
+        {
+            if (_exception != nullptr)
+            {
+                auto exception = _exception;
+                _exception = nullptr;
+                std::rethrow_exception(exception);
+            }
+            return false;
+        }
+
+        item = std::move(_queue.front());
+        _queue.pop_front();
+        lock.unlock();
+        _spaceAvailable.notify_one();
+        return true;
+    }
+
+    template <typename ItemType>
+    void BackgroundProducer<ItemType>::Produce()
+    {
+        bool hasMore = true;
+        while (hasMore)
+        {
+            // produce without holding the lock
+            ItemType item;
+            std::exception_ptr exception;
+            try
+            {
+                hasMore = _produce(item);
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+                hasMore = false;
+            }
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _spaceAvailable.wait(lock, [this]() { return _queue.size() < _maxQueuedItems || _isStopping; });
+            if (_isStopping)
+            {
+                return;
+            }
+            if (!item.empty())
+            {
+                _queue.push_back(std::move(item));
+            }
+            _exception = exception;
+            _isDone = !hasMore;
+            lock.unlock();
+            _itemAvailable.notify_one();
+        }
+    }
+}
+}
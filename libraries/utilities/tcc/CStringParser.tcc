@@ -9,15 +9,73 @@
 // stl
 #include <cctype>
 #include <cerrno>
+#include <cstdint>
 #include <cstdlib>
+#include <limits>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 
 namespace ell
 {
 namespace utilities
 {
-    // wrapper for strtof
+    // fast paths for decimal numbers, defined in CStringParser.cpp; they return false for input that
+    // must go through the strto* family (hexadecimal or octal notation, inf, nan, very long or very
+    // large numbers) and leave the output unchanged in that case
+    bool TryParseDecimalFast(const char* pStr, const char*& pEnd, double& value);
+    bool TryParseDecimalFast(const char* pStr, const char*& pEnd, float& value);
+    bool TryParseDecimalFast(const char* pStr, const char*& pEnd, uint64_t& magnitude, bool& isNegative);
+
+    template <typename FloatType>
+    bool TryParseFloatFast(const char* pStr, char*& pEnd, FloatType& value)
+    {
+        const char* pFastEnd;
+        if (!TryParseDecimalFast(pStr, pFastEnd, value))
+        {
+            return false;
+        }
+        pEnd = const_cast<char*>(pFastEnd);
+        return true;
+    }
+
+    template <typename IntegerType>
+    bool TryParseIntegerFast(const char* pStr, char*& pEnd, IntegerType& value, ParseResult& result)
+    {
+        const char* pFastEnd;
+        uint64_t magnitude;
+        bool isNegative;
+        if (!TryParseDecimalFast(pStr, pFastEnd, magnitude, isNegative))
+        {
+            return false;
+        }
+
+        pEnd = const_cast<char*>(pFastEnd);
+        if (isNegative)
+        {
+            // the magnitude of the smallest value is one more than the largest value
+            if (!std::is_signed<IntegerType>::value || magnitude > static_cast<uint64_t>(std::numeric_limits<IntegerType>::max()) + 1)
+            {
+                result = ParseResult::outOfRange;
+                return true;
+            }
+            value = static_cast<IntegerType>(-static_cast<int64_t>(magnitude - 1) - 1);
+        }
+        else
+        {
+            if (magnitude > static_cast<uint64_t>(std::numeric_limits<IntegerType>::max()))
+            {
+                result = ParseResult::outOfRange;
+                return true;
+            }
+            value = static_cast<IntegerType>(magnitude);
+        }
+
+        result = ParseResult::success;
+        return true;
+    }
+
+    // wrapper for strtof, with a fast path for decimal numbers
     inline ParseResult cParse(const char* pStr, char*& pEnd, float& value)
     {
         if (IsWhitespace(*pStr))
@@ -25,6 +83,11 @@ namespace utilities
             return ParseResult::badFormat;
         }
 
+        if (TryParseFloatFast(pStr, pEnd, value))
+        {
+            return ParseResult::success;
+        }
+
         auto tmp = errno;
         errno = 0;
 
@@ -43,7 +106,7 @@ namespace utilities
         return ParseResult::success;
     }
 
-    // wrapper for std::strtod
+    // wrapper for std::strtod, with a fast path for decimal numbers
     inline ParseResult cParse(const char* pStr, char*& pEnd, double& value)
     {
         if (IsWhitespace(*pStr))
@@ -51,6 +114,11 @@ namespace utilities
             return ParseResult::badFormat;
         }
 
+        if (TryParseFloatFast(pStr, pEnd, value))
+        {
+            return ParseResult::success;
+        }
+
         auto tmp = errno;
         errno = 0;
 
@@ -77,6 +145,12 @@ namespace utilities
             return ParseResult::badFormat;
         }
 
+        ParseResult result;
+        if (TryParseIntegerFast(pStr, pEnd, value, result))
+        {
+            return result;
+        }
+
         auto tmp = errno;
         errno = 0;
 
@@ -109,6 +183,12 @@ namespace utilities
             return ParseResult::badFormat;
         }
 
+        ParseResult result;
+        if (TryParseIntegerFast(pStr, pEnd, value, result))
+        {
+            return result;
+        }
+
         auto tmp = errno;
         errno = 0;
 
@@ -141,6 +221,12 @@ namespace utilities
             return ParseResult::badFormat;
         }
 
+        ParseResult result;
+        if (TryParseIntegerFast(pStr, pEnd, value, result))
+        {
+            return result;
+        }
+
         auto tmp = errno;
         errno = 0;
 
@@ -173,6 +259,12 @@ namespace utilities
             return ParseResult::badFormat;
         }
 
+        ParseResult result;
+        if (TryParseIntegerFast(pStr, pEnd, value, result))
+        {
+            return result;
+        }
+
         auto tmp = errno;
         errno = 0;
 
@@ -199,6 +291,12 @@ namespace utilities
             return ParseResult::badFormat;
         }
 
+        ParseResult result;
+        if (TryParseIntegerFast(pStr, pEnd, value, result))
+        {
+            return result;
+        }
+
         auto tmp = errno;
         errno = 0;
 
@@ -230,6 +328,12 @@ namespace utilities
             return ParseResult::badFormat;
         }
 
+        ParseResult result;
+        if (TryParseIntegerFast(pStr, pEnd, value, result))
+        {
+            return result;
+        }
+
         auto tmp = errno;
         errno = 0;
 
@@ -277,6 +381,12 @@ namespace utilities
             return ParseResult::badFormat;
         }
 
+        ParseResult result;
+        if (TryParseIntegerFast(pStr, pEnd, value, result))
+        {
+            return result;
+        }
+
         auto tmp = errno;
         errno = 0;
 
@@ -325,5 +435,42 @@ namespace utilities
 
         return parseResult;
     }
+
+    template <typename IndexType, typename ValueType>
+    ParseResult ParseIndexValuePairs(const char*& pStr, IndexType* indices, ValueType* values, size_t capacity, size_t& count)
+    {
+        count = 0;
+        TrimLeadingWhitespace(pStr);
+        while (count < capacity)
+        {
+            const char* pEntry = pStr;
+            auto result = Parse(pEntry, indices[count]);
+            if (result == ParseResult::endOfString || result == ParseResult::beginComment)
+            {
+                return ParseResult::success;
+            }
+            if (result != ParseResult::success)
+            {
+                return result;
+            }
+
+            if (*pEntry != ':')
+            {
+                return ParseResult::badFormat;
+            }
+            ++pEntry;
+
+            result = Parse(pEntry, values[count]);
+            if (result != ParseResult::success)
+            {
+                return result == ParseResult::outOfRange ? result : ParseResult::badFormat;
+            }
+
+            ++count;
+            pStr = pEntry;
+            TrimLeadingWhitespace(pStr);
+        }
+        return ParseResult::success;
+    }
 }
 }
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BackgroundProducer_test.cpp (utilities)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "BackgroundProducer_test.h"
+
+// testing
+#include "testing.h"
+
+// utilities
+#include "BackgroundProducer.h"
+#include "Exception.h"
+
+// stl
+#include <vector>
+
+namespace ell
+{
+void TestBackgroundProducer()
+{
+    // the producer outpaces the consumer, so it keeps waiting for space in the queue
+    const int numItems = 100;
+    const int itemSize = 10;
+    int next = 0;
+    utilities::BackgroundProducer<std::vector<int>> producer([&next](std::vector<int>& item) {
+        for (int index = 0; index < itemSize; ++index)
+        {
+            item.push_back(next++);
+        }
+        return next < numItems * itemSize;
+    },
+                                                             2);
+
+    std::vector<int> item;
+    int expected = 0;
+    bool isInOrder = true;
+    while (producer.Take(item))
+    {
+        for (auto value : item)
+        {
+            isInOrder = isInOrder && value == expected++;
+        }
+    }
+    testing::ProcessTest("BackgroundProducer::Take", isInOrder && expected == numItems * itemSize && !producer.Take(item));
+
+    // destroying a producer that is waiting for space in the queue stops it
+    {
+        utilities::BackgroundProducer<std::vector<int>> endlessProducer([](std::vector<int>& item) {
+            item.push_back(1);
+            return true;
+        },
+                                                                        1);
+        endlessProducer.Take(item);
+    }
+    testing::ProcessTest("BackgroundProducer stops when destroyed", item.size() == 1);
+}
+
+void TestBackgroundProducerException()
+{
+    // the items produced before the exception, including the partial item, are delivered first
+    int count = 0;
+    utilities::BackgroundProducer<std::vector<int>> producer([&count](std::vector<int>& item) {
+        item.push_back(count++);
+        if (count == 3)
+        {
+            throw utilities::DataFormatException(utilities::DataFormatErrors::badFormat, "bad item");
+        }
+        return true;
+    },
+                                                             4);
+
+    std::vector<int> values;
+    bool threwException = false;
+    std::vector<int> item;
+    try
+    {
+        while (producer.Take(item))
+        {
+            values.insert(values.end(), item.begin(), item.end());
+        }
+    }
+    catch (const utilities::DataFormatException&)
+    {
+        threwException = true;
+    }
+    testing::ProcessTest("BackgroundProducer rethrows the producer's exception", threwException && values == std::vector<int>{ 0, 1, 2 } && !producer.Take(item));
+}
+}
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     CStringParser_test.cpp (utilities)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CStringParser_test.h"
+
+// testing
+#include "testing.h"
+
+// utilities
+#include "CStringParser.h"
+
+// stl
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ell
+{
+template <typename ValueType>
+bool IsParsedLikeStrtod(const std::string& string)
+{
+    const char* pStr = string.c_str();
+    ValueType value = 0;
+    auto result = utilities::Parse(pStr, value);
+
+    char* pEnd;
+    auto expected = static_cast<ValueType>(std::is_same<ValueType, float>::value ? std::strtof(string.c_str(), &pEnd) : std::strtod(string.c_str(), &pEnd));
+    return result == utilities::ParseResult::success && value == expected && std::signbit(value) == std::signbit(expected) && pStr == pEnd;
+}
+
+void TestParseFloatingPoint()
+{
+    std::vector<std::string> strings = { "0", "-0.0", "1", "+1.5", "-.25", "3.", "3.14159", "1e5", "1E-5", "-2.5e+3", "123456789012345678", "0.000000000000000000000001",
+                                         "9007199254740993", "0.1", "0.30000000000000004", "1e22", "1e23", "0x1p3", "inf", "1e", "1e+", "2.5x", "1.5e5.3", "00012.5000" };
+
+    // random decimal numbers, many of which take the fast path
+    std::default_random_engine engine(1234);
+    std::uniform_int_distribution<int64_t> mantissaDistribution(-99999999, 99999999);
+    std::uniform_int_distribution<int> exponentDistribution(-30, 30);
+    for (int i = 0; i < 1000; ++i)
+    {
+        strings.push_back(std::to_string(mantissaDistribution(engine)) + "e" + std::to_string(exponentDistribution(engine)));
+        strings.push_back(std::to_string(mantissaDistribution(engine)) + "." + std::to_string(mantissaDistribution(engine) & 0xffff));
+    }
+
+    bool isDoubleCorrect = true;
+    bool isFloatCorrect = true;
+    for (const auto& string : strings)
+    {
+        isDoubleCorrect &= IsParsedLikeStrtod<double>(string);
+        isFloatCorrect &= IsParsedLikeStrtod<float>(string);
+    }
+    isDoubleCorrect &= IsParsedLikeStrtod<double>("1e300") && IsParsedLikeStrtod<double>("1.7976931348623157e308");
+    testing::ProcessTest("utilities::Parse double", isDoubleCorrect);
+    testing::ProcessTest("utilities::Parse float", isFloatCorrect);
+
+    const char* pStr = " 1.5";
+    double value;
+    testing::ProcessTest("utilities::Parse double leading whitespace", utilities::Parse(pStr, value) == utilities::ParseResult::badFormat);
+
+    pStr = "1e400";
+    testing::ProcessTest("utilities::Parse double out of range", utilities::Parse(pStr, value) == utilities::ParseResult::outOfRange);
+}
+
+void TestParseInteger()
+{
+    auto parseInt = [](const char* pStr, int& value) { return utilities::Parse(pStr, value); };
+    auto parseUnsigned = [](const char* pStr, unsigned int& value) { return utilities::Parse(pStr, value); };
+    int intValue = 0;
+    unsigned int unsignedValue = 0;
+    uint64_t uint64Value = 0;
+
+    testing::ProcessTest("utilities::Parse int", parseInt("-123:", intValue) == utilities::ParseResult::success && intValue == -123);
+    testing::ProcessTest("utilities::Parse int minimum", parseInt("-2147483648", intValue) == utilities::ParseResult::success && intValue == -2147483647 - 1);
+    testing::ProcessTest("utilities::Parse int out of range", parseInt("2147483648", intValue) == utilities::ParseResult::outOfRange);
+    testing::ProcessTest("utilities::Parse int octal", parseInt("010", intValue) == utilities::ParseResult::success && intValue == 8);
+    testing::ProcessTest("utilities::Parse int hexadecimal", parseInt("0x1f", intValue) == utilities::ParseResult::success && intValue == 31);
+    testing::ProcessTest("utilities::Parse unsigned", parseUnsigned("4294967295", unsignedValue) == utilities::ParseResult::success && unsignedValue == 4294967295u);
+    testing::ProcessTest("utilities::Parse unsigned out of range", parseUnsigned("4294967296", unsignedValue) == utilities::ParseResult::outOfRange);
+    testing::ProcessTest("utilities::Parse unsigned sign", parseUnsigned("-1", unsignedValue) == utilities::ParseResult::badFormat);
+
+    const char* pStr = "18446744073709551615 ";
+    testing::ProcessTest("utilities::Parse uint64", utilities::Parse(pStr, uint64Value) == utilities::ParseResult::success && uint64Value == UINT64_MAX && *pStr == ' ');
+}
+
+void TestParseIndexValuePairs()
+{
+    std::vector<size_t> indices(4);
+    std::vector<double> values(4);
+    size_t count;
+
+    const char* pStr = "  0:1.5 3:-2\t17:1e3 # comment";
+    auto result = utilities::ParseIndexValuePairs(pStr, indices.data(), values.data(), indices.size(), count);
+    testing::ProcessTest("utilities::ParseIndexValuePairs", result == utilities::ParseResult::success && count == 3 && indices[2] == 17 && values[1] == -2 && values[2] == 1000 && *pStr == '#');
+
+    pStr = "1:1 2:2 3:3 4:4 5:5";
+    result = utilities::ParseIndexValuePairs(pStr, indices.data(), values.data(), indices.size(), count);
+    testing::ProcessTest("utilities::ParseIndexValuePairs capacity", result == utilities::ParseResult::success && count == 4 && std::string(pStr) == "5:5");
+
+    pStr = "1:1 2 3:3";
+    result = utilities::ParseIndexValuePairs(pStr, indices.data(), values.data(), indices.size(), count);
+    testing::ProcessTest("utilities::ParseIndexValuePairs bad format", result == utilities::ParseResult::badFormat && count == 1 && std::string(pStr) == "2 3:3");
+}
+}
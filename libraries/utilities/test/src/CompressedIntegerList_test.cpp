@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     CompressedIntegerList_test.cpp (utilities)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CompressedIntegerList_test.h"
+
+// testing
+#include "testing.h"
+
+// utilities
+#include "CompressedIntegerList.h"
+
+// stl
+#include <cstddef>
+#include <vector>
+
+namespace ell
+{
+namespace
+{
+    // deltas that need 1, 2, 4, and 8 bytes, in every position of a group
+    std::vector<size_t> GetIncreasingIntegers(size_t count)
+    {
+        const size_t deltas[] = { 1, 255, 256, 65536, 7, 1ull << 32, 3, 70000, 2 };
+        std::vector<size_t> integers;
+        size_t value = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            integers.push_back(value);
+            value += deltas[i % (sizeof(deltas) / sizeof(size_t))];
+        }
+        return integers;
+    }
+}
+
+void TestCompressedIntegerList()
+{
+    bool isEqual = true;
+    for (size_t count = 0; count < 40; ++count)
+    {
+        auto integers = GetIncreasingIntegers(count);
+        utilities::CompressedIntegerList list;
+        for (auto integer : integers)
+        {
+            list.Append(integer);
+        }
+
+        std::vector<size_t> decoded;
+        auto iterator = list.GetIterator();
+        while (iterator.IsValid())
+        {
+            decoded.push_back(iterator.Get());
+            iterator.Next();
+        }
+        isEqual = isEqual && decoded == integers && list.Size() == count && (count == 0 || list.Max() == integers.back());
+    }
+    testing::ProcessTest("CompressedIntegerList", isEqual);
+}
+
+void TestCompressedIntegerListBlocks()
+{
+    auto integers = GetIncreasingIntegers(23);
+    utilities::CompressedIntegerList list;
+    for (auto integer : integers)
+    {
+        list.Append(integer);
+    }
+
+    // read one element, and then the rest of the list one block at a time
+    auto iterator = list.GetIterator();
+    std::vector<size_t> decoded = { iterator.Get() };
+    iterator.Next();
+    bool isFirstBlockPartial = iterator.GetBlockSize() == 3;
+    while (iterator.IsValid())
+    {
+        decoded.insert(decoded.end(), iterator.GetBlock(), iterator.GetBlock() + iterator.GetBlockSize());
+        iterator.NextBlock();
+    }
+    testing::ProcessTest("CompressedIntegerList blocks", isFirstBlockPartial && decoded == integers);
+}
+}
@@ -0,0 +1,47 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool_test.cpp (utilities)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool_test.h"
+
+// testing
+#include "testing.h"
+
+// utilities
+#include "ThreadPool.h"
+
+// stl
+#include <atomic>
+
+namespace ell
+{
+void TestThreadPool()
+{
+    const int numTasks = 100;
+    const int numSubtasks = 10;
+    std::atomic<int> count(0);
+    {
+        utilities::ThreadPool threadPool(4);
+        for (int task = 0; task < numTasks; ++task)
+        {
+            // each task submits more tasks from its worker thread
+            threadPool.Submit([&threadPool, &count]() {
+                for (int subtask = 0; subtask < numSubtasks; ++subtask)
+                {
+                    threadPool.Submit([&count]() { ++count; });
+                }
+                ++count;
+            });
+        }
+
+        testing::ProcessTest("ThreadPool::NumThreads", threadPool.NumThreads() == 4);
+    }
+
+    // the destructor waits for all the queued tasks
+    testing::ProcessTest("ThreadPool::Submit", count == numTasks * (numSubtasks + 1));
+}
+}
@@ -6,11 +6,15 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "BackgroundProducer_test.h"
+#include "CompressedIntegerList_test.h"
+#include "CStringParser_test.h"
 #include "Format_test.h"
 #include "FunctionUtils_test.h"
 #include "IArchivable_test.h"
 #include "Iterator_test.h"
 #include "ObjectArchive_test.h"
+#include "ThreadPool_test.h"
 #include "TypeFactory_test.h"
 #include "TypeName_test.h"
 #include "Variant_test.h"
@@ -36,6 +40,19 @@ int main()
 {
     try
     {
+        // BackgroundProducer tests
+        TestBackgroundProducer();
+        TestBackgroundProducerException();
+
+        // CompressedIntegerList tests
+        TestCompressedIntegerList();
+        TestCompressedIntegerListBlocks();
+
+        // CStringParser tests
+        TestParseFloatingPoint();
+        TestParseInteger();
+        TestParseIndexValuePairs();
+
         // Format tests
         TestMatchFormat();
 
@@ -44,6 +61,9 @@ int main()
         TestTransformIterator();
         TestParallelTransformIterator();
 
+        // ThreadPool tests
+        TestThreadPool();
+
         // TypeFactory tests
         TypeFactoryTest();
 
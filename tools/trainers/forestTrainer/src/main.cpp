@@ -24,6 +24,7 @@
 #include "LoadModel.h"
 #include "MakeEvaluator.h"
 #include "MakeTrainer.h"
+#include "MapApplicationArguments.h"
 #include "MapLoadArguments.h"
 #include "ModelSaveArguments.h"
 #include "TrainerArguments.h"
@@ -52,6 +53,7 @@ int main(int argc, char* argv[])
         common::ParsedTrainerArguments trainerArguments;
         common::ParsedDataLoadArguments dataLoadArguments;
         common::ParsedMapLoadArguments mapLoadArguments;
+        common::ParsedMapApplicationArguments mapApplicationArguments;
         common::ParsedModelSaveArguments modelSaveArguments;
         common::ParsedForestTrainerArguments forestTrainerArguments;
         common::ParsedEvaluatorArguments evaluatorArguments;
@@ -59,6 +61,7 @@ int main(int argc, char* argv[])
         commandLineParser.AddOptionSet(trainerArguments);
         commandLineParser.AddOptionSet(dataLoadArguments);
         commandLineParser.AddOptionSet(mapLoadArguments);
+        commandLineParser.AddOptionSet(mapApplicationArguments);
         commandLineParser.AddOptionSet(modelSaveArguments);
         commandLineParser.AddOptionSet(forestTrainerArguments);
         commandLineParser.AddOptionSet(evaluatorArguments);
@@ -80,8 +83,7 @@ int main(int argc, char* argv[])
 
         // load dataset
         if (trainerArguments.verbose) std::cout << "Loading data ..." << std::endl;
-        auto stream = utilities::OpenIfstream(dataLoadArguments.inputDataFilename);
-        auto mappedDataset = common::GetMappedDataset(stream, map);
+        auto mappedDataset = common::GetMappedDataset(dataLoadArguments, map, mapApplicationArguments);
 
         // predictor type
         using PredictorType = predictors::SimpleForestPredictor;
@@ -115,7 +117,7 @@ int main(int argc, char* argv[])
         // Save predictor model
         if (modelSaveArguments.outputModelFilename != "")
         {
-            auto model = common::AppendNodeToModel<nodes::SimpleForestPredictorNode, PredictorType>(map, predictor);
+            auto model = common::AppendNodeToModel<nodes::SimpleForestPredictorNode, PredictorType>(map, predictor, dataLoadArguments);
             common::SaveModel(model, modelSaveArguments.outputModelFilename);
         }
     }
@@ -30,6 +30,7 @@ namespace ell
     size_t maxEpochs;
     bool permute;
     std::string randomSeedString;
+    bool streamData;
 };
 
 /// <summary> Parsed version of LinearTrainerArguments. </summary>
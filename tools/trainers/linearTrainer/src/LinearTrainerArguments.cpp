@@ -55,5 +55,11 @@ namespace ell
             "seed",
             "The random seed string",
             "ABCDEFG");
+
+        parser.AddOption(streamData,
+            "streamData",
+            "stream",
+            "Train with SGD or SparseDataSGD without loading the data into memory, by reading and mapping the data file in the background in every epoch",
+            false);
     }
 }
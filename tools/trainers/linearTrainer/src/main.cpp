@@ -16,6 +16,7 @@
 
 // data
 #include "Dataset.h"
+#include "PrefetchingExampleIterator.h"
 
 // common
 #include "AppendNodeToModel.h"
@@ -25,6 +26,7 @@
 #include "LoadModel.h"
 #include "MakeEvaluator.h"
 #include "MakeTrainer.h"
+#include "MapApplicationArguments.h"
 #include "MapLoadArguments.h"
 #include "ModelSaveArguments.h"
 #include "TrainerArguments.h"
@@ -38,6 +40,7 @@
 
 // trainers
 #include "MeanCalculator.h"
+#include "SGDTrainer.h"
 
 // evaluators
 #include "Evaluator.h"
@@ -51,6 +54,46 @@
 
 using namespace ell;
 
+namespace
+{
+    // trains without loading the data into memory: in every epoch, the data file is read, parsed,
+    // and mapped on a background thread while the trainer consumes the examples
+    predictors::LinearPredictor<double> TrainFromStream(const LinearTrainerArguments& linearTrainerArguments, const common::TrainerArguments& trainerArguments, const common::DataLoadArguments& dataLoadArguments, const model::DynamicMap& map)
+    {
+        if (linearTrainerArguments.normalize)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "data normalization requires loading the data into memory, and cannot be used with streamData");
+        }
+
+        std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor<double>>> trainer;
+        switch (linearTrainerArguments.algorithm)
+        {
+        case LinearTrainerArguments::Algorithm::SGD:
+            trainer = common::MakeSGDTrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.randomSeedString });
+            break;
+        case LinearTrainerArguments::Algorithm::SparseDataSGD:
+            trainer = common::MakeSparseDataSGDTrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization });
+            break;
+        default:
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "streamData can only be used with the SGD and SparseDataSGD algorithms");
+        }
+        auto& sgdTrainer = dynamic_cast<trainers::SGDTrainerBase<double>&>(*trainer);
+
+        for (size_t epoch = 0; epoch < trainerArguments.numEpochs; ++epoch)
+        {
+            if (trainerArguments.verbose) std::cout << "Streaming epoch " << epoch << " ..." << std::endl;
+            auto exampleIterator = common::GetMappedExampleIterator(common::GetExampleIterator(dataLoadArguments), map);
+            sgdTrainer.Update(data::MakePrefetchingExampleIterator(std::move(exampleIterator)));
+        }
+
+        if (trainerArguments.verbose)
+        {
+            std::cout << "Finished training. The training error is not evaluated when the data is streamed.\n";
+        }
+        return trainer->GetPredictor();
+    }
+}
+
 int main(int argc, char* argv[])
 {
     try
@@ -62,6 +105,7 @@ int main(int argc, char* argv[])
         ParsedLinearTrainerArguments linearTrainerArguments;
         common::ParsedDataLoadArguments dataLoadArguments;
         common::ParsedMapLoadArguments mapLoadArguments;
+        common::ParsedMapApplicationArguments mapApplicationArguments;
         common::ParsedModelSaveArguments modelSaveArguments;
         common::ParsedTrainerArguments trainerArguments;
         common::ParsedEvaluatorArguments evaluatorArguments;
@@ -69,6 +113,7 @@ int main(int argc, char* argv[])
         commandLineParser.AddOptionSet(linearTrainerArguments);
         commandLineParser.AddOptionSet(dataLoadArguments);
         commandLineParser.AddOptionSet(mapLoadArguments);
+        commandLineParser.AddOptionSet(mapApplicationArguments);
         commandLineParser.AddOptionSet(modelSaveArguments);
         commandLineParser.AddOptionSet(trainerArguments);
         commandLineParser.AddOptionSet(evaluatorArguments);
@@ -86,90 +131,98 @@ int main(int argc, char* argv[])
         mapLoadArguments.defaultInputSize = dataLoadArguments.parsedDataDimension;
         auto map = common::LoadMap(mapLoadArguments);
 
-        // load dataset
-        if (trainerArguments.verbose) std::cout << "Loading data ..." << std::endl;
-        auto stream = utilities::OpenIfstream(dataLoadArguments.inputDataFilename);
-        auto mappedDataset = common::GetMappedDataset(stream, map);
-        auto mappedDatasetDimension = map.GetOutput(0).Size();
-
-        // normalize data
-        if (linearTrainerArguments.normalize)
-        {
-            if (trainerArguments.verbose) std::cout << "Sparisty-preserving data normalization ..." << std::endl;
-
-            // find inverse absolute mean
-            auto scaleVector = trainers::CalculateSparseTransformedMean(mappedDataset.GetAnyDataset(), [](data::IndexValue x) { return std::abs(x.value); });
-            scaleVector.Transform([](double x) {return x > 0.0 ? 1.0 / x : 0.0; });
-
-            // create normalizer
-            auto coordinateTransformation = [&](data::IndexValue x) { return x.value * scaleVector[x.index]; };
-            auto normalizer = predictors::MakeTransformationNormalizer<data::IterationPolicy::skipZeros>(coordinateTransformation);
-
-            // apply normalizer to data
-            auto normalizedDataset = common::GetMappedDataset(mappedDataset.GetExampleIterator(), normalizer);
-            mappedDataset.Swap(normalizedDataset);
-        }
-
         // predictor type
-        using PredictorType = predictors::LinearPredictor;
+        using PredictorType = predictors::LinearPredictor<double>;
+        PredictorType predictor;
 
-        // create linear trainer
-        std::unique_ptr<trainers::ITrainer<PredictorType>> trainer;
-        switch (linearTrainerArguments.algorithm)
-        {
-        case LinearTrainerArguments::Algorithm::SGD:
-            trainer = common::MakeSGDTrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.randomSeedString });
-            break;
-        case LinearTrainerArguments::Algorithm::SparseDataSGD:
-            trainer = common::MakeSparseDataSGDTrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization });
-            break;
-        case LinearTrainerArguments::Algorithm::SparseDataCenteredSGD:
+        if (linearTrainerArguments.streamData)
         {
-            auto mean = trainers::CalculateMean(mappedDataset.GetAnyDataset());
-            trainer = common::MakeSparseDataCenteredSGDTrainer(trainerArguments.lossFunctionArguments, mean, { linearTrainerArguments.regularization });
-            break;
+            predictor = TrainFromStream(linearTrainerArguments, trainerArguments, dataLoadArguments, map);
         }
-        case LinearTrainerArguments::Algorithm::SDCA:
+        else
         {
-            trainer = common::MakeSDCATrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.desiredPrecision, linearTrainerArguments.maxEpochs, linearTrainerArguments.permute, linearTrainerArguments.randomSeedString });
-            break;
-        }
-        default:
-            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "unrecognized algorithm type");
-        }
-
-        // create an evaluator
-        auto evaluator = common::MakeEvaluator<PredictorType>(mappedDataset.GetAnyDataset(), evaluatorArguments, trainerArguments.lossFunctionArguments);
-
-        // Train the predictor
-        if (trainerArguments.verbose) std::cout << "Training ..." << std::endl;
-        trainer->SetDataset(mappedDataset.GetAnyDataset());
+            // load dataset
+            if (trainerArguments.verbose) std::cout << "Loading data ..." << std::endl;
+            auto mappedDataset = common::GetMappedDataset(dataLoadArguments, map, mapApplicationArguments);
+
+            // normalize data
+            if (linearTrainerArguments.normalize)
+            {
+                if (trainerArguments.verbose) std::cout << "Sparisty-preserving data normalization ..." << std::endl;
+
+                // find inverse absolute mean
+                auto scaleVector = trainers::CalculateSparseTransformedMean(mappedDataset.GetAnyDataset(), [](data::IndexValue x) { return std::abs(x.value); });
+                scaleVector.Transform([](double x) {return x > 0.0 ? 1.0 / x : 0.0; });
+
+                // create normalizer
+                auto coordinateTransformation = [&](data::IndexValue x) { return x.value * scaleVector[x.index]; };
+                auto normalizer = predictors::MakeTransformationNormalizer<data::IterationPolicy::skipZeros>(coordinateTransformation);
+
+                // apply normalizer to data
+                auto normalizedDataset = common::GetMappedDataset(mappedDataset.GetExampleIterator(), normalizer);
+                mappedDataset.Swap(normalizedDataset);
+            }
+
+            // create linear trainer
+            std::unique_ptr<trainers::ITrainer<PredictorType>> trainer;
+            switch (linearTrainerArguments.algorithm)
+            {
+            case LinearTrainerArguments::Algorithm::SGD:
+                trainer = common::MakeSGDTrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.randomSeedString });
+                break;
+            case LinearTrainerArguments::Algorithm::SparseDataSGD:
+                trainer = common::MakeSparseDataSGDTrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization });
+                break;
+            case LinearTrainerArguments::Algorithm::SparseDataCenteredSGD:
+            {
+                auto mean = trainers::CalculateMean(mappedDataset.GetAnyDataset());
+                trainer = common::MakeSparseDataCenteredSGDTrainer(trainerArguments.lossFunctionArguments, mean, { linearTrainerArguments.regularization });
+                break;
+            }
+            case LinearTrainerArguments::Algorithm::SDCA:
+            {
+                trainer = common::MakeSDCATrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.desiredPrecision, linearTrainerArguments.maxEpochs, linearTrainerArguments.permute, linearTrainerArguments.randomSeedString });
+                break;
+            }
+            default:
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "unrecognized algorithm type");
+            }
+
+            // create an evaluator
+            auto evaluator = common::MakeEvaluator<PredictorType>(mappedDataset.GetAnyDataset(), evaluatorArguments, trainerArguments.lossFunctionArguments);
+
+            // Train the predictor
+            if (trainerArguments.verbose) std::cout << "Training ..." << std::endl;
+            trainer->SetDataset(mappedDataset.GetAnyDataset());
         
-        for (size_t epoch = 0; epoch < trainerArguments.numEpochs; ++epoch)
-        {
-            trainer->Update();
-            evaluator->Evaluate(trainer->GetPredictor());
-        }
+            for (size_t epoch = 0; epoch < trainerArguments.numEpochs; ++epoch)
+            {
+                trainer->Update();
+                evaluator->Evaluate(trainer->GetPredictor());
+            }
         
-        predictors::LinearPredictor predictor(trainer->GetPredictor());
-        predictor.Resize(mappedDatasetDimension);
-
-        // Print loss and errors
-        if (trainerArguments.verbose)
-        {
-            std::cout << "Finished training.\n";
-
-            // print evaluation
-            std::cout << "Training error\n";
-            evaluator->Print(std::cout);
-            std::cout << std::endl;
+            predictor = trainer->GetPredictor();
+
+            // Print loss and errors
+            if (trainerArguments.verbose)
+            {
+                std::cout << "Finished training.\n";
+
+                // print evaluation
+                std::cout << "Training error\n";
+                evaluator->Print(std::cout);
+                std::cout << std::endl;
+            }
         }
 
+        auto mappedDatasetDimension = map.GetOutput(0).Size();
+        predictor.Resize(mappedDatasetDimension);
+
         // Save predictor model
         if (modelSaveArguments.outputModelFilename != "")
         {
             // Create a model
-            auto model = common::AppendNodeToModel<nodes::LinearPredictorNode, PredictorType>(map, predictor);
+            auto model = common::AppendNodeToModel<nodes::LinearPredictorNode, PredictorType>(map, predictor, dataLoadArguments);
             common::SaveModel(model, modelSaveArguments.outputModelFilename);
         }
     }
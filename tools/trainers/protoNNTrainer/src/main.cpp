@@ -24,6 +24,7 @@
 #include "LoadModel.h"
 #include "MakeEvaluator.h"
 #include "MakeTrainer.h"
+#include "MapApplicationArguments.h"
 #include "MapLoadArguments.h"
 #include "MapSaveArguments.h"
 #include "ModelLoadArguments.h"
@@ -63,6 +64,7 @@ int main(int argc, char* argv[])
         // add arguments to the command line parser
         common::ParsedDataLoadArguments dataLoadArguments;
         common::ParsedMapLoadArguments mapLoadArguments;
+        common::ParsedMapApplicationArguments mapApplicationArguments;
         common::ParsedProtoNNTrainerArguments protoNNTrainerArguments;
         common::ParsedModelSaveArguments modelSaveArguments;
         common::ParsedEvaluatorArguments evaluatorArguments;
@@ -73,6 +75,7 @@ int main(int argc, char* argv[])
         commandLineParser.AddOptionSet(modelSaveArguments);
         commandLineParser.AddOptionSet(trainerArguments);
         commandLineParser.AddOptionSet(mapLoadArguments);
+        commandLineParser.AddOptionSet(mapApplicationArguments);
         commandLineParser.AddOptionSet(evaluatorArguments);
 
         // parse command line
@@ -89,8 +92,7 @@ int main(int argc, char* argv[])
 
         mapLoadArguments.defaultInputSize = dataLoadArguments.parsedDataDimension;
         auto map = common::LoadMap(mapLoadArguments);
-        auto stream = utilities::OpenIfstream(dataLoadArguments.inputDataFilename);
-        auto mappedDataset = common::GetMappedDataset(stream, map);
+        auto mappedDataset = common::GetMappedDataset(dataLoadArguments, map, mapApplicationArguments);
         auto mappedDatasetDimension = map.GetOutput(0).Size();
 
         // create protonn trainer
@@ -141,7 +143,7 @@ int main(int argc, char* argv[])
         if (modelSaveArguments.outputModelFilename != "")
         {
             // Create a model
-            auto model = common::AppendNodeToModel<nodes::ProtoNNPredictorNode, PredictorType>(map, predictor);
+            auto model = common::AppendNodeToModel<nodes::ProtoNNPredictorNode, PredictorType>(map, predictor, dataLoadArguments);
             common::SaveModel(model, modelSaveArguments.outputModelFilename);
         }
     }
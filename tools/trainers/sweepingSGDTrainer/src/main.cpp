@@ -23,6 +23,7 @@
 #include "LoadModel.h"
 #include "MakeEvaluator.h"
 #include "MakeTrainer.h"
+#include "MapApplicationArguments.h"
 #include "MapLoadArguments.h"
 #include "ModelSaveArguments.h"
 #include "ParametersEnumerator.h"
@@ -60,11 +61,13 @@ int main(int argc, char* argv[])
         common::ParsedTrainerArguments trainerArguments;
         common::ParsedDataLoadArguments dataLoadArguments;
         common::ParsedMapLoadArguments mapLoadArguments;
+        common::ParsedMapApplicationArguments mapApplicationArguments;
         common::ParsedModelSaveArguments modelSaveArguments;
 
         commandLineParser.AddOptionSet(trainerArguments);
         commandLineParser.AddOptionSet(dataLoadArguments);
         commandLineParser.AddOptionSet(mapLoadArguments);
+        commandLineParser.AddOptionSet(mapApplicationArguments);
         commandLineParser.AddOptionSet(modelSaveArguments);
 
         // parse command line
@@ -85,12 +88,11 @@ int main(int argc, char* argv[])
 
         // load dataset
         if (trainerArguments.verbose) std::cout << "Loading data ..." << std::endl;
-        auto stream = utilities::OpenIfstream(dataLoadArguments.inputDataFilename);
-        auto mappedDataset = common::GetMappedDataset(stream, map);
+        auto mappedDataset = common::GetMappedDataset(dataLoadArguments, map, mapApplicationArguments);
         auto mappedDatasetDimension = map.GetOutput(0).Size();
 
         // get predictor type
-        using PredictorType = predictors::LinearPredictor;
+        using PredictorType = predictors::LinearPredictor<double>;
 
         // set up evaluators to only evaluate on the last update of the multi-epoch trainer
         evaluators::EvaluatorParameters evaluatorParameters{ 1, false };
@@ -113,7 +115,7 @@ int main(int argc, char* argv[])
         if (trainerArguments.verbose) std::cout << "Training ..." << std::endl;
         trainer->SetDataset(mappedDataset.GetAnyDataset());
         trainer->Update();
-        predictors::LinearPredictor predictor(trainer->GetPredictor());
+        predictors::LinearPredictor<double> predictor(trainer->GetPredictor());
         predictor.Resize(mappedDatasetDimension);
 
         // print loss and errors
@@ -134,7 +136,7 @@ int main(int argc, char* argv[])
         if (modelSaveArguments.outputModelFilename != "")
         {
             // Create a model
-            auto model = common::AppendNodeToModel<nodes::LinearPredictorNode, PredictorType>(map, predictor);
+            auto model = common::AppendNodeToModel<nodes::LinearPredictorNode, PredictorType>(map, predictor, dataLoadArguments);
             common::SaveModel(model, modelSaveArguments.outputModelFilename);
         }
     }
@@ -28,6 +28,7 @@
 #include "DataLoaders.h"
 #include "DataSaveArguments.h"
 #include "LoadModel.h"
+#include "MapApplicationArguments.h"
 #include "MapLoadArguments.h"
 
 // model
@@ -52,11 +53,13 @@ int main(int argc, char* argv[])
         common::ParsedDataLoadArguments dataLoadArguments;
         common::ParsedDataSaveArguments dataSaveArguments;
         common::ParsedMapLoadArguments mapLoadArguments;
+        common::ParsedMapApplicationArguments mapApplicationArguments;
         ParsedApplyArguments applyArguments;
 
         commandLineParser.AddOptionSet(dataLoadArguments);
         commandLineParser.AddOptionSet(dataSaveArguments);
         commandLineParser.AddOptionSet(mapLoadArguments);
+        commandLineParser.AddOptionSet(mapApplicationArguments);
         commandLineParser.AddOptionSet(applyArguments);
 
         // parse command line
@@ -66,8 +69,7 @@ int main(int argc, char* argv[])
         auto map = common::LoadMap(mapLoadArguments);
 
         // get data iterator
-        auto stream = utilities::OpenIfstream(dataLoadArguments.inputDataFilename);
-        auto exampleIterator = common::GetExampleIterator(stream);
+        auto exampleIterator = common::GetExampleIterator(dataLoadArguments);
 
         // get output stream
         auto& outputStream = dataSaveArguments.outputDataStream;
@@ -116,6 +118,21 @@ int main(int argc, char* argv[])
             outputStream << "std:\t" << v << '\n';
         }
 
+        // output new dataset mode, with the map compiled or run on several threads
+        else if (mapApplicationArguments.IsAccelerated())
+        {
+            auto mappedExampleIterator = common::GetMappedExampleIterator(std::move(exampleIterator), map, mapApplicationArguments);
+            while (mappedExampleIterator.IsValid())
+            {
+                auto example = mappedExampleIterator.Get();
+                auto mappedDataVector = example.GetDataVector().CopyAs<data::FloatDataVector>();
+                auto mappedExample = data::DenseSupervisedExample(std::move(mappedDataVector), example.GetMetadata());
+                mappedExample.Print(outputStream);
+                outputStream << '\n';
+                mappedExampleIterator.Next();
+            }
+        }
+
         // output new dataset mode
         else
         {
@@ -41,6 +41,9 @@ struct CompileArguments
     /// <summary> true to optimize. </summary>
     bool optimize = false;
 
+    /// <summary> true to keep the port values in one arena, reusing the memory of ports that are no longer needed. </summary>
+    bool sharePortMemory = false;
+
     /// <summary> Name of the compiled function. </summary>
     std::string compiledFunctionName;
 
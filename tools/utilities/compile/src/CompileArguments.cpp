@@ -37,6 +37,13 @@ void ParsedCompileArguments::AddArgs(utilities::CommandLineParser& parser)
         "Optimize output code",
         false);
 
+    parser.AddOption(
+        sharePortMemory,
+        "sharePortMemory",
+        "spm",
+        "Reuse the memory of intermediate values that are no longer needed",
+        false);
+
     parser.AddOption(
         compiledFunctionName,
         "compiledFunctionName",
@@ -26,9 +26,15 @@
 #include "IRSteppableMapCompiler.h"
 #include "OutputNode.h"
 
+// nodes
+#include "ConstantFoldingPass.h"
+#include "ElementwiseFusionPass.h"
+#include "LayoutPropagationPass.h"
+
 // stl
 #include <chrono>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
 
@@ -52,8 +58,16 @@ void ProduceMapOutput(const common::MapLoadArguments& mapLoadArguments, ParsedCo
         settings.mapFunctionName = compileArguments.compiledFunctionName;
         settings.moduleName = compileArguments.compiledModuleName;
         settings.compilerSettings.optimize = compileArguments.optimize;
+        settings.sharePortMemory = compileArguments.sharePortMemory;
 
         MapCompilerType compiler(settings);
+        compiler.GetModelOptimizer().AddPass(std::make_unique<nodes::ConstantFoldingPass>());
+        if (compileArguments.outputType != CompileArguments::OutputType::compiledMap)
+        {
+            // fused nodes and reordered images can't be saved, so only change them when the output is code
+            compiler.GetModelOptimizer().AddPass(std::make_unique<nodes::LayoutPropagationPass>());
+            compiler.GetModelOptimizer().AddPass(std::make_unique<nodes::ElementwiseFusionPass>());
+        }
         auto compiledMap = compiler.Compile(map);
 
         switch (compileArguments.outputType)
@@ -0,0 +1,41 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     DataConverterArguments.h (dataConverter)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// utilities
+#include "CommandLineParser.h"
+
+// stl
+#include <string>
+
+namespace ell
+{
+/// <summary> Arguments for dataConverter. </summary>
+struct DataConverterArguments
+{
+    std::string outputBinaryFilename;
+    bool includeDenseBlock;
+};
+
+/// <summary> Arguments for parsed dataConverter. </summary>
+struct ParsedDataConverterArguments : public DataConverterArguments, public utilities::ParsedArgSet
+{
+    /// <summary> Adds the arguments. </summary>
+    ///
+    /// <param name="parser"> [in,out] The parser. </param>
+    virtual void AddArgs(utilities::CommandLineParser& parser);
+
+    /// <summary> Check arguments. </summary>
+    ///
+    /// <param name="parser"> The parser. </param>
+    ///
+    /// <returns> An utilities::CommandLineParseResult. </returns>
+    virtual utilities::CommandLineParseResult PostProcess(const utilities::CommandLineParser& parser);
+};
+}
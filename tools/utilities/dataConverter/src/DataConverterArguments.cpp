@@ -0,0 +1,28 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     DataConverterArguments.cpp (dataConverter)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "DataConverterArguments.h"
+
+namespace ell
+{
+void ParsedDataConverterArguments::AddArgs(utilities::CommandLineParser& parser)
+{
+    parser.AddOption(outputBinaryFilename, "outputBinaryFilename", "obf", "Path to the output binary dataset file", "");
+    parser.AddOption(includeDenseBlock, "includeDenseBlock", "dense", "Also store the data in a dense column-major block", false);
+}
+
+utilities::CommandLineParseResult ParsedDataConverterArguments::PostProcess(const utilities::CommandLineParser& parser)
+{
+    std::vector<std::string> parseErrorMessages;
+    if (outputBinaryFilename == "")
+    {
+        parseErrorMessages.push_back("Must specify an output binary dataset file");
+    }
+    return parseErrorMessages;
+}
+}
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     main.cpp (dataConverter)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "DataConverterArguments.h"
+
+// common
+#include "DataLoadArguments.h"
+#include "DataLoaders.h"
+
+// data
+#include "BinaryDataset.h"
+
+// utilities
+#include "CommandLineParser.h"
+#include "Exception.h"
+
+// stl
+#include <fstream>
+#include <iostream>
+
+using namespace ell;
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // create a command line parser
+        utilities::CommandLineParser commandLineParser(argc, argv);
+
+        // add arguments to the command line parser
+        common::ParsedDataLoadArguments dataLoadArguments;
+        ParsedDataConverterArguments dataConverterArguments;
+        commandLineParser.AddOptionSet(dataLoadArguments);
+        commandLineParser.AddOptionSet(dataConverterArguments);
+        commandLineParser.Parse();
+
+        // a binary dataset does not record feature hashing, so a model trained on it could not hash its input
+        if (dataLoadArguments.hashingBits > 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "feature hashing cannot be stored in a binary dataset; pass hashingBits to the trainer with the text data file instead");
+        }
+
+        // get data iterator
+        auto exampleIterator = common::GetExampleIterator(dataLoadArguments);
+
+        // write the binary dataset
+        std::ofstream outputStream(dataConverterArguments.outputBinaryFilename, std::ios::binary);
+        if (!outputStream.is_open())
+        {
+            throw utilities::SystemException(utilities::SystemExceptionErrors::fileNotWritable, "error opening file " + dataConverterArguments.outputBinaryFilename);
+        }
+        data::WriteBinaryDataset(outputStream, std::move(exampleIterator), dataConverterArguments.includeDenseBlock);
+    }
+    catch (const utilities::CommandLineParserPrintHelpException& exception)
+    {
+        std::cout << exception.GetHelpText() << std::endl;
+        return 0;
+    }
+    catch (const utilities::CommandLineParserErrorException& exception)
+    {
+        std::cerr << "Command line parse error:" << std::endl;
+        for (const auto& error : exception.GetParseErrors())
+        {
+            std::cerr << error.GetMessage() << std::endl;
+        }
+        return 1;
+    }
+    catch (const utilities::Exception& exception)
+    {
+        std::cerr << "exception: " << exception.GetMessage() << std::endl;
+        return 1;
+    }
+
+    // the end
+    return 0;
+}